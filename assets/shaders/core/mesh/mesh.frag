@@ -0,0 +1,150 @@
+#version 450
+#extension GL_EXT_nonuniform_qualifier : require
+
+layout(location = 0) in vec3 fragColor;
+layout(location = 1) in vec2 fragTexCoord;
+layout(location = 2) flat in uint fragTextureIndex;
+layout(location = 3) in vec3 fragWorldPos;
+layout(location = 4) in vec3 fragNormal;
+
+layout(location = 0) out vec4 outColor;
+
+// Set global bindless: binding 0 = todas as texturas, binding 1 = sampler compartilhado
+layout(set = 0, binding = 0) uniform texture2D textures[];
+layout(set = 0, binding = 1) uniform sampler linearSampler;
+
+// Mesmo layout do GpuSceneData (PipelineManager.hpp)
+struct SceneData {
+    mat4 view;
+    mat4 cascadeViewProj[4];
+    vec4 cascadeSplits;
+    vec4 lightDirection;
+    vec4 lightColor;
+    uint shadowMapIndices[4];
+    uint cascadeCount;
+    float shadowTexelSize;
+    uint lightBufferIndex;
+    uint clusterBufferIndex;
+    vec4 clusterScale;
+    uvec4 clusterGrid;
+};
+
+// Mesmo layout do GpuPointLight (PipelineManager.hpp)
+struct PointLight {
+    vec4 positionRadius;
+    vec4 colorIntensity;
+};
+
+// Binding 2 = storage buffers: dados do frame, luzes pontuais e grade de clusters (cluster.comp)
+layout(set = 0, binding = 2) readonly buffer SceneBuffer {
+    SceneData scene;
+} sceneBuffers[];
+
+layout(set = 0, binding = 2) readonly buffer LightBuffer {
+    PointLight lights[];
+} lightBuffers[];
+
+layout(set = 0, binding = 2) readonly buffer ClusterBuffer {
+    uint data[];
+} clusterBuffers[];
+
+layout(push_constant) uniform PushConstants {
+    mat4 viewProj;
+    uint objectBufferIndex;
+    uint sceneBufferIndex;
+} push;
+
+// PCF 2x2 bilinear: um textureGather e quatro comparações
+float sampleCascade(uint cascade, vec3 worldPos) {
+    SceneData scene = sceneBuffers[push.sceneBufferIndex].scene;
+
+    vec4 lightClip = scene.cascadeViewProj[cascade] * vec4(worldPos, 1.0);
+    vec3 coord     = lightClip.xyz / lightClip.w;
+    vec2 uv        = coord.xy * 0.5 + 0.5;
+    if (any(lessThan(uv, vec2(0.0))) || any(greaterThan(uv, vec2(1.0))) || coord.z > 1.0) {
+        return 1.0;
+    }
+
+    vec2 texel    = uv / scene.shadowTexelSize - 0.5;
+    vec2 weight   = fract(texel);
+    vec2 gatherUv = (floor(texel) + 1.0) * scene.shadowTexelSize;
+
+    uint index  = scene.shadowMapIndices[cascade];
+    vec4 depths = textureGather(sampler2D(textures[nonuniformEXT(index)], linearSampler), gatherUv);
+    vec4 lit    = step(vec4(coord.z), depths);
+
+    // Ordem do gather: x = (0,1), y = (1,1), z = (1,0), w = (0,0)
+    float top    = mix(lit.w, lit.z, weight.x);
+    float bottom = mix(lit.x, lit.y, weight.x);
+    return mix(top, bottom, weight.y);
+}
+
+float shadowFactor(vec3 worldPos) {
+    SceneData scene = sceneBuffers[push.sceneBufferIndex].scene;
+
+    float viewDepth = -(scene.view * vec4(worldPos, 1.0)).z;
+    for (uint i = 0; i < scene.cascadeCount; i++) {
+        if (viewDepth < scene.cascadeSplits[i]) {
+            return sampleCascade(i, worldPos);
+        }
+    }
+    return 1.0;        // Além da última cascata: sem sombra
+}
+
+// Só as luzes do cluster do pixel (tile de tela x fatia exponencial de profundidade)
+vec3 pointLighting(vec3 worldPos, vec3 normal) {
+    SceneData scene = sceneBuffers[push.sceneBufferIndex].scene;
+    if (scene.clusterGrid.z == 0) {
+        return vec3(0.0);
+    }
+
+    float viewDepth = -(scene.view * vec4(worldPos, 1.0)).z;
+    uvec2 tile      = min(uvec2(gl_FragCoord.xy * scene.clusterScale.xy), scene.clusterGrid.xy - 1u);
+    uint slice      = uint(clamp(log(max(viewDepth, 1e-4)) * scene.clusterScale.z + scene.clusterScale.w, 0.0, float(scene.clusterGrid.z - 1)));
+    uint cluster    = (slice * scene.clusterGrid.y + tile.y) * scene.clusterGrid.x + tile.x;
+
+    uint clusterCount = scene.clusterGrid.x * scene.clusterGrid.y * scene.clusterGrid.z;
+    uint count        = clusterBuffers[scene.clusterBufferIndex].data[cluster];
+    uint first        = clusterCount + cluster * scene.clusterGrid.w;
+
+    vec3 result = vec3(0.0);
+    for (uint i = 0; i < count; i++) {
+        uint index       = clusterBuffers[scene.clusterBufferIndex].data[first + i];
+        PointLight light = lightBuffers[scene.lightBufferIndex].lights[index];
+
+        vec3 toLight    = light.positionRadius.xyz - worldPos;
+        float distance2 = dot(toLight, toLight);
+        float radius2   = light.positionRadius.w * light.positionRadius.w;
+        if (distance2 >= radius2) {
+            continue;
+        }
+
+        // Inverso do quadrado com janela suave até zero no alcance
+        float window  = 1.0 - (distance2 * distance2) / (radius2 * radius2);
+        float falloff = window * window / (distance2 + 1.0);
+        float diffuse = max(dot(normal, toLight * inversesqrt(distance2)), 0.0);
+        result += light.colorIntensity.rgb * (light.colorIntensity.w * falloff * diffuse);
+    }
+    return result;
+}
+
+void main() {
+    vec4 albedo = vec4(fragColor, 1.0) * texture(sampler2D(textures[nonuniformEXT(fragTextureIndex)], linearSampler), fragTexCoord);
+
+    // Malhas sem normal (triângulo/quad de teste) ficam sem iluminação
+    float normalLength = length(fragNormal);
+    if (normalLength < 1e-4) {
+        outColor = albedo;
+        return;
+    }
+
+    SceneData scene  = sceneBuffers[push.sceneBufferIndex].scene;
+    vec3 normal      = fragNormal / normalLength;
+    vec3 toLight     = -normalize(scene.lightDirection.xyz);
+    float diffuse    = max(dot(normal, toLight), 0.0);
+    float visibility = diffuse > 0.0 ? shadowFactor(fragWorldPos) : 0.0;
+
+    vec3 lighting = scene.lightColor.rgb * (scene.lightColor.w + scene.lightDirection.w * diffuse * visibility);
+    lighting += pointLighting(fragWorldPos, normal);
+    outColor      = vec4(albedo.rgb * lighting, albedo.a);
+}
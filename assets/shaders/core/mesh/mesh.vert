@@ -0,0 +1,46 @@
+#version 450
+#extension GL_EXT_nonuniform_qualifier : require
+
+layout(location = 0) in vec3 inPosition;
+layout(location = 1) in vec3 inColor;
+layout(location = 2) in vec2 inTexCoord;
+layout(location = 3) in vec3 inNormal;
+
+layout(location = 0) out vec3 fragColor;
+layout(location = 1) out vec2 fragTexCoord;
+layout(location = 2) flat out uint fragTextureIndex;
+layout(location = 3) out vec3 fragWorldPos;
+layout(location = 4) out vec3 fragNormal;
+
+// Mesmo layout do GpuObjectData (PipelineManager.hpp)
+struct ObjectData {
+    mat4 model;
+    uint textureIndex;
+    uint pad0;
+    uint pad1;
+    uint pad2;
+};
+
+// Set global bindless: binding 2 = array de storage buffers
+layout(set = 0, binding = 2) readonly buffer ObjectBuffer {
+    ObjectData objects[];
+} objectBuffers[];
+
+// Uma vez por passada; o objeto vem do firstInstance de cada draw
+layout(push_constant) uniform PushConstants {
+    mat4 viewProj;
+    uint objectBufferIndex;
+    uint sceneBufferIndex;
+} push;
+
+void main() {
+    ObjectData object = objectBuffers[push.objectBufferIndex].objects[gl_InstanceIndex];
+
+    vec4 worldPos = object.model * vec4(inPosition, 1.0);
+    gl_Position = push.viewProj * worldPos;
+    fragColor = inColor;
+    fragTexCoord = inTexCoord;
+    fragTextureIndex = object.textureIndex;
+    fragWorldPos = worldPos.xyz;
+    fragNormal = mat3(object.model) * inNormal;        // Escala uniforme: o frag só normaliza
+}
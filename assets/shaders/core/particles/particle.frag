@@ -0,0 +1,24 @@
+#version 450
+
+layout(location = 0) in vec2 fragCorner;
+layout(location = 1) in vec4 fragColor;
+layout(location = 2) in float fragFade;
+layout(location = 3) flat in uint fragAdditive;
+
+layout(location = 0) out vec4 outColor;
+
+// Blend premultiplicado (src + dst * (1 - src.a)): alpha 0 soma a cor, como luz
+void main() {
+    // Disco com borda suave no lugar de textura
+    float coverage = (1.0 - smoothstep(0.5, 1.0, length(fragCorner))) * fragFade;
+    if (coverage <= 0.0) {
+        discard;
+    }
+
+    if (fragAdditive != 0u) {
+        outColor = vec4(fragColor.rgb * coverage, 0.0);
+    } else {
+        float alpha = fragColor.a * coverage;
+        outColor    = vec4(fragColor.rgb * alpha, alpha);
+    }
+}
@@ -0,0 +1,61 @@
+#version 450
+#extension GL_EXT_nonuniform_qualifier : require
+
+// Sem vertex buffer: 6 vértices por instância, uma instância por partícula viva
+layout(location = 0) out vec2 fragCorner;        // [-1, 1] no quad
+layout(location = 1) out vec4 fragColor;         // rgb premultiplicado pela cobertura no frag; a: opacidade
+layout(location = 2) out float fragFade;
+layout(location = 3) flat out uint fragAdditive;
+
+// Mesmo layout do GpuParticle (ParticleSystem.hpp)
+struct Particle {
+    vec4 positionAge;
+    vec4 velocityLifetime;
+    vec4 color;
+    vec4 sizeGravityDrag;
+    uint emitter;
+    uint flags;
+    uint pad0;
+    uint pad1;
+};
+
+// Set global bindless: binding 2 = storage buffers
+layout(set = 0, binding = 2) readonly buffer ParticleBuffer {
+    Particle particles[];
+} particleBuffers[];
+
+// Índices compactados pela simulação deste frame
+layout(set = 0, binding = 2) readonly buffer DrawList {
+    uint indices[];
+} drawLists[];
+
+// Mesmo layout de ParticleSystem::DrawPushConstants
+layout(push_constant) uniform PushConstants {
+    mat4 viewProj;
+    vec4 cameraRight;
+    vec4 cameraUp;
+    uint particleBufferIndex;
+    uint drawListIndex;
+} push;
+
+const vec2 CORNERS[6] = vec2[](vec2(-1.0, -1.0), vec2(1.0, -1.0), vec2(1.0, 1.0),
+                               vec2(-1.0, -1.0), vec2(1.0, 1.0), vec2(-1.0, 1.0));
+
+void main() {
+    uint     index    = drawLists[push.drawListIndex].indices[gl_InstanceIndex];
+    Particle particle = particleBuffers[push.particleBufferIndex].particles[index];
+
+    float t        = clamp(particle.positionAge.w / particle.velocityLifetime.w, 0.0, 1.0);
+    float size     = mix(particle.sizeGravityDrag.x, particle.sizeGravityDrag.y, t);
+    vec2  corner   = CORNERS[gl_VertexIndex];
+    vec3  position = particle.positionAge.xyz + (push.cameraRight.xyz * corner.x + push.cameraUp.xyz * corner.y) * size;
+
+    bool additive = (particle.flags & 1u) != 0u;
+
+    gl_Position  = push.viewProj * vec4(position, 1.0);
+    fragCorner   = corner;
+    fragColor    = particle.color;
+    // Aditivas apagam no fim; as de alpha também entram suaves para não "estalar" no emissor
+    fragFade     = additive ? 1.0 - t : smoothstep(0.0, 0.1, t) * (1.0 - t);
+    fragAdditive = additive ? 1u : 0u;
+}
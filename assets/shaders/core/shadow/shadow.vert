@@ -0,0 +1,30 @@
+#version 450
+#extension GL_EXT_nonuniform_qualifier : require
+
+// Só a posição: o pipeline da shadow map não tem fragment shader
+layout(location = 0) in vec3 inPosition;
+
+// Mesmo layout do GpuObjectData (PipelineManager.hpp)
+struct ObjectData {
+    mat4 model;
+    uint textureIndex;
+    uint pad0;
+    uint pad1;
+    uint pad2;
+};
+
+layout(set = 0, binding = 2) readonly buffer ObjectBuffer {
+    ObjectData objects[];
+} objectBuffers[];
+
+// viewProj = matriz da cascata
+layout(push_constant) uniform PushConstants {
+    mat4 viewProj;
+    uint objectBufferIndex;
+    uint sceneBufferIndex;
+} push;
+
+void main() {
+    ObjectData object = objectBuffers[push.objectBufferIndex].objects[gl_InstanceIndex];
+    gl_Position = push.viewProj * object.model * vec4(inPosition, 1.0);
+}
@@ -0,0 +1,43 @@
+#pragma once
+
+#include <vulkan/vulkan.h>
+#include <cstdint>
+#include <vector>
+
+// Command buffers de compute submetidos numa fila separada da gráfica.
+//
+// Cada frame grava o trabalho independente do raster (ex.: atribuição de luzes aos clusters) num
+// command buffer próprio e o submete antes do frame gráfico; a submissão sinaliza o timeline da
+// fila de compute e o frame gráfico espera esse valor só no estágio que consome o resultado. Assim
+// o compute roda em paralelo com sombras e depth, que não dependem dele.
+//
+// Um command buffer por slot de frame: o slot só volta a ser gravado depois que o frame gráfico que
+// o usou terminou, e esse frame esperou o compute do mesmo slot, então o buffer já está livre.
+class AsyncCompute {
+  public:
+	AsyncCompute(VkDevice device, VkQueue queue, uint32_t queueFamily, uint32_t frameSlots);
+	~AsyncCompute();
+
+	AsyncCompute(const AsyncCompute &)            = delete;
+	AsyncCompute &operator=(const AsyncCompute &) = delete;
+
+	// Reinicia e abre o command buffer do slot
+	VkCommandBuffer begin(uint32_t slot);
+
+	// Fecha e submete o command buffer aberto; devolve o valor do timeline que ele sinaliza
+	uint64_t submit();
+
+	VkSemaphore getTimelineSemaphore() const { return timeline; }
+	uint32_t    getQueueFamily() const { return queueFamily; }
+	uint64_t    getSubmittedValue() const { return submittedValue; }
+
+  private:
+	VkDevice                     device;
+	VkQueue                      queue;
+	uint32_t                     queueFamily;
+	VkCommandPool                commandPool = VK_NULL_HANDLE;
+	std::vector<VkCommandBuffer> commandBuffers;
+	VkSemaphore                  timeline       = VK_NULL_HANDLE;
+	uint64_t                     submittedValue = 0;
+	VkCommandBuffer              recording      = VK_NULL_HANDLE;
+};
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Cenas fixas do renderer, escolhidas na linha de comando (--scene)
+enum class BenchmarkScene {
+	Car,            // Um carro girando (cena padrão)
+	CarGrid,        // Grade de carros: muitos objetos e draws, estressa a gravação de comandos
+	NightLights     // Grade de carros à noite com 1000 luzes pontuais: estressa a iluminação clustered
+};
+
+bool        parseBenchmarkScene(const std::string &name, BenchmarkScene &scene);
+const char *toString(BenchmarkScene scene);
+
+// Resumo de uma série de tempos (ms). Percentis pelo método nearest-rank.
+struct FrameTimeSummary {
+	size_t count = 0;
+	double mean  = 0.0;
+	double min   = 0.0;
+	double p50   = 0.0;
+	double p95   = 0.0;
+	double p99   = 0.0;
+	double max   = 0.0;
+};
+
+// Contexto gravado junto com os números, para saber se dois relatórios são comparáveis
+struct BenchmarkInfo {
+	std::string scene;
+	std::string device;
+	uint32_t    width        = 0;
+	uint32_t    height       = 0;
+	uint32_t    warmupFrames = 0;
+	double      timeStepMs   = 0.0;
+	bool        headless     = false;
+	std::string presentPolicy;
+};
+
+// Coleta os tempos dos frames medidos e gera o relatório JSON.
+//   frame : tempo total do frame no CPU, incluindo a espera pelo slot (~ 1/FPS)
+//   cpu   : trabalho do CPU no frame (gravação + submit), sem a espera pelo slot
+//   gpu   : timestamps no início e no fim do command buffer (vazio se o device não suporta)
+class BenchmarkReport {
+  public:
+	void addFrame(double frameMs, double cpuMs);
+	void addGpuFrame(double gpuMs);
+
+	static FrameTimeSummary summarize(std::vector<double> samples);
+
+	std::string toJson(const BenchmarkInfo &info) const;
+	bool        writeJson(const std::string &path, const BenchmarkInfo &info) const;
+
+	size_t getFrameCount() const { return cpuMs.size(); }
+
+  private:
+	std::vector<double> frameMs;
+	std::vector<double> cpuMs;
+	std::vector<double> gpuMs;
+};
@@ -0,0 +1,69 @@
+#pragma once
+
+#include <core/DescriptorAllocator.hpp>
+
+#include <vulkan/vulkan.h>
+#include <cstdint>
+#include <vector>
+
+// Set global de descritores "bindless" (descriptor indexing, Vulkan 1.2).
+//
+// Um único VkDescriptorSet, ligado uma vez por passada, com:
+//   binding 0 : array de sampled images   (índice = TextureManager::getBindlessIndex)
+//   binding 1 : sampler compartilhado
+//   binding 2 : array de storage buffers  (dados por objeto, materiais...)
+//
+// Os shaders indexam os arrays pelos IDs que vêm nos dados do objeto, então não existe
+// bind de descritor por draw. Os arrays usam PARTIALLY_BOUND + UPDATE_AFTER_BIND:
+// slots vazios são permitidos e slots livres podem ser escritos com frames em voo.
+class BindlessDescriptors {
+  public:
+	static constexpr uint32_t TEXTURE_BINDING        = 0;
+	static constexpr uint32_t SAMPLER_BINDING        = 1;
+	static constexpr uint32_t STORAGE_BUFFER_BINDING = 2;
+
+	BindlessDescriptors(VkDevice               device,
+	                    VkPhysicalDevice       physicalDevice,
+	                    DescriptorLayoutCache &layoutCache,        // Dono do layout
+	                    uint32_t               maxTextures       = 4096,
+	                    uint32_t               maxStorageBuffers = 1024);
+	~BindlessDescriptors();
+
+	BindlessDescriptors(const BindlessDescriptors &)            = delete;
+	BindlessDescriptors &operator=(const BindlessDescriptors &) = delete;
+
+	// Features de descriptor indexing que o set precisa (usado na escolha do device)
+	static bool isSupported(VkPhysicalDevice physicalDevice);
+
+	// Devolvem o índice do slot. Liberar um slot só quando nenhum frame em voo usa ele.
+	uint32_t registerTexture(VkImageView view);
+	void     releaseTexture(uint32_t index);
+	uint32_t registerStorageBuffer(VkBuffer buffer, VkDeviceSize offset = 0, VkDeviceSize range = VK_WHOLE_SIZE);
+	void     releaseStorageBuffer(uint32_t index);
+	void     setSampler(VkSampler sampler);
+
+	void bind(VkCommandBuffer cmd, VkPipelineLayout layout, VkPipelineBindPoint bindPoint = VK_PIPELINE_BIND_POINT_GRAPHICS) const;
+
+	VkDescriptorSetLayout getLayout() const { return layout; }
+	VkDescriptorSet       getSet() const { return set; }
+	uint32_t              getTextureCount() const { return textureSlots.highWater - static_cast<uint32_t>(textureSlots.freeList.size()); }
+	uint32_t              getStorageBufferCount() const { return bufferSlots.highWater - static_cast<uint32_t>(bufferSlots.freeList.size()); }
+
+  private:
+	struct SlotAllocator {
+		uint32_t              capacity  = 0;
+		uint32_t              highWater = 0;
+		std::vector<uint32_t> freeList;
+
+		uint32_t allocate();
+		void     free(uint32_t index);
+	};
+
+	VkDevice              device;
+	VkDescriptorSetLayout layout = VK_NULL_HANDLE;
+	VkDescriptorPool      pool   = VK_NULL_HANDLE;
+	VkDescriptorSet       set    = VK_NULL_HANDLE;
+
+	SlotAllocator textureSlots;
+	SlotAllocator bufferSlots;
+};
@@ -27,7 +27,10 @@ class BufferManager {
 	BufferHandle createVertexBuffer(const void *data, size_t size);
 	BufferHandle createIndexBuffer(const void *data, size_t size);
 	BufferHandle createUniformBuffer(size_t size);
+	BufferHandle createStorageBuffer(size_t size);        // Visível pela CPU, escrito todo frame
+	BufferHandle createGpuStorageBuffer(size_t size, VkBufferUsageFlags extraUsage = 0);        // Só a GPU lê e escreve (compute)
 	BufferHandle createStagingBuffer(size_t size);
+	BufferHandle createReadbackBuffer(size_t size);        // GPU -> CPU (cópia de imagem/buffer para ler na CPU)
 
 	void destroyBuffer(BufferHandle& handle);
 
@@ -42,11 +45,19 @@ class BufferManager {
 	void *mapBuffer(BufferHandle buffer);
 	void  unmapBuffer(BufferHandle buffer);
 	void  updateBuffer(BufferHandle buffer, const void *data, size_t size);
+	void  readBuffer(BufferHandle buffer, void *dst, size_t size);        // Invalida o cache antes de copiar
+
+	// Storage buffers criados depois disso são usados por todas essas famílias sem transferência de posse
+	void setSharedQueueFamilies(std::vector<uint32_t> families) { sharedQueueFamilies = std::move(families); }
+
+	// Grava e submete comandos avulsos na fila gráfica e espera terminar
+	void executeOneTimeCommands(std::function<void(VkCommandBuffer)> cmdFunc);
 
 	// Getters
 	VkBuffer getVkBuffer(BufferHandle handle) const {
 		return resources.getVkBuffer(handle);
 	}
+	uint64_t getUploadedBytes() const { return uploadedBytes; }        // Vértices/índices via staging, acumulado
 
   private:
 	VkDevice         device;
@@ -54,8 +65,9 @@ class BufferManager {
 	ResourceManager &resources;
 	CommandManager  &commands;
 	QueueManager    &queueManager;
+	uint64_t         uploadedBytes = 0;
 
-	void executeOneTimeCommands(std::function<void(VkCommandBuffer)> cmdFunc);
+	std::vector<uint32_t> sharedQueueFamilies;
 };
 
 #endif
\ No newline at end of file
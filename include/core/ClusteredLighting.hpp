@@ -0,0 +1,93 @@
+#pragma once
+
+#include <core/BindlessDescriptors.hpp>
+#include <core/BufferManager.hpp>
+#include <core/PipelineManager.hpp>
+#include <core/ResourceTypes.hpp>
+
+#include <vulkan/vulkan.h>
+#include <cstddef>
+#include <cstdint>
+#include <glm/glm.hpp>
+#include <vector>
+
+struct ClusterSettings {
+	uint32_t tilesX              = 16;          // Divisões da tela em x
+	uint32_t tilesY              = 9;           // Divisões da tela em y
+	uint32_t slices              = 24;          // Fatias de profundidade (exponenciais entre near e far)
+	uint32_t maxLights           = 4096;        // Luzes por frame; o excedente é ignorado
+	uint32_t maxLightsPerCluster = 128;         // Limite do custo por pixel
+};
+
+// Iluminação clustered forward para muitas luzes pontuais.
+//
+// O frustum da câmera é dividido numa grade 3D em view space (tiles de tela x fatias exponenciais
+// de profundidade). Todo frame um compute shader testa cada luz (esfera) contra a AABB de cada
+// cluster e grava, por cluster, a contagem e a lista de índices; o fragment shader acha o cluster
+// pelo gl_FragCoord e pela profundidade e só percorre essas luzes. O custo por pixel fica limitado
+// por maxLightsPerCluster, não pelo total de luzes da cena.
+//
+// As luzes ficam num buffer visível pela CPU por frame em voo (reescrito todo frame, sem staging);
+// a grade é um buffer só da GPU por frame em voo, escrito pelo compute (na fila gráfica ou na de
+// compute assíncrono) e lido no mesmo frame pelo passe opaco.
+class ClusteredLighting {
+  public:
+	ClusteredLighting(VkDevice device, BufferManager &buffers, BindlessDescriptors &bindless, uint32_t framesInFlight,
+	                  const ClusterSettings &settings = {});
+	~ClusteredLighting();
+
+	ClusteredLighting(const ClusteredLighting &)            = delete;
+	ClusteredLighting &operator=(const ClusteredLighting &) = delete;
+
+	// Luzes e câmera do frame (perspectiva simétrica fovY/aspect, Y invertido do Vulkan)
+	void update(uint32_t             frame,
+	            const glm::mat4     &view,
+	            float                fovY,
+	            float                aspect,
+	            float                nearPlane,
+	            float                farPlane,
+	            VkExtent2D           extent,
+	            const GpuPointLight *lights,
+	            size_t               count);
+
+	// Campos de luz pontual do GpuSceneData
+	void writeSceneData(GpuSceneData &data) const;
+
+	// Dispatch da atribuição de luzes aos clusters (fora de render pass)
+	void recordCulling(VkCommandBuffer cmd) const;
+
+	VkBuffer getClusterBuffer() const { return buffers.getVkBuffer(clusterBuffers[frame]); }
+	uint32_t getLightCount() const { return lightCount; }
+	uint32_t getClusterCount() const { return settings.tilesX * settings.tilesY * settings.slices; }
+
+  private:
+	// Mesmo layout do push constant de cluster.comp
+	struct CullPushConstants {
+		glm::mat4  view;
+		glm::vec4  projection;        // x, y: tan da metade do fov horizontal/vertical; z: near; w: far
+		glm::uvec4 grid;              // Clusters em x, y, z; w: luzes por cluster
+		uint32_t   lightBufferIndex;
+		uint32_t   clusterBufferIndex;
+		uint32_t   lightCount;
+		uint32_t   pad;
+	};
+
+	VkDevice             device;
+	BufferManager       &buffers;
+	BindlessDescriptors &bindless;
+	ClusterSettings      settings;
+
+	VkPipeline       pipeline       = VK_NULL_HANDLE;
+	VkPipelineLayout pipelineLayout = VK_NULL_HANDLE;
+
+	std::vector<BufferHandle> lightBuffers;
+	std::vector<uint32_t>     lightBufferIndices;
+	std::vector<BufferHandle> clusterBuffers;
+	std::vector<uint32_t>     clusterBufferIndices;
+
+	uint32_t          frame          = 0;
+	uint32_t          lightCount     = 0;
+	bool              overflowWarned = false;
+	CullPushConstants constants{};
+	glm::vec4         clusterScale{0.0f};
+};
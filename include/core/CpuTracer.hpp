@@ -0,0 +1,87 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// Zonas de CPU exportadas no formato trace-event do Chrome (abre em chrome://tracing ou ui.perfetto.dev).
+//
+// Cada thread grava num ring buffer próprio (thread_local), então zonas de threads diferentes não
+// disputam nada. O mutex do buffer só é disputado quando writeChromeTrace() lê aquele buffer.
+// Com o buffer cheio, os eventos mais antigos são sobrescritos.
+//
+// Os macros somem em builds sem SPEED_RACER_CPU_TRACE (opção do CMake).
+class CpuTracer {
+  public:
+	static constexpr size_t EVENTS_PER_THREAD = 16384;
+
+	struct Event {
+		const char *name;        // Literal: só o ponteiro é guardado
+		uint64_t    startNs;
+		uint64_t    durationNs;
+	};
+
+	// Nanossegundos desde o início do processo (steady_clock)
+	static uint64_t now() {
+		return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - epoch).count());
+	}
+
+	static void record(const char *name, uint64_t startNs, uint64_t endNs);
+	static void setThreadName(const char *name);
+
+	// Pausar não apaga o que já foi gravado
+	static void setEnabled(bool value) { enabled.store(value, std::memory_order_relaxed); }
+	static bool isEnabled() { return enabled.load(std::memory_order_relaxed); }
+
+	// Junta os buffers de todas as threads num JSON de trace-event. Pode ser chamado a qualquer momento.
+	static bool writeChromeTrace(const std::string &path);
+
+  private:
+	struct ThreadBuffer {
+		std::mutex                           mutex;
+		std::array<Event, EVENTS_PER_THREAD> events;
+		uint64_t                             written = 0;        // Total gravado (o ring guarda os últimos EVENTS_PER_THREAD)
+		uint32_t                             threadId;
+		std::string                          threadName;
+	};
+
+	static inline const std::chrono::steady_clock::time_point epoch = std::chrono::steady_clock::now();
+	static inline std::atomic<bool>                           enabled{true};
+
+	// Buffers de threads que já terminaram continuam aqui até o fim do processo
+	static inline std::mutex                                 registryMutex;
+	static inline std::vector<std::shared_ptr<ThreadBuffer>> registry;
+
+	static ThreadBuffer &threadBuffer();
+};
+
+// Zona RAII: mede do construtor ao destrutor
+class CpuTraceZone {
+  public:
+	explicit CpuTraceZone(const char *name) :
+	    name(name),
+	    startNs(CpuTracer::now()) {}
+	~CpuTraceZone() { CpuTracer::record(name, startNs, CpuTracer::now()); }
+
+	CpuTraceZone(const CpuTraceZone &)            = delete;
+	CpuTraceZone &operator=(const CpuTraceZone &) = delete;
+
+  private:
+	const char *name;
+	uint64_t    startNs;
+};
+
+#ifdef SPEED_RACER_CPU_TRACE
+#	define CPU_TRACE_CONCAT_INNER(a, b) a##b
+#	define CPU_TRACE_CONCAT(a, b)       CPU_TRACE_CONCAT_INNER(a, b)
+#	define PROFILE_CPU_ZONE(name)       CpuTraceZone CPU_TRACE_CONCAT(cpuTraceZone_, __LINE__)(name)
+#	define PROFILE_CPU_THREAD(name)     CpuTracer::setThreadName(name)
+#else
+#	define PROFILE_CPU_ZONE(name)
+#	define PROFILE_CPU_THREAD(name)
+#endif
@@ -0,0 +1,36 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+// Fila de destruição adiada: cada entrada guarda o valor do timeline do FrameScheduler a partir
+// do qual a GPU não usa mais o objeto. flush(completed) roda os deleters já liberados, na ordem
+// em que foram enfileirados. Serve para qualquer coisa que ainda possa estar em voo
+// (swapchain antigo, image views, framebuffers...) sem precisar de vkDeviceWaitIdle.
+class DeletionQueue {
+  public:
+	DeletionQueue() = default;
+	~DeletionQueue() { flushAll(); }
+
+	DeletionQueue(const DeletionQueue &)            = delete;
+	DeletionQueue &operator=(const DeletionQueue &) = delete;
+
+	void push(uint64_t retireValue, std::function<void()> deleter);
+
+	// Executa tudo com retireValue <= completedValue
+	void flush(uint64_t completedValue);
+
+	// Só depois de vkDeviceWaitIdle (shutdown)
+	void flushAll();
+
+	size_t getPendingCount() const { return entries.size(); }
+
+  private:
+	struct Entry {
+		uint64_t              retireValue;
+		std::function<void()> deleter;
+	};
+
+	std::vector<Entry> entries;
+};
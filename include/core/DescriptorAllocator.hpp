@@ -0,0 +1,104 @@
+#pragma once
+
+#include <vulkan/vulkan.h>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+// Deduplica VkDescriptorSetLayout: o mesmo conjunto de bindings devolve sempre o mesmo layout.
+// A chave inclui flags do layout e os binding flags (VkDescriptorSetLayoutBindingFlagsCreateInfo no pNext).
+// Os layouts vivem até o cache ser destruído.
+class DescriptorLayoutCache {
+  public:
+	explicit DescriptorLayoutCache(VkDevice device);
+	~DescriptorLayoutCache();
+
+	DescriptorLayoutCache(const DescriptorLayoutCache &)            = delete;
+	DescriptorLayoutCache &operator=(const DescriptorLayoutCache &) = delete;
+
+	VkDescriptorSetLayout getLayout(const VkDescriptorSetLayoutCreateInfo &info);
+
+	size_t getLayoutCount() const { return layouts.size(); }
+
+  private:
+	struct BindingKey {
+		uint32_t                 binding;
+		VkDescriptorType         type;
+		uint32_t                 count;
+		VkShaderStageFlags       stages;
+		VkDescriptorBindingFlags flags;
+		std::vector<VkSampler>   immutableSamplers;
+
+		bool operator==(const BindingKey &other) const;
+	};
+
+	struct LayoutKey {
+		VkDescriptorSetLayoutCreateFlags flags = 0;
+		std::vector<BindingKey>          bindings;        // Ordenados por binding
+
+		bool operator==(const LayoutKey &other) const;
+	};
+
+	struct LayoutKeyHash {
+		size_t operator()(const LayoutKey &key) const;
+	};
+
+	VkDevice                                                             device;
+	std::unordered_map<LayoutKey, VkDescriptorSetLayout, LayoutKeyHash> layouts;
+};
+
+// Aloca sets de uma lista de pools que cresce sob demanda.
+// Nada é liberado set a set: reset() devolve todos os pools de uma vez (vkResetDescriptorPool),
+// então alocar e "liberar" custam O(1).
+class DescriptorAllocator {
+  public:
+	struct PoolSizeRatio {
+		VkDescriptorType type;
+		float            ratio;        // Descritores desse tipo por set
+	};
+
+	DescriptorAllocator(VkDevice device, uint32_t setsPerPool = 256, std::vector<PoolSizeRatio> ratios = defaultRatios());
+	~DescriptorAllocator();
+
+	DescriptorAllocator(const DescriptorAllocator &)            = delete;
+	DescriptorAllocator &operator=(const DescriptorAllocator &) = delete;
+	DescriptorAllocator(DescriptorAllocator &&other) noexcept;
+
+	VkDescriptorSet allocate(VkDescriptorSetLayout layout);
+
+	// Só quando a GPU terminou de usar todos os sets alocados (timeline do frame)
+	void reset();
+
+	size_t getPoolCount() const { return usedPools.size() + freePools.size(); }
+	size_t getAllocatedSetCount() const { return allocatedSets; }
+
+	static std::vector<PoolSizeRatio> defaultRatios();
+
+  private:
+	VkDevice                      device;
+	uint32_t                      setsPerPool;
+	std::vector<PoolSizeRatio>    ratios;
+	VkDescriptorPool              currentPool = VK_NULL_HANDLE;
+	std::vector<VkDescriptorPool> usedPools;        // Inclui o currentPool
+	std::vector<VkDescriptorPool> freePools;        // Já resetados, prontos para reuso
+	size_t                        allocatedSets = 0;
+
+	VkDescriptorPool grabPool();
+	VkDescriptorPool createPool();
+};
+
+// Um DescriptorAllocator por frame em voo, no mesmo esquema das FrameArenas:
+// beginFrame(i) é chamado depois da espera do slot i no FrameScheduler, quando todos os sets dele já foram consumidos.
+class FrameDescriptorAllocators {
+  public:
+	FrameDescriptorAllocators(VkDevice device, uint32_t framesInFlight, uint32_t setsPerPool = 256);
+
+	void            beginFrame(uint32_t frameIndex);
+	VkDescriptorSet allocate(VkDescriptorSetLayout layout) { return allocators[currentFrame].allocate(layout); }
+
+	DescriptorAllocator &current() { return allocators[currentFrame]; }
+
+  private:
+	std::vector<DescriptorAllocator> allocators;
+	uint32_t                         currentFrame = 0;
+};
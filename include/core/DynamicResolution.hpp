@@ -0,0 +1,46 @@
+#pragma once
+
+#include <vulkan/vulkan.h>
+#include <cstdint>
+
+struct DynamicResolutionSettings {
+	double   targetMs     = 16.0;         // Orçamento de GPU por frame
+	double   headroom     = 0.9;          // Mira abaixo do orçamento: sobra para picos
+	float    minScale     = 0.5f;         // Por eixo (0.5 = um quarto dos pixels)
+	float    maxScale     = 1.0f;
+	float    scaleStep    = 0.05f;        // A escala anda em degraus (menos trocas de tamanho)
+	double   smoothing    = 0.2;          // Peso da amostra nova na média móvel do tempo de GPU
+	uint32_t settleFrames = 4;            // Amostras ignoradas depois de uma troca (frames em voo ainda na escala antiga)
+};
+
+// Escala de resolução da cena guiada pelo tempo de GPU medido.
+//
+// O custo do frame é tratado como proporcional aos pixels (escala²): a escala desejada é
+// escala * sqrt(orçamento / tempo médio). Acima do orçamento ela cai de uma vez até o degrau que
+// cabe; abaixo, sobe um degrau por vez, sempre esperando os frames já enviados na escala antiga
+// saírem antes de voltar a medir.
+//
+// A cena é desenhada no canto [0, getRenderExtent) de alvos do tamanho da saída e ampliada no fim,
+// então trocar a escala não realoca nada.
+class DynamicResolution {
+  public:
+	explicit DynamicResolution(const DynamicResolutionSettings &settings = {});
+
+	// Tempo de GPU de um frame já concluído
+	void addGpuTime(double gpuMs);
+
+	float      getScale() const { return scale; }
+	VkExtent2D getRenderExtent(VkExtent2D outputExtent) const;
+	uint32_t   getScaleChanges() const { return scaleChanges; }
+
+	const DynamicResolutionSettings &getSettings() const { return settings; }
+
+  private:
+	DynamicResolutionSettings settings;
+
+	float    scale        = 1.0f;
+	double   averageMs    = 0.0;
+	bool     hasSamples   = false;
+	uint32_t settleLeft   = 0;
+	uint32_t scaleChanges = 0;
+};
@@ -0,0 +1,112 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+// Alocador linear (bump allocator) para dados temporários do frame.
+// allocate() só avança um offset; nada é liberado individualmente, tudo volta no reset().
+// Se o bloco encher, pega um bloco extra (overflow) e no próximo reset() cresce para o
+// pico observado, então em regime estável nenhum frame chama malloc.
+class LinearArena {
+  public:
+	explicit LinearArena(size_t capacity);
+
+	LinearArena(const LinearArena &)            = delete;
+	LinearArena &operator=(const LinearArena &) = delete;
+
+	void *allocate(size_t size, size_t alignment = alignof(std::max_align_t));
+	void  reset();
+
+	size_t getCapacity() const { return capacity; }
+	size_t getUsedBytes() const { return usedBytes; }
+	size_t getAllocationCount() const { return allocationCount; }
+	size_t getOverflowCount() const { return overflowBlocks.size(); }
+	size_t getHighWaterBytes() const { return highWaterBytes; }
+
+  private:
+	std::unique_ptr<std::byte[]> block;
+	size_t                       capacity;
+	size_t                       offset = 0;
+
+	std::vector<std::unique_ptr<std::byte[]>> overflowBlocks;
+
+	size_t usedBytes       = 0;        // Fim alinhado da última alocação (inclui o padding)
+	size_t allocationCount = 0;
+	size_t highWaterBytes  = 0;        // Pico de usedBytes desde o último crescimento
+};
+
+// Adapter para usar a arena com containers da STL (std::vector, etc.)
+template <typename T>
+class ArenaAllocator {
+  public:
+	using value_type = T;
+
+	explicit ArenaAllocator(LinearArena &arena) noexcept :
+	    arena(&arena) {
+	}
+
+	template <typename U>
+	ArenaAllocator(const ArenaAllocator<U> &other) noexcept :
+	    arena(other.getArena()) {
+	}
+
+	T *allocate(size_t count) {
+		return static_cast<T *>(arena->allocate(count * sizeof(T), alignof(T)));
+	}
+
+	void deallocate(T *, size_t) noexcept {
+		// Nada: a memória volta inteira no reset() da arena
+	}
+
+	LinearArena *getArena() const noexcept { return arena; }
+
+	template <typename U>
+	bool operator==(const ArenaAllocator<U> &other) const noexcept {
+		return arena == other.getArena();
+	}
+	template <typename U>
+	bool operator!=(const ArenaAllocator<U> &other) const noexcept {
+		return arena != other.getArena();
+	}
+
+  private:
+	LinearArena *arena;
+};
+
+template <typename T>
+using ArenaVector = std::vector<T, ArenaAllocator<T>>;
+
+// Estatísticas do último frame que terminou de usar a sua arena
+struct FrameArenaStats {
+	size_t allocationCount = 0;
+	size_t usedBytes       = 0;
+	size_t overflowCount   = 0;
+	size_t capacity        = 0;
+};
+
+// Uma arena por frame em voo. A arena de um slot só é resetada depois que o
+// timeline semaphore chega no frame que usava aquele slot, então nada que a GPU ainda possa ler é sobrescrito.
+class FrameArenas {
+  public:
+	FrameArenas(uint32_t framesInFlight, size_t bytesPerFrame);
+
+	// Chamado depois do vkWaitForFences do slot
+	LinearArena &beginFrame(uint32_t frameIndex);
+	LinearArena &current() { return *arenas[currentIndex]; }
+
+	const FrameArenaStats &getLastFrameStats() const { return lastFrameStats; }
+
+	template <typename T>
+	ArenaVector<T> makeVector(size_t reserveCount = 0) {
+		ArenaVector<T> vector{ArenaAllocator<T>(current())};
+		vector.reserve(reserveCount);
+		return vector;
+	}
+
+  private:
+	std::vector<std::unique_ptr<LinearArena>> arenas;
+	uint32_t                                  currentIndex = 0;
+	FrameArenaStats                           lastFrameStats;
+};
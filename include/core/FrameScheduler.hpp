@@ -0,0 +1,100 @@
+#pragma once
+
+#include <vulkan/vulkan.h>
+#include <array>
+#include <cstdint>
+
+// Como o CPU espera pela GPU antes de começar um frame
+enum class LatencyMode {
+	Throughput,        // Até framesInFlight frames enfileirados: mais FPS, mais latência de input
+	LowLatency         // Espera o frame anterior terminar: input lido o mais tarde possível
+};
+
+struct FramePacingStats {
+	uint32_t    framesInFlight     = 0;
+	LatencyMode latencyMode        = LatencyMode::Throughput;
+	double      lastCpuWaitMs      = 0.0;        // Tempo bloqueado no último waitForFrame()
+	double      averageCpuWaitMs   = 0.0;        // Média móvel exponencial
+	double      maxCpuWaitMs       = 0.0;        // Pico desde o último resetStats()
+	uint64_t    gpuCompletedFrames = 0;          // Valor atual do timeline semaphore
+};
+
+// Ritmo dos frames com um único timeline semaphore (Vulkan 1.2) no lugar de um fence por frame.
+//
+// O frame N sinaliza o valor N + 1 ao terminar na GPU. Antes de reaproveitar o slot do frame N,
+// o CPU espera o valor N + 1 - framesInFlight (o frame que usava o mesmo slot). No modo LowLatency
+// espera N (o frame anterior inteiro), então nunca há mais de um frame na fila.
+//
+// Acquire/present continuam exigindo semáforos binários, então cada slot ainda tem o seu par.
+// Os recursos por frame (command buffers, arenas, buffers de objeto...) são alocados para
+// MAX_FRAMES_IN_FLIGHT slots; o número ativo pode mudar em runtime entre 1 e esse máximo.
+class FrameScheduler {
+  public:
+	static constexpr uint32_t MAX_FRAMES_IN_FLIGHT = 4;
+
+	FrameScheduler(VkDevice device, uint32_t framesInFlight = 2, LatencyMode latencyMode = LatencyMode::Throughput);
+	~FrameScheduler();
+
+	FrameScheduler(const FrameScheduler &)            = delete;
+	FrameScheduler &operator=(const FrameScheduler &) = delete;
+
+	static bool isSupported(VkPhysicalDevice physicalDevice);
+
+	// Bloqueia até o slot do próximo frame estar livre na GPU e devolve o índice dele.
+	// Pode ser chamado de novo para o mesmo frame (ex.: acquire falhou e o frame foi abortado).
+	uint32_t waitForFrame();
+
+	// Submete o command buffer esperando o acquire e sinalizando o timeline + renderFinished
+	VkResult submit(VkQueue queue, VkCommandBuffer cmd, VkPipelineStageFlags waitStage);
+
+	// Headless: sem acquire/present, só sinaliza o timeline
+	VkResult submitOffscreen(VkQueue queue, VkCommandBuffer cmd);
+
+	// Espera extra (timeline de outra fila, ex.: AsyncCompute) só para a próxima submissão do frame
+	void waitOnNextSubmit(VkSemaphore semaphore, uint64_t value, VkPipelineStageFlags stage);
+
+	// Avança para o próximo frame (depois do present)
+	void endFrame();
+
+	// Espera a GPU terminar tudo que já foi submetido
+	void drain();
+
+	// Trocar o número de frames drena a GPU antes: os slots antigos não podem estar em uso
+	void setFramesInFlight(uint32_t count);
+	void setLatencyMode(LatencyMode mode);
+	void resetStats();
+
+	VkSemaphore getImageAvailableSemaphore() const { return imageAvailable[currentSlot]; }
+	VkSemaphore getRenderFinishedSemaphore() const { return renderFinished[currentSlot]; }
+	VkSemaphore getTimelineSemaphore() const { return timeline; }
+
+	uint32_t                getCurrentSlot() const { return currentSlot; }
+	uint64_t                getFrameNumber() const { return frameNumber; }
+	uint64_t                getSubmittedValue() const { return submittedValue; }
+	uint64_t                getCompletedValue() const;        // Último frame que a GPU terminou (+1)
+	uint32_t                getFramesInFlight() const { return framesInFlight; }
+	LatencyMode             getLatencyMode() const { return latencyMode; }
+	const FramePacingStats &getStats() const { return stats; }
+
+  private:
+	VkDevice    device;
+	VkSemaphore timeline = VK_NULL_HANDLE;
+
+	std::array<VkSemaphore, MAX_FRAMES_IN_FLIGHT> imageAvailable{};
+	std::array<VkSemaphore, MAX_FRAMES_IN_FLIGHT> renderFinished{};
+
+	uint32_t    framesInFlight;
+	LatencyMode latencyMode;
+	uint64_t    frameNumber    = 0;        // Frame sendo gravado; sinaliza frameNumber + 1
+	uint64_t    submittedValue = 0;        // Maior valor já submetido ao timeline
+	uint32_t    currentSlot    = 0;
+
+	// Consumida e limpa pelo próximo submit/submitOffscreen
+	VkSemaphore          extraWaitSemaphore = VK_NULL_HANDLE;
+	uint64_t             extraWaitValue     = 0;
+	VkPipelineStageFlags extraWaitStage     = 0;
+
+	FramePacingStats stats;
+
+	void waitForValue(uint64_t value) const;
+};
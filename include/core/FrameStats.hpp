@@ -0,0 +1,97 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Estágios do frame no CPU (FrameStats::cpuMs)
+enum class FrameStage : uint8_t {
+	Setup,          // beginFrame: deletion queue, monitor de memória, arenas
+	Acquire,        // vkAcquireNextImageKHR
+	Ui,             // Montagem do overlay
+	Record,         // Gravação do command buffer
+	Submit,
+	Present,
+	Count
+};
+
+const char *toString(FrameStage stage);
+
+// Contadores de um frame gravado pelo renderer
+struct FrameStats {
+	uint64_t frameNumber = 0;
+
+	uint32_t drawCalls         = 0;
+	uint32_t instances         = 0;        // Soma dos instanceCount dos draws
+	uint64_t triangles         = 0;
+	uint32_t pipelineBinds     = 0;
+	uint32_t vertexBufferBinds = 0;
+	uint32_t indexBufferBinds  = 0;
+	uint32_t descriptorBinds   = 0;        // vkCmdBindDescriptorSets
+	uint32_t pushConstantBytes = 0;
+	uint64_t uploadedBytes     = 0;        // Staging (texturas, geometria) + dados por objeto escritos no frame
+	uint32_t culledObjects     = 0;        // Objetos da cena descartados antes de virar draw
+
+	uint32_t shadowCascadesRendered = 0;           // Shadow maps refeitas no frame
+	uint32_t shadowCascadesCached   = 0;           // Reaproveitadas do cache
+	uint32_t pointLights            = 0;           // Luzes distribuídas nos clusters no frame
+	uint32_t particles              = 0;           // Partículas vivas (GPU, framesInFlight de atraso)
+	float    renderScale            = 1.0f;        // Escala da resolução dinâmica por eixo (1 = saída)
+
+	std::array<double, static_cast<size_t>(FrameStage::Count)> cpuMs{};
+
+	double &stageMs(FrameStage stage) { return cpuMs[static_cast<size_t>(stage)]; }
+	double  getStageMs(FrameStage stage) const { return cpuMs[static_cast<size_t>(stage)]; }
+	double  getCpuTotalMs() const;
+};
+
+// Histórico dos últimos HISTORY_SIZE frames.
+//
+// O renderer abre o frame com begin(), soma nos contadores de current() enquanto grava e fecha
+// com end(). Um frame abandonado no meio (swapchain recriado no acquire) não entra no histórico:
+// o próximo begin() simplesmente recomeça.
+class FrameStatsRecorder {
+  public:
+	static constexpr size_t HISTORY_SIZE = 1024;
+
+	void        begin(uint64_t frameNumber);
+	FrameStats &current() { return frame; }
+	void        end();
+
+	// Último frame fechado (zerado se ainda não houve nenhum)
+	const FrameStats &last() const;
+
+	// Até count frames, do mais antigo para o mais novo
+	std::vector<FrameStats> getHistory(size_t count = HISTORY_SIZE) const;
+	size_t                  getFrameCount() const { return written < HISTORY_SIZE ? written : HISTORY_SIZE; }
+
+	// Uma linha por frame com todos os contadores e o tempo de cada estágio
+	bool writeCsv(const std::string &path, size_t count = HISTORY_SIZE) const;
+
+  private:
+	FrameStats                           frame;
+	std::array<FrameStats, HISTORY_SIZE> history{};
+	size_t                               written = 0;        // Frames fechados desde o início
+};
+
+// Mede um estágio do frame: soma o tempo do escopo em FrameStats::cpuMs
+class FrameStageTimer {
+  public:
+	FrameStageTimer(FrameStats &stats, FrameStage stage) :
+	    stats(stats),
+	    stage(stage),
+	    start(std::chrono::steady_clock::now()) {}
+	~FrameStageTimer() {
+		stats.stageMs(stage) += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+	}
+
+	FrameStageTimer(const FrameStageTimer &)            = delete;
+	FrameStageTimer &operator=(const FrameStageTimer &) = delete;
+
+  private:
+	FrameStats                           &stats;
+	FrameStage                            stage;
+	std::chrono::steady_clock::time_point start;
+};
@@ -0,0 +1,84 @@
+#pragma once
+
+#include <core/Handle.hpp>
+#include <core/ResourceManager.hpp>
+
+#include <vulkan/vulkan.h>
+#include "vk_mem_alloc.h"
+#include <vector>
+
+// Desfragmentação incremental do pool de geometria usando a API de defrag da VMA.
+//
+// Cada passada move no máximo maxBytesPerPass bytes. As cópias são gravadas no command
+// buffer do frame (antes do render pass) e os handles continuam os mesmos: só o VkBuffer
+// por trás deles muda, quando é seguro.
+//
+// Ciclo de uma passada:
+//   1. Recorded : cópias gravadas no frame N; os draws ainda usam os buffers antigos.
+//   2. Swapped  : o frame N terminou na GPU -> handles passam a apontar para os buffers novos.
+//   3. Retire   : nenhum frame em voo usa mais os buffers antigos -> destrói e fecha a passada.
+class GpuDefragmenter {
+  public:
+	GpuDefragmenter(VkDevice         device,
+	                VmaAllocator     allocator,
+	                ResourceManager &resources,
+	                uint32_t         framesInFlight,
+	                VkDeviceSize     maxBytesPerPass       = 8 * 1024 * 1024,
+	                uint32_t         maxAllocationsPerPass = 64);
+	~GpuDefragmenter();        // Precisa do device ocioso (vkDeviceWaitIdle) antes
+
+	GpuDefragmenter(const GpuDefragmenter &)            = delete;
+	GpuDefragmenter &operator=(const GpuDefragmenter &) = delete;
+
+	// Pede uma desfragmentação completa (executada aos poucos, passada por passada)
+	void requestDefragmentation() { requested = true; }
+
+	// Dispara sozinho quando a fração de memória livre dentro dos blocos passa do limite
+	void setAutoTrigger(float unusedFractionThreshold, uint32_t checkIntervalFrames = 300);
+
+	// Chamado dentro do recordCommandBuffer, antes do render pass
+	void recordCommands(VkCommandBuffer cmd, uint64_t frameNumber);
+
+	bool                           isActive() const { return context != VK_NULL_HANDLE; }
+	const VmaDefragmentationStats &getLastStats() const { return lastStats; }
+
+  private:
+	enum class PassState {
+		Idle,
+		Recorded,
+		Swapped
+	};
+
+	struct PendingMove {
+		uint32_t     moveIndex;        // Índice em passInfo.pMoves
+		BufferHandle handle;
+		VkBuffer     newBuffer;
+		VkBuffer     oldBuffer;
+	};
+
+	VkDevice         device;
+	VmaAllocator     allocator;
+	ResourceManager &resources;
+	uint32_t         framesInFlight;
+	VkDeviceSize     maxBytesPerPass;
+	uint32_t         maxAllocationsPerPass;
+
+	VmaDefragmentationContext      context = VK_NULL_HANDLE;
+	VmaDefragmentationPassMoveInfo passInfo{};
+	VmaDefragmentationStats        lastStats{};
+	std::vector<PendingMove>       pendingMoves;
+
+	PassState state      = PassState::Idle;
+	uint64_t  stateFrame = 0;        // Frame em que a fase atual começou
+	bool      requested  = false;
+
+	float    autoTriggerThreshold = 0.0f;        // 0 = desligado
+	uint32_t autoCheckInterval    = 300;
+
+	bool shouldStart(uint64_t frameNumber) const;
+	void begin();
+	void beginPass(VkCommandBuffer cmd, uint64_t frameNumber);
+	void swapBuffers();
+	void endPass();
+	void finish();
+};
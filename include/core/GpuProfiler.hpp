@@ -0,0 +1,144 @@
+#pragma once
+
+#include <vulkan/vulkan.h>
+#include <array>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Resultado de um escopo num frame já resolvido
+struct GpuScopeResult {
+	const char *name;
+	uint32_t    depth;        // Aninhamento (0 = escopo de topo)
+	double      ms;
+};
+
+struct GpuFrameResult {
+	uint64_t                    frameNumber = 0;
+	double                      totalMs     = 0.0;        // Início ao fim do command buffer
+	std::vector<GpuScopeResult> scopes;                   // Na ordem em que foram abertos
+};
+
+// Estatísticas de um escopo sobre o histórico (últimos HISTORY_SIZE frames em que apareceu)
+struct GpuScopeStats {
+	std::string name;
+	double      lastMs    = 0.0;
+	double      averageMs = 0.0;
+	double      minMs     = 0.0;
+	double      maxMs     = 0.0;
+};
+
+// Profiler de GPU com timestamp queries.
+//
+// Um bloco de queries por slot em voo: o frame grava timestamps no bloco do seu slot e o
+// resultado é lido quando o FrameScheduler libera o slot de novo (o timeline já passou do frame),
+// então vkGetQueryPoolResults nunca espera a GPU. O custo é ver os números com framesInFlight de atraso.
+//
+// Escopos com nome marcam regiões do command buffer e podem ser aninhados:
+//     PROFILE_GPU_SCOPE(cmd, "opaque");
+// O nome precisa viver até o frame ser resolvido (na prática, um literal).
+class GpuProfiler {
+  public:
+	static constexpr uint32_t MAX_SCOPES   = 32;         // Por frame; escopos além disso são ignorados
+	static constexpr uint32_t HISTORY_SIZE = 120;        // Frames no histórico de cada escopo
+
+	GpuProfiler(VkDevice device, VkPhysicalDevice physicalDevice, uint32_t queueFamilyIndex, uint32_t slotCount);
+	~GpuProfiler();
+
+	GpuProfiler(const GpuProfiler &)            = delete;
+	GpuProfiler &operator=(const GpuProfiler &) = delete;
+
+	// A fila precisa de timestampValidBits > 0
+	static bool isSupported(VkPhysicalDevice physicalDevice, uint32_t queueFamilyIndex);
+
+	// Profiler usado pelo PROFILE_GPU_SCOPE (o último criado); nullptr desliga os escopos
+	static GpuProfiler *active() { return activeProfiler; }
+
+	// beginFrame antes de qualquer trabalho no command buffer (fora do render pass), endFrame depois do último
+	void beginFrame(VkCommandBuffer cmd, uint32_t slot, uint64_t frameNumber);
+	void endFrame(VkCommandBuffer cmd);
+
+	// Devolvem/recebem o índice do escopo no frame (UINT32_MAX se estourou MAX_SCOPES)
+	uint32_t beginScope(VkCommandBuffer cmd, const char *name);
+	void     endScope(VkCommandBuffer cmd, uint32_t scope);
+
+	// Lê o último frame gravado no slot (chamar depois da espera do slot).
+	// false se o slot não tinha frame pendente.
+	bool collect(uint32_t slot);
+
+	const GpuFrameResult      &getLastFrame() const { return lastFrame; }
+	std::vector<GpuScopeStats> getScopeStats() const;
+	uint32_t                   getDroppedScopes() const { return droppedScopes; }
+
+  private:
+	struct Scope {
+		const char *name;
+		uint32_t    depth;
+	};
+
+	struct SlotFrame {
+		bool               pending     = false;
+		uint64_t           frameNumber = 0;
+		std::vector<Scope> scopes;
+	};
+
+	struct History {
+		std::string                      name;
+		std::array<double, HISTORY_SIZE> samples{};
+		uint32_t                         head  = 0;
+		uint32_t                         count = 0;
+
+		void push(double ms);
+	};
+
+	static constexpr uint32_t QUERIES_PER_SLOT = 2 + MAX_SCOPES * 2;        // Frame + início/fim de cada escopo
+
+	static inline GpuProfiler *activeProfiler = nullptr;
+
+	VkDevice    device;
+	VkQueryPool queryPool = VK_NULL_HANDLE;
+	double      timestampPeriodNs;
+	uint64_t    validMask;
+
+	std::vector<SlotFrame> slots;
+	uint32_t               currentSlot   = 0;
+	uint32_t               currentDepth  = 0;
+	uint32_t               droppedScopes = 0;
+
+	GpuFrameResult                          lastFrame;
+	std::vector<History>                    histories;        // Na ordem em que cada nome apareceu
+	std::unordered_map<std::string, size_t> historyIndex;
+
+	uint32_t firstQuery(uint32_t slot) const { return slot * QUERIES_PER_SLOT; }
+	double   ticksToMs(uint64_t begin, uint64_t end) const;
+};
+
+// Escopo RAII: abre no construtor e fecha no destrutor. Sem profiler ativo não faz nada.
+class GpuProfileScope {
+  public:
+	GpuProfileScope(VkCommandBuffer cmd, const char *name) :
+	    cmd(cmd),
+	    profiler(GpuProfiler::active()) {
+		if (profiler) {
+			scope = profiler->beginScope(cmd, name);
+		}
+	}
+	~GpuProfileScope() {
+		if (profiler) {
+			profiler->endScope(cmd, scope);
+		}
+	}
+
+	GpuProfileScope(const GpuProfileScope &)            = delete;
+	GpuProfileScope &operator=(const GpuProfileScope &) = delete;
+
+  private:
+	VkCommandBuffer cmd;
+	GpuProfiler    *profiler;
+	uint32_t        scope = UINT32_MAX;
+};
+
+#define GPU_PROFILE_CONCAT_INNER(a, b) a##b
+#define GPU_PROFILE_CONCAT(a, b)       GPU_PROFILE_CONCAT_INNER(a, b)
+#define PROFILE_GPU_SCOPE(cmd, name)   GpuProfileScope GPU_PROFILE_CONCAT(gpuProfileScope_, __LINE__)(cmd, name)
@@ -6,7 +6,8 @@
 
 
 using BufferHandle = uint32_t;
-using ImageHadle = uint32_t; // New way with using (before was Typedef)
+using ImageHandle = uint32_t; // New way with using (before was Typedef)
+using TextureHandle = uint32_t; // Índice no TextureManager (válido antes mesmo do upload terminar)
 
 constexpr uint32_t INVALID_HANDLE = std::numeric_limits<uint32_t>::max();
 
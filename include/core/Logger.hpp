@@ -0,0 +1,198 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <type_traits>
+
+enum class LogLevel : uint8_t {
+	Trace,
+	Debug,
+	Info,
+	Warning,
+	Error
+};
+
+// Nível mínimo compilado (índice do LogLevel, vem do CMake). Abaixo dele as chamadas somem do binário.
+#ifndef SPEED_RACER_LOG_LEVEL
+#	define SPEED_RACER_LOG_LEVEL 2        // Info
+#endif
+
+// Logger assíncrono.
+//
+// Quem loga só copia os argumentos para um slot de um ring buffer lock-free (MPMC limitado, com
+// número de sequência por slot); a formatação e a escrita no stdout/stderr ficam com uma thread
+// de fundo. Com o ring cheio a mensagem é descartada e contada, nunca bloqueia quem loga.
+//
+//     LOG_INFO("VulkanManager", "Framebuffer resized to {}x{}", width, height);
+//
+// Tag e formato são guardados como ponteiros (precisam ser literais). Strings nos argumentos são
+// copiadas para o slot (até MAX_TEXT bytes somados; o que passar é cortado e termina em "...").
+class Logger {
+  public:
+	static constexpr size_t RING_SIZE = 2048;        // Potência de dois
+	static constexpr size_t MAX_ARGS  = 8;
+	static constexpr size_t MAX_TEXT  = 512;        // Mensagens da validação são longas
+
+	template <typename... Args>
+	static void log(LogLevel level, const char *tag, const char *format, const Args &...args) {
+		static_assert(sizeof...(Args) <= MAX_ARGS, "[Logger] : Too many arguments");
+		instance().push(level, tag, format, [&](Record &record) { (record.capture(args), ...); });
+	}
+
+	// Espera a thread de fundo escrever tudo o que já foi logado (ex.: antes de um erro fatal)
+	static void flush();
+
+	static uint64_t getDroppedCount() { return instance().dropped.load(std::memory_order_relaxed); }
+
+	Logger(const Logger &)            = delete;
+	Logger &operator=(const Logger &) = delete;
+
+  private:
+	struct Arg {
+		enum class Type : uint8_t {
+			Int,
+			Uint,
+			Double,
+			Bool,
+			Text
+		};
+
+		struct TextRef {
+			uint16_t offset;        // Em Record::text
+			uint16_t length;
+		};
+
+		Type type;
+		union {
+			int64_t  i;
+			uint64_t u;
+			double   d;
+			bool     b;
+			TextRef  text;
+		};
+	};
+
+	struct Record {
+		uint64_t    timestampNs;
+		const char *tag;
+		const char *format;
+		LogLevel    level;
+		uint8_t     argCount;
+		uint16_t    textUsed;
+		Arg         args[MAX_ARGS];
+		char        text[MAX_TEXT];
+
+		void captureText(std::string_view value);
+
+		template <typename T>
+		void capture(const T &value) {
+			Arg &arg = args[argCount++];
+			if constexpr (std::is_same_v<T, bool>) {
+				arg.type = Arg::Type::Bool;
+				arg.b    = value;
+			}
+			else if constexpr (std::is_enum_v<T>) {
+				arg.type = Arg::Type::Int;
+				arg.i    = static_cast<int64_t>(value);
+			}
+			else if constexpr (std::is_integral_v<T> && std::is_signed_v<T>) {
+				arg.type = Arg::Type::Int;
+				arg.i    = value;
+			}
+			else if constexpr (std::is_integral_v<T>) {
+				arg.type = Arg::Type::Uint;
+				arg.u    = value;
+			}
+			else if constexpr (std::is_floating_point_v<T>) {
+				arg.type = Arg::Type::Double;
+				arg.d    = value;
+			}
+			else {
+				static_assert(std::is_convertible_v<const T &, std::string_view>, "[Logger] : Unsupported argument type");
+				argCount--;
+				captureText(value);
+			}
+		}
+	};
+
+	struct Slot {
+		std::atomic<uint64_t> sequence;
+		Record                record;
+	};
+
+	std::array<Slot, RING_SIZE> slots;
+	std::atomic<uint64_t>       enqueuePos{0};
+	uint64_t                    dequeuePos = 0;        // Só a thread de fundo mexe
+
+	std::atomic<uint64_t> dropped{0};
+	std::atomic<uint32_t> published{0};        // Acorda a thread de fundo (atomic wait/notify)
+	std::atomic<uint64_t> written{0};          // Registros já escritos (flush espera por ele)
+	std::atomic<bool>     running{true};
+	std::thread           worker;
+
+	Logger();
+	~Logger();
+
+	static Logger &instance();
+
+	template <typename Fill>
+	void push(LogLevel level, const char *tag, const char *format, Fill &&fill) {
+		uint64_t pos = enqueuePos.load(std::memory_order_relaxed);
+		Slot    *slot;
+		for (;;) {
+			slot         = &slots[pos & (RING_SIZE - 1)];
+			uint64_t seq = slot->sequence.load(std::memory_order_acquire);
+			int64_t  lag = static_cast<int64_t>(seq) - static_cast<int64_t>(pos);
+			if (lag == 0) {
+				if (enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+					break;
+				}
+			}
+			else if (lag < 0) {
+				// Ring cheio: a thread de fundo ainda não liberou este slot
+				dropped.fetch_add(1, std::memory_order_relaxed);
+				return;
+			}
+			else {
+				pos = enqueuePos.load(std::memory_order_relaxed);
+			}
+		}
+
+		Record &record     = slot->record;
+		record.timestampNs = now();
+		record.tag         = tag;
+		record.format      = format;
+		record.level       = level;
+		record.argCount    = 0;
+		record.textUsed    = 0;
+		fill(record);
+
+		slot->sequence.store(pos + 1, std::memory_order_release);
+		published.fetch_add(1, std::memory_order_release);
+		published.notify_one();
+	}
+
+	static uint64_t now();
+
+	void        run();
+	bool        drain(std::string &line);
+	static void format(const Record &record, std::string &line);
+};
+
+#define SPEED_RACER_LOG(level, tag, ...)                                        \
+	do {                                                                        \
+		if constexpr (static_cast<int>(level) >= SPEED_RACER_LOG_LEVEL) {       \
+			Logger::log(level, tag, __VA_ARGS__);                               \
+		}                                                                       \
+	} while (0)
+
+#define LOG_TRACE(tag, ...) SPEED_RACER_LOG(LogLevel::Trace, tag, __VA_ARGS__)
+#define LOG_DEBUG(tag, ...) SPEED_RACER_LOG(LogLevel::Debug, tag, __VA_ARGS__)
+#define LOG_INFO(tag, ...)  SPEED_RACER_LOG(LogLevel::Info, tag, __VA_ARGS__)
+#define LOG_WARN(tag, ...)  SPEED_RACER_LOG(LogLevel::Warning, tag, __VA_ARGS__)
+#define LOG_ERROR(tag, ...) SPEED_RACER_LOG(LogLevel::Error, tag, __VA_ARGS__)
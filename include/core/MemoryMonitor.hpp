@@ -0,0 +1,46 @@
+#pragma once
+
+#include <core/ResourceManager.hpp>
+#include <core/ResourceTypes.hpp>
+#include <core/VmaWrapper.hpp>
+
+#include <vulkan/vulkan.h>
+#include <string>
+#include <vector>
+
+// Amostra de um heap de memória no momento da última coleta
+struct HeapBudgetSample {
+   VkDeviceSize usage;           // Uso do processo reportado pelo driver (ou estimado pela VMA)
+   VkDeviceSize budget;          // Quanto o processo pode usar sem degradar
+   VkDeviceSize blockBytes;      // Memória reservada pela VMA (VkDeviceMemory)
+   VkDeviceSize allocationBytes; // Memória efetivamente ocupada por recursos
+   uint32_t     unusedRangeCount;
+   VkDeviceSize largestUnusedRange;
+   float        fragmentation;   // 0 = espaço livre contíguo, ~1 = livre espalhado em pedaços pequenos
+};
+
+// Coleta periódica do orçamento de memória da VMA + contabilidade do ResourceManager.
+// Serve pra pegar leak e ver se a sessão está perto de estourar o orçamento.
+class MemoryMonitor {
+public:
+   MemoryMonitor(VmaWrapper& vmaWrapper, const ResourceManager& resources, uint32_t sampleInterval = 120);
+
+   // Chamado uma vez por frame. Só amostra a cada sampleInterval frames.
+   void update(uint32_t frameIndex);
+   void sample();
+
+   const std::vector<HeapBudgetSample>& getHeapSamples() const { return m_heapSamples; }
+   bool isOverBudget(float threshold = 0.9f) const;
+
+   std::string toJson(bool includeVmaDetailedMap = false) const;
+   void dumpJson(const std::string& path, bool includeVmaDetailedMap = false) const;
+
+private:
+   VmaWrapper* m_vmaWrapper;
+   const ResourceManager* m_resources;
+   uint32_t m_sampleInterval;
+   uint32_t m_lastFrameIndex = 0;
+   bool m_warnedOverBudget = false;
+
+   std::vector<HeapBudgetSample> m_heapSamples;
+};
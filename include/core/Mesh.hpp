@@ -4,6 +4,7 @@
 #include <core/BufferManager.hpp>
 #include <core/ResourceManager.hpp>
 #include <core/ResourceTypes.hpp>
+#include <glm/glm.hpp>
 #include <vector>
 
 
@@ -13,6 +14,8 @@ class Mesh {
 	BufferHandle   indexBuffer;
 	uint32_t       indexCount;
 	BufferManager *bufferManager;
+	glm::vec3      boundsMin = glm::vec3(0.0f);        // AABB no espaço do objeto (calculada no upload)
+	glm::vec3      boundsMax = glm::vec3(0.0f);
 
    bool uploaded = false;
 
@@ -34,17 +37,20 @@ class Mesh {
 	void setIndices(const std::vector<uint32_t> &indices);
 
 	void bind(VkCommandBuffer cmd) const;
-	void draw(VkCommandBuffer cmd) const;
+	void draw(VkCommandBuffer cmd, uint32_t firstInstance = 0) const;        // firstInstance = índice do objeto no shader
 
       // Upload dados para GPU via BufferManager
    void upload(const MeshData& data, BufferManager& bufferManager);
 
-	bool isValid() const;
+	bool     isValid() const;
+	uint32_t  getIndexCount() const { return indexCount; }
+	glm::vec3 getBoundsMin() const { return boundsMin; }
+	glm::vec3 getBoundsMax() const { return boundsMax; }
 };
 
 namespace MeshFactory {
     MeshData makeTriangle();
     MeshData makeQuad();
-    MeshData makeCube();
-    // Futuro: MeshData makePlane(float width, float depth, int subdivisions);
+    MeshData makeCube();                     // 24 vértices: normal por face
+    MeshData makePlane(float width, float depth); // Plano XZ virado para +Y
 }
\ No newline at end of file
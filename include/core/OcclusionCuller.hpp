@@ -0,0 +1,146 @@
+#pragma once
+
+#include <core/BindlessDescriptors.hpp>
+#include <core/BufferManager.hpp>
+#include <core/DeletionQueue.hpp>
+#include <core/DescriptorAllocator.hpp>
+#include <core/ResourceManager.hpp>
+#include <core/ResourceTypes.hpp>
+
+#include <vulkan/vulkan.h>
+#include <cstddef>
+#include <cstdint>
+#include <glm/glm.hpp>
+#include <vector>
+
+// Entrada do culling por draw (std430), na ordem dos comandos indiretos
+struct GpuCullObject {
+	glm::vec4 sphere;             // Esfera envolvente no mundo: xyz centro, w raio
+	uint32_t  objectIndex;        // firstInstance do draw (índice no buffer de objetos)
+	uint32_t  indexCount;
+	uint32_t  pad[2];
+};
+
+// Contadores escritos pela GPU (lidos com framesInFlight de atraso)
+struct OcclusionStats {
+	uint32_t earlyDraws    = 0;        // Visíveis no frame anterior, desenhados antes da pirâmide
+	uint32_t lateDraws     = 0;        // Ficaram visíveis agora (desoclusão), desenhados depois
+	uint32_t frustumCulled = 0;
+	uint32_t occluded      = 0;        // Dentro do frustum, mas atrás da pirâmide de profundidade
+	uint32_t triangles     = 0;        // Dos draws que sobraram
+};
+
+// Occlusion culling em duas fases com pirâmide de profundidade (Hi-Z), tudo na GPU.
+//
+//   1. cull early  : objetos visíveis no frame anterior (e no frustum) viram draws indiretos
+//   2. opaque      : desenha esses draws (o depth resultante já tem quase todos os oclusores)
+//   3. pirâmide    : mips R32F com o depth máximo de cada região, reduzidos em compute
+//   4. cull late   : todos os objetos contra frustum + pirâmide; grava a visibilidade para o
+//                    próximo frame e gera draws só para quem ficou visível agora
+//   5. opaque late : desenha os recém-visíveis carregando cor e depth
+//
+// Os comandos ficam num buffer VkDrawIndexedIndirectCommand com duas metades (early/late) e o
+// instanceCount é 0 ou 1; a CPU grava os mesmos draws indiretos todo frame, sem saber o que sobrou.
+// A pirâmide tem potência de 2 abaixo do depth (cada texel cobre a pegada inteira na redução) e
+// é recriada quando o tamanho muda.
+class OcclusionCuller {
+  public:
+	enum class Phase : uint8_t {
+		Early,
+		Late
+	};
+
+	static constexpr VkFormat PYRAMID_FORMAT = VK_FORMAT_R32_SFLOAT;
+
+	OcclusionCuller(VkDevice                   device,
+	                ResourceManager           &resources,
+	                BufferManager             &buffers,
+	                BindlessDescriptors       &bindless,
+	                DescriptorLayoutCache     &layoutCache,
+	                FrameDescriptorAllocators &frameDescriptors,
+	                DeletionQueue             &deletionQueue,
+	                uint32_t                   framesInFlight,
+	                uint32_t                   maxDraws);
+	~OcclusionCuller();
+
+	OcclusionCuller(const OcclusionCuller &)            = delete;
+	OcclusionCuller &operator=(const OcclusionCuller &) = delete;
+
+	// Slot liberado pelo FrameScheduler: devolve os contadores do último frame que usou o slot e os zera
+	const OcclusionStats &beginFrame(uint32_t frame);
+
+	// Draws do frame (mesma ordem dos comandos indiretos) e câmera. Mudar o número de draws descarta
+	// a visibilidade do frame anterior. retireValue: a partir de quando uma pirâmide trocada pode sair.
+	void update(const glm::mat4 &viewProj, VkExtent2D depthExtent, const GpuCullObject *objects, size_t count, uint64_t retireValue);
+
+	void recordCull(VkCommandBuffer cmd, Phase phase);
+	void recordDepthPyramid(VkCommandBuffer cmd, VkImageView depthView);
+
+	VkBuffer     getDrawBuffer() const { return buffers.getVkBuffer(drawBuffer); }
+	VkDeviceSize getDrawOffset(Phase phase, uint32_t draw) const;
+	VkBuffer     getVisibilityBuffer() const { return buffers.getVkBuffer(visibilityBuffer); }
+	VkBuffer     getStatsBuffer() const { return buffers.getVkBuffer(statsBuffers[frame]); }
+	VkImage      getPyramidImage() const { return resources.getVkImage(pyramid); }
+	VkImageView  getPyramidView() const { return resources.getImageView(pyramid); }
+	VkExtent2D   getPyramidExtent() const { return pyramidExtent; }
+
+  private:
+	// Mesmo layout do push constant de occlusion_cull.comp
+	struct CullPushConstants {
+		glm::mat4 viewProj;
+		uint32_t  cullBufferIndex;
+		uint32_t  drawBufferIndex;
+		uint32_t  visibilityBufferIndex;
+		uint32_t  statsBufferIndex;
+		uint32_t  drawCount;
+		uint32_t  lateOffset;           // Primeiro comando da metade late
+		uint32_t  phase;                // 0 = early, 1 = late
+		uint32_t  historyValid;         // 0: visibilidade do frame anterior não vale (primeiro frame, cena nova)
+		glm::vec2 pyramidSize;
+		uint32_t  pyramidLevels;
+		uint32_t  pad;
+	};
+
+	VkDevice                   device;
+	ResourceManager           &resources;
+	BufferManager             &buffers;
+	BindlessDescriptors       &bindless;
+	FrameDescriptorAllocators &frameDescriptors;
+	DeletionQueue             &deletionQueue;
+	uint32_t                   maxDraws;
+
+	VkPipeline            cullPipeline         = VK_NULL_HANDLE;
+	VkPipelineLayout      cullPipelineLayout   = VK_NULL_HANDLE;
+	VkPipeline            reducePipeline       = VK_NULL_HANDLE;
+	VkPipelineLayout      reducePipelineLayout = VK_NULL_HANDLE;
+	VkDescriptorSetLayout cullSetLayout        = VK_NULL_HANDLE;        // Pirâmide inteira (sampler)
+	VkDescriptorSetLayout reduceSetLayout      = VK_NULL_HANDLE;        // Mip de origem + mip de destino (storage)
+	VkSampler             sampler              = VK_NULL_HANDLE;
+
+	// Comandos indiretos e visibilidade persistem entre frames; entrada e contadores são por frame em voo
+	BufferHandle              drawBuffer            = INVALID_HANDLE;
+	BufferHandle              visibilityBuffer      = INVALID_HANDLE;
+	uint32_t                  drawBufferIndex       = 0;
+	uint32_t                  visibilityBufferIndex = 0;
+	std::vector<BufferHandle> cullBuffers;
+	std::vector<uint32_t>     cullBufferIndices;
+	std::vector<BufferHandle> statsBuffers;
+	std::vector<uint32_t>     statsBufferIndices;
+
+	ImageHandle              pyramid = INVALID_HANDLE;
+	std::vector<VkImageView> pyramidMips;        // Uma view por mip (destino/origem da redução)
+	VkExtent2D               pyramidExtent = {0, 0};
+	uint32_t                 pyramidLevels = 0;
+
+	uint32_t          frame             = 0;
+	uint32_t          drawCount         = 0;
+	VkExtent2D        depthExtent       = {0, 0};
+	bool              visibilityWritten = false;        // Algum cull late já gravou a visibilidade
+	bool              historyValid      = false;
+	CullPushConstants constants{};
+	OcclusionStats    lastStats;
+
+	void        createPyramid(VkExtent2D extent);
+	void        retirePyramid(uint64_t retireValue);
+	static void destroyPyramid(VkDevice device, ResourceManager &resources, ImageHandle image, const std::vector<VkImageView> &views);
+};
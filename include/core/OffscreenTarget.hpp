@@ -0,0 +1,39 @@
+#pragma once
+
+#include <core/BufferManager.hpp>
+#include <core/ResourceManager.hpp>
+#include <core/ResourceTypes.hpp>
+
+#include <vulkan/vulkan.h>
+
+// Alvo de renderização sem janela (modo headless): imagem de cor do tamanho pedido.
+// O render graph importa a imagem como backbuffer (o depth é transiente do graph); no fim de cada
+// frame a cor fica em COLOR_ATTACHMENT_OPTIMAL e readback() copia ela para a CPU (RGBA8, já em
+// sRGB, pronta para o PngWriter).
+class OffscreenTarget {
+  public:
+	static constexpr VkFormat COLOR_FORMAT = VK_FORMAT_R8G8B8A8_SRGB;
+
+	OffscreenTarget(ResourceManager &resources, BufferManager &bufferManager, VkExtent2D extent);
+	~OffscreenTarget();
+
+	OffscreenTarget(const OffscreenTarget &)            = delete;
+	OffscreenTarget &operator=(const OffscreenTarget &) = delete;
+
+	// Primeiro formato de depth com suporte a attachment (D32_SFLOAT, senão D16_UNORM, que é obrigatório)
+	static VkFormat chooseDepthFormat(VkPhysicalDevice physicalDevice);
+
+	// Só com a GPU parada em relação a este alvo (ex.: depois de FrameScheduler::drain)
+	ImageData readback();
+
+	VkExtent2D  getExtent() const { return extent; }
+	VkImage     getColorImage() const { return resources.getVkImage(colorImage); }
+	VkImageView getColorView() const { return resources.getImageView(colorImage); }
+
+  private:
+	ResourceManager &resources;
+	BufferManager   &bufferManager;
+	VkExtent2D       extent;
+
+	ImageHandle colorImage = INVALID_HANDLE;
+};
@@ -0,0 +1,198 @@
+#pragma once
+
+#include <core/BindlessDescriptors.hpp>
+#include <core/BufferManager.hpp>
+#include <core/PipelineManager.hpp>
+#include <core/ResourceTypes.hpp>
+
+#include <vulkan/vulkan.h>
+#include <cstddef>
+#include <cstdint>
+#include <glm/glm.hpp>
+#include <vector>
+
+enum class ParticleType : uint8_t {
+	TireSmoke,        // Sobe devagar e cresce; alpha
+	Sparks,           // Rápidas, caem e quicam no chão; aditivas
+	Dust              // Poeira rasteira; alpha
+};
+
+struct ParticleSettings {
+	uint32_t capacity         = 256 * 1024;        // Partículas vivas no total (buffers de tamanho fixo)
+	uint32_t maxEmitters      = 256;
+	uint32_t maxSpawnPerFrame = 1024;              // Por emissor; o excedente fica para o próximo frame
+};
+
+// Emissor descrito pela CPU a cada frame (posição e velocidade podem seguir um carro)
+struct ParticleEmitter {
+	ParticleType type = ParticleType::TireSmoke;
+	glm::vec3    position{0.0f};
+	glm::vec3    velocity{0.0f};               // Velocidade inicial média (m/s)
+	float        spawnRadius = 0.05f;
+	float        speedSpread = 0.5f;           // Velocidade aleatória somada em qualquer direção
+	glm::vec4    color{1.0f};                  // rgb; a: opacidade (ignorada nas aditivas)
+	float        lifetimeMin = 1.0f;
+	float        lifetimeMax = 2.0f;
+	float        startSize   = 0.1f;
+	float        endSize     = 0.1f;
+	float        gravity     = 9.8f;           // Negativo sobe (fumaça quente)
+	float        drag        = 0.0f;           // Perda de velocidade por segundo (exponencial)
+	float        rate        = 100.0f;         // Partículas por segundo
+	uint32_t     budget      = 1024;           // Máximo de partículas vivas deste emissor
+	bool         additive    = false;
+
+	// Valores de partida de cada tipo; quem chama ajusta posição, velocidade e taxa
+	static ParticleEmitter preset(ParticleType type);
+};
+
+// Partícula na GPU (std430); nunca passa pela CPU
+struct GpuParticle {
+	glm::vec4 positionAge;              // xyz; w: idade (s)
+	glm::vec4 velocityLifetime;         // xyz; w: vida total (s)
+	glm::vec4 color;
+	glm::vec4 sizeGravityDrag;          // x, y: tamanho inicial/final; z: gravidade; w: arrasto
+	uint32_t  emitter;                  // Slot do emissor (orçamento)
+	uint32_t  flags;                    // Bit 0: aditiva
+	uint32_t  pad[2];
+};
+
+// Emissor na GPU (std430), um buffer visível pela CPU por frame em voo
+struct GpuParticleEmitter {
+	glm::vec4 positionRadius;         // xyz; w: raio de nascimento
+	glm::vec4 velocitySpread;         // xyz; w: velocidade aleatória
+	glm::vec4 color;
+	glm::vec4 lifeSize;               // x, y: vida min/max; z, w: tamanho inicial/final
+	float     gravity;
+	float     drag;
+	uint32_t  spawnCount;             // Pedidos deste frame (a GPU ainda corta pelo orçamento e pela capacidade)
+	uint32_t  budget;
+	uint32_t  flags;
+	uint32_t  pad[3];
+};
+
+// Contadores escritos pela GPU (lidos com framesInFlight de atraso)
+struct ParticleStats {
+	uint32_t alive   = 0;
+	uint32_t emitted = 0;
+	uint32_t dropped = 0;        // Pedidos recusados pelo orçamento do emissor ou por falta de espaço
+	uint32_t pad     = 0;
+};
+
+// Partículas inteiramente na GPU (fumaça de pneu, faíscas, poeira).
+//
+// Os buffers têm capacidade fixa: as partículas, uma pilha de índices livres e duas listas de
+// índices vivos que se alternam a cada frame. O compute do frame roda em quatro dispatches:
+//   1. emit     : cada pedido do emissor tira um índice livre (se o orçamento do emissor e a pilha
+//                 deixarem) e entra na lista atual
+//   2. args     : monta o dispatch indireto da simulação com o número de vivas
+//   3. simulate : integra as vivas; as que morreram voltam para a pilha, as outras são compactadas
+//                 (append atômico) na outra lista, que vira a lista de desenho
+//   4. finalize : instanceCount do draw indireto e contadores
+// O desenho é um vkCmdDrawIndirect de quads (6 vértices por instância) virados para a câmera.
+// A CPU só escreve os emissores (alguns bytes por emissor) e o número de pedidos de cada um.
+class ParticleSystem {
+  public:
+	ParticleSystem(VkDevice device, BufferManager &buffers, BindlessDescriptors &bindless, VkFormat colorFormat, VkFormat depthFormat,
+	               uint32_t framesInFlight, const ParticleSettings &settings = {});
+	~ParticleSystem();
+
+	ParticleSystem(const ParticleSystem &)            = delete;
+	ParticleSystem &operator=(const ParticleSystem &) = delete;
+
+	// Slot liberado pelo FrameScheduler: devolve os contadores do último frame que usou o slot e os zera
+	const ParticleStats &beginFrame(uint32_t frame);
+
+	// Emissores do frame (o índice no array é o slot do orçamento, deve ser estável) e câmera.
+	// time: tempo da simulação em segundos; o passo é a diferença para a chamada anterior.
+	void update(float time, const glm::mat4 &view, const glm::mat4 &viewProj, float groundHeight, const ParticleEmitter *emitters, size_t count);
+
+	// Compute do frame (fora de render pass)
+	void recordSimulation(VkCommandBuffer cmd);
+
+	// Quads das partículas vivas; dentro do render pass, depth só para teste
+	void recordDraw(VkCommandBuffer cmd, VkExtent2D extent) const;
+
+	// Apaga todas as partículas no próximo recordSimulation
+	void clear() { needsReset = true; }
+
+	VkBuffer getParticleBuffer() const { return buffers.getVkBuffer(particleBuffer); }
+	VkBuffer getDrawListBuffer() const { return buffers.getVkBuffer(aliveLists[1 - currentList]); }
+	VkBuffer getArgsBuffer() const { return buffers.getVkBuffer(argsBuffer); }
+	VkBuffer getStatsBuffer() const { return buffers.getVkBuffer(statsBuffers[frame]); }
+	uint32_t getCapacity() const { return settings.capacity; }
+
+  private:
+	// Mesmo layout do push constant de particles.comp
+	struct SimulatePushConstants {
+		uint32_t pass;        // 0 = reset, 1 = emit, 2 = args, 3 = simulate, 4 = finalize
+		uint32_t particleBufferIndex;
+		uint32_t deadBufferIndex;
+		uint32_t counterBufferIndex;
+		uint32_t argsBufferIndex;
+		uint32_t emitterBufferIndex;
+		uint32_t statsBufferIndex;
+		uint32_t currentListIndex;        // Lista lida (emit acrescenta nela)
+		uint32_t nextListIndex;           // Lista escrita pela simulação (desenhada)
+		uint32_t currentList;             // 0/1: contador da lista atual
+		uint32_t capacity;
+		uint32_t emitterCount;
+		uint32_t maxEmitters;
+		uint32_t seed;
+		float    deltaTime;
+		float    groundHeight;
+	};
+
+	// Mesmo layout do push constant de particle.vert
+	struct DrawPushConstants {
+		glm::mat4 viewProj;
+		glm::vec4 cameraRight;
+		glm::vec4 cameraUp;
+		uint32_t  particleBufferIndex;
+		uint32_t  drawListIndex;
+		uint32_t  pad[2];
+	};
+
+	VkDevice             device;
+	BufferManager       &buffers;
+	BindlessDescriptors &bindless;
+	ParticleSettings     settings;
+
+	VkPipeline       simulatePipeline       = VK_NULL_HANDLE;
+	VkPipelineLayout simulatePipelineLayout = VK_NULL_HANDLE;
+	VkPipeline       drawPipeline           = VK_NULL_HANDLE;
+	VkPipelineLayout drawPipelineLayout     = VK_NULL_HANDLE;
+
+	// Estado das partículas persiste entre frames; emissores e contadores são por frame em voo
+	BufferHandle              particleBuffer      = INVALID_HANDLE;
+	BufferHandle              deadBuffer          = INVALID_HANDLE;        // Pilha de índices livres
+	BufferHandle              counterBuffer       = INVALID_HANDLE;        // Vivas por lista, livres, vivas por emissor
+	BufferHandle              argsBuffer          = INVALID_HANDLE;        // Dispatch da simulação + draw
+	BufferHandle              aliveLists[2]       = {INVALID_HANDLE, INVALID_HANDLE};
+	uint32_t                  particleBufferIndex = 0;
+	uint32_t                  deadBufferIndex     = 0;
+	uint32_t                  counterBufferIndex  = 0;
+	uint32_t                  argsBufferIndex     = 0;
+	uint32_t                  aliveListIndices[2] = {0, 0};
+	std::vector<BufferHandle> emitterBuffers;
+	std::vector<uint32_t>     emitterBufferIndices;
+	std::vector<BufferHandle> statsBuffers;
+	std::vector<uint32_t>     statsBufferIndices;
+
+	std::vector<GpuParticleEmitter> gpuEmitters;        // Montados no update (capacidade reservada: sem malloc por frame)
+	std::vector<float>              spawnCarry;         // Fração de partícula que sobrou de cada emissor
+
+	uint32_t              frame          = 0;
+	uint32_t              currentList    = 0;
+	uint32_t              emitterCount   = 0;
+	uint32_t              maxSpawn       = 0;        // Maior spawnCount do frame (largura do dispatch de emit)
+	uint32_t              seed           = 0;
+	float                 lastTime       = -1.0f;
+	bool                  needsReset     = true;
+	bool                  pendingSwap    = false;        // A simulação gravada escreveu a outra lista
+	bool                  overflowWarned = false;
+	SimulatePushConstants simulateConstants{};
+	DrawPushConstants     drawConstants{};
+	ParticleStats         lastStats;
+
+	void dispatch(VkCommandBuffer cmd, uint32_t pass, uint32_t groupsX, uint32_t groupsY = 1);
+};
@@ -0,0 +1,82 @@
+#pragma once
+
+#include <core/FrameScheduler.hpp>
+#include <core/FrameStats.hpp>
+#include <core/GpuProfiler.hpp>
+#include <core/MemoryMonitor.hpp>
+
+#define GLFW_INCLUDE_VULKAN
+#include <GLFW/glfw3.h>
+#include <vulkan/vulkan.h>
+#include <array>
+#include <cstdint>
+#include <vector>
+
+// Números do frame que o overlay mostra (montados pelo VulkanManager a cada build)
+struct OverlayFrameData {
+	const FramePacingStats              *pacing        = nullptr;
+	const std::vector<GpuScopeStats>    *gpuScopes     = nullptr;        // nullptr sem suporte a timestamps
+	const std::vector<HeapBudgetSample> *heaps         = nullptr;
+	const FrameStats                    *frame         = nullptr;        // Último frame completo
+	uint64_t                             uploadedBytes = 0;              // Acumulado desde o início (texturas + buffers)
+};
+
+// Overlay de desempenho com o Dear ImGui (backends GLFW + Vulkan).
+//
+// F1 alterna a visibilidade. Escondido, o overlay não custa nada no frame: nem NewFrame/Render
+// do ImGui no CPU nem a passada na GPU; só as amostras dos gráficos continuam sendo guardadas.
+class PerformanceOverlay {
+  public:
+	struct InitInfo {
+		VkInstance       instance;
+		VkPhysicalDevice physicalDevice;
+		VkDevice         device;
+		uint32_t         queueFamily;
+		VkQueue          queue;
+		GLFWwindow      *window;
+		uint32_t         imageCount;
+		VkFormat         colorFormat;        // Formato do swapchain (pipeline de dynamic rendering)
+		VkRenderPass     renderPass;         // VK_NULL_HANDLE = dynamic rendering
+	};
+
+	static constexpr uint32_t HISTORY_SIZE = 240;        // Frames nos gráficos
+	static constexpr int      TOGGLE_KEY   = GLFW_KEY_F1;
+
+	explicit PerformanceOverlay(const InitInfo &info);
+	~PerformanceOverlay();
+
+	PerformanceOverlay(const PerformanceOverlay &)            = delete;
+	PerformanceOverlay &operator=(const PerformanceOverlay &) = delete;
+
+	// Lê a tecla de alternar; chamar depois do pollEvents
+	void handleInput();
+	bool isVisible() const { return visible; }
+	void setVisible(bool value) { visible = value; }
+
+	// Amostra dos gráficos (barata, guardada mesmo com o overlay escondido)
+	void addFrameSample(float cpuFrameMs, float gpuFrameMs);
+
+	// NewFrame + janelas + Render do ImGui (só CPU). Só quando visível.
+	void build(const OverlayFrameData &data);
+
+	// Grava os draws do ImGui; precisa estar dentro de uma passada sobre a imagem do swapchain
+	void record(VkCommandBuffer cmd);
+
+	void setMinImageCount(uint32_t count);
+
+  private:
+	GLFWwindow *window;
+	bool        visible       = false;
+	bool        toggleWasDown = false;
+
+	std::array<float, HISTORY_SIZE> cpuHistory{};
+	std::array<float, HISTORY_SIZE> gpuHistory{};
+	uint32_t                        historyHead = 0;
+
+	// Vazão de upload medida entre builds
+	uint64_t lastUploadedBytes = 0;
+	double   lastUploadTime    = 0.0;
+	double   uploadRateMBps    = 0.0;
+
+	void plotHistory(const char *label, const std::array<float, HISTORY_SIZE> &history) const;
+};
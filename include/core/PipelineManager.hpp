@@ -6,22 +6,70 @@
 
 #include <string>
 #include <utility>
+#include <vector>
 #include <iostream>
 #include <glm/glm.hpp>
 
+// Enviado uma vez por passada; cada draw acha seus dados pelo gl_InstanceIndex (firstInstance)
 struct MeshPushConstants {
-    glm::mat4 render_matrix;
+    glm::mat4 viewProj;
+    uint32_t objectBufferIndex; // Slot do storage buffer de objetos no set bindless
+    uint32_t sceneBufferIndex;  // Slot do GpuSceneData do frame (luz e sombras)
+};
+
+// Dados por objeto (std430), lidos no shader via objectBuffers[objectBufferIndex].objects[gl_InstanceIndex]
+struct GpuObjectData {
+    glm::mat4 model;
+    uint32_t textureIndex; // Slot da textura no set bindless
+    uint32_t pad[3];
+};
+
+// Dados do frame inteiro (std430), um buffer por frame em voo, lidos no fragment shader
+struct GpuSceneData {
+    static constexpr uint32_t MAX_CASCADES = 4;
+
+    glm::mat4 view;                              // Profundidade em view space escolhe a cascata
+    glm::mat4 cascadeViewProj[MAX_CASCADES];
+    glm::vec4 cascadeSplits;                     // Distância (view space) onde cada cascata termina
+    glm::vec4 lightDirection;                    // xyz: direção em que a luz viaja; w: intensidade
+    glm::vec4 lightColor;                        // rgb; w: luz ambiente
+    uint32_t shadowMapIndices[MAX_CASCADES];     // Slots das shadow maps no set bindless
+    uint32_t cascadeCount;                       // 0 = sem sombras (fallback de render pass)
+    float shadowTexelSize;                       // 1 / resolução da shadow map
+    uint32_t lightBufferIndex;                   // GpuPointLight[] do frame no set bindless
+    uint32_t clusterBufferIndex;                 // Contagens + listas de luzes por cluster
+    glm::vec4 clusterScale;                      // xy: clusters por pixel; z, w: slice = log(depth) * z + w
+    glm::uvec4 clusterGrid;                      // Clusters em x, y, z (z = 0: sem luzes pontuais); w: luzes por cluster
+};
+
+// Luz pontual (std430), lida pelo compute de clusters e pelo fragment shader
+struct GpuPointLight {
+    glm::vec4 positionRadius;                    // xyz: posição no mundo; w: alcance
+    glm::vec4 colorIntensity;                    // rgb; w: intensidade
 };
 
 struct PipelineConfig {
   VkExtent2D extend;
-  VkRenderPass renderPass;
-  std::string vertexShaderPath;
-  std::string fragmentShaderPath;
+  VkRenderPass renderPass = VK_NULL_HANDLE; // VK_NULL_HANDLE = dynamic rendering (usa os formatos abaixo)
+  std::vector<VkFormat> colorAttachmentFormats;
+  VkFormat depthAttachmentFormat = VK_FORMAT_UNDEFINED; // Diferente de UNDEFINED liga o depth test
+  std::string vertexShaderPath = "../assets/shaders/core/mesh/compiled/vert.spv";
+  std::string fragmentShaderPath = "../assets/shaders/core/mesh/compiled/frag.spv"; // Vazio = só depth (ex.: shadow map)
+  std::vector<VkDescriptorSetLayout> setLayouts; // Normalmente só o set bindless (set 0)
 
   VkPrimitiveTopology topology = VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST;
   VkPolygonMode polygonMode = VK_POLYGON_MODE_FILL;
   VkCullModeFlags cullMode = VK_CULL_MODE_BACK_BIT;
+
+  // Depth bias fixo (shadow maps: evita acne sem mexer no shader)
+  bool depthBias = false;
+  float depthBiasConstant = 0.0f;
+  float depthBiasSlope = 0.0f;
+
+  bool vertexInput = true; // false: sem vertex buffer (o shader monta os vértices, ex.: partículas)
+  bool depthWrite = true; // false: só depth test (transparentes sobre o depth do opaco)
+  bool premultipliedAlpha = false; // Blend src + dst * (1 - src.a); alpha 0 vira aditivo
+  uint32_t pushConstantSize = sizeof(MeshPushConstants); // Vertex + fragment
 };
 
 
@@ -33,6 +81,14 @@ public:
       const PipelineConfig& config
    );
 
+   // Pipeline de compute com um shader; push constants de pushConstantSize bytes
+   static std::pair<VkPipeline, VkPipelineLayout> createComputePipeline (
+      VkDevice device,
+      const std::string& shaderPath,
+      const std::vector<VkDescriptorSetLayout>& setLayouts,
+      uint32_t pushConstantSize
+   );
+
    static void destroy (
       VkDevice device,
       VkPipeline pipeline,
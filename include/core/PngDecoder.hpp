@@ -0,0 +1,19 @@
+#pragma once
+
+#include <core/ResourceTypes.hpp>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Decodificador PNG mínimo (sem dependência externa).
+// Suporta PNG 8 bits por canal não entrelaçado: gray, gray+alpha, RGB, RGBA e paleta.
+// A saída é sempre RGBA8.
+class PngDecoder {
+public:
+   static ImageData decodeFile(const std::string& path);
+   static ImageData decode(const std::vector<uint8_t>& fileData);
+
+   // Descompressão zlib (RFC 1950/1951)
+   static std::vector<uint8_t> inflateZlib(const uint8_t* data, size_t size, size_t expectedSize = 0);
+};
@@ -0,0 +1,16 @@
+#pragma once
+
+#include <core/ResourceTypes.hpp>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Gravador PNG mínimo (RGBA8, sem dependência externa), par do PngDecoder.
+// Usa blocos deflate "stored" (sem compressão): o arquivo fica maior, mas a saída é
+// byte a byte determinística, o que é o que importa para comparar imagens de referência.
+class PngWriter {
+public:
+   static std::vector<uint8_t> encode(const ImageData& image);
+   static bool writeFile(const std::string& path, const ImageData& image);
+};
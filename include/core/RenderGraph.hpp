@@ -0,0 +1,232 @@
+#pragma once
+
+#include <core/DeletionQueue.hpp>
+
+#include <vulkan/vulkan.h>
+#include "vk_mem_alloc.h"
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+// Como um pass usa um recurso. Cada uso define estágio, acesso e layout (imagens) da barreira.
+enum class RenderGraphAccess : uint8_t {
+	ColorAttachment,            // Escrita de cor (com LOAD também lê)
+	DepthAttachment,            // Depth test + escrita
+	DepthReadOnly,              // Depth test sem escrita
+	FragmentSampled,            // Amostrada no fragment shader
+	ComputeSampled,
+	VertexStorageRead,          // Storage buffer/imagem lido no vertex shader
+	FragmentStorageRead,
+	ComputeStorageRead,
+	ComputeStorageWrite,
+	IndirectRead,               // Argumentos de draw/dispatch indireto
+	VertexInput,                // Vertex/index buffer
+	TransferRead,
+	TransferWrite
+};
+
+enum class AttachmentLoad : uint8_t {
+	Clear,
+	Load,
+	DontCare
+};
+
+struct RenderGraphImageDesc {
+	VkFormat   format = VK_FORMAT_UNDEFINED;
+	VkExtent2D extent = {0, 0};
+	uint32_t   layers = 1;
+};
+
+struct RenderGraphResource {
+	uint32_t index = UINT32_MAX;
+
+	bool isValid() const { return index != UINT32_MAX; }
+};
+
+// Render graph de um frame.
+//
+// A cada frame o VulkanManager descreve os passes (reset + import/create + addPass), compila e
+// executa. Cada pass declara o que lê e escreve; o compile então:
+//   - descarta passes cujo resultado não chega a nenhum recurso importado (nem tem efeito colateral);
+//   - escolhe STORE/DONT_CARE de cada attachment conforme alguém lê o conteúdo depois;
+//   - calcula as barreiras mínimas: nada entre leituras no mesmo layout, só dependência de execução
+//     para escrita depois de leitura, transições de layout juntas com a barreira do pass;
+//   - põe imagens transientes com tempos de vida disjuntos na mesma memória (aliasing).
+// As imagens transientes físicas ficam em cache enquanto a descrição (formatos, tamanhos,
+// aliasing) não muda; quando muda, as antigas vão para a DeletionQueue.
+//
+// Passes com attachments são gravados dentro de um vkCmdBeginRendering montado pelo graph;
+// exige dynamic rendering (Vulkan 1.3).
+class RenderGraph {
+  public:
+	using ExecuteFn = std::function<void(VkCommandBuffer)>;
+
+	class PassBuilder {
+	  public:
+		PassBuilder &writeColor(RenderGraphResource resource, AttachmentLoad load = AttachmentLoad::Clear, VkClearColorValue clear = {});
+		PassBuilder &writeDepth(RenderGraphResource resource, AttachmentLoad load = AttachmentLoad::Clear, float clearDepth = 1.0f);
+		PassBuilder &readDepth(RenderGraphResource resource);        // Depth test sem escrita, como attachment
+		PassBuilder &read(RenderGraphResource resource, RenderGraphAccess access);
+		PassBuilder &write(RenderGraphResource resource, RenderGraphAccess access);
+
+		// Nunca é descartado (ex.: escreve num buffer lido pela CPU)
+		PassBuilder &setSideEffect();
+
+	  private:
+		friend class RenderGraph;
+		PassBuilder(RenderGraph &graph, uint32_t pass) :
+		    graph(graph),
+		    pass(pass) {}
+
+		RenderGraph &graph;
+		uint32_t     pass;
+	};
+
+	struct Stats {
+		uint32_t     passes               = 0;
+		uint32_t     culledPasses         = 0;
+		uint32_t     barriers             = 0;        // Barreiras de imagem/buffer gravadas por frame
+		uint32_t     transientImages      = 0;
+		uint32_t     transientAllocations = 0;
+		VkDeviceSize transientBytes       = 0;
+		VkDeviceSize unaliasedBytes       = 0;        // O que as transientes ocupariam sem aliasing
+	};
+
+	RenderGraph(VkDevice device, VmaAllocator allocator, DeletionQueue &deletionQueue);
+	~RenderGraph();
+
+	RenderGraph(const RenderGraph &)            = delete;
+	RenderGraph &operator=(const RenderGraph &) = delete;
+
+	// Começa a descrição de um novo frame (o cache de imagens transientes continua)
+	void reset();
+
+	// Imagem que vive fora do graph. previousStages/previousAccess: último uso antes deste frame
+	// (a primeira barreira espera por ele; sem bits de escrita conta como leitura).
+	// finalLayout UNDEFINED deixa no layout do último pass.
+	RenderGraphResource importImage(const char                 *name,
+	                                VkImage                     image,
+	                                VkImageView                 view,
+	                                const RenderGraphImageDesc &desc,
+	                                VkImageAspectFlags          aspect,
+	                                VkImageLayout               initialLayout,
+	                                VkPipelineStageFlags        previousStages,
+	                                VkAccessFlags               previousAccess,
+	                                VkImageLayout               finalLayout);
+	RenderGraphResource importBuffer(const char *name, VkBuffer buffer, VkPipelineStageFlags previousStages, VkAccessFlags previousAccess);
+
+	// Imagem que só existe dentro do frame; o uso (attachment, sampled...) vem dos passes
+	RenderGraphResource createImage(const char *name, const RenderGraphImageDesc &desc);
+
+	// name precisa viver até o frame terminar na GPU (escopo do profiler; na prática, um literal)
+	PassBuilder addPass(const char *name, ExecuteFn execute);
+
+	// retireValue: valor do timeline a partir do qual imagens transientes trocadas podem ser destruídas
+	void compile(uint64_t retireValue);
+	void execute(VkCommandBuffer cmd);
+
+	// Válidos depois do compile (ex.: para registrar uma imagem transiente como textura)
+	VkImage     getImage(RenderGraphResource resource) const;
+	VkImageView getImageView(RenderGraphResource resource) const;
+
+	const Stats &getStats() const { return stats; }
+
+  private:
+	struct Use {
+		uint32_t          resource;
+		RenderGraphAccess access;
+		bool              write;
+		AttachmentLoad    load  = AttachmentLoad::Load;
+		bool              store = true;        // Decidido no compile
+		VkClearValue      clear{};
+	};
+
+	struct Pass {
+		const char      *name;
+		ExecuteFn        execute;
+		std::vector<Use> uses;
+		bool             sideEffect = false;
+		bool             culled     = false;
+
+		// Barreiras antes do pass (compile)
+		VkPipelineStageFlags               srcStages = 0;
+		VkPipelineStageFlags               dstStages = 0;
+		std::vector<VkImageMemoryBarrier>  imageBarriers;
+		std::vector<VkBufferMemoryBarrier> bufferBarriers;
+	};
+
+	// Estado de sincronização de um recurso enquanto o compile percorre os passes
+	struct SyncState {
+		VkImageLayout        layout        = VK_IMAGE_LAYOUT_UNDEFINED;
+		VkPipelineStageFlags writeStages   = 0;        // Última escrita (ou transição de layout)
+		VkAccessFlags        writeAccess   = 0;
+		VkPipelineStageFlags readStages    = 0;        // Leituras desde a última escrita
+		VkAccessFlags        visibleAccess = 0;        // Acessos que já enxergam a última escrita
+	};
+
+	struct Resource {
+		const char          *name;
+		bool                 imported = false;
+		bool                 isBuffer = false;
+		RenderGraphImageDesc desc;
+		VkImageAspectFlags   aspect = VK_IMAGE_ASPECT_COLOR_BIT;
+		VkImage              image  = VK_NULL_HANDLE;
+		VkImageView          view   = VK_NULL_HANDLE;
+		VkBuffer             buffer = VK_NULL_HANDLE;
+
+		VkImageLayout        initialLayout  = VK_IMAGE_LAYOUT_UNDEFINED;
+		VkImageLayout        finalLayout    = VK_IMAGE_LAYOUT_UNDEFINED;
+		VkPipelineStageFlags previousStages = 0;
+		VkAccessFlags        previousAccess = 0;
+
+		// Compile
+		VkImageUsageFlags usage     = 0;
+		uint32_t          firstPass = UINT32_MAX;
+		uint32_t          lastPass  = 0;
+		uint32_t          physical  = UINT32_MAX;        // Índice em physicalImages (transientes)
+		SyncState         state;
+	};
+
+	// Imagem transiente de verdade, presa a um bloco de memória compartilhado
+	struct PhysicalImage {
+		RenderGraphImageDesc desc;
+		VkImageUsageFlags    usage;
+		VkImageAspectFlags   aspect;
+		uint32_t             slot;
+		VkImage              image = VK_NULL_HANDLE;
+		VkImageView          view  = VK_NULL_HANDLE;
+	};
+
+	struct MemorySlot {
+		VkMemoryRequirements requirements{};
+		VmaAllocation        allocation = VK_NULL_HANDLE;
+		VkPipelineStageFlags stages     = 0;        // Todos os usos das imagens do slot no frame
+		VkAccessFlags        writes     = 0;
+	};
+
+	VkDevice       device;
+	VmaAllocator   allocator;
+	DeletionQueue &deletionQueue;
+
+	std::vector<Resource> resources;
+	std::vector<Pass>     passes;
+
+	std::vector<PhysicalImage> physicalImages;
+	std::vector<MemorySlot>    memorySlots;
+
+	VkPipelineStageFlags              finalSrcStages = 0;
+	VkPipelineStageFlags              finalDstStages = 0;
+	std::vector<VkImageMemoryBarrier> finalBarriers;
+	Stats                             stats;
+
+	Use &addUse(uint32_t pass, RenderGraphResource resource, RenderGraphAccess access, bool write);
+
+	void cullPasses();
+	void computeLifetimes();
+	void allocateTransients(uint64_t retireValue);
+	void buildBarriers();
+	void addBarrier(Pass &pass, Resource &resource, const Use &use);
+
+	VkMemoryRequirements getRequirements(const RenderGraphImageDesc &desc, VkImageUsageFlags usage) const;
+	void                 retirePhysicalImages(uint64_t retireValue);
+};
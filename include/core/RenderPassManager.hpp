@@ -20,6 +20,10 @@ class RenderPassManager {
 
 
    static void destroy(VkDevice device, VkRenderPass renderPass);
+
+   // Dynamic rendering (core no Vulkan 1.3): passadas começam com vkCmdBeginRendering,
+   // sem VkRenderPass nem VkFramebuffer. Sem suporte, o render pass clássico é o fallback.
+   static bool isDynamicRenderingSupported(VkPhysicalDevice physicalDevice);
 };
 // Conceitos importantes:
 // Attachment: Descrição de imagens usadas (color, depth, stencil)
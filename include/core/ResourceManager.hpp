@@ -5,7 +5,9 @@
 #include <core/VmaWrapper.hpp>
 
 #include <vulkan/vulkan.h>
+#include <array>
 #include <unordered_map>
+#include <algorithm>
 #include <stdexcept> 
 
 
@@ -21,14 +23,61 @@ public:
    void destroyBuffer(BufferHandle handle);
    VmaBuffer getBuffer(BufferHandle handle) const; // Alterado para retornar VmaBuffer para mais informações
    VkBuffer getVkBuffer(BufferHandle handle) const;
+
+   // Imagens: cria a VkImage (VMA) e uma view que cobre todos os mips
+   ImageHandle createImage(const ImageCreateInfo& info);
+   void destroyImage(ImageHandle handle);
+   VmaImage getImage(ImageHandle handle) const;
+   VkImage getVkImage(ImageHandle handle) const;
+   VkImageView getImageView(ImageHandle handle) const;
+
+   // Contabilidade por categoria (geometry, staging, uniform, image)
+   const CategoryUsage& getCategoryUsage(ResourceCategory category) const;
+   VkDeviceSize getTotalTrackedBytes() const;
+
+   // ---- Suporte à desfragmentação (GpuDefragmenter) ----
+   // Buffers de geometria GPU_ONLY vivem num pool próprio, o único que é desfragmentado.
+   VmaPool getGeometryPool() const { return m_geometryPool; }
+   BufferHandle getHandleFromAllocation(VmaAllocation allocation) const;
+   VkBufferCreateInfo getBufferCreateInfo(BufferHandle handle) const;
+   // Enquanto um buffer está sendo movido, destroyBuffer() só marca ele para destruição
+   void beginMove(BufferHandle handle);
+   bool endMove(BufferHandle handle); // Retorna false se o buffer foi destruído durante o move
+   // Troca o VkBuffer por trás do handle e devolve o antigo (a alocação continua a mesma)
+   VkBuffer swapVkBuffer(BufferHandle handle, VkBuffer newBuffer);
 private:
+   struct BufferEntry {
+      VmaBuffer          buffer;
+      ResourceCategory   category;
+      VkDeviceSize       allocatedSize; // Tamanho real da alocação (com alinhamento)
+      VkDeviceSize       requestedSize;
+      VkBufferUsageFlags usage;
+      bool               moving         = false;
+      bool               pendingDestroy = false;
+   };
+
+   struct ImageEntry {
+      VmaImage         image;
+      VkImageView      view;
+      ResourceCategory category;
+      VkDeviceSize     allocatedSize;
+   };
+
    VkDevice m_device;
    VmaAllocator m_allocator;
    VmaWrapper* m_vmaWrapper;
 
-   std::unordered_map<BufferHandle, VmaBuffer> m_buffers;
+   std::unordered_map<BufferHandle, BufferEntry> m_buffers;
+   std::unordered_map<ImageHandle, ImageEntry> m_images;
 
    HandleAllocator<BufferHandle> m_bufferHandleAllocator;
+   HandleAllocator<ImageHandle> m_imageHandleAllocator;
+
+   VmaPool m_geometryPool = VK_NULL_HANDLE;
+
+   std::array<CategoryUsage, static_cast<size_t>(ResourceCategory::Count)> m_categoryUsage{};
 
-   // HandleAllocator<ImageHandle> m_imageHandleAllocator;
-};
\ No newline at end of file
+   void trackAllocation(ResourceCategory category, VkDeviceSize size);
+   void trackFree(ResourceCategory category, VkDeviceSize size);
+   void createGeometryPool();
+};
@@ -3,18 +3,52 @@
 #include <vulkan/vulkan.h>
 
 #include "vk_mem_alloc.h" 
+#include <cstdint>
 #include <vector> 
 
 
+// Categoria de contabilidade de memória (usada pelo ResourceManager e MemoryMonitor)
+enum class ResourceCategory : uint32_t {
+   Geometry = 0, // Vertex / Index buffers
+   Staging,
+   Uniform,
+   Image,
+   RenderTarget, // Color/depth attachments (offscreen)
+   Count
+};
+
+inline const char* toString(ResourceCategory category) {
+   switch (category) {
+      case ResourceCategory::Geometry: return "geometry";
+      case ResourceCategory::Staging:  return "staging";
+      case ResourceCategory::Uniform:  return "uniform";
+      case ResourceCategory::Image:    return "image";
+      case ResourceCategory::RenderTarget: return "render_target";
+      default:                         return "unknown";
+   }
+}
+
 struct BufferCreateInfo {
    VkDeviceSize size;
    VkBufferUsageFlags usage;
    VmaMemoryUsage memoryUsage;
+   ResourceCategory category = ResourceCategory::Geometry;
+   std::vector<uint32_t> queueFamilies = {}; // Mais de uma família: VK_SHARING_MODE_CONCURRENT (ex.: fila de compute assíncrona)
+};
+
+// Uso acumulado de uma categoria (bytes reais alocados pela VMA, não o tamanho pedido)
+struct CategoryUsage {
+   VkDeviceSize currentBytes     = 0;
+   VkDeviceSize peakBytes        = 0;
+   uint32_t     liveCount        = 0;
+   uint64_t     totalAllocations = 0;
 };
 
 struct Vertex {
-    float pos[3];   // X, Y, Z
-    float color[3]; // R, G, B
+    float pos[3];           // X, Y, Z
+    float color[3];         // R, G, B
+    float texCoord[2] = {}; // U, V
+    float normal[3]   = {}; // Espaço do objeto (zero = sem normal, o shader não ilumina)
 };
 
 // Dados brutos da mesh (CPU side)
@@ -23,4 +57,19 @@ struct MeshData {
     std::vector<uint32_t> indices;
 };
 
-// struct ImageCreateInfo { ... };
\ No newline at end of file
+struct ImageCreateInfo {
+   VkExtent3D extent;
+   VkFormat format;
+   uint32_t mipLevels = 1;
+   VkImageUsageFlags usage;
+   VmaMemoryUsage memoryUsage = VMA_MEMORY_USAGE_GPU_ONLY;
+   VkImageAspectFlags aspect = VK_IMAGE_ASPECT_COLOR_BIT;
+   ResourceCategory category = ResourceCategory::Image;
+};
+
+// Pixels brutos de uma imagem (CPU side), sempre RGBA8
+struct ImageData {
+   uint32_t width = 0;
+   uint32_t height = 0;
+   std::vector<uint8_t> pixels;
+};
\ No newline at end of file
@@ -0,0 +1,92 @@
+#pragma once
+
+#include <core/BindlessDescriptors.hpp>
+#include <core/PipelineManager.hpp>
+#include <core/ResourceManager.hpp>
+#include <core/ResourceTypes.hpp>
+
+#include <vulkan/vulkan.h>
+#include <array>
+#include <cstdint>
+#include <glm/glm.hpp>
+
+struct ShadowSettings {
+	uint32_t cascadeCount    = 4;           // Até GpuSceneData::MAX_CASCADES
+	uint32_t resolution      = 2048;        // Lado de cada shadow map
+	uint32_t dynamicCascades = 1;           // As primeiras N (perto da câmera) são refeitas todo frame com tudo
+	float    shadowDistance  = 60.0f;       // Até onde existe sombra (limitado ao far da câmera)
+	float    splitLambda     = 0.75f;       // 0 = divisões uniformes, 1 = logarítmicas
+	float    cachePadding    = 0.15f;       // Folga das cascatas em cache (fração do raio) antes de refazer
+	float    lightTolerance  = 0.9999f;     // cos do ângulo que a luz pode girar sem invalidar o cache
+};
+
+// Contadores do último update()
+struct ShadowStats {
+	uint32_t renderedCascades = 0;        // Re-renderizadas neste frame
+	uint32_t cachedCascades   = 0;        // Reaproveitadas do cache
+	uint64_t cacheRefreshes   = 0;        // Cascatas estáticas refeitas desde o início (luz/câmera andou)
+};
+
+// Cascaded shadow maps de uma luz direcional, com cache das cascatas distantes.
+//
+// Cada cascata cobre uma fatia do frustum da câmera com uma esfera (estável na rotação, texel
+// alinhado). As dynamicCascades mais próximas são refeitas todo frame com toda a geometria; as
+// demais só desenham geometria estática e ficam em cache: o ajuste delas ganha cachePadding de
+// folga, e só são refeitas quando a fatia atual sai da esfera guardada ou a luz gira além de
+// lightTolerance. Com a câmera e a luz paradas, o custo por frame é só o das cascatas próximas.
+//
+// As shadow maps são imagens persistentes (o cache precisa sobreviver ao frame) registradas no
+// set bindless; o render graph importa cada uma e a deixa em SHADER_READ_ONLY no fim do frame.
+class ShadowCascades {
+  public:
+	static constexpr uint32_t MAX_CASCADES = GpuSceneData::MAX_CASCADES;
+
+	struct Cascade {
+		glm::mat4   viewProj      = glm::mat4(1.0f);
+		float       splitFar      = 0.0f;         // Distância em view space onde a cascata termina
+		bool        dynamic       = false;        // Geometria móvel entra (refeita todo frame)
+		bool        needsRender   = false;        // Decidido no update()
+		bool        initialized   = false;        // Já foi renderizada (imagem em SHADER_READ_ONLY)
+		glm::vec3   center        = glm::vec3(0.0f);
+		float       radius        = 0.0f;
+		glm::vec3   lightDir      = glm::vec3(0.0f);
+		ImageHandle image         = INVALID_HANDLE;
+		uint32_t    bindlessIndex = 0;
+	};
+
+	ShadowCascades(ResourceManager &resources, BindlessDescriptors &bindless, VkFormat depthFormat, const ShadowSettings &settings = {});
+	~ShadowCascades();
+
+	ShadowCascades(const ShadowCascades &)            = delete;
+	ShadowCascades &operator=(const ShadowCascades &) = delete;
+
+	// Ajusta as cascatas à câmera (perspectiva fovY/aspect, planos near/far) e decide quais renderizar.
+	// lightDir: direção em que a luz viaja. casterDepth: quanto antes da fatia ainda pode haver
+	// oclusor (altura da cena na direção da luz).
+	void update(const glm::mat4 &view, float fovY, float aspect, float nearPlane, float farPlane, const glm::vec3 &lightDir, float casterDepth);
+
+	// Chamado depois de gravar a passada da cascata (a imagem passa a valer no cache)
+	void markRendered(uint32_t cascade) { cascades[cascade].initialized = true; }
+
+	// Campos de sombra do GpuSceneData
+	void writeSceneData(GpuSceneData &data) const;
+
+	uint32_t           getCascadeCount() const { return settings.cascadeCount; }
+	const Cascade     &getCascade(uint32_t cascade) const { return cascades[cascade]; }
+	VkImage            getImage(uint32_t cascade) const { return resources.getVkImage(cascades[cascade].image); }
+	VkImageView        getImageView(uint32_t cascade) const { return resources.getImageView(cascades[cascade].image); }
+	VkFormat           getDepthFormat() const { return depthFormat; }
+	uint32_t           getResolution() const { return settings.resolution; }
+	const ShadowStats &getStats() const { return stats; }
+
+  private:
+	ResourceManager     &resources;
+	BindlessDescriptors &bindless;
+	VkFormat             depthFormat;
+	ShadowSettings       settings;
+	ShadowStats          stats;
+
+	std::array<Cascade, MAX_CASCADES> cascades{};
+
+	glm::mat4 fitCascade(const glm::vec3 &center, float radius, const glm::vec3 &lightDir, float casterDepth) const;
+};
@@ -3,6 +3,7 @@
 
 #include <GLFW/glfw3.h>
 #include <algorithm>
+#include <chrono>
 #include <iostream>
 #include <limits>
 #include <set>
@@ -10,11 +11,31 @@
 #include <vector>
 #include <vulkan/vulkan.h>
 
+#include <core/DeletionQueue.hpp>
 #include <core/queueManager.hpp>
 
 const std::vector<const char *> deviceExtensions = {
     VK_KHR_SWAPCHAIN_EXTENSION_NAME};
 
+// Política de apresentação: escolhe o present mode e quantas imagens pedir ao swapchain.
+// Se o modo preferido não existir, cai para o próximo da lista (FIFO sempre existe).
+enum class PresentPolicy {
+	Throughput,        // MAILBOX > FIFO, minImageCount + 1 (mín. 3): sem tearing (sem MAILBOX, limitado ao vsync)
+	LowLatency,        // MAILBOX > FIFO_RELAXED > FIFO, minImageCount: fila de imagens mais curta possível
+	Vsync,             // FIFO, minImageCount + 1: ritmo do monitor, para rodar em produção
+	Immediate          // IMMEDIATE > MAILBOX > FIFO, minImageCount: benchmark sem limite, tearing permitido
+};
+
+// Intervalo entre presents medido no CPU (logo após vkQueuePresentKHR).
+// Não é o momento em que a imagem aparece na tela, mas mostra o ritmo imposto pelo present mode.
+struct PresentTimingStats {
+	double   lastIntervalMs    = 0.0;
+	double   averageIntervalMs = 0.0;        // Média móvel exponencial
+	double   minIntervalMs     = 0.0;
+	double   maxIntervalMs     = 0.0;
+	uint64_t presentCount      = 0;
+};
+
 class SwapchainManager {
   public:
 	SwapchainManager();
@@ -23,14 +44,34 @@ class SwapchainManager {
 	}
 
 
-	bool createSwapchain(uint32_t width, uint32_t height);
+	bool createSwapchain(uint32_t width, uint32_t height, VkSwapchainKHR oldSwapchain = VK_NULL_HANDLE);
 	bool createImageViews();
 	void cleanup();
 	void cleanupSwapchain();
-	void recreateSwapchain(uint32_t width, uint32_t height);
+
+	// Cria o novo swapchain passando o atual como oldSwapchain, sem esperar a GPU.
+	// Swapchain, image views e framebuffers antigos vão para a deletionQueue e só são
+	// destruídos quando o timeline chegar em retireValue (frames em voo ainda usam eles).
+	void recreateSwapchain(uint32_t width, uint32_t height, DeletionQueue &deletionQueue, uint64_t retireValue);
 
 	static bool checkDeviceSupportSwapChain(VkPhysicalDevice device);
 
+	// Só passa a valer no próximo createSwapchain/recreateSwapchain
+	void          setPresentPolicy(PresentPolicy policy) { presentPolicy = policy; }
+	PresentPolicy getPresentPolicy() const { return presentPolicy; }
+
+	// "throughput", "low-latency", "vsync", "immediate"
+	static bool        parsePresentPolicy(const std::string &name, PresentPolicy &policy);
+	static const char *toString(PresentPolicy policy);
+
+	// vkQueuePresentKHR + medição do intervalo entre presents
+	VkResult                  present(VkQueue queue, VkSemaphore waitSemaphore, uint32_t imageIndex);
+	const PresentTimingStats &getPresentTimingStats() const { return presentTiming; }
+	void                      resetPresentTimingStats();
+
+	VkPresentModeKHR getPresentMode() const { return presentMode; }
+	uint32_t         getImageCount() const { return static_cast<uint32_t>(swapchainImages.size()); }
+
 	// Support details
 	struct SwapChainSupportDetails {
 		VkSurfaceCapabilitiesKHR        capabilities;
@@ -44,8 +85,14 @@ class SwapchainManager {
 
 	VkFormat getSwapchainImageFormat() const { return swapchainImageFormat; }
 
+	// Imagens aceitam vkCmdBlitImage (destino do upscale da resolução dinâmica)
+	bool isTransferDstSupported() const { return transferDstSupported; }
+
 	VkSwapchainKHR getSwapchain() const { return swapchain; }
 
+	const std::vector<VkImage>     &getImages() const { return swapchainImages; }
+	const std::vector<VkImageView> &getImageViews() const { return swapchainImageViews; }
+
 	// FrameBuffers Functions
 	bool createFramebuffers(VkRenderPass renderPass);
 	const std::vector<VkFramebuffer>& getFramebuffers() const {
@@ -69,8 +116,16 @@ class SwapchainManager {
 	
 	std::vector<VkFramebuffer> swapchainFramebuffers;
 
+	PresentPolicy    presentPolicy        = PresentPolicy::Throughput;
+	VkPresentModeKHR presentMode          = VK_PRESENT_MODE_FIFO_KHR;
+	bool             transferDstSupported = false;
+
+	PresentTimingStats                    presentTiming;
+	std::chrono::steady_clock::time_point lastPresentTime;
+
 	VkSurfaceFormatKHR chooseSwapSurfaceFormat(const std::vector<VkSurfaceFormatKHR> &availableFormats);
 	VkPresentModeKHR   chooseSwapPresentMode(const std::vector<VkPresentModeKHR> &availablePresentModes);
+	uint32_t           chooseImageCount(const VkSurfaceCapabilitiesKHR &capabilities, VkPresentModeKHR mode) const;
 };
 
 #endif
\ No newline at end of file
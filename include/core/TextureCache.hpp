@@ -0,0 +1,50 @@
+#pragma once
+
+#include <core/ResourceTypes.hpp>
+#include <core/TextureCompressor.hpp>
+
+#include <vulkan/vulkan.h>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Textura já comprimida com todos os mips, pronta para ir direto pro staging
+struct CompressedTexture {
+   VkFormat format = VK_FORMAT_UNDEFINED;
+   uint32_t width = 0;
+   uint32_t height = 0;
+   std::vector<VkDeviceSize> mipOffsets; // Offset de cada mip dentro de data (alinhado a 16)
+   std::vector<VkDeviceSize> mipSizes;
+   std::vector<uint8_t> data;
+
+   uint32_t getMipLevels() const { return static_cast<uint32_t>(mipOffsets.size()); }
+};
+
+// Cache em disco de texturas BC1/BC7, num container parecido com KTX2:
+//
+//   header     : identificador, vkFormat, largura, altura, número de mips,
+//                tamanho e data de modificação do PNG de origem (invalidação)
+//   level index: (offset, tamanho) de cada mip
+//   dados      : mips em sequência, do maior para o menor
+//
+// Na primeira execução o PNG é decodificado, comprimido e gravado; nas seguintes o arquivo
+// é lido inteiro e copiado para o staging sem nenhum processamento.
+class TextureCache {
+public:
+   explicit TextureCache(std::string directory);
+
+   // false se não existe, está corrompido ou o PNG de origem mudou
+   bool load(const std::string& sourcePath, BlockFormat format, CompressedTexture& out) const;
+   void store(const std::string& sourcePath, BlockFormat format, const CompressedTexture& texture) const;
+
+   // Gera os mips na CPU e comprime cada um
+   static CompressedTexture build(const ImageData& image, BlockFormat format);
+   static VkFormat toVkFormat(BlockFormat format);
+
+   const std::string& getDirectory() const { return m_directory; }
+
+private:
+   std::string m_directory;
+
+   std::string cachePathFor(const std::string& sourcePath, BlockFormat format) const;
+};
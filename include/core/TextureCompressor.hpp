@@ -0,0 +1,30 @@
+#pragma once
+
+#include <core/ResourceTypes.hpp>
+
+#include <cstdint>
+#include <vector>
+
+enum class BlockFormat : uint32_t {
+   BC1, // RGB 5:6:5, 8 bytes por bloco 4x4 (texturas opacas)
+   BC7  // RGBA, 16 bytes por bloco 4x4 (só o modo 6)
+};
+
+// Encoder de blocos BC na CPU (sem dependência externa).
+// Qualidade de "primeira execução": eixo principal (PCA) por bloco + índices pelo mais próximo.
+// Bem mais rápido que um encoder offline completo e suficiente para as texturas chapadas do car-kit.
+class TextureCompressor {
+public:
+   // Comprime uma imagem RGBA8 inteira (bordas que não fecham bloco repetem o último pixel)
+   static std::vector<uint8_t> compress(const ImageData& image, BlockFormat format);
+
+   // Mip chain completa (box filter 2x2, cor média em espaço linear), começando pela própria imagem
+   static std::vector<ImageData> buildMipChain(const ImageData& base);
+
+   static size_t compressedSize(uint32_t width, uint32_t height, BlockFormat format);
+   static bool hasAlpha(const ImageData& image);
+
+   // Bloco = 16 pixels RGBA8 em ordem de linha
+   static void encodeBlockBC1(const uint8_t* rgba, uint8_t* out);
+   static void encodeBlockBC7(const uint8_t* rgba, uint8_t* out);
+};
@@ -0,0 +1,142 @@
+#pragma once
+
+#include <core/BindlessDescriptors.hpp>
+#include <core/BufferManager.hpp>
+#include <core/Handle.hpp>
+#include <core/ResourceManager.hpp>
+#include <core/ResourceTypes.hpp>
+#include <core/TextureCache.hpp>
+
+#include <vulkan/vulkan.h>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+// Carregamento de texturas sem travar a thread de render.
+//
+//   loadTexture()    -> devolve o handle na hora e coloca o arquivo na fila dos workers
+//   workers          -> decodificam o PNG (CPU) e entregam os pixels prontos
+//   processUploads() -> na thread de render: staging + cópia para a imagem + mips por blit,
+//                       tudo gravado no command buffer do frame (antes do render pass)
+//
+// Com BC habilitado no device, os workers procuram primeiro no TextureCache (BC1 para texturas
+// opacas, BC7 com alpha). Na falta do cache, comprimem na CPU e gravam para a próxima execução.
+// Sem suporte a BC, tudo continua em RGBA8.
+//
+// Enquanto a textura não fica pronta, getImageView()/getBindlessIndex() devolvem a textura padrão
+// (1x1 branca). O slot bindless só é escrito quando a imagem fica pronta, então um slot nunca muda
+// de conteúdo com frames em voo.
+class TextureManager {
+  public:
+	TextureManager(VkDevice             device,
+	               VkPhysicalDevice     physicalDevice,
+	               ResourceManager     &resources,
+	               BufferManager       &bufferManager,
+	               BindlessDescriptors &bindless,
+	               uint32_t             framesInFlight,
+	               bool                 blockCompressionEnabled,        // textureCompressionBC ligado no device
+	               uint32_t             workerCount          = 0,       // 0 = escolhe pelo número de cores
+	               VkDeviceSize         uploadBudgetPerFrame = 16 * 1024 * 1024);
+	~TextureManager();        // Precisa do device ocioso (vkDeviceWaitIdle) antes
+
+	TextureManager(const TextureManager &)            = delete;
+	TextureManager &operator=(const TextureManager &) = delete;
+
+	// Não bloqueia; o mesmo caminho devolve sempre o mesmo handle
+	TextureHandle loadTexture(const std::string &path);
+
+	// Chamado dentro do recordCommandBuffer, antes do render pass
+	void processUploads(VkCommandBuffer cmd, uint64_t frameNumber);
+
+	bool        isReady(TextureHandle handle) const;
+	VkImageView getImageView(TextureHandle handle) const;
+	uint32_t    getBindlessIndex(TextureHandle handle) const;        // Índice no array de texturas do shader
+	VkSampler   getSampler() const { return sampler; }
+
+	TextureHandle getDefaultTexture() const { return defaultTexture; }
+	uint32_t      getTextureCount() const { return static_cast<uint32_t>(textures.size()); }
+	size_t        getPendingCount() const;        // Ainda decodificando ou esperando upload
+	bool          isBlockCompressionEnabled() const { return bc1Supported || bc7Supported; }
+	VkDeviceSize  getUploadedBytes() const { return totalUploadedBytes; }        // Acumulado desde a criação
+
+  private:
+	enum class TextureState {
+		Decoding,
+		Ready,
+		Failed
+	};
+
+	struct TextureEntry {
+		std::string  path;
+		TextureState state         = TextureState::Decoding;
+		ImageHandle  image         = INVALID_HANDLE;
+		VkFormat     format        = VK_FORMAT_UNDEFINED;
+		uint32_t     bindlessIndex = INVALID_HANDLE;
+		uint32_t     width         = 0;
+		uint32_t     height        = 0;
+		uint32_t     mipLevels     = 1;
+	};
+
+	struct DecodeJob {
+		TextureHandle handle;
+		std::string   path;
+	};
+
+	struct DecodedImage {
+		TextureHandle     handle;
+		ImageData         data         = {};        // RGBA8 (mips gerados na GPU)
+		CompressedTexture compressed   = {};        // BC1/BC7 com todos os mips
+		bool              isCompressed = false;
+		bool              failed       = false;
+	};
+
+	struct StagingRelease {
+		BufferHandle buffer;
+		uint64_t     retireFrame;
+	};
+
+	VkDevice             device;
+	VkPhysicalDevice     physicalDevice;
+	ResourceManager     &resources;
+	BufferManager       &bufferManager;
+	BindlessDescriptors &bindless;
+	uint32_t             framesInFlight;
+	VkDeviceSize         uploadBudgetPerFrame;
+	VkDeviceSize         totalUploadedBytes = 0;
+
+	VkFormat  textureFormat = VK_FORMAT_R8G8B8A8_SRGB;
+	bool      canBlitMips   = false;        // Formato suporta filtro linear em blit
+	bool      bc1Supported  = false;
+	bool      bc7Supported  = false;
+	VkSampler sampler       = VK_NULL_HANDLE;
+
+	TextureCache cache{"texture_cache"};        // Relativo ao diretório de execução (build/)
+
+	// Só acessados pela thread de render
+	std::vector<TextureEntry>                      textures;
+	std::unordered_map<std::string, TextureHandle> pathToHandle;
+	std::vector<StagingRelease>                    stagingToRelease;
+	TextureHandle                                  defaultTexture = INVALID_HANDLE;
+
+	// Compartilhados com os workers (protegidos por queueMutex)
+	std::mutex               queueMutex;
+	std::condition_variable  queueCondition;
+	std::deque<DecodeJob>    jobs;
+	std::deque<DecodedImage> decoded;
+	bool                     stopping     = false;
+
+	std::vector<std::thread> workers;
+
+	void workerLoop();
+	bool loadCompressed(const std::string &path, DecodedImage &result);
+	void createSampler();
+	void createDefaultTexture();
+	void upload(VkCommandBuffer cmd, uint64_t frameNumber, DecodedImage &image);
+	void uploadCompressed(VkCommandBuffer cmd, uint64_t frameNumber, DecodedImage &image);
+	void markReady(TextureEntry &texture);
+	void generateMips(VkCommandBuffer cmd, VkImage image, uint32_t width, uint32_t height, uint32_t mipLevels);
+};
@@ -5,30 +5,54 @@
 #include "vk_mem_alloc.h"
 #include <iostream>
 #include <stdexcept>
+#include <string>
+#include <vector>
 
 struct VmaBuffer { // Ela agrupa um buffer Vulkan com sua alocação de memória da VMA.
    VkBuffer buffer;
    VmaAllocation allocation;
 };
 
+struct VmaImage { // Mesma ideia do VmaBuffer, mas para imagens
+   VkImage image;
+   VmaAllocation allocation;
+};
+
 class VmaWrapper {
 public: 
    VmaWrapper();
    ~VmaWrapper();
 
-   void initialize(VkDevice device, VkPhysicalDevice physicalDevice, VkInstance instance);
+   // enableMemoryBudget só deve ser true se VK_EXT_memory_budget foi habilitada no device
+   void initialize(VkDevice device, VkPhysicalDevice physicalDevice, VkInstance instance, bool enableMemoryBudget = false);
    void destroy();
 
    VmaAllocator getAllocator() const { return allocator; }
 
 
    bool isInitialized() const { return allocator != VK_NULL_HANDLE; }
+   bool isMemoryBudgetEnabled() const { return memoryBudgetEnabled; }
 
-   VmaBuffer createBuffer(const VkBufferCreateInfo& bufferInfo, const VmaAllocationCreateInfo& allocInfo);
+   VmaBuffer createBuffer(const VkBufferCreateInfo& bufferInfo, const VmaAllocationCreateInfo& allocInfo, VmaAllocationInfo* outAllocInfo = nullptr);
    void destroyBuffer(VmaBuffer& buffer);
+
+   VmaImage createImage(const VkImageCreateInfo& imageInfo, const VmaAllocationCreateInfo& allocInfo, VmaAllocationInfo* outAllocInfo = nullptr);
+   void destroyImage(VmaImage& image);
+
+   // Pools customizados (ex: heap de geometria que pode ser desfragmentado)
+   VmaPool createPoolForBuffers(const VkBufferCreateInfo& sampleBufferInfo, const VmaAllocationCreateInfo& sampleAllocInfo);
+   void destroyPool(VmaPool& pool);
+
+   // Estatísticas / orçamento de memória
+   void setCurrentFrameIndex(uint32_t frameIndex);
+   uint32_t getMemoryHeapCount() const;
+   std::vector<VmaBudget> getHeapBudgets() const;
+   VmaTotalStatistics calculateStatistics() const;
+   std::string buildStatsString(bool detailedMap) const; // JSON gerado pela própria VMA
 private:
    VmaAllocator allocator;
    VkDevice device;
+   bool memoryBudgetEnabled;
 
    VmaWrapper (const VmaWrapper&) = delete;  // Operador de Deleção C++
    VmaWrapper& operator = (const VmaWrapper&) = delete;
@@ -3,35 +3,139 @@
 
 #include <iostream>
 #include <memory>
+#include <optional>
 #include <stdexcept>
+#include <string>
 #include <vector>
 
 #include "VulkanUtils/VulkanTools.hpp"
 #include <core/ResourceTypes.hpp>
 
+#include <core/AsyncCompute.hpp>
+#include <core/Benchmark.hpp>
+#include <core/BindlessDescriptors.hpp>
 #include <core/BufferManager.hpp>
+#include <core/ClusteredLighting.hpp>
 #include <core/CommandManager.hpp>
+#include <core/CpuTracer.hpp>
+#include <core/DeletionQueue.hpp>
+#include <core/DescriptorAllocator.hpp>
+#include <core/DynamicResolution.hpp>
+#include <core/FrameArena.hpp>
+#include <core/FrameScheduler.hpp>
+#include <core/GpuDefragmenter.hpp>
+#include <core/GpuProfiler.hpp>
+#include <core/OcclusionCuller.hpp>
+#include <core/OffscreenTarget.hpp>
+#include <core/ParticleSystem.hpp>
+#include <core/FrameStats.hpp>
+#include <core/PerformanceOverlay.hpp>
 #include <core/PipelineManager.hpp>
+#include <core/RenderGraph.hpp>
 #include <core/ResourceManager.hpp>
 #include <core/ShaderManager.hpp>
+#include <core/ShadowCascades.hpp>
 #include <core/SwapchainManager.hpp>
+#include <core/TextureManager.hpp>
 #include <core/VmaWrapper.hpp>
 #include <core/WindowManager.hpp>
 #include <core/logicalDevice.hpp>
 #include <core/physicalDevice.hpp>
 #include <core/queueManager.hpp>
 #include <core/Mesh.hpp>
+#include <core/MemoryMonitor.hpp>
 #include <core/ModelLoader.hpp>
 
+// Opções escolhidas na inicialização (linha de comando)
+struct RendererOptions {
+	PresentPolicy presentPolicy    = PresentPolicy::Throughput;
+	bool          dynamicRendering = true;        // Usa vkCmdBeginRendering quando o device suporta (senão, render pass)
+	uint32_t      framesInFlight   = 2;           // Frames enfileirados na GPU, de 1 a FrameScheduler::MAX_FRAMES_IN_FLIGHT
+
+	// Headless: sem janela, surface nem swapchain; renderiza frameCount frames num OffscreenTarget
+	// (exige dynamic rendering) e, se readbackPath não estiver vazio, grava o último frame em PNG
+	bool        headless   = false;
+	uint32_t    frameCount = 300;
+	std::string readbackPath;
+
+	// Benchmark: warmupFrames de aquecimento + frameCount frames medidos; grava p50/p95/p99/max
+	// dos tempos de CPU, GPU e frame em benchmarkOutput. Funciona com janela ou headless.
+	bool           benchmark       = false;
+	uint32_t       warmupFrames    = 60;
+	std::string    benchmarkOutput = "benchmark.json";
+	BenchmarkScene scene           = BenchmarkScene::Car;
+
+	// Passo do tempo simulado por frame no headless/benchmark (o modo interativo usa o relógio)
+	double timeStep = 1.0 / 60.0;
+
+	// Se não estiver vazio, as zonas de CPU (PROFILE_CPU_ZONE) são gravadas nesse JSON ao sair do run()
+	std::string tracePath;
+
+	// Se não estiver vazio, o histórico de FrameStats é gravado nesse CSV ao sair do run()
+	std::string frameStatsPath;
+
+	// Se não estiver vazio, o relatório de memória (JSON) é gravado nesse arquivo no cleanup,
+	// depois de liberados os recursos (o que sobrar vivo é leak)
+	std::string memoryReportPath;
+
+	// > 0: a cena é renderizada numa resolução que se ajusta para caber nesse tempo de GPU por
+	// frame e ampliada para a saída (exige render graph e timestamps)
+	double gpuBudgetMs = 0.0;
+
+	// Atribuição de luzes aos clusters numa fila de compute própria, em paralelo com sombras e depth
+	// (só com render graph e uma segunda fila que aceite compute)
+	bool asyncCompute = true;
+};
+
 // Coordena a criação da instância Vulkan, ciclo da janela e liberação dos recursos.
 class VulkanManager {
   public:
-	VulkanManager(int width, int height, const char *title);
+	VulkanManager(int width, int height, const char *title, const RendererOptions &options = {});
 	~VulkanManager();  
 	void run();
 
+	// Escreve o relatório de memória (categorias, heaps, fragmentação) em JSON
+	void dumpMemoryReport(const std::string &path) const;
+
+	// Compacta o heap de geometria aos poucos (algumas cópias por frame)
+	void requestGeometryDefragmentation();
+
+	// Alocações da arena no último frame concluído (deve ficar estável; overflow > 0 = arena pequena)
+	const FrameArenaStats &getFrameArenaStats() const { return frameArenas->getLastFrameStats(); }
+
+	// Frames em voo (1-4) e modo de latência podem mudar em runtime; trocar o número drena a GPU
+	void                    setFramesInFlight(uint32_t count) { frameScheduler->setFramesInFlight(count); }
+	void                    setLatencyMode(LatencyMode mode) { frameScheduler->setLatencyMode(mode); }
+	const FramePacingStats &getFramePacingStats() const { return frameScheduler->getStats(); }
+
+	// Troca o present mode/número de imagens; o swapchain é recriado no fim do frame atual.
+	// LowLatency também põe o FrameScheduler em LatencyMode::LowLatency.
+	void                      setPresentPolicy(PresentPolicy policy);
+	PresentPolicy             getPresentPolicy() const { return presentPolicy; }
+	const PresentTimingStats &getPresentTimingStats() const;
+
+	// Zonas de CPU de todas as threads até agora, no formato do chrome://tracing (precisa de SPEED_RACER_CPU_TRACE)
+	bool dumpCpuTrace(const std::string &path) const { return CpuTracer::writeChromeTrace(path); }
+
+	// Contadores dos últimos frames (draws, binds, uploads, tempo de CPU por estágio)
+	const FrameStatsRecorder &getFrameStats() const { return frameStats; }
+	bool                      dumpFrameStats(const std::string &path) const { return frameStats.writeCsv(path); }
+
+	// Passes, barreiras e memória transiente do último frame compilado (zerado sem dynamic rendering)
+	RenderGraph::Stats getRenderGraphStats() const { return renderGraph ? renderGraph->getStats() : RenderGraph::Stats{}; }
+
+	// Luz direcional do sol (direção em que a luz viaja); girar além da tolerância refaz as cascatas em cache
+	void               setLightDirection(const glm::vec3 &direction) { lightDirection = glm::normalize(direction); }
+	const ShadowStats *getShadowStats() const { return shadowCascades ? &shadowCascades->getStats() : nullptr; }
+
+	// Overlay de desempenho (F1); não existe no modo headless
+	void setOverlayVisible(bool visible);
+
+	// Tempos de GPU por escopo (PROFILE_GPU_SCOPE), com framesInFlight de atraso; vazio sem suporte a timestamps
+	std::vector<GpuScopeStats> getGpuScopeStats() const;
+
   private:
-	WindowManager                     window;
+	std::unique_ptr<WindowManager>    window;        // nullptr no modo headless
 	VkInstance                        instance;
 	VkSurfaceKHR                      surface;
 	VkDebugUtilsMessengerEXT          debugMessenger;
@@ -40,24 +144,64 @@ class VulkanManager {
 	QueueManager                      queueManager;
 	LogicalDeviceCreator::DeviceQueue queues;
 	std::unique_ptr<SwapchainManager> swapchainManager;        // Mantém a posse exclusiva do swapchain, garantindo liberação automática na destruição.
-	VkRenderPass                      renderPass;
-	VkPipelineLayout                  graphicsPipelineLayout;
-	VkPipeline                        graphicsPipeline;
+	VkRenderPass                      renderPass             = VK_NULL_HANDLE;        // Só no fallback sem dynamic rendering
+	VkPipelineLayout                  graphicsPipelineLayout = VK_NULL_HANDLE;
+	VkPipeline                        graphicsPipeline       = VK_NULL_HANDLE;
+	VkPipelineLayout                  shadowPipelineLayout   = VK_NULL_HANDLE;        // Só depth, sem fragment shader
+	VkPipeline                        shadowPipeline         = VK_NULL_HANDLE;
 	std::unique_ptr<CommandManager>   commandManager;
 	std::vector<VkCommandBuffer>      commandBuffers;
+	std::unique_ptr<FrameScheduler>   frameScheduler;        // Timeline semaphore + semáforos de acquire/present por slot
+	std::unique_ptr<AsyncCompute>     asyncCompute;          // nullptr: o compute do frame fica na fila gráfica
+	DeletionQueue                     deletionQueue;         // Objetos que a GPU ainda pode estar usando (swapchain antigo...)
+
+	// Recursos por frame são alocados para a capacidade máxima; o FrameScheduler decide quantos estão ativos
+	static constexpr uint32_t MAX_FRAMES_IN_FLIGHT = FrameScheduler::MAX_FRAMES_IN_FLIGHT;
 
-	std::vector<VkSemaphore> imageAvailableSemaphores;
-	std::vector<VkSemaphore> renderFinishedSemaphores;
-	std::vector<VkFence>     inFlightFences;
+	uint32_t currentFrame                 = 0;        // Slot do frame atual (vem do FrameScheduler)
+	uint32_t frameNumber                  = 0;        // Contador monotônico de frames (não volta a zero como currentFrame)
+	bool     framebufferResized           = false;
+	bool     presentPolicyChanged         = false;        // Recria o swapchain depois do próximo present
+	bool     memoryBudgetEnabled          = false;
+	bool     textureCompressionBCEnabled  = false;
+	bool     dynamicRenderingEnabled      = false;
+	bool     firstInstanceIndirectEnabled = false;        // firstInstance != 0 em draws indiretos (occlusion culling)
+	bool     multiDrawIndirectEnabled     = false;        // drawCount > 1 no vkCmdDrawIndexedIndirect
+	VkFormat depthFormat                  = VK_FORMAT_UNDEFINED;        // Depth transiente do render graph
 
-	const int MAX_FRAMES_IN_FLIGHT = 2;
-	uint32_t  currentFrame         = 0;
-	bool      framebufferResized   = false;
+	RendererOptions options;
+	PresentPolicy   presentPolicy;
+	VkExtent2D      requestedExtent;        // Tamanho pedido no construtor (alvo offscreen no headless)
 
 	VmaWrapper vmaWrapper;
 
-	std::unique_ptr<ResourceManager> resourceManager;
-	std::unique_ptr<BufferManager>   bufferManager;
+	std::unique_ptr<ResourceManager>           resourceManager;
+	std::unique_ptr<BufferManager>             bufferManager;
+	std::unique_ptr<MemoryMonitor>             memoryMonitor;
+	std::unique_ptr<GpuDefragmenter>           defragmenter;
+	std::unique_ptr<FrameArenas>               frameArenas;        // Memória temporária de CPU, uma arena por frame em voo
+	std::unique_ptr<TextureManager>            textureManager;
+	std::unique_ptr<BindlessDescriptors>       bindlessDescriptors;        // Set global (texturas + storage buffers), set 0 de todo pipeline
+	std::unique_ptr<DescriptorLayoutCache>     descriptorLayoutCache;
+	std::unique_ptr<OffscreenTarget>           offscreenTarget;        // Só no modo headless
+	std::unique_ptr<GpuProfiler>               gpuProfiler;            // nullptr se a fila não tem timestamps
+	std::unique_ptr<PerformanceOverlay>        overlay;                // Só com janela
+	std::unique_ptr<RenderGraph>               renderGraph;            // Só com dynamic rendering (senão, render pass fixo)
+	std::unique_ptr<ShadowCascades>            shadowCascades;         // Só com render graph
+	std::unique_ptr<ClusteredLighting>         clusteredLighting;      // Só com render graph (o compute entra como pass ou na fila assíncrona)
+	std::unique_ptr<OcclusionCuller>           occlusionCuller;        // Só com render graph e firstInstance em draws indiretos
+	std::unique_ptr<DynamicResolution>         dynamicResolution;      // Só com gpuBudgetMs, render graph, timestamps e blit na saída
+	std::unique_ptr<ParticleSystem>            particleSystem;         // Só com render graph (compute + draw indireto)
+	std::unique_ptr<FrameDescriptorAllocators> frameDescriptors;        // Sets transitórios, pools resetados quando o frame sai de voo
+
+	// Dados por objeto, um buffer por frame em voo (a GPU pode estar lendo o do frame anterior)
+	static constexpr uint32_t MAX_OBJECTS = 4096;
+	std::vector<BufferHandle> objectBuffers;
+	std::vector<uint32_t>     objectBufferIndices;        // Slot de cada um no set bindless
+	std::vector<BufferHandle> sceneBuffers;               // GpuSceneData (luz, cascatas), também um por frame em voo
+	std::vector<uint32_t>     sceneBufferIndices;
+
+	TextureHandle colormapTexture = INVALID_HANDLE;
 
 	void initVulkan();
 	void mainLoop();
@@ -72,11 +216,44 @@ class VulkanManager {
 	void createCommandPool();
 	void createCommandBuffers();
 	void recordCommandBuffer(VkCommandBuffer commandBuffer, uint32_t imageIndex);
+	void recordFrameGraph(VkCommandBuffer commandBuffer, uint32_t imageIndex);
+	void recordMainPass(VkCommandBuffer commandBuffer, uint32_t imageIndex);
+	void recordScene(VkCommandBuffer commandBuffer, std::optional<OcclusionCuller::Phase> phase = std::nullopt);
+	void recordShadowCascade(VkCommandBuffer commandBuffer, uint32_t cascade);
+	void drawObjects(VkCommandBuffer commandBuffer, size_t count);
+	void drawCulled(VkCommandBuffer commandBuffer, OcclusionCuller::Phase phase);
+	void updateSceneData();
+	void beginFrame();
 	void drawFrame();
+	void drawOffscreenFrame();
+	void runFixedFrames();
+	void createOffscreenTarget();
+	void createGpuProfiler();
+	void createOverlay();
+	void createRenderGraph();
+	void createShadowCascades();
+	void createClusteredLighting();
+	void createOcclusionCuller();
+	void createDynamicResolution();
+	void createParticleSystem();
+	void buildScene();
+
+	VkExtent2D getOutputExtent() const;        // Swapchain ou alvo offscreen
+	VkExtent2D getRenderExtent() const;        // Área da cena: a saída inteira ou a escala da resolução dinâmica
+
 	void createSyncObjects();
+	void createAsyncCompute();
+	void submitAsyncCompute();
+	void createFrameArenas();
 	void setupVmaWrapper();
 	void createResourceManager();
 	void createBufferManager();
+	void createMemoryMonitor();
+	void createDefragmenter();
+	void createTextureManager();
+	void createBindlessDescriptors();
+	void createDescriptorAllocators();
+	void createObjectBuffers();
 
 	// // TESTES DE MESH E RENDERING
 	// std::unique_ptr<Mesh> cubeMesh;
@@ -85,6 +262,57 @@ class VulkanManager {
 	// void createTriangle();
 
 	std::vector<Mesh> carMeshes;  //
+	std::vector<Mesh> propMeshes;        // Chão e barreiras da pista (geometria estática)
+
+	// Objeto da cena: um slot no buffer de objetos (o índice no vetor é o gl_InstanceIndex)
+	struct SceneObject {
+		const Mesh   *mesh;
+		glm::mat4     transform;        // Estáticos: a model inteira; carros: posição e escala (o giro é por frame)
+		TextureHandle texture;
+		bool          dynamic;
+	};
+
+	// Cena (options.scene): posição de cada cópia do carro e câmera que enquadra todas.
+	// sceneObjects tem os estáticos primeiro: as cascatas em cache desenham só [0, staticObjectCount).
+	std::vector<glm::vec3>   carInstances;
+	std::vector<SceneObject> sceneObjects;
+
+	// Luz pontual da cena: gira em torno de pivot (eixo Y) a angularSpeed rad/s.
+	// Lâmpadas da pista ficam paradas; faróis giram com o carro; as do teste de estresse rodam a pista.
+	struct SceneLight {
+		glm::vec3 pivot;
+		glm::vec3 offset;
+		float     angularSpeed;
+		glm::vec3 color;
+		float     radius;
+		float     intensity;
+	};
+	std::vector<SceneLight> sceneLights;
+
+	// Draws indiretos do occlusion culling, agrupados por mesh: drawOrder[slot] é o objeto de cada
+	// comando e cada lote é uma faixa contígua de comandos que usa a mesma geometria.
+	struct DrawBatch {
+		const Mesh *mesh;
+		uint32_t    firstDraw;
+		uint32_t    drawCount;
+	};
+	std::vector<DrawBatch> drawBatches;
+	std::vector<uint32_t>  drawOrder;
+	size_t                   staticObjectCount = 0;
+	float                    sceneRadius       = 10.0f;        // Raio do chão (profundidade dos oclusores das sombras)
+	float                    groundHeight      = 0.0f;         // Y do chão (base dos carros)
+	glm::vec3                carBoundsMin      = glm::vec3(0.0f);        // AABB local do carro na escala da cena (rodas dos emissores)
+	glm::vec3                carBoundsMax      = glm::vec3(0.0f);
+	glm::vec3                cameraEye         = glm::vec3(0.0f, 2.0f, 4.0f);
+	float                    cameraFar         = 10.0f;
+	double                   simulationTime    = 0.0;        // Segundos de animação (passo fixo no headless/benchmark)
+	glm::vec3                lightDirection    = glm::normalize(glm::vec3(-0.4f, -1.0f, -0.3f));
+	float                    sunIntensity      = 1.0f;
+	float                    ambientLight      = 0.25f;
+	glm::mat4                frameViewProj     = glm::mat4(1.0f);        // Câmera do frame sendo gravado
+
+	FrameStatsRecorder frameStats;
+	uint64_t           lastUploadedTotal = 0;        // Bytes de staging já contados em algum frame
 
 	void loadCarModel();
 
@@ -19,6 +19,10 @@ namespace VulkanTools { // Habilita validation layers apenas em modo debug
         const bool enableValidationLayers = true;
     #endif
     
+    // Versão da API pedida pela instância (1.2: descriptor indexing, usado pelo set bindless;
+    // 1.3: dynamic rendering, opcional). Devices 1.2 continuam funcionando com o render pass clássico.
+    constexpr uint32_t apiVersion = VK_API_VERSION_1_3;
+
     // std::vector<const char *> deviceExtensions = {VK_KHR_SWAPCHAIN_EXTENSION_NAME};
 
     // Lista de validation layers
@@ -27,8 +31,11 @@ namespace VulkanTools { // Habilita validation layers apenas em modo debug
     // Verifica suporte para validation layers
     bool checkValidationLayerSupport();
 
-    // Obtém extensões necessárias
-    std::vector<const char*> getRequiredExtensions();
+    // Obtém extensões necessárias (sem janela, nenhuma extensão de surface do GLFW)
+    std::vector<const char*> getRequiredExtensions(bool windowSystem = true);
+
+    // Verifica se o device expõe uma extensão (usado para extensões opcionais)
+    bool isDeviceExtensionSupported(VkPhysicalDevice physicalDevice, const char* extensionName);
 
 // Callback para mensagens de validação do Vulkan
     VKAPI_ATTR VkBool32 VKAPI_CALL debugCallback(
@@ -11,13 +11,17 @@ class LogicalDeviceCreator {
       struct DeviceQueue {
          VkQueue graphicsQueue;
          VkQueue presentQueue;
+         VkQueue computeQueue;        // Fila de compute separada da gráfica (VK_NULL_HANDLE se não houver)
+         uint32_t computeFamily;
       };
       static std::pair<VkDevice, DeviceQueue> create(
         VkPhysicalDevice physicalDevice,
         QueueManager& queueManager,
         bool enableValidationLayers,
         const std::vector<const char*>& validationLayers,
-        const std::vector<const char*>& deviceExtensions
+        const std::vector<const char*>& deviceExtensions,
+        const VkPhysicalDeviceFeatures& enabledFeatures = {},
+        const void* featureChain = nullptr // pNext com VkPhysicalDeviceVulkan12Features etc.
     );
 };
 
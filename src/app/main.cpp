@@ -1,14 +1,89 @@
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
 #include <iostream>
 #include <stdexcept>
 
+#include <core/Logger.hpp>
 #include <core/VulkanManager.hpp>
 
-int main() {
+int main(int argc, char **argv) {
+	// --present throughput|low-latency|vsync|immediate
+	// --frames-in-flight N : frames enfileirados na GPU (1-4; padrão 2)
+	// --render-pass : força o render pass clássico mesmo com dynamic rendering disponível
+	// --headless : sem janela, renderiza offscreen (CI / lavapipe)
+	// --frames N : frames renderizados no modo headless
+	// --readback arquivo.png : grava o último frame headless
+	// --benchmark [relatorio.json] : aquecimento + frames medidos com passo fixo, relatório de percentis
+	// --warmup N : frames de aquecimento do benchmark
+	// --scene car|car-grid|night-lights
+	// --trace arquivo.json : grava as zonas de CPU no formato do chrome://tracing ao sair
+	// --frame-stats arquivo.csv : grava os contadores dos últimos frames ao sair
+	// --memory-report arquivo.json : grava o relatório de memória ao sair (recursos que sobraram vivos)
+	// --gpu-budget ms : resolução dinâmica da cena para caber nesse tempo de GPU por frame
+	// --no-async-compute : atribuição de luzes na fila gráfica, mesmo com fila de compute disponível
+	RendererOptions options;
+	for (int i = 1; i < argc; i++) {
+		if (std::strcmp(argv[i], "--present") == 0 && i + 1 < argc) {
+			if (!SwapchainManager::parsePresentPolicy(argv[++i], options.presentPolicy)) {
+				std::cerr << "[Main] : Unknown present policy '" << argv[i] << "'" << std::endl;
+				return 1;
+			}
+		}
+		else if (std::strcmp(argv[i], "--render-pass") == 0) {
+			options.dynamicRendering = false;
+		}
+		else if (std::strcmp(argv[i], "--frames-in-flight") == 0 && i + 1 < argc) {
+			unsigned long count    = std::strtoul(argv[++i], nullptr, 10);
+			options.framesInFlight = static_cast<uint32_t>(std::clamp<unsigned long>(count, 1, FrameScheduler::MAX_FRAMES_IN_FLIGHT));
+		}
+		else if (std::strcmp(argv[i], "--headless") == 0) {
+			options.headless = true;
+		}
+		else if (std::strcmp(argv[i], "--frames") == 0 && i + 1 < argc) {
+			options.frameCount = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+		}
+		else if (std::strcmp(argv[i], "--readback") == 0 && i + 1 < argc) {
+			options.readbackPath = argv[++i];
+		}
+		else if (std::strcmp(argv[i], "--benchmark") == 0) {
+			options.benchmark = true;
+			if (i + 1 < argc && argv[i + 1][0] != '-') {
+				options.benchmarkOutput = argv[++i];
+			}
+		}
+		else if (std::strcmp(argv[i], "--warmup") == 0 && i + 1 < argc) {
+			options.warmupFrames = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+		}
+		else if (std::strcmp(argv[i], "--trace") == 0 && i + 1 < argc) {
+			options.tracePath = argv[++i];
+		}
+		else if (std::strcmp(argv[i], "--frame-stats") == 0 && i + 1 < argc) {
+			options.frameStatsPath = argv[++i];
+		}
+		else if (std::strcmp(argv[i], "--memory-report") == 0 && i + 1 < argc) {
+			options.memoryReportPath = argv[++i];
+		}
+		else if (std::strcmp(argv[i], "--gpu-budget") == 0 && i + 1 < argc) {
+			options.gpuBudgetMs = std::strtod(argv[++i], nullptr);
+		}
+		else if (std::strcmp(argv[i], "--no-async-compute") == 0) {
+			options.asyncCompute = false;
+		}
+		else if (std::strcmp(argv[i], "--scene") == 0 && i + 1 < argc) {
+			if (!parseBenchmarkScene(argv[++i], options.scene)) {
+				std::cerr << "[Main] : Unknown scene '" << argv[i] << "'" << std::endl;
+				return 1;
+			}
+		}
+	}
+
 	try {
-		VulkanManager vulkanManager(1280, 720, "Speed Racer");
+		VulkanManager vulkanManager(1280, 720, "Speed Racer", options);
 		vulkanManager.run();
 	}
 	catch (const std::exception &e) {
+		Logger::flush();        // O log assíncrono pendente sai antes do erro
 		std::cerr << "[Main] : Error: " << e.what() << std::endl;
 		return 1;
 	}
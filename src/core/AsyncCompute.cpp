@@ -0,0 +1,107 @@
+#include <core/AsyncCompute.hpp>
+#include <core/Logger.hpp>
+
+#include <stdexcept>
+
+AsyncCompute::AsyncCompute(VkDevice device, VkQueue queue, uint32_t queueFamily, uint32_t frameSlots) :
+    device(device),
+    queue(queue),
+    queueFamily(queueFamily) {
+	if (queue == VK_NULL_HANDLE || frameSlots == 0) {
+		throw std::runtime_error("[AsyncCompute] : Invalid compute queue!");
+	}
+
+	VkCommandPoolCreateInfo poolInfo{};
+	poolInfo.sType            = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
+	poolInfo.flags            = VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT;
+	poolInfo.queueFamilyIndex = queueFamily;
+
+	if (vkCreateCommandPool(device, &poolInfo, nullptr, &commandPool) != VK_SUCCESS) {
+		throw std::runtime_error("[AsyncCompute] : Failed to create command pool!");
+	}
+
+	commandBuffers.resize(frameSlots);
+	VkCommandBufferAllocateInfo allocInfo{};
+	allocInfo.sType              = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+	allocInfo.commandPool        = commandPool;
+	allocInfo.level              = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+	allocInfo.commandBufferCount = frameSlots;
+
+	if (vkAllocateCommandBuffers(device, &allocInfo, commandBuffers.data()) != VK_SUCCESS) {
+		throw std::runtime_error("[AsyncCompute] : Failed to allocate command buffers!");
+	}
+
+	VkSemaphoreTypeCreateInfo typeInfo{};
+	typeInfo.sType         = VK_STRUCTURE_TYPE_SEMAPHORE_TYPE_CREATE_INFO;
+	typeInfo.semaphoreType = VK_SEMAPHORE_TYPE_TIMELINE;
+	typeInfo.initialValue  = 0;
+
+	VkSemaphoreCreateInfo semaphoreInfo{};
+	semaphoreInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
+	semaphoreInfo.pNext = &typeInfo;
+
+	if (vkCreateSemaphore(device, &semaphoreInfo, nullptr, &timeline) != VK_SUCCESS) {
+		throw std::runtime_error("[AsyncCompute] : Failed to create timeline semaphore!");
+	}
+
+	LOG_INFO("AsyncCompute", "Created on queue family {} ({} command buffers).", queueFamily, frameSlots);
+}
+
+AsyncCompute::~AsyncCompute() {
+	if (timeline != VK_NULL_HANDLE) {
+		vkDestroySemaphore(device, timeline, nullptr);
+	}
+	if (commandPool != VK_NULL_HANDLE) {
+		vkDestroyCommandPool(device, commandPool, nullptr);
+	}
+}
+
+VkCommandBuffer AsyncCompute::begin(uint32_t slot) {
+	if (slot >= commandBuffers.size()) {
+		throw std::runtime_error("[AsyncCompute] : Frame slot out of range!");
+	}
+
+	recording = commandBuffers[slot];
+	vkResetCommandBuffer(recording, 0);
+
+	VkCommandBufferBeginInfo beginInfo{};
+	beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+	beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+
+	if (vkBeginCommandBuffer(recording, &beginInfo) != VK_SUCCESS) {
+		throw std::runtime_error("[AsyncCompute] : Failed to begin command buffer!");
+	}
+	return recording;
+}
+
+uint64_t AsyncCompute::submit() {
+	if (recording == VK_NULL_HANDLE) {
+		throw std::runtime_error("[AsyncCompute] : Nothing recorded to submit!");
+	}
+	if (vkEndCommandBuffer(recording) != VK_SUCCESS) {
+		throw std::runtime_error("[AsyncCompute] : Failed to record command buffer!");
+	}
+
+	uint64_t signalValue = submittedValue + 1;
+
+	VkTimelineSemaphoreSubmitInfo timelineInfo{};
+	timelineInfo.sType                     = VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO;
+	timelineInfo.signalSemaphoreValueCount = 1;
+	timelineInfo.pSignalSemaphoreValues    = &signalValue;
+
+	VkSubmitInfo submitInfo{};
+	submitInfo.sType                = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+	submitInfo.pNext                = &timelineInfo;
+	submitInfo.commandBufferCount   = 1;
+	submitInfo.pCommandBuffers      = &recording;
+	submitInfo.signalSemaphoreCount = 1;
+	submitInfo.pSignalSemaphores    = &timeline;
+
+	if (vkQueueSubmit(queue, 1, &submitInfo, VK_NULL_HANDLE) != VK_SUCCESS) {
+		throw std::runtime_error("[AsyncCompute] : Failed to submit compute work!");
+	}
+
+	submittedValue = signalValue;
+	recording      = VK_NULL_HANDLE;
+	return submittedValue;
+}
@@ -0,0 +1,113 @@
+#include <core/Benchmark.hpp>
+#include <core/Logger.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <numeric>
+#include <sstream>
+
+bool parseBenchmarkScene(const std::string &name, BenchmarkScene &scene) {
+	if (name == "car") {
+		scene = BenchmarkScene::Car;
+	}
+	else if (name == "car-grid") {
+		scene = BenchmarkScene::CarGrid;
+	}
+	else if (name == "night-lights") {
+		scene = BenchmarkScene::NightLights;
+	}
+	else {
+		return false;
+	}
+	return true;
+}
+
+const char *toString(BenchmarkScene scene) {
+	switch (scene) {
+		case BenchmarkScene::Car:
+			return "car";
+		case BenchmarkScene::CarGrid:
+			return "car-grid";
+		case BenchmarkScene::NightLights:
+			return "night-lights";
+	}
+	return "unknown";
+}
+
+void BenchmarkReport::addFrame(double frameMs, double cpuMs) {
+	this->frameMs.push_back(frameMs);
+	this->cpuMs.push_back(cpuMs);
+}
+
+void BenchmarkReport::addGpuFrame(double gpuMs) {
+	this->gpuMs.push_back(gpuMs);
+}
+
+FrameTimeSummary BenchmarkReport::summarize(std::vector<double> samples) {
+	FrameTimeSummary summary;
+	if (samples.empty()) {
+		return summary;
+	}
+	std::sort(samples.begin(), samples.end());
+
+	// Nearest-rank: o menor valor com pelo menos p% das amostras <= ele
+	auto percentile = [&samples](double p) {
+		size_t rank = static_cast<size_t>(std::ceil(p / 100.0 * static_cast<double>(samples.size())));
+		return samples[std::clamp<size_t>(rank, 1, samples.size()) - 1];
+	};
+
+	summary.count = samples.size();
+	summary.mean  = std::accumulate(samples.begin(), samples.end(), 0.0) / static_cast<double>(samples.size());
+	summary.min   = samples.front();
+	summary.p50   = percentile(50.0);
+	summary.p95   = percentile(95.0);
+	summary.p99   = percentile(99.0);
+	summary.max   = samples.back();
+	return summary;
+}
+
+namespace {
+	void writeSummary(std::ostringstream &json, const char *name, const std::vector<double> &samples, bool last) {
+		json << "  \"" << name << "\": ";
+		if (samples.empty()) {
+			json << "null";
+		}
+		else {
+			FrameTimeSummary s = BenchmarkReport::summarize(samples);
+			json << "{\"count\": " << s.count << ", \"meanMs\": " << s.mean << ", \"minMs\": " << s.min
+			     << ", \"p50Ms\": " << s.p50 << ", \"p95Ms\": " << s.p95 << ", \"p99Ms\": " << s.p99
+			     << ", \"maxMs\": " << s.max << "}";
+		}
+		json << (last ? "\n" : ",\n");
+	}
+}        // namespace
+
+std::string BenchmarkReport::toJson(const BenchmarkInfo &info) const {
+	std::ostringstream json;
+	json << "{\n";
+	json << "  \"scene\": \"" << info.scene << "\",\n";
+	json << "  \"device\": \"" << info.device << "\",\n";
+	json << "  \"resolution\": [" << info.width << ", " << info.height << "],\n";
+	json << "  \"headless\": " << (info.headless ? "true" : "false") << ",\n";
+	json << "  \"presentPolicy\": \"" << info.presentPolicy << "\",\n";
+	json << "  \"warmupFrames\": " << info.warmupFrames << ",\n";
+	json << "  \"frames\": " << cpuMs.size() << ",\n";
+	json << "  \"timeStepMs\": " << info.timeStepMs << ",\n";
+	writeSummary(json, "frame", frameMs, false);
+	writeSummary(json, "cpu", cpuMs, false);
+	writeSummary(json, "gpu", gpuMs, true);
+	json << "}\n";
+	return json.str();
+}
+
+bool BenchmarkReport::writeJson(const std::string &path, const BenchmarkInfo &info) const {
+	std::ofstream file(path);
+	if (!file) {
+		LOG_ERROR("BenchmarkReport", "Failed to open {}", path);
+		return false;
+	}
+	file << toJson(info);
+	LOG_INFO("BenchmarkReport", "Report written to {}", path);
+	return true;
+}
@@ -0,0 +1,207 @@
+#include <core/BindlessDescriptors.hpp>
+#include <core/Logger.hpp>
+
+#include <algorithm>
+#include <array>
+#include <stdexcept>
+
+uint32_t BindlessDescriptors::SlotAllocator::allocate() {
+	if (!freeList.empty()) {
+		uint32_t index = freeList.back();
+		freeList.pop_back();
+		return index;
+	}
+	if (highWater >= capacity) {
+		throw std::runtime_error("[BindlessDescriptors] : Descriptor array is full!");
+	}
+	return highWater++;
+}
+
+void BindlessDescriptors::SlotAllocator::free(uint32_t index) {
+	if (index < highWater) {
+		freeList.push_back(index);
+	}
+}
+
+bool BindlessDescriptors::isSupported(VkPhysicalDevice physicalDevice) {
+	VkPhysicalDeviceProperties properties;
+	vkGetPhysicalDeviceProperties(physicalDevice, &properties);
+	if (properties.apiVersion < VK_API_VERSION_1_2) {
+		return false;
+	}
+
+	VkPhysicalDeviceVulkan12Features features12{};
+	features12.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_FEATURES;
+	VkPhysicalDeviceFeatures2 features{};
+	features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2;
+	features.pNext = &features12;
+	vkGetPhysicalDeviceFeatures2(physicalDevice, &features);
+
+	return features12.descriptorIndexing &&
+	       features12.runtimeDescriptorArray &&
+	       features12.descriptorBindingPartiallyBound &&
+	       features12.descriptorBindingSampledImageUpdateAfterBind &&
+	       features12.descriptorBindingStorageBufferUpdateAfterBind &&
+	       features12.descriptorBindingUpdateUnusedWhilePending &&
+	       features12.shaderSampledImageArrayNonUniformIndexing;
+}
+
+BindlessDescriptors::BindlessDescriptors(VkDevice device, VkPhysicalDevice physicalDevice, DescriptorLayoutCache &layoutCache, uint32_t maxTextures, uint32_t maxStorageBuffers) :
+    device(device) {
+	// Respeita os limites de update-after-bind do device
+	VkPhysicalDeviceVulkan12Properties properties12{};
+	properties12.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_PROPERTIES;
+	VkPhysicalDeviceProperties2 properties{};
+	properties.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PROPERTIES_2;
+	properties.pNext = &properties12;
+	vkGetPhysicalDeviceProperties2(physicalDevice, &properties);
+
+	textureSlots.capacity = std::min({maxTextures,
+	                                  properties12.maxDescriptorSetUpdateAfterBindSampledImages,
+	                                  properties12.maxPerStageDescriptorUpdateAfterBindSampledImages});
+	bufferSlots.capacity  = std::min({maxStorageBuffers,
+	                                  properties12.maxDescriptorSetUpdateAfterBindStorageBuffers,
+	                                  properties12.maxPerStageDescriptorUpdateAfterBindStorageBuffers});
+
+	// ---- Layout ----
+	std::array<VkDescriptorSetLayoutBinding, 3> bindings{};
+	bindings[0].binding         = TEXTURE_BINDING;
+	bindings[0].descriptorType  = VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE;
+	bindings[0].descriptorCount = textureSlots.capacity;
+	bindings[0].stageFlags      = VK_SHADER_STAGE_ALL;
+
+	bindings[1].binding         = SAMPLER_BINDING;
+	bindings[1].descriptorType  = VK_DESCRIPTOR_TYPE_SAMPLER;
+	bindings[1].descriptorCount = 1;
+	bindings[1].stageFlags      = VK_SHADER_STAGE_ALL;
+
+	bindings[2].binding         = STORAGE_BUFFER_BINDING;
+	bindings[2].descriptorType  = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+	bindings[2].descriptorCount = bufferSlots.capacity;
+	bindings[2].stageFlags      = VK_SHADER_STAGE_ALL;
+
+	const VkDescriptorBindingFlags arrayFlags = VK_DESCRIPTOR_BINDING_PARTIALLY_BOUND_BIT |
+	                                            VK_DESCRIPTOR_BINDING_UPDATE_AFTER_BIND_BIT |
+	                                            VK_DESCRIPTOR_BINDING_UPDATE_UNUSED_WHILE_PENDING_BIT;
+	// O sampler é escrito uma vez só, antes do primeiro frame
+	std::array<VkDescriptorBindingFlags, 3> bindingFlags = {arrayFlags, 0, arrayFlags};
+
+	VkDescriptorSetLayoutBindingFlagsCreateInfo bindingFlagsInfo{};
+	bindingFlagsInfo.sType         = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_BINDING_FLAGS_CREATE_INFO;
+	bindingFlagsInfo.bindingCount  = static_cast<uint32_t>(bindingFlags.size());
+	bindingFlagsInfo.pBindingFlags = bindingFlags.data();
+
+	VkDescriptorSetLayoutCreateInfo layoutInfo{};
+	layoutInfo.sType        = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+	layoutInfo.pNext        = &bindingFlagsInfo;
+	layoutInfo.flags        = VK_DESCRIPTOR_SET_LAYOUT_CREATE_UPDATE_AFTER_BIND_POOL_BIT;
+	layoutInfo.bindingCount = static_cast<uint32_t>(bindings.size());
+	layoutInfo.pBindings    = bindings.data();
+
+	layout = layoutCache.getLayout(layoutInfo);
+
+	// ---- Pool + set (um só, vive a aplicação inteira) ----
+	std::array<VkDescriptorPoolSize, 3> poolSizes = {{
+	    {VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE, textureSlots.capacity},
+	    {VK_DESCRIPTOR_TYPE_SAMPLER, 1},
+	    {VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, bufferSlots.capacity},
+	}};
+
+	VkDescriptorPoolCreateInfo poolInfo{};
+	poolInfo.sType         = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+	poolInfo.flags         = VK_DESCRIPTOR_POOL_CREATE_UPDATE_AFTER_BIND_BIT;
+	poolInfo.maxSets       = 1;
+	poolInfo.poolSizeCount = static_cast<uint32_t>(poolSizes.size());
+	poolInfo.pPoolSizes    = poolSizes.data();
+
+	if (vkCreateDescriptorPool(device, &poolInfo, nullptr, &pool) != VK_SUCCESS) {
+		throw std::runtime_error("[BindlessDescriptors] : Failed to create descriptor pool!");
+	}
+
+	VkDescriptorSetAllocateInfo allocInfo{};
+	allocInfo.sType              = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+	allocInfo.descriptorPool     = pool;
+	allocInfo.descriptorSetCount = 1;
+	allocInfo.pSetLayouts        = &layout;
+
+	if (vkAllocateDescriptorSets(device, &allocInfo, &set) != VK_SUCCESS) {
+		throw std::runtime_error("[BindlessDescriptors] : Failed to allocate descriptor set!");
+	}
+
+	LOG_INFO("BindlessDescriptors", "Global set created ({} textures, {} storage buffers).", textureSlots.capacity, bufferSlots.capacity);
+}
+
+BindlessDescriptors::~BindlessDescriptors() {
+	// O set é liberado junto com o pool; o layout pertence ao DescriptorLayoutCache
+	if (pool != VK_NULL_HANDLE) {
+		vkDestroyDescriptorPool(device, pool, nullptr);
+	}
+}
+
+uint32_t BindlessDescriptors::registerTexture(VkImageView view) {
+	uint32_t index = textureSlots.allocate();
+
+	VkDescriptorImageInfo imageInfo{};
+	imageInfo.imageView   = view;
+	imageInfo.imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+
+	VkWriteDescriptorSet write{};
+	write.sType           = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+	write.dstSet          = set;
+	write.dstBinding      = TEXTURE_BINDING;
+	write.dstArrayElement = index;
+	write.descriptorCount = 1;
+	write.descriptorType  = VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE;
+	write.pImageInfo      = &imageInfo;
+	vkUpdateDescriptorSets(device, 1, &write, 0, nullptr);
+
+	return index;
+}
+
+void BindlessDescriptors::releaseTexture(uint32_t index) {
+	textureSlots.free(index);
+}
+
+uint32_t BindlessDescriptors::registerStorageBuffer(VkBuffer buffer, VkDeviceSize offset, VkDeviceSize range) {
+	uint32_t index = bufferSlots.allocate();
+
+	VkDescriptorBufferInfo bufferInfo{};
+	bufferInfo.buffer = buffer;
+	bufferInfo.offset = offset;
+	bufferInfo.range  = range;
+
+	VkWriteDescriptorSet write{};
+	write.sType           = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+	write.dstSet          = set;
+	write.dstBinding      = STORAGE_BUFFER_BINDING;
+	write.dstArrayElement = index;
+	write.descriptorCount = 1;
+	write.descriptorType  = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+	write.pBufferInfo     = &bufferInfo;
+	vkUpdateDescriptorSets(device, 1, &write, 0, nullptr);
+
+	return index;
+}
+
+void BindlessDescriptors::releaseStorageBuffer(uint32_t index) {
+	bufferSlots.free(index);
+}
+
+void BindlessDescriptors::setSampler(VkSampler sampler) {
+	VkDescriptorImageInfo samplerInfo{};
+	samplerInfo.sampler = sampler;
+
+	VkWriteDescriptorSet write{};
+	write.sType           = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+	write.dstSet          = set;
+	write.dstBinding      = SAMPLER_BINDING;
+	write.dstArrayElement = 0;
+	write.descriptorCount = 1;
+	write.descriptorType  = VK_DESCRIPTOR_TYPE_SAMPLER;
+	write.pImageInfo      = &samplerInfo;
+	vkUpdateDescriptorSets(device, 1, &write, 0, nullptr);
+}
+
+void BindlessDescriptors::bind(VkCommandBuffer cmd, VkPipelineLayout pipelineLayout, VkPipelineBindPoint bindPoint) const {
+	vkCmdBindDescriptorSets(cmd, bindPoint, pipelineLayout, 0, 1, &set, 0, nullptr);
+}
@@ -1,4 +1,5 @@
 #include "core/BufferManager.hpp"
+#include "core/CpuTracer.hpp"
 
 BufferManager::BufferManager(VkDevice         device,
                              VmaAllocator     allocator,
@@ -18,23 +19,35 @@ BufferHandle BufferManager::createStagingBuffer(size_t size) {
 	BufferHandle stagingBuffer = resources.createBuffer({// "Designated Initializers" (do C++20).
 	                                                     .size        = size,
 	                                                     .usage       = VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
-	                                                     .memoryUsage = VMA_MEMORY_USAGE_CPU_TO_GPU});
+	                                                     .memoryUsage = VMA_MEMORY_USAGE_CPU_TO_GPU,
+	                                                     .category    = ResourceCategory::Staging});
 
 	return stagingBuffer;
 }
 
+BufferHandle BufferManager::createReadbackBuffer(size_t size) {
+	return resources.createBuffer({.size        = size,
+	                               .usage       = VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+	                               .memoryUsage = VMA_MEMORY_USAGE_GPU_TO_CPU,
+	                               .category    = ResourceCategory::Staging});
+}
+
 BufferHandle BufferManager::createVertexBuffer(const void *data, size_t size) {
+	PROFILE_CPU_ZONE("BufferManager::createVertexBuffer");
 	BufferHandle stagingBuffer = createStagingBuffer(size);
 
 	updateBuffer(stagingBuffer, data, size);
 
+	// TRANSFER_SRC porque o GpuDefragmenter copia o conteúdo para a nova posição
 	BufferHandle vertexBuffer = resources.createBuffer(
 	    {// "Designated Initializers" (do C++20).
 	     .size        = size,
-	     .usage       = VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_VERTEX_BUFFER_BIT,
-	     .memoryUsage = VMA_MEMORY_USAGE_GPU_ONLY});
+	     .usage       = VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_VERTEX_BUFFER_BIT,
+	     .memoryUsage = VMA_MEMORY_USAGE_GPU_ONLY,
+	     .category    = ResourceCategory::Geometry});
 
 	copyBuffer(stagingBuffer, vertexBuffer, size);
+	uploadedBytes += size;
 
 	resources.destroyBuffer(stagingBuffer);
 
@@ -42,6 +55,7 @@ BufferHandle BufferManager::createVertexBuffer(const void *data, size_t size) {
 }
 
 BufferHandle BufferManager::createIndexBuffer(const void *data, size_t size) {
+	PROFILE_CPU_ZONE("BufferManager::createIndexBuffer");
 	// Cria o Staging
 	BufferHandle stagingBuffer = createStagingBuffer(size);
 
@@ -50,11 +64,13 @@ BufferHandle BufferManager::createIndexBuffer(const void *data, size_t size) {
 
 	// Cria o buffer final na GPU (Agora com a flag de INDEX BUFFER)
 	BufferHandle indexBuffer = resources.createBuffer({.size        = size,
-	                                                   .usage       = VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_INDEX_BUFFER_BIT,
-	                                                   .memoryUsage = VMA_MEMORY_USAGE_GPU_ONLY});
+	                                                   .usage       = VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_INDEX_BUFFER_BIT,
+	                                                   .memoryUsage = VMA_MEMORY_USAGE_GPU_ONLY,
+	                                                   .category    = ResourceCategory::Geometry});
 
 	// Move do Staging para o final
 	copyBuffer(stagingBuffer, indexBuffer, size);
+	uploadedBytes += size;
 
 	// Libera o Staging
 	resources.destroyBuffer(stagingBuffer);
@@ -65,11 +81,32 @@ BufferHandle BufferManager::createIndexBuffer(const void *data, size_t size) {
 BufferHandle BufferManager::createUniformBuffer(size_t size) {
 	BufferHandle uniformBuffer = resources.createBuffer({.size        = size,
 	                                                     .usage       = VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT,
-	                                                     .memoryUsage = VMA_MEMORY_USAGE_CPU_TO_GPU});
+	                                                     .memoryUsage = VMA_MEMORY_USAGE_CPU_TO_GPU,
+	                                                     .category    = ResourceCategory::Uniform});
 
 	return uniformBuffer;
 }
 
+BufferHandle BufferManager::createStorageBuffer(size_t size) {
+	BufferHandle storageBuffer = resources.createBuffer({.size          = size,
+	                                                     .usage         = VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
+	                                                     .memoryUsage   = VMA_MEMORY_USAGE_CPU_TO_GPU,
+	                                                     .category      = ResourceCategory::Uniform,
+	                                                     .queueFamilies = sharedQueueFamilies});
+
+	return storageBuffer;
+}
+
+BufferHandle BufferManager::createGpuStorageBuffer(size_t size, VkBufferUsageFlags extraUsage) {
+	BufferHandle storageBuffer = resources.createBuffer({.size          = size,
+	                                                     .usage         = VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | extraUsage,
+	                                                     .memoryUsage   = VMA_MEMORY_USAGE_GPU_ONLY,
+	                                                     .category      = ResourceCategory::Uniform,
+	                                                     .queueFamilies = sharedQueueFamilies});
+
+	return storageBuffer;
+}
+
 void BufferManager::copyBuffer(BufferHandle srcHandle, BufferHandle dstHandle, VkDeviceSize size, VkDeviceSize srcOffset, VkDeviceSize dstOffset) {
 	executeOneTimeCommands([&](VkCommandBuffer commandBuffer) {
 		// Aqui dentro nós gravamos os comandos de cópia
@@ -89,6 +126,7 @@ void BufferManager::copyBuffer(BufferHandle srcHandle, BufferHandle dstHandle, V
 }
 
 void BufferManager::executeOneTimeCommands(std::function<void(VkCommandBuffer)> cmdFunc) {
+	PROFILE_CPU_ZONE("BufferManager::executeOneTimeCommands");
 	// Alocar buffer temporario
 	VkCommandBuffer commandBuffer = commands.allocateCommandBuffers(1)[0];
 
@@ -142,6 +180,16 @@ void BufferManager::updateBuffer(BufferHandle buffer, const void *data, size_t s
 	unmapBuffer(buffer);
 }
 
+void BufferManager::readBuffer(BufferHandle handle, void *dst, size_t size) {
+	VmaBuffer buffer = resources.getBuffer(handle);
+	// Memória GPU_TO_CPU costuma ser cached e não coerente
+	vmaInvalidateAllocation(allocator, buffer.allocation, 0, size);
+
+	void *mappedData = mapBuffer(handle);
+	memcpy(dst, mappedData, size);
+	unmapBuffer(handle);
+}
+
 void BufferManager::destroyBuffer(BufferHandle& handle){ // Acredito que não precise passar por referencia, mas na minha cabeça faz mais sentido
 	if (handle != INVALID_HANDLE) {
 		resources.destroyBuffer(handle);
@@ -0,0 +1,109 @@
+#include <core/ClusteredLighting.hpp>
+#include <core/Logger.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <tuple>
+
+namespace {
+	// local_size_x de cluster.comp
+	constexpr uint32_t CLUSTERS_PER_GROUP = 64;
+}        // namespace
+
+ClusteredLighting::ClusteredLighting(VkDevice device, BufferManager &buffers, BindlessDescriptors &bindless, uint32_t framesInFlight,
+                                     const ClusterSettings &settings) :
+    device(device),
+    buffers(buffers),
+    bindless(bindless),
+    settings(settings) {
+	if (settings.tilesX == 0 || settings.tilesY == 0 || settings.slices == 0 || settings.maxLightsPerCluster == 0) {
+		throw std::runtime_error("[ClusteredLighting] : Cluster grid must not be empty!");
+	}
+
+	// Contagem de cada cluster seguida das listas de tamanho fixo (sem contador global nem atomics)
+	VkDeviceSize clusterBytes = static_cast<VkDeviceSize>(getClusterCount()) * (1 + settings.maxLightsPerCluster) * sizeof(uint32_t);
+
+	for (uint32_t i = 0; i < framesInFlight; i++) {
+		BufferHandle buffer = buffers.createStorageBuffer(settings.maxLights * sizeof(GpuPointLight));
+		lightBuffers.push_back(buffer);
+		lightBufferIndices.push_back(bindless.registerStorageBuffer(buffers.getVkBuffer(buffer)));
+
+		// Grade por frame em voo: com compute assíncrono o frame seguinte escreve enquanto este ainda lê
+		BufferHandle clusters = buffers.createGpuStorageBuffer(clusterBytes);
+		clusterBuffers.push_back(clusters);
+		clusterBufferIndices.push_back(bindless.registerStorageBuffer(buffers.getVkBuffer(clusters)));
+	}
+
+	std::tie(pipeline, pipelineLayout) = PipelineManager::createComputePipeline(device,
+	                                                                            "../assets/shaders/core/lighting/compiled/comp.spv",
+	                                                                            {bindless.getLayout()},
+	                                                                            sizeof(CullPushConstants));
+
+	LOG_INFO("ClusteredLighting", "{}x{}x{} clusters, up to {} lights ({} per cluster, {} KiB of lists).", settings.tilesX, settings.tilesY,
+	         settings.slices, settings.maxLights, settings.maxLightsPerCluster, clusterBytes / 1024);
+}
+
+ClusteredLighting::~ClusteredLighting() {
+	PipelineManager::destroy(device, pipeline, pipelineLayout);
+
+	for (size_t i = 0; i < lightBuffers.size(); i++) {
+		bindless.releaseStorageBuffer(clusterBufferIndices[i]);
+		buffers.destroyBuffer(clusterBuffers[i]);
+		bindless.releaseStorageBuffer(lightBufferIndices[i]);
+		buffers.destroyBuffer(lightBuffers[i]);
+	}
+}
+
+void ClusteredLighting::update(uint32_t             frame,
+                               const glm::mat4     &view,
+                               float                fovY,
+                               float                aspect,
+                               float                nearPlane,
+                               float                farPlane,
+                               VkExtent2D           extent,
+                               const GpuPointLight *lights,
+                               size_t               count) {
+	if (count > settings.maxLights && !overflowWarned) {
+		LOG_WARN("ClusteredLighting", "{} point lights, only the first {} are used.", count, settings.maxLights);
+		overflowWarned = true;
+	}
+
+	this->frame = frame;
+	lightCount  = static_cast<uint32_t>(std::min<size_t>(count, settings.maxLights));
+	if (lightCount > 0) {
+		buffers.updateBuffer(lightBuffers[frame], lights, lightCount * sizeof(GpuPointLight));
+	}
+
+	float tanHalfFov = std::tan(fovY * 0.5f);
+
+	constants.view               = view;
+	constants.projection         = glm::vec4(tanHalfFov * aspect, tanHalfFov, nearPlane, farPlane);
+	constants.grid               = glm::uvec4(settings.tilesX, settings.tilesY, settings.slices, settings.maxLightsPerCluster);
+	constants.lightBufferIndex   = lightBufferIndices[frame];
+	constants.clusterBufferIndex = clusterBufferIndices[frame];
+	constants.lightCount         = lightCount;
+
+	// Fatia exponencial: slice = log(depth / near) / log(far / near) * slices
+	float sliceScale = static_cast<float>(settings.slices) / std::log(farPlane / nearPlane);
+	clusterScale     = glm::vec4(static_cast<float>(settings.tilesX) / static_cast<float>(std::max(extent.width, 1u)),
+	                             static_cast<float>(settings.tilesY) / static_cast<float>(std::max(extent.height, 1u)),
+	                             sliceScale,
+	                             -std::log(nearPlane) * sliceScale);
+}
+
+void ClusteredLighting::writeSceneData(GpuSceneData &data) const {
+	data.lightBufferIndex   = lightBufferIndices[frame];
+	data.clusterBufferIndex = clusterBufferIndices[frame];
+	data.clusterScale       = clusterScale;
+	data.clusterGrid        = glm::uvec4(settings.tilesX, settings.tilesY, settings.slices, settings.maxLightsPerCluster);
+}
+
+void ClusteredLighting::recordCulling(VkCommandBuffer cmd) const {
+	vkCmdBindPipeline(cmd, VK_PIPELINE_BIND_POINT_COMPUTE, pipeline);
+	bindless.bind(cmd, pipelineLayout, VK_PIPELINE_BIND_POINT_COMPUTE);
+	vkCmdPushConstants(cmd, pipelineLayout, VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(CullPushConstants), &constants);
+
+	// Um thread por cluster; sem luzes o shader só zera as contagens
+	vkCmdDispatch(cmd, (getClusterCount() + CLUSTERS_PER_GROUP - 1) / CLUSTERS_PER_GROUP, 1, 1);
+}
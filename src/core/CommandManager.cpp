@@ -1,9 +1,10 @@
 #include <core/CommandManager.hpp>
+#include <core/Logger.hpp>
 
 
 CommandManager::CommandManager(VkDevice device, QueueManager& queueManager) 
 : device(device), queueManager(queueManager), commandPool(VK_NULL_HANDLE) {
-   std::cout << "[CommandManager] : CommandManager created." << std::endl;
+   LOG_INFO("CommandManager", "CommandManager created.");
 }
 
 CommandManager::~CommandManager() {
@@ -23,7 +24,7 @@ void CommandManager::createCommandPool() {
    if (vkCreateCommandPool(device, &poolInfo, nullptr, &commandPool) != VK_SUCCESS) {
       throw std::runtime_error("[CommandManager] : Failed to create command pool!");
    } 
-   std::cout << "[CommandManager] : Command pool created." << std::endl;
+   LOG_INFO("CommandManager", "Command pool created.");
 }
 
 std::vector<VkCommandBuffer> CommandManager::allocateCommandBuffers(size_t count) {
@@ -39,7 +40,7 @@ std::vector<VkCommandBuffer> CommandManager::allocateCommandBuffers(size_t count
       throw std::runtime_error("[CommandManager] : Failed to allocate command buffers!");
    }
 
-   std::cout << "[CommandManager] : Command buffers allocated (" << count << " buffers)." << std::endl;
+   LOG_DEBUG("CommandManager", "Command buffers allocated ({} buffers).", count);
 
    return commandBuffers;
 }
@@ -47,7 +48,7 @@ std::vector<VkCommandBuffer> CommandManager::allocateCommandBuffers(size_t count
 void CommandManager::cleanup() {
    if (commandPool != VK_NULL_HANDLE) {
       vkDestroyCommandPool(device, commandPool, nullptr);
-      std::cout << "[CommandManager] : Command pool destroyed." << std::endl;
+      LOG_INFO("CommandManager", "Command pool destroyed.");
       commandPool = VK_NULL_HANDLE;
    }
    
@@ -0,0 +1,92 @@
+#include <core/CpuTracer.hpp>
+#include <core/Logger.hpp>
+
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+
+namespace {
+	// Nomes são literais do código; só aspas e barras precisam de escape no JSON
+	void writeEscaped(std::ofstream &file, const std::string &text) {
+		for (char c : text) {
+			if (c == '"' || c == '\\') {
+				file << '\\';
+			}
+			file << c;
+		}
+	}
+}        // namespace
+
+CpuTracer::ThreadBuffer &CpuTracer::threadBuffer() {
+	thread_local std::shared_ptr<ThreadBuffer> buffer = [] {
+		auto created = std::make_shared<ThreadBuffer>();
+
+		std::lock_guard<std::mutex> lock(registryMutex);
+		created->threadId   = static_cast<uint32_t>(registry.size()) + 1;
+		created->threadName = "thread " + std::to_string(created->threadId);
+		registry.push_back(created);
+		return created;
+	}();
+	return *buffer;
+}
+
+void CpuTracer::record(const char *name, uint64_t startNs, uint64_t endNs) {
+	if (!isEnabled()) {
+		return;
+	}
+	ThreadBuffer &buffer = threadBuffer();
+
+	std::lock_guard<std::mutex> lock(buffer.mutex);
+	buffer.events[buffer.written % EVENTS_PER_THREAD] = {name, startNs, endNs - startNs};
+	buffer.written++;
+}
+
+void CpuTracer::setThreadName(const char *name) {
+	ThreadBuffer &buffer = threadBuffer();
+
+	std::lock_guard<std::mutex> lock(buffer.mutex);
+	buffer.threadName = name;
+}
+
+bool CpuTracer::writeChromeTrace(const std::string &path) {
+	std::ofstream file(path);
+	if (!file) {
+		LOG_ERROR("CpuTracer", "Failed to open {}", path);
+		return false;
+	}
+
+	std::vector<std::shared_ptr<ThreadBuffer>> buffers;
+	{
+		std::lock_guard<std::mutex> lock(registryMutex);
+		buffers = registry;
+	}
+
+	// Eventos "X" (completos) em microssegundos; metadados "M" dão nome às threads
+	file << std::fixed << std::setprecision(3);        // ts em µs com precisão de ns, sem notação científica
+	file << "{\"displayTimeUnit\": \"ms\", \"traceEvents\": [\n";
+	bool   first  = true;
+	size_t events = 0;
+	for (const auto &buffer : buffers) {
+		std::lock_guard<std::mutex> lock(buffer->mutex);
+
+		file << (first ? "" : ",\n") << "{\"ph\": \"M\", \"name\": \"thread_name\", \"pid\": 1, \"tid\": " << buffer->threadId
+		     << ", \"args\": {\"name\": \"";
+		writeEscaped(file, buffer->threadName);
+		file << "\"}}";
+		first = false;
+
+		uint64_t count = std::min<uint64_t>(buffer->written, EVENTS_PER_THREAD);
+		for (uint64_t i = buffer->written - count; i < buffer->written; i++) {
+			const Event &event = buffer->events[i % EVENTS_PER_THREAD];
+			file << ",\n{\"ph\": \"X\", \"name\": \"";
+			writeEscaped(file, event.name);
+			file << "\", \"pid\": 1, \"tid\": " << buffer->threadId << ", \"ts\": " << event.startNs / 1000.0
+			     << ", \"dur\": " << event.durationNs / 1000.0 << "}";
+		}
+		events += count;
+	}
+	file << "\n]}\n";
+
+	LOG_INFO("CpuTracer", "{} events from {} threads written to {}", events, buffers.size(), path);
+	return true;
+}
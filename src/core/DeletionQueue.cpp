@@ -0,0 +1,26 @@
+#include <core/DeletionQueue.hpp>
+
+#include <algorithm>
+
+void DeletionQueue::push(uint64_t retireValue, std::function<void()> deleter) {
+	entries.push_back({retireValue, std::move(deleter)});
+}
+
+void DeletionQueue::flush(uint64_t completedValue) {
+	// stable_partition mantém a ordem de enfileiramento dos dois lados
+	auto firstPending = std::stable_partition(entries.begin(), entries.end(), [completedValue](const Entry &entry) {
+		return entry.retireValue <= completedValue;
+	});
+
+	for (auto it = entries.begin(); it != firstPending; ++it) {
+		it->deleter();
+	}
+	entries.erase(entries.begin(), firstPending);
+}
+
+void DeletionQueue::flushAll() {
+	for (Entry &entry : entries) {
+		entry.deleter();
+	}
+	entries.clear();
+}
@@ -0,0 +1,213 @@
+#include <core/DescriptorAllocator.hpp>
+
+#include <algorithm>
+#include <functional>
+#include <stdexcept>
+
+// ================== DescriptorLayoutCache ============================
+
+DescriptorLayoutCache::DescriptorLayoutCache(VkDevice device) :
+    device(device) {
+}
+
+DescriptorLayoutCache::~DescriptorLayoutCache() {
+	for (auto &[key, layout] : layouts) {
+		vkDestroyDescriptorSetLayout(device, layout, nullptr);
+	}
+}
+
+bool DescriptorLayoutCache::BindingKey::operator==(const BindingKey &other) const {
+	return binding == other.binding && type == other.type && count == other.count &&
+	       stages == other.stages && flags == other.flags && immutableSamplers == other.immutableSamplers;
+}
+
+bool DescriptorLayoutCache::LayoutKey::operator==(const LayoutKey &other) const {
+	return flags == other.flags && bindings == other.bindings;
+}
+
+size_t DescriptorLayoutCache::LayoutKeyHash::operator()(const LayoutKey &key) const {
+	// Combinação no estilo boost::hash_combine
+	size_t hash    = std::hash<uint32_t>{}(key.flags);
+	auto   combine = [&hash](uint64_t value) {
+		hash ^= std::hash<uint64_t>{}(value) + 0x9e3779b97f4a7c15ull + (hash << 6) + (hash >> 2);
+	};
+
+	for (const BindingKey &binding : key.bindings) {
+		combine(binding.binding | (static_cast<uint64_t>(binding.type) << 32));
+		combine(binding.count | (static_cast<uint64_t>(binding.stages) << 32));
+		combine(binding.flags);
+		for (VkSampler sampler : binding.immutableSamplers) {
+			combine(reinterpret_cast<uint64_t>(sampler));
+		}
+	}
+	return hash;
+}
+
+VkDescriptorSetLayout DescriptorLayoutCache::getLayout(const VkDescriptorSetLayoutCreateInfo &info) {
+	// Binding flags, se vierem no pNext, são indexados na mesma ordem de pBindings
+	const VkDescriptorSetLayoutBindingFlagsCreateInfo *bindingFlags = nullptr;
+	for (auto *next = static_cast<const VkBaseInStructure *>(info.pNext); next != nullptr; next = next->pNext) {
+		if (next->sType == VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_BINDING_FLAGS_CREATE_INFO) {
+			bindingFlags = reinterpret_cast<const VkDescriptorSetLayoutBindingFlagsCreateInfo *>(next);
+		}
+	}
+
+	LayoutKey key;
+	key.flags = info.flags;
+	key.bindings.reserve(info.bindingCount);
+	for (uint32_t i = 0; i < info.bindingCount; i++) {
+		const VkDescriptorSetLayoutBinding &binding = info.pBindings[i];
+
+		BindingKey bindingKey{binding.binding, binding.descriptorType, binding.descriptorCount, binding.stageFlags, 0, {}};
+		if (bindingFlags && i < bindingFlags->bindingCount) {
+			bindingKey.flags = bindingFlags->pBindingFlags[i];
+		}
+		if (binding.pImmutableSamplers) {
+			bindingKey.immutableSamplers.assign(binding.pImmutableSamplers, binding.pImmutableSamplers + binding.descriptorCount);
+		}
+		key.bindings.push_back(std::move(bindingKey));
+	}
+	// A ordem em que os bindings foram escritos não muda o layout
+	std::sort(key.bindings.begin(), key.bindings.end(),
+	          [](const BindingKey &a, const BindingKey &b) { return a.binding < b.binding; });
+
+	auto it = layouts.find(key);
+	if (it != layouts.end()) {
+		return it->second;
+	}
+
+	VkDescriptorSetLayout layout;
+	if (vkCreateDescriptorSetLayout(device, &info, nullptr, &layout) != VK_SUCCESS) {
+		throw std::runtime_error("[DescriptorLayoutCache] : Failed to create descriptor set layout!");
+	}
+	layouts.emplace(std::move(key), layout);
+	return layout;
+}
+
+// ================== DescriptorAllocator ============================
+
+std::vector<DescriptorAllocator::PoolSizeRatio> DescriptorAllocator::defaultRatios() {
+	return {
+	    {VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, 2.0f},
+	    {VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC, 1.0f},
+	    {VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 2.0f},
+	    {VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, 2.0f},
+	    {VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE, 2.0f},
+	    {VK_DESCRIPTOR_TYPE_SAMPLER, 1.0f},
+	    {VK_DESCRIPTOR_TYPE_STORAGE_IMAGE, 1.0f},
+	};
+}
+
+DescriptorAllocator::DescriptorAllocator(VkDevice device, uint32_t setsPerPool, std::vector<PoolSizeRatio> ratios) :
+    device(device),
+    setsPerPool(setsPerPool),
+    ratios(std::move(ratios)) {
+}
+
+DescriptorAllocator::DescriptorAllocator(DescriptorAllocator &&other) noexcept :
+    device(other.device),
+    setsPerPool(other.setsPerPool),
+    ratios(std::move(other.ratios)),
+    currentPool(other.currentPool),
+    usedPools(std::move(other.usedPools)),
+    freePools(std::move(other.freePools)),
+    allocatedSets(other.allocatedSets) {
+	other.currentPool = VK_NULL_HANDLE;
+	other.usedPools.clear();
+	other.freePools.clear();
+}
+
+DescriptorAllocator::~DescriptorAllocator() {
+	for (VkDescriptorPool pool : usedPools) {
+		vkDestroyDescriptorPool(device, pool, nullptr);
+	}
+	for (VkDescriptorPool pool : freePools) {
+		vkDestroyDescriptorPool(device, pool, nullptr);
+	}
+}
+
+VkDescriptorPool DescriptorAllocator::createPool() {
+	std::vector<VkDescriptorPoolSize> sizes;
+	sizes.reserve(ratios.size());
+	for (const PoolSizeRatio &ratio : ratios) {
+		sizes.push_back({ratio.type, std::max(1u, static_cast<uint32_t>(ratio.ratio * setsPerPool))});
+	}
+
+	VkDescriptorPoolCreateInfo poolInfo{};
+	poolInfo.sType         = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+	poolInfo.flags         = 0;        // Sem FREE_DESCRIPTOR_SET: só reset do pool inteiro
+	poolInfo.maxSets       = setsPerPool;
+	poolInfo.poolSizeCount = static_cast<uint32_t>(sizes.size());
+	poolInfo.pPoolSizes    = sizes.data();
+
+	VkDescriptorPool pool;
+	if (vkCreateDescriptorPool(device, &poolInfo, nullptr, &pool) != VK_SUCCESS) {
+		throw std::runtime_error("[DescriptorAllocator] : Failed to create descriptor pool!");
+	}
+	return pool;
+}
+
+VkDescriptorPool DescriptorAllocator::grabPool() {
+	VkDescriptorPool pool;
+	if (!freePools.empty()) {
+		pool = freePools.back();
+		freePools.pop_back();
+	}
+	else {
+		pool = createPool();
+	}
+	usedPools.push_back(pool);
+	return pool;
+}
+
+VkDescriptorSet DescriptorAllocator::allocate(VkDescriptorSetLayout layout) {
+	if (currentPool == VK_NULL_HANDLE) {
+		currentPool = grabPool();
+	}
+
+	VkDescriptorSetAllocateInfo allocInfo{};
+	allocInfo.sType              = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+	allocInfo.descriptorPool     = currentPool;
+	allocInfo.descriptorSetCount = 1;
+	allocInfo.pSetLayouts        = &layout;
+
+	VkDescriptorSet set;
+	VkResult        result = vkAllocateDescriptorSets(device, &allocInfo, &set);
+
+	// Pool cheio: pega outro e tenta de novo (uma vez só; se falhar de novo o layout não cabe num pool)
+	if (result == VK_ERROR_OUT_OF_POOL_MEMORY || result == VK_ERROR_FRAGMENTED_POOL) {
+		currentPool              = grabPool();
+		allocInfo.descriptorPool = currentPool;
+		result                   = vkAllocateDescriptorSets(device, &allocInfo, &set);
+	}
+	if (result != VK_SUCCESS) {
+		throw std::runtime_error("[DescriptorAllocator] : Failed to allocate descriptor set!");
+	}
+
+	allocatedSets++;
+	return set;
+}
+
+void DescriptorAllocator::reset() {
+	for (VkDescriptorPool pool : usedPools) {
+		vkResetDescriptorPool(device, pool, 0);
+		freePools.push_back(pool);
+	}
+	usedPools.clear();
+	currentPool   = VK_NULL_HANDLE;
+	allocatedSets = 0;
+}
+
+// ================== FrameDescriptorAllocators ============================
+
+FrameDescriptorAllocators::FrameDescriptorAllocators(VkDevice device, uint32_t framesInFlight, uint32_t setsPerPool) {
+	allocators.reserve(framesInFlight);
+	for (uint32_t i = 0; i < framesInFlight; i++) {
+		allocators.emplace_back(device, setsPerPool);
+	}
+}
+
+void FrameDescriptorAllocators::beginFrame(uint32_t frameIndex) {
+	currentFrame = frameIndex;
+	allocators[currentFrame].reset();
+}
@@ -0,0 +1,48 @@
+#include <core/DynamicResolution.hpp>
+#include <core/Logger.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+DynamicResolution::DynamicResolution(const DynamicResolutionSettings &settings) :
+    settings(settings) {
+	if (settings.targetMs <= 0.0 || settings.minScale <= 0.0f || settings.minScale > settings.maxScale || settings.scaleStep <= 0.0f) {
+		throw std::runtime_error("[DynamicResolution] : Invalid budget or scale range!");
+	}
+	scale = settings.maxScale;
+
+	LOG_INFO("DynamicResolution", "GPU budget {} ms, scale {}-{}.", settings.targetMs, settings.minScale, settings.maxScale);
+}
+
+void DynamicResolution::addGpuTime(double gpuMs) {
+	// Frames gravados antes da última troca não dizem nada sobre a escala nova
+	if (settleLeft > 0) {
+		settleLeft--;
+		return;
+	}
+	averageMs  = hasSamples ? averageMs + (gpuMs - averageMs) * settings.smoothing : gpuMs;
+	hasSamples = true;
+
+	// Pixels ~ escala²: a escala que gastaria o orçamento (com folga) na média atual
+	double desired = scale * std::sqrt(settings.targetMs * settings.headroom / std::max(averageMs, 0.01));
+	float  next    = std::floor(static_cast<float>(desired) / settings.scaleStep + 1e-3f) * settings.scaleStep;
+	next           = std::clamp(next, settings.minScale, settings.maxScale);
+	if (next > scale) {
+		next = std::min(scale + settings.scaleStep, settings.maxScale);        // Sobe devagar
+	}
+	if (std::abs(next - scale) < settings.scaleStep * 0.5f) {
+		return;
+	}
+
+	LOG_DEBUG("DynamicResolution", "GPU {} ms (budget {}): scale {} -> {}", averageMs, settings.targetMs, scale, next);
+	scale      = next;
+	settleLeft = settings.settleFrames;
+	hasSamples = false;
+	scaleChanges++;
+}
+
+VkExtent2D DynamicResolution::getRenderExtent(VkExtent2D outputExtent) const {
+	return {std::max(1u, static_cast<uint32_t>(std::lround(outputExtent.width * scale))),
+	        std::max(1u, static_cast<uint32_t>(std::lround(outputExtent.height * scale)))};
+}
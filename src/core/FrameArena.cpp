@@ -0,0 +1,83 @@
+#include <core/FrameArena.hpp>
+#include <core/Logger.hpp>
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace {
+size_t alignUp(size_t value, size_t alignment) {
+	return (value + alignment - 1) & ~(alignment - 1);
+}
+}        // namespace
+
+// ================== LinearArena ============================
+
+LinearArena::LinearArena(size_t capacity) :
+    block(new std::byte[capacity]),
+    capacity(capacity) {
+}
+
+void *LinearArena::allocate(size_t size, size_t alignment) {
+	if (size == 0) {
+		size = 1;
+	}
+
+	// new[] garante alinhamento de max_align_t; alinhamentos maiores não são suportados
+	if (alignment > alignof(std::max_align_t)) {
+		throw std::runtime_error("[LinearArena] : Unsupported alignment!");
+	}
+
+	// Uso = fim alinhado como se tudo coubesse no bloco (padding incluso), mesmo depois do overflow
+	allocationCount++;
+	usedBytes      = alignUp(usedBytes, alignment) + size;
+	highWaterBytes = std::max(highWaterBytes, usedBytes);
+
+	size_t alignedOffset = alignUp(offset, alignment);
+	if (alignedOffset + size <= capacity) {
+		offset = alignedOffset + size;
+		return block.get() + alignedOffset;
+	}
+
+	// Bloco cheio: alocação avulsa até o próximo reset
+	overflowBlocks.emplace_back(new std::byte[size]);
+	return overflowBlocks.back().get();
+}
+
+void LinearArena::reset() {
+	if (!overflowBlocks.empty()) {
+		// Cresce para o pico + folga, assim o próximo frame cabe num bloco só
+		size_t newCapacity = alignUp(highWaterBytes + highWaterBytes / 2, alignof(std::max_align_t));
+		LOG_WARN("LinearArena", "Overflow ({} blocks), growing {} -> {} bytes.", overflowBlocks.size(), capacity, newCapacity);
+
+		overflowBlocks.clear();
+		block.reset(new std::byte[newCapacity]);
+		capacity       = newCapacity;
+		highWaterBytes = 0;
+	}
+
+	offset          = 0;
+	usedBytes       = 0;
+	allocationCount = 0;
+}
+
+// ================== FrameArenas ============================
+
+FrameArenas::FrameArenas(uint32_t framesInFlight, size_t bytesPerFrame) {
+	arenas.reserve(framesInFlight);
+	for (uint32_t i = 0; i < framesInFlight; i++) {
+		arenas.push_back(std::make_unique<LinearArena>(bytesPerFrame));
+	}
+}
+
+LinearArena &FrameArenas::beginFrame(uint32_t frameIndex) {
+	LinearArena &arena = *arenas.at(frameIndex);
+
+	lastFrameStats.allocationCount = arena.getAllocationCount();
+	lastFrameStats.usedBytes       = arena.getUsedBytes();
+	lastFrameStats.overflowCount   = arena.getOverflowCount();
+	lastFrameStats.capacity        = arena.getCapacity();
+
+	arena.reset();
+	currentIndex = frameIndex;
+	return arena;
+}
@@ -0,0 +1,216 @@
+#include <core/FrameScheduler.hpp>
+#include <core/Logger.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <stdexcept>
+
+bool FrameScheduler::isSupported(VkPhysicalDevice physicalDevice) {
+	VkPhysicalDeviceVulkan12Features features12{};
+	features12.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_FEATURES;
+	VkPhysicalDeviceFeatures2 features{};
+	features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2;
+	features.pNext = &features12;
+	vkGetPhysicalDeviceFeatures2(physicalDevice, &features);
+
+	return features12.timelineSemaphore;
+}
+
+FrameScheduler::FrameScheduler(VkDevice device, uint32_t framesInFlight, LatencyMode latencyMode) :
+    device(device),
+    framesInFlight(std::clamp(framesInFlight, 1u, MAX_FRAMES_IN_FLIGHT)),
+    latencyMode(latencyMode) {
+	VkSemaphoreTypeCreateInfo typeInfo{};
+	typeInfo.sType         = VK_STRUCTURE_TYPE_SEMAPHORE_TYPE_CREATE_INFO;
+	typeInfo.semaphoreType = VK_SEMAPHORE_TYPE_TIMELINE;
+	typeInfo.initialValue  = 0;
+
+	VkSemaphoreCreateInfo timelineInfo{};
+	timelineInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
+	timelineInfo.pNext = &typeInfo;
+
+	if (vkCreateSemaphore(device, &timelineInfo, nullptr, &timeline) != VK_SUCCESS) {
+		throw std::runtime_error("[FrameScheduler] : Failed to create timeline semaphore!");
+	}
+
+	VkSemaphoreCreateInfo binaryInfo{};
+	binaryInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
+
+	for (uint32_t i = 0; i < MAX_FRAMES_IN_FLIGHT; i++) {
+		if (vkCreateSemaphore(device, &binaryInfo, nullptr, &imageAvailable[i]) != VK_SUCCESS ||
+		    vkCreateSemaphore(device, &binaryInfo, nullptr, &renderFinished[i]) != VK_SUCCESS) {
+			throw std::runtime_error("[FrameScheduler] : Failed to create frame semaphores!");
+		}
+	}
+
+	stats.framesInFlight = this->framesInFlight;
+	stats.latencyMode    = latencyMode;
+
+	LOG_INFO("FrameScheduler", "Created ({} frames in flight, {}).", this->framesInFlight, latencyMode == LatencyMode::LowLatency ? "low latency" : "throughput");
+}
+
+FrameScheduler::~FrameScheduler() {
+	for (uint32_t i = 0; i < MAX_FRAMES_IN_FLIGHT; i++) {
+		if (imageAvailable[i] != VK_NULL_HANDLE) {
+			vkDestroySemaphore(device, imageAvailable[i], nullptr);
+		}
+		if (renderFinished[i] != VK_NULL_HANDLE) {
+			vkDestroySemaphore(device, renderFinished[i], nullptr);
+		}
+	}
+	if (timeline != VK_NULL_HANDLE) {
+		vkDestroySemaphore(device, timeline, nullptr);
+	}
+}
+
+void FrameScheduler::waitForValue(uint64_t value) const {
+	VkSemaphoreWaitInfo waitInfo{};
+	waitInfo.sType          = VK_STRUCTURE_TYPE_SEMAPHORE_WAIT_INFO;
+	waitInfo.semaphoreCount = 1;
+	waitInfo.pSemaphores    = &timeline;
+	waitInfo.pValues        = &value;
+
+	if (vkWaitSemaphores(device, &waitInfo, UINT64_MAX) != VK_SUCCESS) {
+		throw std::runtime_error("[FrameScheduler] : Failed to wait on timeline semaphore!");
+	}
+}
+
+uint32_t FrameScheduler::waitForFrame() {
+	// Frame N reaproveita o slot de N - framesInFlight, que sinaliza N + 1 - framesInFlight
+	uint64_t waitValue = 0;
+	if (latencyMode == LatencyMode::LowLatency) {
+		waitValue = frameNumber;
+	}
+	else if (frameNumber >= framesInFlight) {
+		waitValue = frameNumber + 1 - framesInFlight;
+	}
+
+	auto start = std::chrono::steady_clock::now();
+	if (waitValue > 0) {
+		waitForValue(waitValue);
+	}
+	double waitMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+	stats.lastCpuWaitMs    = waitMs;
+	stats.averageCpuWaitMs = stats.averageCpuWaitMs * 0.95 + waitMs * 0.05;
+	stats.maxCpuWaitMs     = std::max(stats.maxCpuWaitMs, waitMs);
+	vkGetSemaphoreCounterValue(device, timeline, &stats.gpuCompletedFrames);
+
+	currentSlot = static_cast<uint32_t>(frameNumber % framesInFlight);
+	return currentSlot;
+}
+
+void FrameScheduler::waitOnNextSubmit(VkSemaphore semaphore, uint64_t value, VkPipelineStageFlags stage) {
+	extraWaitSemaphore = semaphore;
+	extraWaitValue     = value;
+	extraWaitStage     = stage;
+}
+
+VkResult FrameScheduler::submit(VkQueue queue, VkCommandBuffer cmd, VkPipelineStageFlags waitStage) {
+	const uint64_t signalValue = frameNumber + 1;
+
+	// Valores dos semáforos binários são ignorados, mas os arrays precisam ter o mesmo tamanho
+	uint64_t             waitValues[]       = {0, extraWaitValue};
+	VkSemaphore          waitSemaphores[]   = {imageAvailable[currentSlot], extraWaitSemaphore};
+	VkPipelineStageFlags waitStages[]       = {waitStage, extraWaitStage};
+	uint32_t             waitCount          = extraWaitSemaphore != VK_NULL_HANDLE ? 2 : 1;
+	uint64_t             signalValues[]     = {signalValue, 0};
+	VkSemaphore          signalSemaphores[] = {timeline, renderFinished[currentSlot]};
+	extraWaitSemaphore                      = VK_NULL_HANDLE;
+
+	VkTimelineSemaphoreSubmitInfo timelineInfo{};
+	timelineInfo.sType                     = VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO;
+	timelineInfo.waitSemaphoreValueCount   = waitCount;
+	timelineInfo.pWaitSemaphoreValues      = waitValues;
+	timelineInfo.signalSemaphoreValueCount = 2;
+	timelineInfo.pSignalSemaphoreValues    = signalValues;
+
+	VkSubmitInfo submitInfo{};
+	submitInfo.sType                = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+	submitInfo.pNext                = &timelineInfo;
+	submitInfo.waitSemaphoreCount   = waitCount;
+	submitInfo.pWaitSemaphores      = waitSemaphores;
+	submitInfo.pWaitDstStageMask    = waitStages;
+	submitInfo.commandBufferCount   = 1;
+	submitInfo.pCommandBuffers      = &cmd;
+	submitInfo.signalSemaphoreCount = 2;
+	submitInfo.pSignalSemaphores    = signalSemaphores;
+
+	VkResult result = vkQueueSubmit(queue, 1, &submitInfo, VK_NULL_HANDLE);
+	if (result == VK_SUCCESS) {
+		submittedValue = signalValue;
+	}
+	return result;
+}
+
+uint64_t FrameScheduler::getCompletedValue() const {
+	uint64_t value = 0;
+	vkGetSemaphoreCounterValue(device, timeline, &value);
+	return value;
+}
+
+VkResult FrameScheduler::submitOffscreen(VkQueue queue, VkCommandBuffer cmd) {
+	const uint64_t signalValue = frameNumber + 1;
+	const uint64_t waitValue   = extraWaitValue;
+	uint32_t       waitCount   = extraWaitSemaphore != VK_NULL_HANDLE ? 1 : 0;
+
+	VkTimelineSemaphoreSubmitInfo timelineInfo{};
+	timelineInfo.sType                     = VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO;
+	timelineInfo.waitSemaphoreValueCount   = waitCount;
+	timelineInfo.pWaitSemaphoreValues      = &waitValue;
+	timelineInfo.signalSemaphoreValueCount = 1;
+	timelineInfo.pSignalSemaphoreValues    = &signalValue;
+
+	VkSubmitInfo submitInfo{};
+	submitInfo.sType                = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+	submitInfo.pNext                = &timelineInfo;
+	submitInfo.waitSemaphoreCount   = waitCount;
+	submitInfo.pWaitSemaphores      = &extraWaitSemaphore;
+	submitInfo.pWaitDstStageMask    = &extraWaitStage;
+	submitInfo.commandBufferCount   = 1;
+	submitInfo.pCommandBuffers      = &cmd;
+	submitInfo.signalSemaphoreCount = 1;
+	submitInfo.pSignalSemaphores    = &timeline;
+
+	VkResult result    = vkQueueSubmit(queue, 1, &submitInfo, VK_NULL_HANDLE);
+	extraWaitSemaphore = VK_NULL_HANDLE;
+	if (result == VK_SUCCESS) {
+		submittedValue = signalValue;
+	}
+	return result;
+}
+
+void FrameScheduler::endFrame() {
+	frameNumber++;
+}
+
+void FrameScheduler::drain() {
+	if (submittedValue > 0) {
+		waitForValue(submittedValue);
+	}
+}
+
+void FrameScheduler::setFramesInFlight(uint32_t count) {
+	count = std::clamp(count, 1u, MAX_FRAMES_IN_FLIGHT);
+	if (count == framesInFlight) {
+		return;
+	}
+
+	// O mapeamento frame -> slot muda: nenhum slot pode estar em uso na GPU
+	drain();
+	framesInFlight       = count;
+	stats.framesInFlight = count;
+	LOG_INFO("FrameScheduler", "Frames in flight set to {}.", count);
+}
+
+void FrameScheduler::setLatencyMode(LatencyMode mode) {
+	// Não precisa drenar: o slot continua frameNumber % framesInFlight, só a espera muda
+	latencyMode       = mode;
+	stats.latencyMode = mode;
+}
+
+void FrameScheduler::resetStats() {
+	stats.lastCpuWaitMs    = 0.0;
+	stats.averageCpuWaitMs = 0.0;
+	stats.maxCpuWaitMs     = 0.0;
+}
@@ -0,0 +1,81 @@
+#include <core/FrameStats.hpp>
+#include <core/Logger.hpp>
+
+#include <algorithm>
+#include <fstream>
+#include <numeric>
+
+const char *toString(FrameStage stage) {
+	switch (stage) {
+		case FrameStage::Setup: return "setup";
+		case FrameStage::Acquire: return "acquire";
+		case FrameStage::Ui: return "ui";
+		case FrameStage::Record: return "record";
+		case FrameStage::Submit: return "submit";
+		case FrameStage::Present: return "present";
+		case FrameStage::Count: break;
+	}
+	return "unknown";
+}
+
+double FrameStats::getCpuTotalMs() const {
+	return std::accumulate(cpuMs.begin(), cpuMs.end(), 0.0);
+}
+
+void FrameStatsRecorder::begin(uint64_t frameNumber) {
+	frame             = FrameStats{};
+	frame.frameNumber = frameNumber;
+}
+
+void FrameStatsRecorder::end() {
+	history[written % HISTORY_SIZE] = frame;
+	written++;
+}
+
+const FrameStats &FrameStatsRecorder::last() const {
+	static const FrameStats empty{};
+	return written > 0 ? history[(written - 1) % HISTORY_SIZE] : empty;
+}
+
+std::vector<FrameStats> FrameStatsRecorder::getHistory(size_t count) const {
+	count = std::min(count, getFrameCount());
+
+	std::vector<FrameStats> frames;
+	frames.reserve(count);
+	for (size_t i = written - count; i < written; i++) {
+		frames.push_back(history[i % HISTORY_SIZE]);
+	}
+	return frames;
+}
+
+bool FrameStatsRecorder::writeCsv(const std::string &path, size_t count) const {
+	std::ofstream file(path);
+	if (!file) {
+		LOG_ERROR("FrameStats", "Failed to open {}", path);
+		return false;
+	}
+
+	file << "frame,draw_calls,instances,triangles,pipeline_binds,vertex_buffer_binds,index_buffer_binds,"
+	        "descriptor_binds,push_constant_bytes,uploaded_bytes,culled_objects,shadow_cascades_rendered,shadow_cascades_cached,point_lights,"
+	        "particles,render_scale";
+	for (size_t stage = 0; stage < static_cast<size_t>(FrameStage::Count); stage++) {
+		file << ",cpu_" << toString(static_cast<FrameStage>(stage)) << "_ms";
+	}
+	file << ",cpu_total_ms\n";
+
+	std::vector<FrameStats> frames = getHistory(count);
+	for (const FrameStats &stats : frames) {
+		file << stats.frameNumber << ',' << stats.drawCalls << ',' << stats.instances << ',' << stats.triangles << ','
+		     << stats.pipelineBinds << ',' << stats.vertexBufferBinds << ',' << stats.indexBufferBinds << ','
+		     << stats.descriptorBinds << ',' << stats.pushConstantBytes << ',' << stats.uploadedBytes << ','
+		     << stats.culledObjects << ',' << stats.shadowCascadesRendered << ',' << stats.shadowCascadesCached << ','
+		     << stats.pointLights << ',' << stats.particles << ',' << stats.renderScale;
+		for (double ms : stats.cpuMs) {
+			file << ',' << ms;
+		}
+		file << ',' << stats.getCpuTotalMs() << '\n';
+	}
+
+	LOG_INFO("FrameStats", "{} frames written to {}", frames.size(), path);
+	return true;
+}
@@ -0,0 +1,199 @@
+#include <core/GpuDefragmenter.hpp>
+#include <core/Logger.hpp>
+
+#include <stdexcept>
+
+GpuDefragmenter::GpuDefragmenter(VkDevice         device,
+                                 VmaAllocator     allocator,
+                                 ResourceManager &resources,
+                                 uint32_t         framesInFlight,
+                                 VkDeviceSize     maxBytesPerPass,
+                                 uint32_t         maxAllocationsPerPass) :
+    device(device),
+    allocator(allocator),
+    resources(resources),
+    framesInFlight(framesInFlight),
+    maxBytesPerPass(maxBytesPerPass),
+    maxAllocationsPerPass(maxAllocationsPerPass) {
+	LOG_INFO("GpuDefragmenter", "Created (max {} bytes / pass).", maxBytesPerPass);
+}
+
+GpuDefragmenter::~GpuDefragmenter() {
+	// Device já está ocioso aqui, então dá pra fechar a passada atual direto
+	if (state == PassState::Recorded) {
+		swapBuffers();
+		state = PassState::Swapped;
+	}
+	if (state == PassState::Swapped) {
+		endPass();
+	}
+	if (isActive()) {
+		finish();
+	}
+}
+
+void GpuDefragmenter::setAutoTrigger(float unusedFractionThreshold, uint32_t checkIntervalFrames) {
+	autoTriggerThreshold = unusedFractionThreshold;
+	autoCheckInterval    = checkIntervalFrames > 0 ? checkIntervalFrames : 1;
+}
+
+void GpuDefragmenter::recordCommands(VkCommandBuffer cmd, uint64_t frameNumber) {
+	switch (state) {
+		case PassState::Idle:
+			if (!isActive()) {
+				if (!shouldStart(frameNumber)) {
+					return;
+				}
+				begin();
+			}
+			beginPass(cmd, frameNumber);
+			break;
+
+		case PassState::Recorded:
+			// O frame stateFrame já saiu do timeline -> as cópias terminaram
+			if (frameNumber >= stateFrame + framesInFlight) {
+				swapBuffers();
+				state      = PassState::Swapped;
+				stateFrame = frameNumber;
+			}
+			break;
+
+		case PassState::Swapped:
+			// Todos os frames gravados com os buffers antigos já saíram da GPU
+			if (frameNumber >= stateFrame + framesInFlight) {
+				endPass();
+				if (isActive()) {
+					beginPass(cmd, frameNumber);
+				}
+			}
+			break;
+	}
+}
+
+bool GpuDefragmenter::shouldStart(uint64_t frameNumber) const {
+	if (requested) {
+		return true;
+	}
+	if (autoTriggerThreshold <= 0.0f || frameNumber % autoCheckInterval != 0) {
+		return false;
+	}
+
+	VmaDetailedStatistics poolStats{};
+	vmaCalculatePoolStatistics(allocator, resources.getGeometryPool(), &poolStats);
+
+	// Com um bloco só não tem o que compactar
+	if (poolStats.statistics.blockCount <= 1 || poolStats.statistics.blockBytes == 0) {
+		return false;
+	}
+	VkDeviceSize unusedBytes    = poolStats.statistics.blockBytes - poolStats.statistics.allocationBytes;
+	float        unusedFraction = static_cast<float>(unusedBytes) / static_cast<float>(poolStats.statistics.blockBytes);
+	return unusedFraction > autoTriggerThreshold;
+}
+
+void GpuDefragmenter::begin() {
+	VmaDefragmentationInfo defragInfo{};
+	defragInfo.flags                 = VMA_DEFRAGMENTATION_FLAG_ALGORITHM_BALANCED_BIT;
+	defragInfo.pool                  = resources.getGeometryPool();
+	defragInfo.maxBytesPerPass       = maxBytesPerPass;
+	defragInfo.maxAllocationsPerPass = maxAllocationsPerPass;
+
+	if (vmaBeginDefragmentation(allocator, &defragInfo, &context) != VK_SUCCESS) {
+		throw std::runtime_error("[GpuDefragmenter] : Failed to begin defragmentation!");
+	}
+	requested = false;
+	LOG_INFO("GpuDefragmenter", "Defragmentation started.");
+}
+
+void GpuDefragmenter::beginPass(VkCommandBuffer cmd, uint64_t frameNumber) {
+	VkResult result = vmaBeginDefragmentationPass(allocator, context, &passInfo);
+	if (result == VK_SUCCESS) {
+		// Nada mais para mover
+		finish();
+		return;
+	}
+	if (result != VK_INCOMPLETE) {
+		throw std::runtime_error("[GpuDefragmenter] : Failed to begin defragmentation pass!");
+	}
+
+	pendingMoves.clear();
+	pendingMoves.reserve(passInfo.moveCount);
+
+	for (uint32_t i = 0; i < passInfo.moveCount; i++) {
+		VmaDefragmentationMove &move   = passInfo.pMoves[i];
+		BufferHandle            handle = resources.getHandleFromAllocation(move.srcAllocation);
+
+		VkBufferCreateInfo bufferInfo = resources.getBufferCreateInfo(handle);
+		VkBuffer           newBuffer  = VK_NULL_HANDLE;
+		if (vkCreateBuffer(device, &bufferInfo, nullptr, &newBuffer) != VK_SUCCESS ||
+		    vmaBindBufferMemory(allocator, move.dstTmpAllocation, newBuffer) != VK_SUCCESS) {
+			// Não conseguiu criar o destino: deixa essa alocação onde está
+			if (newBuffer != VK_NULL_HANDLE) {
+				vkDestroyBuffer(device, newBuffer, nullptr);
+			}
+			move.operation = VMA_DEFRAGMENTATION_MOVE_OPERATION_IGNORE;
+			continue;
+		}
+
+		VkBufferCopy copyRegion{};
+		copyRegion.size = bufferInfo.size;
+		vkCmdCopyBuffer(cmd, resources.getVkBuffer(handle), newBuffer, 1, &copyRegion);
+
+		resources.beginMove(handle);
+		pendingMoves.push_back({i, handle, newBuffer, VK_NULL_HANDLE});
+	}
+
+	if (!pendingMoves.empty()) {
+		// Frames seguintes vão ler os buffers novos como vertex/index
+		VkMemoryBarrier barrier{};
+		barrier.sType         = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+		barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+		barrier.dstAccessMask = VK_ACCESS_VERTEX_ATTRIBUTE_READ_BIT | VK_ACCESS_INDEX_READ_BIT;
+
+		vkCmdPipelineBarrier(cmd,
+		                     VK_PIPELINE_STAGE_TRANSFER_BIT,
+		                     VK_PIPELINE_STAGE_VERTEX_INPUT_BIT,
+		                     0,
+		                     1, &barrier,
+		                     0, nullptr,
+		                     0, nullptr);
+	}
+
+	state      = PassState::Recorded;
+	stateFrame = frameNumber;
+}
+
+void GpuDefragmenter::swapBuffers() {
+	for (auto &pendingMove : pendingMoves) {
+		pendingMove.oldBuffer = resources.swapVkBuffer(pendingMove.handle, pendingMove.newBuffer);
+	}
+}
+
+void GpuDefragmenter::endPass() {
+	for (const auto &pendingMove : pendingMoves) {
+		vkDestroyBuffer(device, pendingMove.oldBuffer, nullptr);
+
+		if (!resources.endMove(pendingMove.handle)) {
+			// O dono destruiu o buffer durante a passada: a VMA libera as duas alocações
+			vkDestroyBuffer(device, pendingMove.newBuffer, nullptr);
+			passInfo.pMoves[pendingMove.moveIndex].operation = VMA_DEFRAGMENTATION_MOVE_OPERATION_DESTROY;
+		}
+	}
+	pendingMoves.clear();
+	state = PassState::Idle;
+
+	VkResult result = vmaEndDefragmentationPass(allocator, context, &passInfo);
+	if (result == VK_SUCCESS) {
+		finish();
+	}
+	else if (result != VK_INCOMPLETE) {
+		throw std::runtime_error("[GpuDefragmenter] : Failed to end defragmentation pass!");
+	}
+}
+
+void GpuDefragmenter::finish() {
+	vmaEndDefragmentation(allocator, context, &lastStats);
+	context = VK_NULL_HANDLE;
+	state   = PassState::Idle;
+
+	LOG_INFO("GpuDefragmenter", "Defragmentation finished - {} bytes moved, {} bytes freed, {} blocks released.", lastStats.bytesMoved, lastStats.bytesFreed, lastStats.deviceMemoryBlocksFreed);
+}
@@ -0,0 +1,164 @@
+#include <core/GpuProfiler.hpp>
+#include <core/Logger.hpp>
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace {
+	uint32_t timestampValidBits(VkPhysicalDevice physicalDevice, uint32_t queueFamilyIndex) {
+		uint32_t count = 0;
+		vkGetPhysicalDeviceQueueFamilyProperties(physicalDevice, &count, nullptr);
+		std::vector<VkQueueFamilyProperties> families(count);
+		vkGetPhysicalDeviceQueueFamilyProperties(physicalDevice, &count, families.data());
+		return queueFamilyIndex < count ? families[queueFamilyIndex].timestampValidBits : 0;
+	}
+}        // namespace
+
+void GpuProfiler::History::push(double ms) {
+	samples[head] = ms;
+	head          = (head + 1) % HISTORY_SIZE;
+	count         = std::min(count + 1, HISTORY_SIZE);
+}
+
+bool GpuProfiler::isSupported(VkPhysicalDevice physicalDevice, uint32_t queueFamilyIndex) {
+	VkPhysicalDeviceProperties properties;
+	vkGetPhysicalDeviceProperties(physicalDevice, &properties);
+	return properties.limits.timestampPeriod > 0.0f && timestampValidBits(physicalDevice, queueFamilyIndex) > 0;
+}
+
+GpuProfiler::GpuProfiler(VkDevice device, VkPhysicalDevice physicalDevice, uint32_t queueFamilyIndex, uint32_t slotCount) :
+    device(device),
+    slots(slotCount) {
+	VkPhysicalDeviceProperties properties;
+	vkGetPhysicalDeviceProperties(physicalDevice, &properties);
+	timestampPeriodNs = properties.limits.timestampPeriod;
+
+	uint32_t validBits = timestampValidBits(physicalDevice, queueFamilyIndex);
+	validMask          = validBits >= 64 ? ~0ull : ((1ull << validBits) - 1);
+
+	VkQueryPoolCreateInfo poolInfo{};
+	poolInfo.sType      = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO;
+	poolInfo.queryType  = VK_QUERY_TYPE_TIMESTAMP;
+	poolInfo.queryCount = slotCount * QUERIES_PER_SLOT;
+
+	if (vkCreateQueryPool(device, &poolInfo, nullptr, &queryPool) != VK_SUCCESS) {
+		throw std::runtime_error("[GpuProfiler] : Failed to create timestamp query pool!");
+	}
+	for (SlotFrame &slot : slots) {
+		slot.scopes.reserve(MAX_SCOPES);
+	}
+	lastFrame.scopes.reserve(MAX_SCOPES);
+
+	activeProfiler = this;
+	LOG_INFO("GpuProfiler", "Created ({} slots, {} scopes per frame, {} ns/tick).", slotCount, MAX_SCOPES, timestampPeriodNs);
+}
+
+GpuProfiler::~GpuProfiler() {
+	if (activeProfiler == this) {
+		activeProfiler = nullptr;
+	}
+	if (queryPool != VK_NULL_HANDLE) {
+		vkDestroyQueryPool(device, queryPool, nullptr);
+	}
+}
+
+void GpuProfiler::beginFrame(VkCommandBuffer cmd, uint32_t slot, uint64_t frameNumber) {
+	currentSlot  = slot;
+	currentDepth = 0;
+
+	SlotFrame &frame  = slots[slot];
+	frame.frameNumber = frameNumber;
+	frame.scopes.clear();
+
+	vkCmdResetQueryPool(cmd, queryPool, firstQuery(slot), QUERIES_PER_SLOT);
+	vkCmdWriteTimestamp(cmd, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, queryPool, firstQuery(slot));
+}
+
+void GpuProfiler::endFrame(VkCommandBuffer cmd) {
+	vkCmdWriteTimestamp(cmd, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, queryPool, firstQuery(currentSlot) + 1);
+	slots[currentSlot].pending = true;
+}
+
+uint32_t GpuProfiler::beginScope(VkCommandBuffer cmd, const char *name) {
+	SlotFrame &frame = slots[currentSlot];
+	if (frame.scopes.size() >= MAX_SCOPES) {
+		droppedScopes++;
+		return UINT32_MAX;
+	}
+
+	uint32_t scope = static_cast<uint32_t>(frame.scopes.size());
+	frame.scopes.push_back({name, currentDepth++});
+	vkCmdWriteTimestamp(cmd, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, queryPool, firstQuery(currentSlot) + 2 + scope * 2);
+	return scope;
+}
+
+void GpuProfiler::endScope(VkCommandBuffer cmd, uint32_t scope) {
+	if (scope == UINT32_MAX) {
+		return;
+	}
+	currentDepth--;
+	vkCmdWriteTimestamp(cmd, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, queryPool, firstQuery(currentSlot) + 3 + scope * 2);
+}
+
+double GpuProfiler::ticksToMs(uint64_t begin, uint64_t end) const {
+	uint64_t ticks = ((end & validMask) - (begin & validMask)) & validMask;
+	return static_cast<double>(ticks) * timestampPeriodNs / 1.0e6;
+}
+
+bool GpuProfiler::collect(uint32_t slot) {
+	SlotFrame &frame = slots[slot];
+	if (!frame.pending) {
+		return false;
+	}
+	frame.pending = false;
+
+	// Só as queries escritas; as que sobraram do bloco continuam resetadas (e dariam VK_NOT_READY)
+	std::array<uint64_t, QUERIES_PER_SLOT> timestamps{};
+	uint32_t                               queryCount = 2 + static_cast<uint32_t>(frame.scopes.size()) * 2;
+
+	VkResult result = vkGetQueryPoolResults(device, queryPool, firstQuery(slot), queryCount, queryCount * sizeof(uint64_t),
+	                                        timestamps.data(), sizeof(uint64_t), VK_QUERY_RESULT_64_BIT);
+	if (result != VK_SUCCESS) {
+		return false;
+	}
+
+	lastFrame.frameNumber = frame.frameNumber;
+	lastFrame.totalMs     = ticksToMs(timestamps[0], timestamps[1]);
+	lastFrame.scopes.clear();
+
+	for (size_t i = 0; i < frame.scopes.size(); i++) {
+		const Scope &scope = frame.scopes[i];
+		double       ms    = ticksToMs(timestamps[2 + i * 2], timestamps[3 + i * 2]);
+		lastFrame.scopes.push_back({scope.name, scope.depth, ms});
+
+		auto [it, inserted] = historyIndex.try_emplace(scope.name, histories.size());
+		if (inserted) {
+			histories.push_back({.name = scope.name});
+		}
+		histories[it->second].push(ms);
+	}
+	return true;
+}
+
+std::vector<GpuScopeStats> GpuProfiler::getScopeStats() const {
+	std::vector<GpuScopeStats> stats;
+	stats.reserve(histories.size());
+
+	for (const History &history : histories) {
+		GpuScopeStats scope;
+		scope.name   = history.name;
+		scope.lastMs = history.samples[(history.head + HISTORY_SIZE - 1) % HISTORY_SIZE];
+		scope.minMs  = history.samples[0];
+		scope.maxMs  = history.samples[0];
+
+		double sum = 0.0;
+		for (uint32_t i = 0; i < history.count; i++) {
+			sum         += history.samples[i];
+			scope.minMs  = std::min(scope.minMs, history.samples[i]);
+			scope.maxMs  = std::max(scope.maxMs, history.samples[i]);
+		}
+		scope.averageMs = history.count > 0 ? sum / history.count : 0.0;
+		stats.push_back(scope);
+	}
+	return stats;
+}
@@ -0,0 +1,167 @@
+#include <core/Logger.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cinttypes>
+#include <cstdio>
+
+namespace {
+	const auto processStart = std::chrono::steady_clock::now();
+
+	const char *levelName(LogLevel level) {
+		switch (level) {
+			case LogLevel::Trace: return "T";
+			case LogLevel::Debug: return "D";
+			case LogLevel::Info: return "I";
+			case LogLevel::Warning: return "W";
+			case LogLevel::Error: return "E";
+		}
+		return "?";
+	}
+}        // namespace
+
+Logger::Logger() {
+	for (size_t i = 0; i < RING_SIZE; i++) {
+		slots[i].sequence.store(i, std::memory_order_relaxed);
+	}
+	worker = std::thread(&Logger::run, this);
+}
+
+Logger::~Logger() {
+	running.store(false, std::memory_order_release);
+	published.fetch_add(1, std::memory_order_release);
+	published.notify_one();
+	worker.join();
+}
+
+Logger &Logger::instance() {
+	// Construído no primeiro log; o destrutor (fim do processo) escreve o que sobrou
+	static Logger logger;
+	return logger;
+}
+
+uint64_t Logger::now() {
+	return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - processStart).count());
+}
+
+void Logger::flush() {
+	Logger  &logger = instance();
+	uint64_t target = logger.enqueuePos.load(std::memory_order_acquire);        // Descartados nem chegam a ocupar posição
+	uint64_t done   = logger.written.load(std::memory_order_acquire);
+	while (done < target) {
+		logger.written.wait(done, std::memory_order_acquire);
+		done = logger.written.load(std::memory_order_acquire);
+	}
+}
+
+void Logger::Record::captureText(std::string_view value) {
+	Arg &arg = args[argCount++];
+	arg.type = Arg::Type::Text;
+
+	size_t length   = std::min<size_t>(value.size(), MAX_TEXT - textUsed);
+	arg.text.offset = textUsed;
+	arg.text.length = static_cast<uint16_t>(length);
+	std::memcpy(text + textUsed, value.data(), length);
+	if (length < value.size() && length >= 3) {
+		std::memcpy(text + textUsed + length - 3, "...", 3);
+	}
+	textUsed += static_cast<uint16_t>(length);
+}
+
+void Logger::format(const Record &record, std::string &line) {
+	char prefix[32];
+	snprintf(prefix, sizeof(prefix), "%9.3f %s [", record.timestampNs / 1e9, levelName(record.level));
+	line += prefix;
+	line += record.tag;
+	line += "] : ";
+
+	// Cada "{}" consome o próximo argumento; "{}" sobrando fica como está
+	uint8_t next = 0;
+	for (const char *c = record.format; *c; c++) {
+		if (c[0] != '{' || c[1] != '}' || next >= record.argCount) {
+			line += *c;
+			continue;
+		}
+		c++;
+
+		const Arg &arg = record.args[next++];
+		char       number[32];
+		switch (arg.type) {
+			case Arg::Type::Int:
+				snprintf(number, sizeof(number), "%" PRId64, arg.i);
+				line += number;
+				break;
+			case Arg::Type::Uint:
+				snprintf(number, sizeof(number), "%" PRIu64, arg.u);
+				line += number;
+				break;
+			case Arg::Type::Double:
+				snprintf(number, sizeof(number), "%g", arg.d);
+				line += number;
+				break;
+			case Arg::Type::Bool:
+				line += arg.b ? "true" : "false";
+				break;
+			case Arg::Type::Text:
+				line.append(record.text + arg.text.offset, arg.text.length);
+				break;
+		}
+	}
+	line += '\n';
+}
+
+bool Logger::drain(std::string &line) {
+	bool any = false;
+	for (;;) {
+		Slot    &slot = slots[dequeuePos & (RING_SIZE - 1)];
+		uint64_t seq  = slot.sequence.load(std::memory_order_acquire);
+		if (seq != dequeuePos + 1) {
+			break;        // Vazio (ou o próximo ainda está sendo preenchido)
+		}
+
+		line.clear();
+		format(slot.record, line);
+		FILE *stream = slot.record.level >= LogLevel::Warning ? stderr : stdout;
+		if (stream == stderr) {
+			fflush(stdout);        // Mantém a ordem entre os dois streams no terminal
+		}
+		fwrite(line.data(), 1, line.size(), stream);
+
+		// Devolve o slot para a próxima volta do ring
+		slot.sequence.store(dequeuePos + RING_SIZE, std::memory_order_release);
+		dequeuePos++;
+		written.fetch_add(1, std::memory_order_release);
+		any = true;
+	}
+
+	if (any) {
+		fflush(stdout);
+		written.notify_all();
+	}
+	return any;
+}
+
+void Logger::run() {
+	std::string line;
+	line.reserve(512);
+
+	uint64_t reportedDrops = 0;
+	for (;;) {
+		// Lê o contador antes de esvaziar: um push depois disto muda o valor e o wait não dorme
+		uint32_t seen = published.load(std::memory_order_acquire);
+		drain(line);
+
+		uint64_t drops = dropped.load(std::memory_order_relaxed);
+		if (drops != reportedDrops) {
+			fprintf(stderr, "[Logger] : %" PRIu64 " messages dropped (ring full).\n", drops - reportedDrops);
+			reportedDrops = drops;
+			written.notify_all();
+		}
+
+		if (!running.load(std::memory_order_acquire)) {
+			drain(line);
+			break;
+		}
+		published.wait(seen, std::memory_order_acquire);
+	}
+}
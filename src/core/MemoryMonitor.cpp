@@ -0,0 +1,108 @@
+#include <core/MemoryMonitor.hpp>
+#include <core/Logger.hpp>
+
+#include <fstream>
+#include <sstream>
+
+MemoryMonitor::MemoryMonitor(VmaWrapper& vmaWrapper, const ResourceManager& resources, uint32_t sampleInterval)
+    : m_vmaWrapper(&vmaWrapper),
+      m_resources(&resources),
+      m_sampleInterval(sampleInterval > 0 ? sampleInterval : 1) {
+   sample();
+}
+
+void MemoryMonitor::update(uint32_t frameIndex) {
+   m_lastFrameIndex = frameIndex;
+   m_vmaWrapper->setCurrentFrameIndex(frameIndex);
+
+   if (frameIndex % m_sampleInterval == 0) {
+      sample();
+   }
+}
+
+void MemoryMonitor::sample() {
+   std::vector<VmaBudget> budgets = m_vmaWrapper->getHeapBudgets();
+   VmaTotalStatistics stats = m_vmaWrapper->calculateStatistics();
+
+   m_heapSamples.resize(budgets.size());
+   for (size_t heap = 0; heap < budgets.size(); heap++) {
+      const VmaDetailedStatistics& detailed = stats.memoryHeap[heap];
+      HeapBudgetSample& heapSample = m_heapSamples[heap];
+
+      heapSample.usage              = budgets[heap].usage;
+      heapSample.budget             = budgets[heap].budget;
+      heapSample.blockBytes         = budgets[heap].statistics.blockBytes;
+      heapSample.allocationBytes    = budgets[heap].statistics.allocationBytes;
+      heapSample.unusedRangeCount   = detailed.unusedRangeCount;
+      heapSample.largestUnusedRange = detailed.unusedRangeCount > 0 ? detailed.unusedRangeSizeMax : 0;
+
+      VkDeviceSize unusedBytes = detailed.statistics.blockBytes - detailed.statistics.allocationBytes;
+      heapSample.fragmentation = unusedBytes > 0
+          ? 1.0f - static_cast<float>(heapSample.largestUnusedRange) / static_cast<float>(unusedBytes)
+          : 0.0f;
+   }
+
+   bool overBudget = isOverBudget();
+   if (overBudget && !m_warnedOverBudget) {
+      LOG_WARN("MemoryMonitor", "GPU memory usage above 90% of budget!");
+   }
+   m_warnedOverBudget = overBudget;
+}
+
+bool MemoryMonitor::isOverBudget(float threshold) const {
+   for (const auto& heapSample : m_heapSamples) {
+      if (heapSample.budget > 0 && heapSample.usage > static_cast<VkDeviceSize>(heapSample.budget * threshold)) {
+         return true;
+      }
+   }
+   return false;
+}
+
+std::string MemoryMonitor::toJson(bool includeVmaDetailedMap) const {
+   std::ostringstream json;
+   json << "{\n";
+   json << "  \"frame\": " << m_lastFrameIndex << ",\n";
+   json << "  \"memoryBudgetExtension\": " << (m_vmaWrapper->isMemoryBudgetEnabled() ? "true" : "false") << ",\n";
+
+   json << "  \"categories\": {\n";
+   for (uint32_t i = 0; i < static_cast<uint32_t>(ResourceCategory::Count); i++) {
+      ResourceCategory category = static_cast<ResourceCategory>(i);
+      const CategoryUsage& usage = m_resources->getCategoryUsage(category);
+      json << "    \"" << toString(category) << "\": {"
+           << "\"currentBytes\": " << usage.currentBytes << ", "
+           << "\"peakBytes\": " << usage.peakBytes << ", "
+           << "\"liveCount\": " << usage.liveCount << ", "
+           << "\"totalAllocations\": " << usage.totalAllocations << "}"
+           << (i + 1 < static_cast<uint32_t>(ResourceCategory::Count) ? "," : "") << "\n";
+   }
+   json << "  },\n";
+
+   json << "  \"heaps\": [\n";
+   for (size_t heap = 0; heap < m_heapSamples.size(); heap++) {
+      const HeapBudgetSample& heapSample = m_heapSamples[heap];
+      json << "    {\"index\": " << heap << ", "
+           << "\"usage\": " << heapSample.usage << ", "
+           << "\"budget\": " << heapSample.budget << ", "
+           << "\"blockBytes\": " << heapSample.blockBytes << ", "
+           << "\"allocationBytes\": " << heapSample.allocationBytes << ", "
+           << "\"unusedRangeCount\": " << heapSample.unusedRangeCount << ", "
+           << "\"largestUnusedRange\": " << heapSample.largestUnusedRange << ", "
+           << "\"fragmentation\": " << heapSample.fragmentation << "}"
+           << (heap + 1 < m_heapSamples.size() ? "," : "") << "\n";
+   }
+   json << "  ],\n";
+
+   // A VMA já gera JSON válido, então é só embutir
+   json << "  \"vma\": " << m_vmaWrapper->buildStatsString(includeVmaDetailedMap) << "\n";
+   json << "}\n";
+   return json.str();
+}
+
+void MemoryMonitor::dumpJson(const std::string& path, bool includeVmaDetailedMap) const {
+   std::ofstream file(path);
+   if (!file.is_open()) {
+      throw std::runtime_error("[MemoryMonitor] : Failed to open " + path);
+   }
+   file << toJson(includeVmaDetailedMap);
+   LOG_INFO("MemoryMonitor", "Memory report written to {}", path);
+}
@@ -1,4 +1,5 @@
 #include <core/Mesh.hpp>
+#include <core/Logger.hpp>
 
 Mesh::Mesh(BufferManager *bufferMgr) : vertexBuffer(INVALID_HANDLE),
                                        indexBuffer(INVALID_HANDLE),
@@ -14,7 +15,9 @@ Mesh::Mesh(Mesh &&other) noexcept
     : vertexBuffer(other.vertexBuffer),
       indexBuffer(other.indexBuffer),
       indexCount(other.indexCount),
-      bufferManager(other.bufferManager) {
+      bufferManager(other.bufferManager),
+      boundsMin(other.boundsMin),
+      boundsMax(other.boundsMax) {
 	other.vertexBuffer  = INVALID_HANDLE;
 	other.indexBuffer   = INVALID_HANDLE;
 	other.indexCount    = 0;
@@ -29,6 +32,8 @@ Mesh &Mesh::operator=(Mesh &&other) noexcept {
 		indexBuffer   = other.indexBuffer;
 		indexCount    = other.indexCount;
 		bufferManager = other.bufferManager;
+		boundsMin     = other.boundsMin;
+		boundsMax     = other.boundsMax;
 
 		other.vertexBuffer  = INVALID_HANDLE;
 		other.indexBuffer   = INVALID_HANDLE;
@@ -88,9 +93,9 @@ void Mesh::bind(VkCommandBuffer cmd) const {
 	}
 }
 
-void Mesh::draw(VkCommandBuffer cmd) const {
+void Mesh::draw(VkCommandBuffer cmd, uint32_t firstInstance) const {
 	if (indexCount > 0) {
-		vkCmdDrawIndexed(cmd, indexCount, 1, 0, 0, 0);
+		vkCmdDrawIndexed(cmd, indexCount, 1, 0, 0, firstInstance);
 	}
 }
 
@@ -118,10 +123,16 @@ void Mesh::upload(const MeshData &data, BufferManager &bufferManager) {
     );
     
     indexCount = static_cast<uint32_t>(data.indices.size());
+
+    boundsMin = glm::vec3(data.vertices[0].pos[0], data.vertices[0].pos[1], data.vertices[0].pos[2]);
+    boundsMax = boundsMin;
+    for (const Vertex &vertex : data.vertices) {
+        glm::vec3 position(vertex.pos[0], vertex.pos[1], vertex.pos[2]);
+        boundsMin = glm::min(boundsMin, position);
+        boundsMax = glm::max(boundsMax, position);
+    }
     
-    std::cout << "[Mesh] : Upload completo - " 
-              << data.vertices.size() << " vértices, "
-              << data.indices.size() << " índices" << std::endl;
+    LOG_DEBUG("Mesh", "Upload completo - {} vértices, {} índices", data.vertices.size(), data.indices.size());
 }
 
 
@@ -150,24 +161,49 @@ MeshData MeshFactory::makeQuad() {
 }
 
 MeshData MeshFactory::makeCube() {
+    // Uma face por vez (4 vértices cada) para a normal não ser dividida entre faces
+    struct Face {
+        glm::vec3 normal;
+        glm::vec3 u;
+        glm::vec3 v;
+        glm::vec3 color;
+    };
+    const Face faces[] = {
+        {{ 0.0f,  0.0f,  1.0f}, { 1.0f, 0.0f,  0.0f}, {0.0f, 1.0f,  0.0f}, {1.0f, 0.0f, 0.0f}}, // Frente
+        {{ 1.0f,  0.0f,  0.0f}, { 0.0f, 0.0f, -1.0f}, {0.0f, 1.0f,  0.0f}, {0.0f, 1.0f, 0.0f}}, // Direita
+        {{ 0.0f,  0.0f, -1.0f}, {-1.0f, 0.0f,  0.0f}, {0.0f, 1.0f,  0.0f}, {0.0f, 0.0f, 1.0f}}, // Trás
+        {{-1.0f,  0.0f,  0.0f}, { 0.0f, 0.0f,  1.0f}, {0.0f, 1.0f,  0.0f}, {1.0f, 1.0f, 0.0f}}, // Esquerda
+        {{ 0.0f,  1.0f,  0.0f}, { 1.0f, 0.0f,  0.0f}, {0.0f, 0.0f, -1.0f}, {1.0f, 0.0f, 1.0f}}, // Topo
+        {{ 0.0f, -1.0f,  0.0f}, { 1.0f, 0.0f,  0.0f}, {0.0f, 0.0f,  1.0f}, {0.0f, 1.0f, 1.0f}}  // Base
+    };
+
+    MeshData data;
+    for (const Face &face : faces) {
+        uint32_t base = static_cast<uint32_t>(data.vertices.size());
+        const float corners[4][2] = {{-0.5f, -0.5f}, {0.5f, -0.5f}, {0.5f, 0.5f}, {-0.5f, 0.5f}};
+        for (const auto &corner : corners) {
+            glm::vec3 position = face.normal * 0.5f + face.u * corner[0] + face.v * corner[1];
+            data.vertices.push_back({{position.x, position.y, position.z},
+                                     {face.color.x, face.color.y, face.color.z},
+                                     {corner[0] + 0.5f, corner[1] + 0.5f},
+                                     {face.normal.x, face.normal.y, face.normal.z}});
+        }
+        data.indices.insert(data.indices.end(), {base, base + 1, base + 2, base + 2, base + 3, base});
+    }
+    return data;
+}
+
+MeshData MeshFactory::makePlane(float width, float depth) {
+    float halfWidth = width * 0.5f;
+    float halfDepth = depth * 0.5f;
+
     MeshData data;
     data.vertices = {
-        {{-0.5f, -0.5f,  0.5f}, {1.0f, 0.0f, 0.0f}}, // 0
-        {{ 0.5f, -0.5f,  0.5f}, {0.0f, 1.0f, 0.0f}}, // 1
-        {{ 0.5f,  0.5f,  0.5f}, {0.0f, 0.0f, 1.0f}}, // 2
-        {{-0.5f,  0.5f,  0.5f}, {1.0f, 1.0f, 0.0f}}, // 3
-        {{-0.5f, -0.5f, -0.5f}, {1.0f, 0.0f, 1.0f}}, // 4
-        {{ 0.5f, -0.5f, -0.5f}, {0.0f, 1.0f, 1.0f}}, // 5
-        {{ 0.5f,  0.5f, -0.5f}, {1.0f, 1.0f, 1.0f}}, // 6
-        {{-0.5f,  0.5f, -0.5f}, {0.0f, 0.0f, 0.0f}}  // 7
-    };
-    data.indices = {
-        0, 1, 2, 2, 3, 0, // Frente
-        1, 5, 6, 6, 2, 1, // Direita
-        5, 4, 7, 7, 6, 5, // Trás
-        4, 0, 3, 3, 7, 4, // Esquerda
-        3, 2, 6, 6, 7, 3, // Topo
-        4, 5, 1, 1, 0, 4  // Base
+        {{-halfWidth, 0.0f,  halfDepth}, {1.0f, 1.0f, 1.0f}, {0.0f, 0.0f}, {0.0f, 1.0f, 0.0f}},
+        {{ halfWidth, 0.0f,  halfDepth}, {1.0f, 1.0f, 1.0f}, {1.0f, 0.0f}, {0.0f, 1.0f, 0.0f}},
+        {{ halfWidth, 0.0f, -halfDepth}, {1.0f, 1.0f, 1.0f}, {1.0f, 1.0f}, {0.0f, 1.0f, 0.0f}},
+        {{-halfWidth, 0.0f, -halfDepth}, {1.0f, 1.0f, 1.0f}, {0.0f, 1.0f}, {0.0f, 1.0f, 0.0f}}
     };
+    data.indices = {0, 1, 2, 2, 3, 0};
     return data;
-}
\ No newline at end of file
+}
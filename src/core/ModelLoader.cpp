@@ -1,13 +1,16 @@
+#include <core/CpuTracer.hpp>
+#include <core/Logger.hpp>
 #include <core/ModelLoader.hpp>
 
 std::vector<MeshData> ModelLoader::load(const std::string &path) {
-	std::cout << "[ModelLoader] : Carregando modelo: " << path << std::endl;
+	PROFILE_CPU_ZONE("ModelLoader::load");
+	LOG_INFO("ModelLoader", "Carregando modelo: {}", path);
 
 	Assimp::Importer importer;
 
 	// Flags importantes:
 	// aiProcess_Triangulate → garante que tudo vira triângulo
-	// aiProcess_GenNormals → gera normais (pra iluminação futura)
+	// aiProcess_GenNormals → gera normais (iluminação)
 	// aiProcess_JoinIdenticalVertices → otimiza vértices duplicados
 
 	const aiScene *scene = importer.ReadFile(path,
@@ -24,8 +27,7 @@ std::vector<MeshData> ModelLoader::load(const std::string &path) {
 	std::vector<MeshData> meshes;
 	processNode(scene->mRootNode, scene, meshes);
 
-	std::cout << "[ModelLoader] : Carregado com sucesso! "
-	          << meshes.size() << " submeshes encontradas." << std::endl;
+	LOG_INFO("ModelLoader", "Carregado com sucesso! {} submeshes encontradas.", meshes.size());
 
 	return meshes;
 }
@@ -68,6 +70,19 @@ MeshData ModelLoader::processMesh(const aiMesh* mesh) {
             vertex.color[1] = 0.7f;
             vertex.color[2] = 0.7f;
         }
+
+        // UV (só o primeiro canal)
+        if (mesh->HasTextureCoords(0)) {
+            vertex.texCoord[0] = mesh->mTextureCoords[0][i].x;
+            vertex.texCoord[1] = mesh->mTextureCoords[0][i].y;
+        }
+
+        // Normal (aiProcess_GenNormals garante, exceto em malhas só de linhas/pontos)
+        if (mesh->HasNormals()) {
+            vertex.normal[0] = mesh->mNormals[i].x;
+            vertex.normal[1] = mesh->mNormals[i].y;
+            vertex.normal[2] = mesh->mNormals[i].z;
+        }
         
         data.vertices.push_back(vertex);
     }
@@ -80,9 +95,7 @@ MeshData ModelLoader::processMesh(const aiMesh* mesh) {
         }
     }
     
-    std::cout << "[ModelLoader] :   Mesh processada - " 
-              << data.vertices.size() << " vértices, "
-              << data.indices.size() << " índices" << std::endl;
+    LOG_DEBUG("ModelLoader", "Mesh processada - {} vértices, {} índices", data.vertices.size(), data.indices.size());
     
     return data;
 }
\ No newline at end of file
@@ -0,0 +1,324 @@
+#include <core/Logger.hpp>
+#include <core/OcclusionCuller.hpp>
+#include <core/PipelineManager.hpp>
+
+#include <algorithm>
+#include <array>
+#include <stdexcept>
+#include <tuple>
+
+namespace {
+	// local_size de occlusion_cull.comp e depth_reduce.comp
+	constexpr uint32_t CULL_GROUP_SIZE   = 64;
+	constexpr uint32_t REDUCE_GROUP_SIZE = 8;
+
+	// Mesmo layout do push constant de depth_reduce.comp
+	struct ReducePushConstants {
+		uint32_t sourceWidth;
+		uint32_t sourceHeight;
+		uint32_t destinationWidth;
+		uint32_t destinationHeight;
+	};
+
+	uint32_t previousPowerOfTwo(uint32_t value) {
+		uint32_t result = 1;
+		while (result * 2 <= value) {
+			result *= 2;
+		}
+		return result;
+	}
+}        // namespace
+
+OcclusionCuller::OcclusionCuller(VkDevice                   device,
+                                 ResourceManager           &resources,
+                                 BufferManager             &buffers,
+                                 BindlessDescriptors       &bindless,
+                                 DescriptorLayoutCache     &layoutCache,
+                                 FrameDescriptorAllocators &frameDescriptors,
+                                 DeletionQueue             &deletionQueue,
+                                 uint32_t                   framesInFlight,
+                                 uint32_t                   maxDraws) :
+    device(device),
+    resources(resources),
+    buffers(buffers),
+    bindless(bindless),
+    frameDescriptors(frameDescriptors),
+    deletionQueue(deletionQueue),
+    maxDraws(maxDraws) {
+	// Duas metades de comandos (early/late)
+	drawBuffer            = buffers.createGpuStorageBuffer(2 * maxDraws * sizeof(VkDrawIndexedIndirectCommand), VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT);
+	visibilityBuffer      = buffers.createGpuStorageBuffer(maxDraws * sizeof(uint32_t));
+	drawBufferIndex       = bindless.registerStorageBuffer(buffers.getVkBuffer(drawBuffer));
+	visibilityBufferIndex = bindless.registerStorageBuffer(buffers.getVkBuffer(visibilityBuffer));
+
+	OcclusionStats zero{};
+	for (uint32_t i = 0; i < framesInFlight; i++) {
+		BufferHandle cullBuffer = buffers.createStorageBuffer(maxDraws * sizeof(GpuCullObject));
+		cullBuffers.push_back(cullBuffer);
+		cullBufferIndices.push_back(bindless.registerStorageBuffer(buffers.getVkBuffer(cullBuffer)));
+
+		BufferHandle statsBuffer = buffers.createStorageBuffer(sizeof(OcclusionStats));
+		buffers.updateBuffer(statsBuffer, &zero, sizeof(OcclusionStats));
+		statsBuffers.push_back(statsBuffer);
+		statsBufferIndices.push_back(bindless.registerStorageBuffer(buffers.getVkBuffer(statsBuffer)));
+	}
+
+	// Só texelFetch: o sampler existe porque o descritor é combined image sampler
+	VkSamplerCreateInfo samplerInfo{};
+	samplerInfo.sType        = VK_STRUCTURE_TYPE_SAMPLER_CREATE_INFO;
+	samplerInfo.magFilter    = VK_FILTER_NEAREST;
+	samplerInfo.minFilter    = VK_FILTER_NEAREST;
+	samplerInfo.mipmapMode   = VK_SAMPLER_MIPMAP_MODE_NEAREST;
+	samplerInfo.addressModeU = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+	samplerInfo.addressModeV = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+	samplerInfo.addressModeW = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+	samplerInfo.minLod       = 0.0f;
+	samplerInfo.maxLod       = VK_LOD_CLAMP_NONE;
+	if (vkCreateSampler(device, &samplerInfo, nullptr, &sampler) != VK_SUCCESS) {
+		throw std::runtime_error("[OcclusionCuller] : Failed to create depth pyramid sampler!");
+	}
+
+	std::array<VkDescriptorSetLayoutBinding, 2> bindings{};
+	bindings[0].binding         = 0;
+	bindings[0].descriptorType  = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+	bindings[0].descriptorCount = 1;
+	bindings[0].stageFlags      = VK_SHADER_STAGE_COMPUTE_BIT;
+	bindings[1].binding         = 1;
+	bindings[1].descriptorType  = VK_DESCRIPTOR_TYPE_STORAGE_IMAGE;
+	bindings[1].descriptorCount = 1;
+	bindings[1].stageFlags      = VK_SHADER_STAGE_COMPUTE_BIT;
+
+	VkDescriptorSetLayoutCreateInfo layoutInfo{};
+	layoutInfo.sType        = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+	layoutInfo.bindingCount = 2;
+	layoutInfo.pBindings    = bindings.data();
+	reduceSetLayout         = layoutCache.getLayout(layoutInfo);
+
+	layoutInfo.bindingCount = 1;
+	cullSetLayout           = layoutCache.getLayout(layoutInfo);
+
+	std::tie(cullPipeline, cullPipelineLayout)     = PipelineManager::createComputePipeline(device,
+                                                                                        "../assets/shaders/core/culling/compiled/comp.spv",
+                                                                                        {bindless.getLayout(), cullSetLayout},
+                                                                                        sizeof(CullPushConstants));
+	std::tie(reducePipeline, reducePipelineLayout) = PipelineManager::createComputePipeline(device,
+	                                                                                        "../assets/shaders/core/depth_pyramid/compiled/comp.spv",
+	                                                                                        {reduceSetLayout},
+	                                                                                        sizeof(ReducePushConstants));
+
+	LOG_INFO("OcclusionCuller", "Two-phase occlusion culling ready ({} draws max).", maxDraws);
+}
+
+OcclusionCuller::~OcclusionCuller() {
+	// Destruído com a GPU parada
+	if (pyramid != INVALID_HANDLE) {
+		destroyPyramid(device, resources, pyramid, pyramidMips);
+	}
+
+	PipelineManager::destroy(device, cullPipeline, cullPipelineLayout);
+	PipelineManager::destroy(device, reducePipeline, reducePipelineLayout);
+	vkDestroySampler(device, sampler, nullptr);
+
+	for (size_t i = 0; i < cullBuffers.size(); i++) {
+		bindless.releaseStorageBuffer(cullBufferIndices[i]);
+		buffers.destroyBuffer(cullBuffers[i]);
+		bindless.releaseStorageBuffer(statsBufferIndices[i]);
+		buffers.destroyBuffer(statsBuffers[i]);
+	}
+	bindless.releaseStorageBuffer(drawBufferIndex);
+	bindless.releaseStorageBuffer(visibilityBufferIndex);
+	buffers.destroyBuffer(drawBuffer);
+	buffers.destroyBuffer(visibilityBuffer);
+}
+
+const OcclusionStats &OcclusionCuller::beginFrame(uint32_t frame) {
+	this->frame = frame;
+
+	OcclusionStats zero{};
+	buffers.readBuffer(statsBuffers[frame], &lastStats, sizeof(OcclusionStats));
+	buffers.updateBuffer(statsBuffers[frame], &zero, sizeof(OcclusionStats));
+	return lastStats;
+}
+
+void OcclusionCuller::update(const glm::mat4 &viewProj, VkExtent2D depthExtent, const GpuCullObject *objects, size_t count, uint64_t retireValue) {
+	if (count > maxDraws) {
+		throw std::runtime_error("[OcclusionCuller] : Too many draws for the indirect buffer!");
+	}
+
+	VkExtent2D extent = {previousPowerOfTwo(std::max(depthExtent.width, 1u)), previousPowerOfTwo(std::max(depthExtent.height, 1u))};
+	if (extent.width != pyramidExtent.width || extent.height != pyramidExtent.height) {
+		retirePyramid(retireValue);
+		createPyramid(extent);
+	}
+	this->depthExtent = depthExtent;
+
+	// Outra cena: os índices de visibilidade não correspondem mais aos mesmos objetos
+	historyValid = visibilityWritten && count == drawCount;
+	drawCount    = static_cast<uint32_t>(count);
+	if (count > 0) {
+		buffers.updateBuffer(cullBuffers[frame], objects, count * sizeof(GpuCullObject));
+	}
+
+	constants.viewProj              = viewProj;
+	constants.cullBufferIndex       = cullBufferIndices[frame];
+	constants.drawBufferIndex       = drawBufferIndex;
+	constants.visibilityBufferIndex = visibilityBufferIndex;
+	constants.statsBufferIndex      = statsBufferIndices[frame];
+	constants.drawCount             = drawCount;
+	constants.lateOffset            = maxDraws;
+	constants.pyramidSize           = glm::vec2(static_cast<float>(pyramidExtent.width), static_cast<float>(pyramidExtent.height));
+	constants.pyramidLevels         = pyramidLevels;
+}
+
+VkDeviceSize OcclusionCuller::getDrawOffset(Phase phase, uint32_t draw) const {
+	uint32_t first = phase == Phase::Late ? maxDraws : 0;
+	return static_cast<VkDeviceSize>(first + draw) * sizeof(VkDrawIndexedIndirectCommand);
+}
+
+void OcclusionCuller::recordCull(VkCommandBuffer cmd, Phase phase) {
+	CullPushConstants push = constants;
+	push.phase             = phase == Phase::Late ? 1 : 0;
+	push.historyValid      = historyValid ? 1 : 0;
+
+	vkCmdBindPipeline(cmd, VK_PIPELINE_BIND_POINT_COMPUTE, cullPipeline);
+	bindless.bind(cmd, cullPipelineLayout, VK_PIPELINE_BIND_POINT_COMPUTE);
+
+	// A fase early não lê a pirâmide, mas o layout do pipeline é o mesmo
+	VkDescriptorSet set = frameDescriptors.allocate(cullSetLayout);
+
+	VkDescriptorImageInfo imageInfo{sampler, getPyramidView(), VK_IMAGE_LAYOUT_GENERAL};
+	VkWriteDescriptorSet  write{};
+	write.sType           = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+	write.dstSet          = set;
+	write.dstBinding      = 0;
+	write.descriptorCount = 1;
+	write.descriptorType  = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+	write.pImageInfo      = &imageInfo;
+	vkUpdateDescriptorSets(device, 1, &write, 0, nullptr);
+	vkCmdBindDescriptorSets(cmd, VK_PIPELINE_BIND_POINT_COMPUTE, cullPipelineLayout, 1, 1, &set, 0, nullptr);
+
+	vkCmdPushConstants(cmd, cullPipelineLayout, VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(CullPushConstants), &push);
+	vkCmdDispatch(cmd, (drawCount + CULL_GROUP_SIZE - 1) / CULL_GROUP_SIZE, 1, 1);
+
+	if (phase == Phase::Late) {
+		// Contadores lidos pela CPU quando o slot voltar (o render graph não conhece leituras do host)
+		VkMemoryBarrier barrier{};
+		barrier.sType         = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+		barrier.srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT;
+		barrier.dstAccessMask = VK_ACCESS_HOST_READ_BIT;
+		vkCmdPipelineBarrier(cmd, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_HOST_BIT, 0, 1, &barrier, 0, nullptr, 0, nullptr);
+		visibilityWritten = true;
+	}
+}
+
+void OcclusionCuller::recordDepthPyramid(VkCommandBuffer cmd, VkImageView depthView) {
+	vkCmdBindPipeline(cmd, VK_PIPELINE_BIND_POINT_COMPUTE, reducePipeline);
+
+	// O render graph deixa o depth em SHADER_READ_ONLY e a pirâmide inteira em GENERAL;
+	// entre os mips a barreira é daqui mesmo (o graph vê a pirâmide como um recurso só)
+	VkExtent2D sourceExtent = depthExtent;
+	for (uint32_t level = 0; level < pyramidLevels; level++) {
+		VkExtent2D destinationExtent = {std::max(pyramidExtent.width >> level, 1u), std::max(pyramidExtent.height >> level, 1u)};
+
+		VkDescriptorImageInfo source{sampler, level == 0 ? depthView : pyramidMips[level - 1],
+		                             level == 0 ? VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL : VK_IMAGE_LAYOUT_GENERAL};
+		VkDescriptorImageInfo destination{VK_NULL_HANDLE, pyramidMips[level], VK_IMAGE_LAYOUT_GENERAL};
+
+		VkDescriptorSet                     set = frameDescriptors.allocate(reduceSetLayout);
+		std::array<VkWriteDescriptorSet, 2> writes{};
+		writes[0].sType           = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+		writes[0].dstSet          = set;
+		writes[0].dstBinding      = 0;
+		writes[0].descriptorCount = 1;
+		writes[0].descriptorType  = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+		writes[0].pImageInfo      = &source;
+		writes[1].sType           = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+		writes[1].dstSet          = set;
+		writes[1].dstBinding      = 1;
+		writes[1].descriptorCount = 1;
+		writes[1].descriptorType  = VK_DESCRIPTOR_TYPE_STORAGE_IMAGE;
+		writes[1].pImageInfo      = &destination;
+		vkUpdateDescriptorSets(device, static_cast<uint32_t>(writes.size()), writes.data(), 0, nullptr);
+		vkCmdBindDescriptorSets(cmd, VK_PIPELINE_BIND_POINT_COMPUTE, reducePipelineLayout, 0, 1, &set, 0, nullptr);
+
+		// O mip 0 reduz o depth inteiro (até 3x3 texels por texel: o depth não é potência de 2)
+		ReducePushConstants push{sourceExtent.width, sourceExtent.height, destinationExtent.width, destinationExtent.height};
+		vkCmdPushConstants(cmd, reducePipelineLayout, VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(ReducePushConstants), &push);
+		vkCmdDispatch(cmd, (destinationExtent.width + REDUCE_GROUP_SIZE - 1) / REDUCE_GROUP_SIZE,
+		              (destinationExtent.height + REDUCE_GROUP_SIZE - 1) / REDUCE_GROUP_SIZE, 1);
+
+		VkImageMemoryBarrier barrier{};
+		barrier.sType                         = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+		barrier.srcAccessMask                 = VK_ACCESS_SHADER_WRITE_BIT;
+		barrier.dstAccessMask                 = VK_ACCESS_SHADER_READ_BIT;
+		barrier.oldLayout                     = VK_IMAGE_LAYOUT_GENERAL;
+		barrier.newLayout                     = VK_IMAGE_LAYOUT_GENERAL;
+		barrier.srcQueueFamilyIndex           = VK_QUEUE_FAMILY_IGNORED;
+		barrier.dstQueueFamilyIndex           = VK_QUEUE_FAMILY_IGNORED;
+		barrier.image                         = getPyramidImage();
+		barrier.subresourceRange.aspectMask   = VK_IMAGE_ASPECT_COLOR_BIT;
+		barrier.subresourceRange.baseMipLevel = level;
+		barrier.subresourceRange.levelCount   = 1;
+		barrier.subresourceRange.layerCount   = 1;
+		vkCmdPipelineBarrier(cmd, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, 0, 0, nullptr, 0, nullptr, 1, &barrier);
+
+		sourceExtent = destinationExtent;
+	}
+}
+
+void OcclusionCuller::createPyramid(VkExtent2D extent) {
+	pyramidExtent = extent;
+	pyramidLevels = 1;
+	while ((std::max(extent.width, extent.height) >> pyramidLevels) > 0) {
+		pyramidLevels++;
+	}
+
+	pyramid = resources.createImage({.extent    = {extent.width, extent.height, 1},
+	                                 .format    = PYRAMID_FORMAT,
+	                                 .mipLevels = pyramidLevels,
+	                                 .usage     = VK_IMAGE_USAGE_STORAGE_BIT | VK_IMAGE_USAGE_SAMPLED_BIT,
+	                                 .aspect    = VK_IMAGE_ASPECT_COLOR_BIT,
+	                                 .category  = ResourceCategory::RenderTarget});
+
+	for (uint32_t level = 0; level < pyramidLevels; level++) {
+		VkImageViewCreateInfo viewInfo{};
+		viewInfo.sType                           = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
+		viewInfo.image                           = getPyramidImage();
+		viewInfo.viewType                        = VK_IMAGE_VIEW_TYPE_2D;
+		viewInfo.format                          = PYRAMID_FORMAT;
+		viewInfo.subresourceRange.aspectMask     = VK_IMAGE_ASPECT_COLOR_BIT;
+		viewInfo.subresourceRange.baseMipLevel   = level;
+		viewInfo.subresourceRange.levelCount     = 1;
+		viewInfo.subresourceRange.baseArrayLayer = 0;
+		viewInfo.subresourceRange.layerCount     = 1;
+
+		VkImageView view;
+		if (vkCreateImageView(device, &viewInfo, nullptr, &view) != VK_SUCCESS) {
+			throw std::runtime_error("[OcclusionCuller] : Failed to create depth pyramid mip view!");
+		}
+		pyramidMips.push_back(view);
+	}
+	LOG_DEBUG("OcclusionCuller", "Depth pyramid {}x{} with {} mips.", extent.width, extent.height, pyramidLevels);
+}
+
+void OcclusionCuller::retirePyramid(uint64_t retireValue) {
+	if (pyramid == INVALID_HANDLE) {
+		return;
+	}
+
+	// Frames já enviados ainda podem ler a pirâmide antiga
+	deletionQueue.push(retireValue, [device = device, resources = &resources, image = pyramid, views = pyramidMips]() {
+		destroyPyramid(device, *resources, image, views);
+	});
+	pyramid = INVALID_HANDLE;
+	pyramidMips.clear();
+	pyramidExtent = {0, 0};
+	pyramidLevels = 0;
+}
+
+void OcclusionCuller::destroyPyramid(VkDevice device, ResourceManager &resources, ImageHandle image, const std::vector<VkImageView> &views) {
+	for (VkImageView view : views) {
+		vkDestroyImageView(device, view, nullptr);
+	}
+	resources.destroyImage(image);
+}
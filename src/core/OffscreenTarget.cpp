@@ -0,0 +1,78 @@
+#include <core/OffscreenTarget.hpp>
+#include <core/Logger.hpp>
+
+#include <cstring>
+#include <stdexcept>
+
+VkFormat OffscreenTarget::chooseDepthFormat(VkPhysicalDevice physicalDevice) {
+	for (VkFormat format : {VK_FORMAT_D32_SFLOAT, VK_FORMAT_D16_UNORM}) {
+		VkFormatProperties properties;
+		vkGetPhysicalDeviceFormatProperties(physicalDevice, format, &properties);
+		if (properties.optimalTilingFeatures & VK_FORMAT_FEATURE_DEPTH_STENCIL_ATTACHMENT_BIT) {
+			return format;
+		}
+	}
+	throw std::runtime_error("[OffscreenTarget] : No supported depth format!");
+}
+
+OffscreenTarget::OffscreenTarget(ResourceManager &resources, BufferManager &bufferManager, VkExtent2D extent) :
+    resources(resources),
+    bufferManager(bufferManager),
+    extent(extent) {
+	colorImage = resources.createImage({.extent   = {extent.width, extent.height, 1},
+	                                    .format   = COLOR_FORMAT,
+	                                    .usage    = VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_TRANSFER_SRC_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT,
+	                                    .category = ResourceCategory::RenderTarget});
+
+	LOG_INFO("OffscreenTarget", "Created {}x{} color target.", extent.width, extent.height);
+}
+
+OffscreenTarget::~OffscreenTarget() {
+	resources.destroyImage(colorImage);
+}
+
+ImageData OffscreenTarget::readback() {
+	ImageData image;
+	image.width  = extent.width;
+	image.height = extent.height;
+	image.pixels.resize(static_cast<size_t>(extent.width) * extent.height * 4);
+
+	BufferHandle readbackBuffer = bufferManager.createReadbackBuffer(image.pixels.size());
+
+	bufferManager.executeOneTimeCommands([&](VkCommandBuffer cmd) {
+		VkImageMemoryBarrier toTransfer{};
+		toTransfer.sType                       = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+		toTransfer.srcAccessMask               = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
+		toTransfer.dstAccessMask               = VK_ACCESS_TRANSFER_READ_BIT;
+		toTransfer.oldLayout                   = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+		toTransfer.newLayout                   = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
+		toTransfer.srcQueueFamilyIndex         = VK_QUEUE_FAMILY_IGNORED;
+		toTransfer.dstQueueFamilyIndex         = VK_QUEUE_FAMILY_IGNORED;
+		toTransfer.image                       = resources.getVkImage(colorImage);
+		toTransfer.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+		toTransfer.subresourceRange.levelCount = 1;
+		toTransfer.subresourceRange.layerCount = 1;
+		vkCmdPipelineBarrier(cmd, VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT,
+		                     0, 0, nullptr, 0, nullptr, 1, &toTransfer);
+
+		VkBufferImageCopy region{};
+		region.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+		region.imageSubresource.layerCount = 1;
+		region.imageExtent                 = {extent.width, extent.height, 1};
+		vkCmdCopyImageToBuffer(cmd, toTransfer.image, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+		                       bufferManager.getVkBuffer(readbackBuffer), 1, &region);
+
+		// Volta para o layout que o próximo frame espera encontrar
+		VkImageMemoryBarrier toAttachment = toTransfer;
+		toAttachment.srcAccessMask        = VK_ACCESS_TRANSFER_READ_BIT;
+		toAttachment.dstAccessMask        = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
+		toAttachment.oldLayout            = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
+		toAttachment.newLayout            = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+		vkCmdPipelineBarrier(cmd, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT,
+		                     0, 0, nullptr, 0, nullptr, 1, &toAttachment);
+	});
+
+	bufferManager.readBuffer(readbackBuffer, image.pixels.data(), image.pixels.size());
+	bufferManager.destroyBuffer(readbackBuffer);
+	return image;
+}
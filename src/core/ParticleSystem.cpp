@@ -0,0 +1,329 @@
+#include <core/Logger.hpp>
+#include <core/ParticleSystem.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <tuple>
+
+namespace {
+	// local_size_x de particles.comp
+	constexpr uint32_t PARTICLE_GROUP_SIZE = 64;
+
+	// Passes de particles.comp
+	constexpr uint32_t PASS_RESET    = 0;
+	constexpr uint32_t PASS_EMIT     = 1;
+	constexpr uint32_t PASS_ARGS     = 2;
+	constexpr uint32_t PASS_SIMULATE = 3;
+	constexpr uint32_t PASS_FINALIZE = 4;
+
+	// Layout do argsBuffer: VkDispatchIndirectCommand (+ pad) e VkDrawIndirectCommand
+	constexpr VkDeviceSize DISPATCH_ARGS_OFFSET = 0;
+	constexpr VkDeviceSize DRAW_ARGS_OFFSET     = 16;
+	constexpr VkDeviceSize ARGS_SIZE            = DRAW_ARGS_OFFSET + sizeof(VkDrawIndirectCommand);
+
+	// Contadores antes dos vivos por emissor: vivas da lista 0 e 1, livres, pad
+	constexpr uint32_t COUNTER_HEADER = 4;
+
+	constexpr uint32_t FLAG_ADDITIVE = 1;
+
+	uint32_t groupCount(uint32_t threads) {
+		return (threads + PARTICLE_GROUP_SIZE - 1) / PARTICLE_GROUP_SIZE;
+	}
+
+	// Escritas de compute visíveis para o próximo dispatch (e, se pedido, para o indirect)
+	void computeBarrier(VkCommandBuffer cmd, VkPipelineStageFlags srcStages, VkPipelineStageFlags dstStages, VkAccessFlags dstAccess) {
+		VkMemoryBarrier barrier{};
+		barrier.sType         = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+		barrier.srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT;
+		barrier.dstAccessMask = dstAccess;
+		vkCmdPipelineBarrier(cmd, srcStages, dstStages, 0, 1, &barrier, 0, nullptr, 0, nullptr);
+	}
+}        // namespace
+
+ParticleEmitter ParticleEmitter::preset(ParticleType type) {
+	ParticleEmitter emitter;
+	emitter.type = type;
+	switch (type) {
+		case ParticleType::TireSmoke:
+			emitter.spawnRadius = 0.05f;
+			emitter.speedSpread = 0.35f;
+			emitter.color       = glm::vec4(0.78f, 0.78f, 0.8f, 0.3f);
+			emitter.lifetimeMin = 2.5f;
+			emitter.lifetimeMax = 4.0f;
+			emitter.startSize   = 0.12f;
+			emitter.endSize     = 0.9f;
+			emitter.gravity     = -0.35f;
+			emitter.drag        = 1.2f;
+			emitter.rate        = 300.0f;
+			emitter.budget      = 2048;
+			break;
+		case ParticleType::Sparks:
+			emitter.spawnRadius = 0.02f;
+			emitter.speedSpread = 1.5f;
+			emitter.color       = glm::vec4(1.0f, 0.62f, 0.22f, 1.0f);
+			emitter.lifetimeMin = 0.25f;
+			emitter.lifetimeMax = 0.6f;
+			emitter.startSize   = 0.025f;
+			emitter.endSize     = 0.01f;
+			emitter.gravity     = 9.8f;
+			emitter.drag        = 0.3f;
+			emitter.rate        = 80.0f;
+			emitter.budget      = 256;
+			emitter.additive    = true;
+			break;
+		case ParticleType::Dust:
+			emitter.spawnRadius = 0.1f;
+			emitter.speedSpread = 0.4f;
+			emitter.color       = glm::vec4(0.55f, 0.46f, 0.34f, 0.25f);
+			emitter.lifetimeMin = 1.0f;
+			emitter.lifetimeMax = 2.0f;
+			emitter.startSize   = 0.08f;
+			emitter.endSize     = 0.4f;
+			emitter.gravity     = 0.3f;
+			emitter.drag        = 2.0f;
+			emitter.rate        = 120.0f;
+			emitter.budget      = 512;
+			break;
+	}
+	return emitter;
+}
+
+ParticleSystem::ParticleSystem(VkDevice                device,
+                               BufferManager          &buffers,
+                               BindlessDescriptors    &bindless,
+                               VkFormat                colorFormat,
+                               VkFormat                depthFormat,
+                               uint32_t                framesInFlight,
+                               const ParticleSettings &settings) :
+    device(device),
+    buffers(buffers),
+    bindless(bindless),
+    settings(settings) {
+	if (settings.capacity == 0 || settings.maxEmitters == 0) {
+		throw std::runtime_error("[ParticleSystem] : Particle capacity and emitter count must not be zero!");
+	}
+
+	particleBuffer = buffers.createGpuStorageBuffer(static_cast<VkDeviceSize>(settings.capacity) * sizeof(GpuParticle));
+	deadBuffer     = buffers.createGpuStorageBuffer(settings.capacity * sizeof(uint32_t));
+	counterBuffer  = buffers.createGpuStorageBuffer((COUNTER_HEADER + settings.maxEmitters) * sizeof(uint32_t));
+	argsBuffer     = buffers.createGpuStorageBuffer(ARGS_SIZE, VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT);
+
+	particleBufferIndex = bindless.registerStorageBuffer(buffers.getVkBuffer(particleBuffer));
+	deadBufferIndex     = bindless.registerStorageBuffer(buffers.getVkBuffer(deadBuffer));
+	counterBufferIndex  = bindless.registerStorageBuffer(buffers.getVkBuffer(counterBuffer));
+	argsBufferIndex     = bindless.registerStorageBuffer(buffers.getVkBuffer(argsBuffer));
+	for (uint32_t i = 0; i < 2; i++) {
+		aliveLists[i]       = buffers.createGpuStorageBuffer(settings.capacity * sizeof(uint32_t));
+		aliveListIndices[i] = bindless.registerStorageBuffer(buffers.getVkBuffer(aliveLists[i]));
+	}
+
+	ParticleStats zero{};
+	for (uint32_t i = 0; i < framesInFlight; i++) {
+		BufferHandle emitterBuffer = buffers.createStorageBuffer(settings.maxEmitters * sizeof(GpuParticleEmitter));
+		emitterBuffers.push_back(emitterBuffer);
+		emitterBufferIndices.push_back(bindless.registerStorageBuffer(buffers.getVkBuffer(emitterBuffer)));
+
+		BufferHandle statsBuffer = buffers.createStorageBuffer(sizeof(ParticleStats));
+		buffers.updateBuffer(statsBuffer, &zero, sizeof(ParticleStats));
+		statsBuffers.push_back(statsBuffer);
+		statsBufferIndices.push_back(bindless.registerStorageBuffer(buffers.getVkBuffer(statsBuffer)));
+	}
+
+	gpuEmitters.reserve(settings.maxEmitters);
+	spawnCarry.assign(settings.maxEmitters, 0.0f);
+
+	std::tie(simulatePipeline, simulatePipelineLayout) = PipelineManager::createComputePipeline(device,
+	                                                                                            "../assets/shaders/core/particles/compiled/comp.spv",
+	                                                                                            {bindless.getLayout()},
+	                                                                                            sizeof(SimulatePushConstants));
+
+	// Quads montados no vertex shader; depth só testado (sem ordenação, blend premultiplicado)
+	PipelineConfig pipelineConfig{};
+	pipelineConfig.extend                 = {1, 1};        // Viewport e scissor são dinâmicos
+	pipelineConfig.colorAttachmentFormats = {colorFormat};
+	pipelineConfig.depthAttachmentFormat  = depthFormat;
+	pipelineConfig.vertexShaderPath       = "../assets/shaders/core/particles/compiled/vert.spv";
+	pipelineConfig.fragmentShaderPath     = "../assets/shaders/core/particles/compiled/frag.spv";
+	pipelineConfig.setLayouts             = {bindless.getLayout()};
+	pipelineConfig.cullMode               = VK_CULL_MODE_NONE;
+	pipelineConfig.vertexInput            = false;
+	pipelineConfig.depthWrite             = false;
+	pipelineConfig.premultipliedAlpha     = true;
+	pipelineConfig.pushConstantSize       = sizeof(DrawPushConstants);
+
+	std::tie(drawPipeline, drawPipelineLayout) = PipelineManager::createGraphicsPipeline(device, pipelineConfig);
+
+	LOG_INFO("ParticleSystem", "{} particles max, {} emitters ({} KiB of particle state).", settings.capacity, settings.maxEmitters,
+	         (static_cast<VkDeviceSize>(settings.capacity) * (sizeof(GpuParticle) + 3 * sizeof(uint32_t))) / 1024);
+}
+
+ParticleSystem::~ParticleSystem() {
+	PipelineManager::destroy(device, simulatePipeline, simulatePipelineLayout);
+	PipelineManager::destroy(device, drawPipeline, drawPipelineLayout);
+
+	for (size_t i = 0; i < emitterBuffers.size(); i++) {
+		bindless.releaseStorageBuffer(emitterBufferIndices[i]);
+		buffers.destroyBuffer(emitterBuffers[i]);
+		bindless.releaseStorageBuffer(statsBufferIndices[i]);
+		buffers.destroyBuffer(statsBuffers[i]);
+	}
+	for (uint32_t i = 0; i < 2; i++) {
+		bindless.releaseStorageBuffer(aliveListIndices[i]);
+		buffers.destroyBuffer(aliveLists[i]);
+	}
+	bindless.releaseStorageBuffer(particleBufferIndex);
+	bindless.releaseStorageBuffer(deadBufferIndex);
+	bindless.releaseStorageBuffer(counterBufferIndex);
+	bindless.releaseStorageBuffer(argsBufferIndex);
+	buffers.destroyBuffer(particleBuffer);
+	buffers.destroyBuffer(deadBuffer);
+	buffers.destroyBuffer(counterBuffer);
+	buffers.destroyBuffer(argsBuffer);
+}
+
+const ParticleStats &ParticleSystem::beginFrame(uint32_t frame) {
+	this->frame = frame;
+
+	ParticleStats zero{};
+	buffers.readBuffer(statsBuffers[frame], &lastStats, sizeof(ParticleStats));
+	buffers.updateBuffer(statsBuffers[frame], &zero, sizeof(ParticleStats));
+	return lastStats;
+}
+
+void ParticleSystem::update(float time, const glm::mat4 &view, const glm::mat4 &viewProj, float groundHeight, const ParticleEmitter *emitters, size_t count) {
+	if (count > settings.maxEmitters && !overflowWarned) {
+		LOG_WARN("ParticleSystem", "{} emitters, only the first {} are used.", count, settings.maxEmitters);
+		overflowWarned = true;
+	}
+
+	// A lista que a simulação anterior escreveu é a lida agora
+	if (pendingSwap) {
+		currentList = 1 - currentList;
+		pendingSwap = false;
+	}
+
+	// Passo limitado: uma pausa longa (janela arrastada, benchmark reiniciado) não vira um salto
+	float deltaTime = lastTime < 0.0f ? 0.0f : std::clamp(time - lastTime, 0.0f, 0.1f);
+	lastTime        = time;
+
+	emitterCount = static_cast<uint32_t>(std::min<size_t>(count, settings.maxEmitters));
+	maxSpawn     = 0;
+	gpuEmitters.clear();
+	for (uint32_t i = 0; i < emitterCount; i++) {
+		const ParticleEmitter &emitter = emitters[i];
+
+		// Taxa contínua: a fração que não fecha uma partícula fica para o próximo frame
+		spawnCarry[i] += emitter.rate * deltaTime;
+		float    whole  = std::floor(spawnCarry[i]);
+		uint32_t spawns = static_cast<uint32_t>(std::min(whole, static_cast<float>(settings.maxSpawnPerFrame)));
+		spawnCarry[i] -= whole;
+		maxSpawn = std::max(maxSpawn, spawns);
+
+		gpuEmitters.push_back({.positionRadius = glm::vec4(emitter.position, emitter.spawnRadius),
+		                       .velocitySpread = glm::vec4(emitter.velocity, emitter.speedSpread),
+		                       .color          = emitter.color,
+		                       .lifeSize       = glm::vec4(emitter.lifetimeMin, std::max(emitter.lifetimeMax, emitter.lifetimeMin), emitter.startSize, emitter.endSize),
+		                       .gravity        = emitter.gravity,
+		                       .drag           = emitter.drag,
+		                       .spawnCount     = spawns,
+		                       .budget         = emitter.budget,
+		                       .flags          = emitter.additive ? FLAG_ADDITIVE : 0u,
+		                       .pad            = {}});
+	}
+	std::fill(spawnCarry.begin() + emitterCount, spawnCarry.end(), 0.0f);
+	if (emitterCount > 0) {
+		buffers.updateBuffer(emitterBuffers[frame], gpuEmitters.data(), emitterCount * sizeof(GpuParticleEmitter));
+	}
+
+	simulateConstants.particleBufferIndex = particleBufferIndex;
+	simulateConstants.deadBufferIndex     = deadBufferIndex;
+	simulateConstants.counterBufferIndex  = counterBufferIndex;
+	simulateConstants.argsBufferIndex     = argsBufferIndex;
+	simulateConstants.emitterBufferIndex  = emitterBufferIndices[frame];
+	simulateConstants.statsBufferIndex    = statsBufferIndices[frame];
+	simulateConstants.currentListIndex    = aliveListIndices[currentList];
+	simulateConstants.nextListIndex       = aliveListIndices[1 - currentList];
+	simulateConstants.currentList         = currentList;
+	simulateConstants.capacity            = settings.capacity;
+	simulateConstants.emitterCount        = emitterCount;
+	simulateConstants.maxEmitters         = settings.maxEmitters;
+	simulateConstants.seed                = ++seed;
+	simulateConstants.deltaTime           = deltaTime;
+	simulateConstants.groundHeight        = groundHeight;
+
+	// Eixos da câmera no mundo (linhas da view): os quads ficam sempre de frente
+	drawConstants.viewProj            = viewProj;
+	drawConstants.cameraRight         = glm::vec4(view[0][0], view[1][0], view[2][0], 0.0f);
+	drawConstants.cameraUp            = glm::vec4(view[0][1], view[1][1], view[2][1], 0.0f);
+	drawConstants.particleBufferIndex = particleBufferIndex;
+	drawConstants.drawListIndex       = aliveListIndices[1 - currentList];
+}
+
+void ParticleSystem::dispatch(VkCommandBuffer cmd, uint32_t pass, uint32_t groupsX, uint32_t groupsY) {
+	simulateConstants.pass = pass;
+	vkCmdPushConstants(cmd, simulatePipelineLayout, VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(SimulatePushConstants), &simulateConstants);
+	vkCmdDispatch(cmd, groupsX, groupsY, 1);
+}
+
+void ParticleSystem::recordSimulation(VkCommandBuffer cmd) {
+	vkCmdBindPipeline(cmd, VK_PIPELINE_BIND_POINT_COMPUTE, simulatePipeline);
+	bindless.bind(cmd, simulatePipelineLayout, VK_PIPELINE_BIND_POINT_COMPUTE);
+
+	// Contadores, pilha e listas do frame anterior (compute) e o desenho dele (vertex/indirect)
+	computeBarrier(cmd,
+	               VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT | VK_PIPELINE_STAGE_VERTEX_SHADER_BIT | VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT,
+	               VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+	               VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT);
+
+	if (needsReset) {
+		dispatch(cmd, PASS_RESET, groupCount(std::max(settings.capacity, settings.maxEmitters)));
+		computeBarrier(cmd, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT);
+		needsReset = false;
+	}
+
+	if (emitterCount > 0 && maxSpawn > 0) {
+		dispatch(cmd, PASS_EMIT, groupCount(maxSpawn), emitterCount);
+		computeBarrier(cmd, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT);
+	}
+
+	dispatch(cmd, PASS_ARGS, 1);
+	computeBarrier(cmd,
+	               VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+	               VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT | VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+	               VK_ACCESS_INDIRECT_COMMAND_READ_BIT | VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT);
+
+	// Um thread por partícula viva; o número de grupos só existe na GPU
+	simulateConstants.pass = PASS_SIMULATE;
+	vkCmdPushConstants(cmd, simulatePipelineLayout, VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(SimulatePushConstants), &simulateConstants);
+	vkCmdDispatchIndirect(cmd, buffers.getVkBuffer(argsBuffer), DISPATCH_ARGS_OFFSET);
+	computeBarrier(cmd, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT);
+
+	// A barreira até o draw indireto vem do render graph (o pass declara a escrita)
+	dispatch(cmd, PASS_FINALIZE, 1);
+	pendingSwap = true;
+}
+
+void ParticleSystem::recordDraw(VkCommandBuffer cmd, VkExtent2D extent) const {
+	vkCmdBindPipeline(cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, drawPipeline);
+
+	VkViewport viewport{};
+	viewport.x        = 0.0f;
+	viewport.y        = 0.0f;
+	viewport.width    = static_cast<float>(extent.width);
+	viewport.height   = static_cast<float>(extent.height);
+	viewport.minDepth = 0.0f;
+	viewport.maxDepth = 1.0f;
+	vkCmdSetViewport(cmd, 0, 1, &viewport);
+
+	VkRect2D scissor{};
+	scissor.offset = {0, 0};
+	scissor.extent = extent;
+	vkCmdSetScissor(cmd, 0, 1, &scissor);
+
+	bindless.bind(cmd, drawPipelineLayout);
+	vkCmdPushConstants(cmd, drawPipelineLayout, VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT, 0, sizeof(DrawPushConstants), &drawConstants);
+
+	// 6 vértices por partícula viva; instanceCount escrito pelo finalize
+	vkCmdDrawIndirect(cmd, buffers.getVkBuffer(argsBuffer), DRAW_ARGS_OFFSET, 1, sizeof(VkDrawIndirectCommand));
+}
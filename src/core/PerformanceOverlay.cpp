@@ -0,0 +1,208 @@
+#include <core/PerformanceOverlay.hpp>
+#include <core/Logger.hpp>
+
+#include <imgui.h>
+#include <imgui_impl_glfw.h>
+#include <imgui_impl_vulkan.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <stdexcept>
+
+namespace {
+	void checkVkResult(VkResult result) {
+		if (result != VK_SUCCESS) {
+			LOG_ERROR("PerformanceOverlay", "Vulkan error {}", result);
+		}
+	}
+}        // namespace
+
+PerformanceOverlay::PerformanceOverlay(const InitInfo &info) :
+    window(info.window) {
+	IMGUI_CHECKVERSION();
+	ImGui::CreateContext();
+	ImGuiIO &io    = ImGui::GetIO();
+	io.IniFilename = nullptr;        // Sem imgui.ini ao lado do executável
+	ImGui::StyleColorsDark();
+
+	// Instala os callbacks de input encadeados com os que já existem na janela
+	ImGui_ImplGlfw_InitForVulkan(window, true);
+
+	ImGui_ImplVulkan_InitInfo initInfo{};
+	initInfo.ApiVersion         = VK_API_VERSION_1_3;
+	initInfo.Instance           = info.instance;
+	initInfo.PhysicalDevice     = info.physicalDevice;
+	initInfo.Device             = info.device;
+	initInfo.QueueFamily        = info.queueFamily;
+	initInfo.Queue              = info.queue;
+	initInfo.DescriptorPoolSize = IMGUI_IMPL_VULKAN_MINIMUM_IMAGE_SAMPLER_POOL_SIZE;
+	initInfo.MinImageCount      = std::max(info.imageCount, 2u);
+	initInfo.ImageCount         = std::max(info.imageCount, 2u);
+	initInfo.MSAASamples        = VK_SAMPLE_COUNT_1_BIT;
+	initInfo.CheckVkResultFn    = checkVkResult;
+
+	if (info.renderPass != VK_NULL_HANDLE) {
+		initInfo.RenderPass = info.renderPass;
+		initInfo.Subpass    = 0;
+	}
+	else {
+		initInfo.UseDynamicRendering                                 = true;
+		initInfo.PipelineRenderingCreateInfo.sType                   = VK_STRUCTURE_TYPE_PIPELINE_RENDERING_CREATE_INFO;
+		initInfo.PipelineRenderingCreateInfo.colorAttachmentCount    = 1;
+		initInfo.PipelineRenderingCreateInfo.pColorAttachmentFormats = &info.colorFormat;        // O backend copia
+	}
+
+	if (!ImGui_ImplVulkan_Init(&initInfo)) {
+		ImGui_ImplGlfw_Shutdown();
+		ImGui::DestroyContext();
+		throw std::runtime_error("[PerformanceOverlay] : Failed to initialize ImGui Vulkan backend!");
+	}
+
+	lastUploadTime = glfwGetTime();
+	LOG_INFO("PerformanceOverlay", "Created ({}, F1 toggles).", info.renderPass != VK_NULL_HANDLE ? "render pass" : "dynamic rendering");
+}
+
+PerformanceOverlay::~PerformanceOverlay() {
+	ImGui_ImplVulkan_Shutdown();
+	ImGui_ImplGlfw_Shutdown();
+	ImGui::DestroyContext();
+}
+
+void PerformanceOverlay::handleInput() {
+	// Alterna na borda de descida: segurar a tecla não fica piscando
+	bool down = glfwGetKey(window, TOGGLE_KEY) == GLFW_PRESS;
+	if (down && !toggleWasDown) {
+		visible = !visible;
+	}
+	toggleWasDown = down;
+
+	// Escondido não há NewFrame para consumir os eventos que os callbacks do GLFW enfileiram
+	if (!visible) {
+		ImGui::GetIO().ClearEventsQueue();
+	}
+}
+
+void PerformanceOverlay::addFrameSample(float cpuFrameMs, float gpuFrameMs) {
+	cpuHistory[historyHead] = cpuFrameMs;
+	gpuHistory[historyHead] = gpuFrameMs;
+	historyHead             = (historyHead + 1) % HISTORY_SIZE;
+}
+
+void PerformanceOverlay::setMinImageCount(uint32_t count) {
+	ImGui_ImplVulkan_SetMinImageCount(std::max(count, 2u));
+}
+
+void PerformanceOverlay::plotHistory(const char *label, const std::array<float, HISTORY_SIZE> &history) const {
+	float last = history[(historyHead + HISTORY_SIZE - 1) % HISTORY_SIZE];
+	float peak = *std::max_element(history.begin(), history.end());
+
+	// Escala fixa em 33 ms (30 FPS) até algum frame passar disso
+	char overlayText[64];
+	snprintf(overlayText, sizeof(overlayText), "%s %.2f ms", label, last);
+	ImGui::PlotLines("##history", history.data(), HISTORY_SIZE, static_cast<int>(historyHead), overlayText,
+	                 0.0f, std::max(33.3f, peak * 1.1f), ImVec2(300.0f, 60.0f));
+}
+
+void PerformanceOverlay::build(const OverlayFrameData &data) {
+	ImGui_ImplVulkan_NewFrame();
+	ImGui_ImplGlfw_NewFrame();
+	ImGui::NewFrame();
+
+	ImGui::SetNextWindowPos(ImVec2(10.0f, 10.0f), ImGuiCond_FirstUseEver);
+	ImGui::SetNextWindowBgAlpha(0.8f);
+	ImGui::Begin("Performance (F1)", nullptr, ImGuiWindowFlags_AlwaysAutoResize | ImGuiWindowFlags_NoFocusOnAppearing | ImGuiWindowFlags_NoNav);
+
+	// ---- Tempos de frame ----
+	float cpuLast = cpuHistory[(historyHead + HISTORY_SIZE - 1) % HISTORY_SIZE];
+	ImGui::Text("%.1f FPS", cpuLast > 0.0f ? 1000.0f / cpuLast : 0.0f);
+	ImGui::PushID("cpu");
+	plotHistory("CPU", cpuHistory);
+	ImGui::PopID();
+	if (data.gpuScopes) {
+		ImGui::PushID("gpu");
+		plotHistory("GPU", gpuHistory);
+		ImGui::PopID();
+	}
+
+	if (data.pacing) {
+		ImGui::Text("Frames in flight: %u  CPU wait: %.2f ms (avg %.2f, max %.2f)",
+		            data.pacing->framesInFlight, data.pacing->lastCpuWaitMs, data.pacing->averageCpuWaitMs, data.pacing->maxCpuWaitMs);
+	}
+
+	// ---- Passadas na GPU ----
+	if (data.gpuScopes && !data.gpuScopes->empty() && ImGui::CollapsingHeader("GPU passes", ImGuiTreeNodeFlags_DefaultOpen)) {
+		if (ImGui::BeginTable("gpuPasses", 4, ImGuiTableFlags_SizingFixedFit)) {
+			ImGui::TableSetupColumn("Pass");
+			ImGui::TableSetupColumn("Last");
+			ImGui::TableSetupColumn("Avg");
+			ImGui::TableSetupColumn("Max");
+			ImGui::TableHeadersRow();
+			for (const GpuScopeStats &scope : *data.gpuScopes) {
+				ImGui::TableNextRow();
+				ImGui::TableNextColumn();
+				ImGui::TextUnformatted(scope.name.c_str());
+				ImGui::TableNextColumn();
+				ImGui::Text("%.3f", scope.lastMs);
+				ImGui::TableNextColumn();
+				ImGui::Text("%.3f", scope.averageMs);
+				ImGui::TableNextColumn();
+				ImGui::Text("%.3f", scope.maxMs);
+			}
+			ImGui::EndTable();
+		}
+	}
+
+	// ---- Geometria ----
+	if (data.frame && ImGui::CollapsingHeader("Geometry", ImGuiTreeNodeFlags_DefaultOpen)) {
+		const FrameStats &frame = *data.frame;
+		ImGui::Text("Draw calls: %u (%u instances, %u culled)", frame.drawCalls, frame.instances, frame.culledObjects);
+		ImGui::Text("Triangles:  %llu", static_cast<unsigned long long>(frame.triangles));
+		ImGui::Text("Binds: %u pipeline, %u vertex, %u index, %u descriptor", frame.pipelineBinds, frame.vertexBufferBinds,
+		            frame.indexBufferBinds, frame.descriptorBinds);
+		ImGui::Text("Push constants: %u bytes", frame.pushConstantBytes);
+		ImGui::Text("Shadow cascades: %u rendered, %u cached", frame.shadowCascadesRendered, frame.shadowCascadesCached);
+		ImGui::Text("Point lights: %u", frame.pointLights);
+		ImGui::Text("Particles: %u", frame.particles);
+		ImGui::Text("Render scale: %.0f%%", frame.renderScale * 100.0f);
+	}
+
+	// ---- CPU por estágio ----
+	if (data.frame && ImGui::CollapsingHeader("CPU stages")) {
+		for (size_t stage = 0; stage < static_cast<size_t>(FrameStage::Count); stage++) {
+			ImGui::Text("%-8s %.3f ms", toString(static_cast<FrameStage>(stage)), data.frame->cpuMs[stage]);
+		}
+	}
+
+	// ---- Memória e uploads ----
+	if (ImGui::CollapsingHeader("Memory", ImGuiTreeNodeFlags_DefaultOpen)) {
+		if (data.heaps) {
+			for (size_t heap = 0; heap < data.heaps->size(); heap++) {
+				const HeapBudgetSample &sample = (*data.heaps)[heap];
+				if (sample.budget == 0) {
+					continue;
+				}
+				double usageMB  = sample.usage / (1024.0 * 1024.0);
+				double budgetMB = sample.budget / (1024.0 * 1024.0);
+				char   label[64];
+				snprintf(label, sizeof(label), "heap %zu: %.0f / %.0f MB", heap, usageMB, budgetMB);
+				ImGui::ProgressBar(static_cast<float>(usageMB / budgetMB), ImVec2(300.0f, 0.0f), label);
+			}
+		}
+
+		// Vazão recalculada a cada meio segundo (um frame só é ruidoso demais)
+		double now = glfwGetTime();
+		if (now - lastUploadTime >= 0.5) {
+			uploadRateMBps    = (data.uploadedBytes - lastUploadedBytes) / (1024.0 * 1024.0) / (now - lastUploadTime);
+			lastUploadedBytes = data.uploadedBytes;
+			lastUploadTime    = now;
+		}
+		ImGui::Text("Uploads: %.1f MB/s (%.1f MB total)", uploadRateMBps, data.uploadedBytes / (1024.0 * 1024.0));
+	}
+
+	ImGui::End();
+	ImGui::Render();
+}
+
+void PerformanceOverlay::record(VkCommandBuffer cmd) {
+	ImGui_ImplVulkan_RenderDrawData(ImGui::GetDrawData(), cmd);
+}
@@ -1,11 +1,18 @@
 #include "core/PipelineManager.hpp"
+#include <core/ResourceTypes.hpp>
+#include <core/Logger.hpp>
+
+#include <cstddef>
 
 std::pair<VkPipeline, VkPipelineLayout> PipelineManager::createGraphicsPipeline(VkDevice device, const PipelineConfig &config) {
-	auto vertShaderCode = ShaderManager::readFile("../assets/shaders/core/cube/compiled/vert.spv");
-	auto fragShaderCode = ShaderManager::readFile("../assets/shaders/core/cube/compiled/frag.spv");
+	// Sem fragment shader o pipeline só escreve depth
+	bool hasFragment = !config.fragmentShaderPath.empty();
+
+	auto vertShaderCode = ShaderManager::readFile(config.vertexShaderPath);
+	auto fragShaderCode = hasFragment ? ShaderManager::readFile(config.fragmentShaderPath) : std::vector<char>{};
 
 	VkShaderModule vertShaderModule = ShaderManager::createShaderModule(device, vertShaderCode);
-	VkShaderModule fragShaderModule = ShaderManager::createShaderModule(device, fragShaderCode);
+	VkShaderModule fragShaderModule = hasFragment ? ShaderManager::createShaderModule(device, fragShaderCode) : VK_NULL_HANDLE;
 
 	// --- 2. Create Shader Stage Info  ---
 
@@ -23,7 +30,7 @@ std::pair<VkPipeline, VkPipelineLayout> PipelineManager::createGraphicsPipeline(
 
 	VkPipelineShaderStageCreateInfo shaderStages[] = {vertShaderStageInfo, fragShaderStageInfo};
 
-	std::cout << "[PipelineManager] : Successfully created shader stages!" << std::endl;
+	LOG_INFO("PipelineManager", "Successfully created shader stages!");
 
 	// ============================= Fixed Functions =====================================
 	// https://vulkan-tutorial.com/Drawing_a_triangle/Graphics_pipeline_basics/Fixed_functions
@@ -43,10 +50,10 @@ std::pair<VkPipeline, VkPipelineLayout> PipelineManager::createGraphicsPipeline(
 
 	VkVertexInputBindingDescription bindingDescription{};
 	bindingDescription.binding   = 0;
-	bindingDescription.stride    = sizeof(float) * 6;        // 3 floats pos + 3 floats color
+	bindingDescription.stride    = sizeof(Vertex);        // pos + color + texCoord
 	bindingDescription.inputRate = VK_VERTEX_INPUT_RATE_VERTEX;
 
-	std::vector<VkVertexInputAttributeDescription> attributeDescriptions(2);
+	std::vector<VkVertexInputAttributeDescription> attributeDescriptions(3);
 	// Posição (Location 0)
 	attributeDescriptions[0].binding  = 0;
 	attributeDescriptions[0].location = 0;
@@ -59,18 +66,30 @@ std::pair<VkPipeline, VkPipelineLayout> PipelineManager::createGraphicsPipeline(
 	attributeDescriptions[1].format   = VK_FORMAT_R32G32B32_SFLOAT;
 	attributeDescriptions[1].offset   = sizeof(float) * 3;
 
+	// UV (Location 2)
+	attributeDescriptions[2].binding  = 0;
+	attributeDescriptions[2].location = 2;
+	attributeDescriptions[2].format   = VK_FORMAT_R32G32_SFLOAT;
+	attributeDescriptions[2].offset   = offsetof(Vertex, texCoord);
+
+	// Normal (Location 3)
+	attributeDescriptions[3].binding  = 0;
+	attributeDescriptions[3].location = 3;
+	attributeDescriptions[3].format   = VK_FORMAT_R32G32B32_SFLOAT;
+	attributeDescriptions[3].offset   = offsetof(Vertex, normal);
+
 	VkPipelineVertexInputStateCreateInfo vertexInputInfo{};
 	vertexInputInfo.sType                           = VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_STATE_CREATE_INFO;
-	vertexInputInfo.vertexBindingDescriptionCount   = 1;
+	vertexInputInfo.vertexBindingDescriptionCount   = config.vertexInput ? 1 : 0;
 	vertexInputInfo.pVertexBindingDescriptions      = &bindingDescription;
-	vertexInputInfo.vertexAttributeDescriptionCount = static_cast<uint32_t>(attributeDescriptions.size());
+	vertexInputInfo.vertexAttributeDescriptionCount = config.vertexInput ? static_cast<uint32_t>(attributeDescriptions.size()) : 0;
 	vertexInputInfo.pVertexAttributeDescriptions    = attributeDescriptions.data();
 
 	// ------------------------------ Input Assembly -------------------------------------
 
 	VkPipelineInputAssemblyStateCreateInfo inputAssembly{};
 	inputAssembly.sType                  = VK_STRUCTURE_TYPE_PIPELINE_INPUT_ASSEMBLY_STATE_CREATE_INFO;
-	inputAssembly.topology               = VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST;
+	inputAssembly.topology               = config.topology;
 	inputAssembly.primitiveRestartEnable = VK_FALSE;
 
 	// ------------------------------ Viewports and Scissors -----------------------------
@@ -99,15 +118,15 @@ std::pair<VkPipeline, VkPipelineLayout> PipelineManager::createGraphicsPipeline(
 	rasterizer.sType                   = VK_STRUCTURE_TYPE_PIPELINE_RASTERIZATION_STATE_CREATE_INFO;
 	rasterizer.depthClampEnable        = VK_FALSE;
 	rasterizer.rasterizerDiscardEnable = VK_FALSE;
-	rasterizer.polygonMode             = VK_POLYGON_MODE_FILL;
+	rasterizer.polygonMode             = config.polygonMode;
 	rasterizer.lineWidth               = 1.0f;
-	rasterizer.cullMode                = VK_CULL_MODE_BACK_BIT;
+	rasterizer.cullMode                = config.cullMode;
 	rasterizer.frontFace               = VK_FRONT_FACE_COUNTER_CLOCKWISE;
 
-	rasterizer.depthBiasEnable         = VK_FALSE;
-	rasterizer.depthBiasConstantFactor = 0.0f;        // Optional
-	rasterizer.depthBiasClamp          = 0.0f;        // Optional
-	rasterizer.depthBiasSlopeFactor    = 0.0f;        // Optional
+	rasterizer.depthBiasEnable         = config.depthBias ? VK_TRUE : VK_FALSE;
+	rasterizer.depthBiasConstantFactor = config.depthBiasConstant;
+	rasterizer.depthBiasClamp          = 0.0f;
+	rasterizer.depthBiasSlopeFactor    = config.depthBiasSlope;
 
 	// ------------------------------ Multisampling --------------------------------------
 	VkPipelineMultisampleStateCreateInfo multisampling{};
@@ -120,19 +139,36 @@ std::pair<VkPipeline, VkPipelineLayout> PipelineManager::createGraphicsPipeline(
 	multisampling.alphaToOneEnable      = VK_FALSE;        // Optional
 
 	// ------------------------------ Depth and stencil testing --------------------------
-	// Implementar depois
+	// Só quando a passada tem depth (ex.: depth transiente do render graph)
+	bool hasDepth = config.depthAttachmentFormat != VK_FORMAT_UNDEFINED;
+
+	VkPipelineDepthStencilStateCreateInfo depthStencil{};
+	depthStencil.sType            = VK_STRUCTURE_TYPE_PIPELINE_DEPTH_STENCIL_STATE_CREATE_INFO;
+	depthStencil.depthTestEnable  = VK_TRUE;
+	depthStencil.depthWriteEnable = config.depthWrite ? VK_TRUE : VK_FALSE;
+	depthStencil.depthCompareOp   = VK_COMPARE_OP_LESS;
+	depthStencil.minDepthBounds   = 0.0f;
+	depthStencil.maxDepthBounds   = 1.0f;
 
 	// ------------------------------ Color blending --------------------------------------
 	VkPipelineColorBlendAttachmentState colorBlendAttachment{};
 	colorBlendAttachment.colorWriteMask = VK_COLOR_COMPONENT_R_BIT | VK_COLOR_COMPONENT_G_BIT |
 	                                      VK_COLOR_COMPONENT_B_BIT | VK_COLOR_COMPONENT_A_BIT;
-	colorBlendAttachment.blendEnable = VK_FALSE;
+	colorBlendAttachment.blendEnable = config.premultipliedAlpha ? VK_TRUE : VK_FALSE;
+	if (config.premultipliedAlpha) {
+		colorBlendAttachment.srcColorBlendFactor = VK_BLEND_FACTOR_ONE;
+		colorBlendAttachment.dstColorBlendFactor = VK_BLEND_FACTOR_ONE_MINUS_SRC_ALPHA;
+		colorBlendAttachment.colorBlendOp        = VK_BLEND_OP_ADD;
+		colorBlendAttachment.srcAlphaBlendFactor = VK_BLEND_FACTOR_ONE;
+		colorBlendAttachment.dstAlphaBlendFactor = VK_BLEND_FACTOR_ONE_MINUS_SRC_ALPHA;
+		colorBlendAttachment.alphaBlendOp        = VK_BLEND_OP_ADD;
+	}
 
 	VkPipelineColorBlendStateCreateInfo colorBlending{};
 	colorBlending.sType             = VK_STRUCTURE_TYPE_PIPELINE_COLOR_BLEND_STATE_CREATE_INFO;
 	colorBlending.logicOpEnable     = VK_FALSE;
 	colorBlending.logicOp           = VK_LOGIC_OP_COPY;
-	colorBlending.attachmentCount   = 1;
+	colorBlending.attachmentCount   = config.renderPass == VK_NULL_HANDLE ? static_cast<uint32_t>(config.colorAttachmentFormats.size()) : 1;
 	colorBlending.pAttachments      = &colorBlendAttachment;
 	colorBlending.blendConstants[0] = 0.0f;
 	colorBlending.blendConstants[1] = 0.0f;
@@ -143,13 +179,13 @@ std::pair<VkPipeline, VkPipelineLayout> PipelineManager::createGraphicsPipeline(
 
 	VkPushConstantRange pushConstant{};
 	pushConstant.offset     = 0;
-	pushConstant.size       = sizeof(MeshPushConstants);
-	pushConstant.stageFlags = VK_SHADER_STAGE_VERTEX_BIT;
+	pushConstant.size       = config.pushConstantSize;
+	pushConstant.stageFlags = VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT;
 
 	VkPipelineLayoutCreateInfo pipelineLayoutInfo{};
 	pipelineLayoutInfo.sType                  = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
-	pipelineLayoutInfo.setLayoutCount         = 0;
-	pipelineLayoutInfo.pSetLayouts            = nullptr;
+	pipelineLayoutInfo.setLayoutCount         = static_cast<uint32_t>(config.setLayouts.size());
+	pipelineLayoutInfo.pSetLayouts            = config.setLayouts.data();
 	pipelineLayoutInfo.pushConstantRangeCount = 1;
 	pipelineLayoutInfo.pPushConstantRanges    = &pushConstant;
 
@@ -158,17 +194,26 @@ std::pair<VkPipeline, VkPipelineLayout> PipelineManager::createGraphicsPipeline(
 		throw std::runtime_error("[PipelineManager] Failed to create pipeline layout!");
 	}
 
+	// ------------------------------ Dynamic rendering ----------------------------------
+	// Sem render pass o pipeline só precisa saber os formatos dos attachments
+	VkPipelineRenderingCreateInfo renderingInfo{};
+	renderingInfo.sType                   = VK_STRUCTURE_TYPE_PIPELINE_RENDERING_CREATE_INFO;
+	renderingInfo.colorAttachmentCount    = static_cast<uint32_t>(config.colorAttachmentFormats.size());
+	renderingInfo.pColorAttachmentFormats = config.colorAttachmentFormats.data();
+	renderingInfo.depthAttachmentFormat   = config.depthAttachmentFormat;
+
 	// ========== 9. GRAPHICS PIPELINE CREATION ==========
 	VkGraphicsPipelineCreateInfo pipelineInfo{};
 	pipelineInfo.sType               = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO;
-	pipelineInfo.stageCount          = 2;
+	pipelineInfo.pNext               = config.renderPass == VK_NULL_HANDLE ? &renderingInfo : nullptr;
+	pipelineInfo.stageCount          = hasFragment ? 2 : 1;
 	pipelineInfo.pStages             = shaderStages;
 	pipelineInfo.pVertexInputState   = &vertexInputInfo;
 	pipelineInfo.pInputAssemblyState = &inputAssembly;
 	pipelineInfo.pViewportState      = &viewportState;
 	pipelineInfo.pRasterizationState = &rasterizer;
 	pipelineInfo.pMultisampleState   = &multisampling;
-	pipelineInfo.pDepthStencilState  = nullptr;
+	pipelineInfo.pDepthStencilState  = hasDepth ? &depthStencil : nullptr;
 	pipelineInfo.pColorBlendState    = &colorBlending;
 	pipelineInfo.pDynamicState       = &dynamicState;
 	pipelineInfo.layout              = pipelineLayout;
@@ -184,13 +229,60 @@ std::pair<VkPipeline, VkPipelineLayout> PipelineManager::createGraphicsPipeline(
 	}
 
 	ShaderManager::destroyShaderModule(device, vertShaderModule);
-	ShaderManager::destroyShaderModule(device, fragShaderModule);
+	if (hasFragment) {
+		ShaderManager::destroyShaderModule(device, fragShaderModule);
+	}
 
 	return std::make_pair(graphicsPipeline, pipelineLayout);
 }
 
+std::pair<VkPipeline, VkPipelineLayout> PipelineManager::createComputePipeline(VkDevice                                  device,
+                                                                              const std::string                        &shaderPath,
+                                                                              const std::vector<VkDescriptorSetLayout> &setLayouts,
+                                                                              uint32_t                                  pushConstantSize) {
+	auto           shaderCode   = ShaderManager::readFile(shaderPath);
+	VkShaderModule shaderModule = ShaderManager::createShaderModule(device, shaderCode);
+
+	VkPushConstantRange pushConstant{};
+	pushConstant.offset     = 0;
+	pushConstant.size       = pushConstantSize;
+	pushConstant.stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
+
+	VkPipelineLayoutCreateInfo pipelineLayoutInfo{};
+	pipelineLayoutInfo.sType                  = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+	pipelineLayoutInfo.setLayoutCount         = static_cast<uint32_t>(setLayouts.size());
+	pipelineLayoutInfo.pSetLayouts            = setLayouts.data();
+	pipelineLayoutInfo.pushConstantRangeCount = pushConstantSize > 0 ? 1 : 0;
+	pipelineLayoutInfo.pPushConstantRanges    = &pushConstant;
+
+	VkPipelineLayout pipelineLayout;
+	if (vkCreatePipelineLayout(device, &pipelineLayoutInfo, nullptr, &pipelineLayout) != VK_SUCCESS) {
+		ShaderManager::destroyShaderModule(device, shaderModule);
+		throw std::runtime_error("[PipelineManager] Failed to create compute pipeline layout!");
+	}
+
+	VkComputePipelineCreateInfo pipelineInfo{};
+	pipelineInfo.sType        = VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO;
+	pipelineInfo.stage.sType  = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+	pipelineInfo.stage.stage  = VK_SHADER_STAGE_COMPUTE_BIT;
+	pipelineInfo.stage.module = shaderModule;
+	pipelineInfo.stage.pName  = "main";
+	pipelineInfo.layout       = pipelineLayout;
+
+	VkPipeline computePipeline;
+	VkResult   result = vkCreateComputePipelines(device, VK_NULL_HANDLE, 1, &pipelineInfo, nullptr, &computePipeline);
+	ShaderManager::destroyShaderModule(device, shaderModule);
+	if (result != VK_SUCCESS) {
+		vkDestroyPipelineLayout(device, pipelineLayout, nullptr);
+		throw std::runtime_error("[PipelineManager] Failed to create compute pipeline!");
+	}
+
+	LOG_INFO("PipelineManager", "Compute pipeline created from {}", shaderPath);
+	return std::make_pair(computePipeline, pipelineLayout);
+}
+
 void PipelineManager::destroy(VkDevice device, VkPipeline pipeline, VkPipelineLayout layout) {
-	std::cout << "[PipelineManager] : Destroying graphics pipeline and layout..." << std::endl;
+	LOG_INFO("PipelineManager", "Destroying graphics pipeline and layout...");
 	vkDestroyPipeline(device, pipeline, nullptr);
 	vkDestroyPipelineLayout(device, layout, nullptr);
 }
\ No newline at end of file
@@ -0,0 +1,423 @@
+#include <core/PngDecoder.hpp>
+
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+
+namespace {
+
+// ================== Inflate (RFC 1951) ============================
+
+// Lê bits do stream, LSB primeiro
+struct BitReader {
+	const uint8_t *data;
+	size_t         size;
+	size_t         pos      = 0;
+	uint32_t       bitBuf   = 0;
+	int            bitCount = 0;
+
+	uint32_t bits(int count) {
+		while (bitCount < count) {
+			if (pos >= size) {
+				throw std::runtime_error("[PngDecoder] : Unexpected end of deflate stream");
+			}
+			bitBuf |= static_cast<uint32_t>(data[pos++]) << bitCount;
+			bitCount += 8;
+		}
+		uint32_t value = bitBuf & ((1u << count) - 1);
+		bitBuf >>= count;
+		bitCount -= count;
+		return value;
+	}
+
+	// Descarta os bits que sobraram do byte atual
+	void alignToByte() {
+		bitBuf   = 0;
+		bitCount = 0;
+	}
+};
+
+// Tabela de Huffman canônica (mesmo esquema do puff.c do zlib)
+struct Huffman {
+	uint16_t counts[16];
+	uint16_t symbols[288];
+
+	void build(const uint8_t *lengths, int symbolCount) {
+		std::memset(counts, 0, sizeof(counts));
+		for (int symbol = 0; symbol < symbolCount; symbol++) {
+			counts[lengths[symbol]]++;
+		}
+		counts[0] = 0;
+
+		uint16_t offsets[16];
+		offsets[1] = 0;
+		for (int len = 1; len < 15; len++) {
+			offsets[len + 1] = offsets[len] + counts[len];
+		}
+		for (int symbol = 0; symbol < symbolCount; symbol++) {
+			if (lengths[symbol] != 0) {
+				symbols[offsets[lengths[symbol]]++] = static_cast<uint16_t>(symbol);
+			}
+		}
+	}
+
+	int decode(BitReader &reader) const {
+		int code = 0, first = 0, index = 0;
+		for (int len = 1; len < 16; len++) {
+			code |= static_cast<int>(reader.bits(1));
+			int count = counts[len];
+			if (code - count < first) {
+				return symbols[index + (code - first)];
+			}
+			index += count;
+			first += count;
+			first <<= 1;
+			code <<= 1;
+		}
+		throw std::runtime_error("[PngDecoder] : Invalid Huffman code");
+	}
+};
+
+const uint16_t lengthBase[29]  = {3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31, 35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258};
+const uint8_t  lengthExtra[29] = {0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2, 3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0};
+const uint16_t distBase[30]    = {1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193, 257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097, 6145, 8193, 12289, 16385, 24577};
+const uint8_t  distExtra[30]   = {0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6, 7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13};
+
+void inflateBlock(BitReader &reader, const Huffman &literals, const Huffman &distances, std::vector<uint8_t> &out) {
+	while (true) {
+		int symbol = literals.decode(reader);
+		if (symbol < 256) {
+			out.push_back(static_cast<uint8_t>(symbol));
+			continue;
+		}
+		if (symbol == 256) {
+			return;
+		}
+
+		symbol -= 257;
+		if (symbol >= 29) {
+			throw std::runtime_error("[PngDecoder] : Invalid length symbol");
+		}
+		size_t length = lengthBase[symbol] + reader.bits(lengthExtra[symbol]);
+
+		int distSymbol = distances.decode(reader);
+		if (distSymbol >= 30) {
+			throw std::runtime_error("[PngDecoder] : Invalid distance symbol");
+		}
+		size_t distance = distBase[distSymbol] + reader.bits(distExtra[distSymbol]);
+		if (distance > out.size()) {
+			throw std::runtime_error("[PngDecoder] : Distance too far back");
+		}
+
+		// Cópia byte a byte: origem e destino podem se sobrepor
+		size_t start = out.size() - distance;
+		for (size_t i = 0; i < length; i++) {
+			out.push_back(out[start + i]);
+		}
+	}
+}
+
+void buildFixedTables(Huffman &literals, Huffman &distances) {
+	uint8_t lengths[288];
+	for (int i = 0; i < 144; i++) lengths[i] = 8;
+	for (int i = 144; i < 256; i++) lengths[i] = 9;
+	for (int i = 256; i < 280; i++) lengths[i] = 7;
+	for (int i = 280; i < 288; i++) lengths[i] = 8;
+	literals.build(lengths, 288);
+
+	for (int i = 0; i < 30; i++) lengths[i] = 5;
+	distances.build(lengths, 30);
+}
+
+void buildDynamicTables(BitReader &reader, Huffman &literals, Huffman &distances) {
+	static const uint8_t order[19] = {16, 17, 18, 0, 8, 7, 9, 6, 10, 5, 11, 4, 12, 3, 13, 2, 14, 1, 15};
+
+	int literalCount  = static_cast<int>(reader.bits(5)) + 257;
+	int distanceCount = static_cast<int>(reader.bits(5)) + 1;
+	int codeLenCount  = static_cast<int>(reader.bits(4)) + 4;
+
+	uint8_t codeLengths[19] = {};
+	for (int i = 0; i < codeLenCount; i++) {
+		codeLengths[order[i]] = static_cast<uint8_t>(reader.bits(3));
+	}
+	Huffman codeLenTable;
+	codeLenTable.build(codeLengths, 19);
+
+	uint8_t lengths[288 + 32] = {};
+	int     index             = 0;
+	while (index < literalCount + distanceCount) {
+		int symbol = codeLenTable.decode(reader);
+		if (symbol < 16) {
+			lengths[index++] = static_cast<uint8_t>(symbol);
+			continue;
+		}
+
+		uint8_t repeatValue = 0;
+		int     repeatCount = 0;
+		if (symbol == 16) {
+			if (index == 0) {
+				throw std::runtime_error("[PngDecoder] : Repeat with no previous length");
+			}
+			repeatValue = lengths[index - 1];
+			repeatCount = 3 + static_cast<int>(reader.bits(2));
+		}
+		else if (symbol == 17) {
+			repeatCount = 3 + static_cast<int>(reader.bits(3));
+		}
+		else {
+			repeatCount = 11 + static_cast<int>(reader.bits(7));
+		}
+
+		if (index + repeatCount > literalCount + distanceCount) {
+			throw std::runtime_error("[PngDecoder] : Too many code lengths");
+		}
+		while (repeatCount--) {
+			lengths[index++] = repeatValue;
+		}
+	}
+
+	literals.build(lengths, literalCount);
+	distances.build(lengths + literalCount, distanceCount);
+}
+
+uint32_t readBigEndian32(const uint8_t *data) {
+	return (static_cast<uint32_t>(data[0]) << 24) | (static_cast<uint32_t>(data[1]) << 16) |
+	       (static_cast<uint32_t>(data[2]) << 8) | static_cast<uint32_t>(data[3]);
+}
+
+uint8_t paethPredictor(int a, int b, int c) {
+	int p  = a + b - c;
+	int pa = std::abs(p - a);
+	int pb = std::abs(p - b);
+	int pc = std::abs(p - c);
+	if (pa <= pb && pa <= pc) return static_cast<uint8_t>(a);
+	if (pb <= pc) return static_cast<uint8_t>(b);
+	return static_cast<uint8_t>(c);
+}
+
+}        // namespace
+
+// ================== zlib ============================
+
+std::vector<uint8_t> PngDecoder::inflateZlib(const uint8_t *data, size_t size, size_t expectedSize) {
+	if (size < 6) {
+		throw std::runtime_error("[PngDecoder] : zlib stream too small");
+	}
+	uint8_t cmf = data[0];
+	uint8_t flg = data[1];
+	if ((cmf & 0x0F) != 8 || ((cmf << 8) | flg) % 31 != 0 || (flg & 0x20)) {
+		throw std::runtime_error("[PngDecoder] : Invalid zlib header");
+	}
+
+	std::vector<uint8_t> out;
+	out.reserve(expectedSize);
+
+	BitReader reader{data + 2, size - 2};
+	bool      lastBlock = false;
+	while (!lastBlock) {
+		lastBlock      = reader.bits(1) != 0;
+		uint32_t type  = reader.bits(2);
+
+		if (type == 0) {
+			// Bloco sem compressão
+			reader.alignToByte();
+			if (reader.pos + 4 > reader.size) {
+				throw std::runtime_error("[PngDecoder] : Truncated stored block");
+			}
+			uint16_t length  = static_cast<uint16_t>(reader.data[reader.pos] | (reader.data[reader.pos + 1] << 8));
+			uint16_t nlength = static_cast<uint16_t>(reader.data[reader.pos + 2] | (reader.data[reader.pos + 3] << 8));
+			reader.pos += 4;
+			if (length != static_cast<uint16_t>(~nlength) || reader.pos + length > reader.size) {
+				throw std::runtime_error("[PngDecoder] : Corrupt stored block");
+			}
+			out.insert(out.end(), reader.data + reader.pos, reader.data + reader.pos + length);
+			reader.pos += length;
+		}
+		else if (type == 1 || type == 2) {
+			Huffman literals, distances;
+			if (type == 1) {
+				buildFixedTables(literals, distances);
+			}
+			else {
+				buildDynamicTables(reader, literals, distances);
+			}
+			inflateBlock(reader, literals, distances, out);
+		}
+		else {
+			throw std::runtime_error("[PngDecoder] : Invalid deflate block type");
+		}
+	}
+
+	// Adler-32 no fim do stream zlib
+	reader.alignToByte();
+	if (reader.pos + 4 <= reader.size) {
+		uint32_t a = 1, b = 0;
+		for (uint8_t byte : out) {
+			a = (a + byte) % 65521;
+			b = (b + a) % 65521;
+		}
+		if (((b << 16) | a) != readBigEndian32(reader.data + reader.pos)) {
+			throw std::runtime_error("[PngDecoder] : Adler-32 mismatch");
+		}
+	}
+
+	return out;
+}
+
+// ================== PNG ============================
+
+ImageData PngDecoder::decodeFile(const std::string &path) {
+	std::ifstream file(path, std::ios::ate | std::ios::binary);
+	if (!file.is_open()) {
+		throw std::runtime_error("[PngDecoder] : Failed to open " + path);
+	}
+
+	size_t               fileSize = static_cast<size_t>(file.tellg());
+	std::vector<uint8_t> fileData(fileSize);
+	file.seekg(0);
+	file.read(reinterpret_cast<char *>(fileData.data()), fileSize);
+
+	return decode(fileData);
+}
+
+ImageData PngDecoder::decode(const std::vector<uint8_t> &fileData) {
+	static const uint8_t signature[8] = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n'};
+	if (fileData.size() < 8 || std::memcmp(fileData.data(), signature, 8) != 0) {
+		throw std::runtime_error("[PngDecoder] : Not a PNG file");
+	}
+
+	uint32_t             width = 0, height = 0;
+	uint8_t              bitDepth = 0, colorType = 0, interlace = 0;
+	std::vector<uint8_t> palette;        // RGBA
+	std::vector<uint8_t> compressed;
+
+	size_t pos = 8;
+	while (pos + 12 <= fileData.size()) {
+		uint32_t       length = readBigEndian32(&fileData[pos]);
+		const uint8_t *type   = &fileData[pos + 4];
+		const uint8_t *chunk  = &fileData[pos + 8];
+		if (pos + 12 + length > fileData.size()) {
+			throw std::runtime_error("[PngDecoder] : Truncated chunk");
+		}
+
+		if (std::memcmp(type, "IHDR", 4) == 0) {
+			width     = readBigEndian32(chunk);
+			height    = readBigEndian32(chunk + 4);
+			bitDepth  = chunk[8];
+			colorType = chunk[9];
+			interlace = chunk[12];
+		}
+		else if (std::memcmp(type, "PLTE", 4) == 0) {
+			palette.assign((length / 3) * 4, 255);
+			for (uint32_t i = 0; i < length / 3; i++) {
+				palette[i * 4 + 0] = chunk[i * 3 + 0];
+				palette[i * 4 + 1] = chunk[i * 3 + 1];
+				palette[i * 4 + 2] = chunk[i * 3 + 2];
+			}
+		}
+		else if (std::memcmp(type, "tRNS", 4) == 0 && colorType == 3) {
+			for (uint32_t i = 0; i < length && i * 4 + 3 < palette.size(); i++) {
+				palette[i * 4 + 3] = chunk[i];
+			}
+		}
+		else if (std::memcmp(type, "IDAT", 4) == 0) {
+			compressed.insert(compressed.end(), chunk, chunk + length);
+		}
+		else if (std::memcmp(type, "IEND", 4) == 0) {
+			break;
+		}
+		pos += 12 + length;
+	}
+
+	if (width == 0 || height == 0) {
+		throw std::runtime_error("[PngDecoder] : Missing IHDR");
+	}
+	if (bitDepth != 8 || interlace != 0) {
+		throw std::runtime_error("[PngDecoder] : Only 8-bit non-interlaced PNGs are supported");
+	}
+
+	uint32_t channels = 0;
+	switch (colorType) {
+		case 0: channels = 1; break;        // Gray
+		case 2: channels = 3; break;        // RGB
+		case 3: channels = 1; break;        // Paleta
+		case 4: channels = 2; break;        // Gray + Alpha
+		case 6: channels = 4; break;        // RGBA
+		default: throw std::runtime_error("[PngDecoder] : Unsupported color type");
+	}
+	if (colorType == 3 && palette.empty()) {
+		throw std::runtime_error("[PngDecoder] : Palette image without PLTE");
+	}
+
+	size_t               stride = static_cast<size_t>(width) * channels;
+	std::vector<uint8_t> raw    = inflateZlib(compressed.data(), compressed.size(), (stride + 1) * height);
+	if (raw.size() < (stride + 1) * height) {
+		throw std::runtime_error("[PngDecoder] : Not enough image data");
+	}
+
+	// Desfaz os filtros linha a linha (cada linha começa com o tipo do filtro)
+	std::vector<uint8_t> unfiltered(stride * height);
+	for (uint32_t y = 0; y < height; y++) {
+		uint8_t        filter = raw[y * (stride + 1)];
+		const uint8_t *src    = &raw[y * (stride + 1) + 1];
+		uint8_t       *dst    = &unfiltered[y * stride];
+		const uint8_t *prev   = y > 0 ? &unfiltered[(y - 1) * stride] : nullptr;
+
+		for (size_t x = 0; x < stride; x++) {
+			int left    = x >= channels ? dst[x - channels] : 0;
+			int up      = prev ? prev[x] : 0;
+			int upLeft  = (prev && x >= channels) ? prev[x - channels] : 0;
+			int predict = 0;
+			switch (filter) {
+				case 0: predict = 0; break;
+				case 1: predict = left; break;
+				case 2: predict = up; break;
+				case 3: predict = (left + up) / 2; break;
+				case 4: predict = paethPredictor(left, up, upLeft); break;
+				default: throw std::runtime_error("[PngDecoder] : Invalid filter type");
+			}
+			dst[x] = static_cast<uint8_t>(src[x] + predict);
+		}
+	}
+
+	// Converte para RGBA8
+	ImageData image;
+	image.width  = width;
+	image.height = height;
+	image.pixels.resize(static_cast<size_t>(width) * height * 4);
+
+	for (size_t i = 0; i < static_cast<size_t>(width) * height; i++) {
+		const uint8_t *src = &unfiltered[i * channels];
+		uint8_t       *dst = &image.pixels[i * 4];
+		switch (colorType) {
+			case 0:
+				dst[0] = dst[1] = dst[2] = src[0];
+				dst[3]                   = 255;
+				break;
+			case 2:
+				dst[0] = src[0];
+				dst[1] = src[1];
+				dst[2] = src[2];
+				dst[3] = 255;
+				break;
+			case 3: {
+				size_t index = static_cast<size_t>(src[0]) * 4;
+				if (index + 3 >= palette.size()) {
+					throw std::runtime_error("[PngDecoder] : Palette index out of range");
+				}
+				std::memcpy(dst, &palette[index], 4);
+				break;
+			}
+			case 4:
+				dst[0] = dst[1] = dst[2] = src[0];
+				dst[3]                   = src[1];
+				break;
+			case 6:
+				std::memcpy(dst, src, 4);
+				break;
+		}
+	}
+
+	return image;
+}
@@ -0,0 +1,113 @@
+#include <core/PngWriter.hpp>
+#include <core/Logger.hpp>
+
+#include <algorithm>
+#include <array>
+#include <fstream>
+
+namespace {
+
+const uint8_t pngSignature[8] = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n'};
+
+uint32_t crc32(const uint8_t *data, size_t size, uint32_t crc = 0) {
+	static const std::array<uint32_t, 256> table = [] {
+		std::array<uint32_t, 256> t{};
+		for (uint32_t n = 0; n < 256; n++) {
+			uint32_t c = n;
+			for (int k = 0; k < 8; k++) {
+				c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+			}
+			t[n] = c;
+		}
+		return t;
+	}();
+
+	crc = ~crc;
+	for (size_t i = 0; i < size; i++) {
+		crc = table[(crc ^ data[i]) & 0xFF] ^ (crc >> 8);
+	}
+	return ~crc;
+}
+
+void putU32(std::vector<uint8_t> &out, uint32_t value) {
+	out.push_back(static_cast<uint8_t>(value >> 24));
+	out.push_back(static_cast<uint8_t>(value >> 16));
+	out.push_back(static_cast<uint8_t>(value >> 8));
+	out.push_back(static_cast<uint8_t>(value));
+}
+
+void writeChunk(std::vector<uint8_t> &out, const char type[4], const std::vector<uint8_t> &data) {
+	putU32(out, static_cast<uint32_t>(data.size()));
+	size_t typeStart = out.size();
+	out.insert(out.end(), type, type + 4);
+	out.insert(out.end(), data.begin(), data.end());
+	// CRC cobre tipo + dados
+	putU32(out, crc32(out.data() + typeStart, out.size() - typeStart));
+}
+
+// Stream zlib só com blocos stored (máx. 65535 bytes cada)
+std::vector<uint8_t> deflateStored(const std::vector<uint8_t> &raw) {
+	std::vector<uint8_t> out = {0x78, 0x01};
+
+	size_t offset = 0;
+	do {
+		size_t   blockSize = std::min<size_t>(raw.size() - offset, 65535);
+		bool     last      = offset + blockSize == raw.size();
+		uint16_t len       = static_cast<uint16_t>(blockSize);
+
+		out.push_back(last ? 1 : 0);
+		out.push_back(static_cast<uint8_t>(len));
+		out.push_back(static_cast<uint8_t>(len >> 8));
+		out.push_back(static_cast<uint8_t>(~len));
+		out.push_back(static_cast<uint8_t>(~len >> 8));
+		out.insert(out.end(), raw.begin() + offset, raw.begin() + offset + blockSize);
+		offset += blockSize;
+	} while (offset < raw.size());
+
+	uint32_t a = 1, b = 0;
+	for (uint8_t byte : raw) {
+		a = (a + byte) % 65521;
+		b = (b + a) % 65521;
+	}
+	putU32(out, (b << 16) | a);
+	return out;
+}
+
+}        // namespace
+
+std::vector<uint8_t> PngWriter::encode(const ImageData &image) {
+	// Cada linha: byte de filtro (0 = None) + pixels RGBA
+	size_t               rowSize = static_cast<size_t>(image.width) * 4;
+	std::vector<uint8_t> raw;
+	raw.reserve((rowSize + 1) * image.height);
+	for (uint32_t y = 0; y < image.height; y++) {
+		raw.push_back(0);
+		raw.insert(raw.end(), image.pixels.begin() + y * rowSize, image.pixels.begin() + (y + 1) * rowSize);
+	}
+
+	std::vector<uint8_t> header;
+	putU32(header, image.width);
+	putU32(header, image.height);
+	header.push_back(8);        // Bits por canal
+	header.push_back(6);        // RGBA
+	header.push_back(0);        // Compressão deflate
+	header.push_back(0);        // Filtro adaptativo
+	header.push_back(0);        // Sem entrelaçamento
+
+	std::vector<uint8_t> out(pngSignature, pngSignature + sizeof(pngSignature));
+	writeChunk(out, "IHDR", header);
+	writeChunk(out, "IDAT", deflateStored(raw));
+	writeChunk(out, "IEND", {});
+	return out;
+}
+
+bool PngWriter::writeFile(const std::string &path, const ImageData &image) {
+	std::ofstream file(path, std::ios::binary | std::ios::trunc);
+	if (!file.is_open()) {
+		LOG_ERROR("PngWriter", "Failed to open {}", path);
+		return false;
+	}
+	std::vector<uint8_t> data = encode(image);
+	file.write(reinterpret_cast<const char *>(data.data()), data.size());
+	return static_cast<bool>(file);
+}
@@ -0,0 +1,713 @@
+#include <core/CpuTracer.hpp>
+#include <core/GpuProfiler.hpp>
+#include <core/Logger.hpp>
+#include <core/RenderGraph.hpp>
+
+#include <algorithm>
+#include <array>
+#include <numeric>
+#include <stdexcept>
+
+namespace {
+	struct AccessInfo {
+		VkPipelineStageFlags stages;
+		VkAccessFlags        access;
+		VkImageLayout        layout;
+		VkImageUsageFlags    usage;
+	};
+
+	constexpr VkAccessFlags WRITE_ACCESS = VK_ACCESS_SHADER_WRITE_BIT | VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT |
+	                                       VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT | VK_ACCESS_TRANSFER_WRITE_BIT |
+	                                       VK_ACCESS_HOST_WRITE_BIT | VK_ACCESS_MEMORY_WRITE_BIT;
+
+	constexpr VkPipelineStageFlags DEPTH_STAGES = VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT | VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT;
+
+	AccessInfo describe(RenderGraphAccess access, AttachmentLoad load) {
+		switch (access) {
+			case RenderGraphAccess::ColorAttachment:
+				return {VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT,
+				        VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT | (load == AttachmentLoad::Load ? static_cast<VkAccessFlags>(VK_ACCESS_COLOR_ATTACHMENT_READ_BIT) : 0u),
+				        VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL, VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT};
+			case RenderGraphAccess::DepthAttachment:
+				return {DEPTH_STAGES, VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_READ_BIT | VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT,
+				        VK_IMAGE_LAYOUT_DEPTH_ATTACHMENT_OPTIMAL, VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT};
+			case RenderGraphAccess::DepthReadOnly:
+				return {DEPTH_STAGES, VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_READ_BIT,
+				        VK_IMAGE_LAYOUT_DEPTH_READ_ONLY_OPTIMAL, VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT};
+			case RenderGraphAccess::FragmentSampled:
+				return {VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, VK_ACCESS_SHADER_READ_BIT,
+				        VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, VK_IMAGE_USAGE_SAMPLED_BIT};
+			case RenderGraphAccess::ComputeSampled:
+				return {VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_ACCESS_SHADER_READ_BIT,
+				        VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, VK_IMAGE_USAGE_SAMPLED_BIT};
+			case RenderGraphAccess::VertexStorageRead:
+				return {VK_PIPELINE_STAGE_VERTEX_SHADER_BIT, VK_ACCESS_SHADER_READ_BIT, VK_IMAGE_LAYOUT_GENERAL, VK_IMAGE_USAGE_STORAGE_BIT};
+			case RenderGraphAccess::FragmentStorageRead:
+				return {VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, VK_ACCESS_SHADER_READ_BIT, VK_IMAGE_LAYOUT_GENERAL, VK_IMAGE_USAGE_STORAGE_BIT};
+			case RenderGraphAccess::ComputeStorageRead:
+				return {VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_ACCESS_SHADER_READ_BIT, VK_IMAGE_LAYOUT_GENERAL, VK_IMAGE_USAGE_STORAGE_BIT};
+			case RenderGraphAccess::ComputeStorageWrite:
+				return {VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT,
+				        VK_IMAGE_LAYOUT_GENERAL, VK_IMAGE_USAGE_STORAGE_BIT};
+			case RenderGraphAccess::IndirectRead:
+				return {VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT, VK_ACCESS_INDIRECT_COMMAND_READ_BIT, VK_IMAGE_LAYOUT_UNDEFINED, 0};
+			case RenderGraphAccess::VertexInput:
+				return {VK_PIPELINE_STAGE_VERTEX_INPUT_BIT, VK_ACCESS_VERTEX_ATTRIBUTE_READ_BIT | VK_ACCESS_INDEX_READ_BIT,
+				        VK_IMAGE_LAYOUT_UNDEFINED, 0};
+			case RenderGraphAccess::TransferRead:
+				return {VK_PIPELINE_STAGE_TRANSFER_BIT, VK_ACCESS_TRANSFER_READ_BIT, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, VK_IMAGE_USAGE_TRANSFER_SRC_BIT};
+			case RenderGraphAccess::TransferWrite:
+				return {VK_PIPELINE_STAGE_TRANSFER_BIT, VK_ACCESS_TRANSFER_WRITE_BIT, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_USAGE_TRANSFER_DST_BIT};
+		}
+		throw std::runtime_error("[RenderGraph] : Unknown access!");
+	}
+
+	bool isAttachment(RenderGraphAccess access) {
+		return access == RenderGraphAccess::ColorAttachment ||
+		       access == RenderGraphAccess::DepthAttachment ||
+		       access == RenderGraphAccess::DepthReadOnly;
+	}
+
+	bool isDepth(VkFormat format) {
+		return format == VK_FORMAT_D16_UNORM || format == VK_FORMAT_D32_SFLOAT || format == VK_FORMAT_D24_UNORM_S8_UINT ||
+		       format == VK_FORMAT_D32_SFLOAT_S8_UINT || format == VK_FORMAT_X8_D24_UNORM_PACK32;
+	}
+
+	bool sameDesc(const RenderGraphImageDesc &a, const RenderGraphImageDesc &b) {
+		return a.format == b.format && a.extent.width == b.extent.width && a.extent.height == b.extent.height && a.layers == b.layers;
+	}
+}        // namespace
+
+// ---- PassBuilder ----
+
+RenderGraph::PassBuilder &RenderGraph::PassBuilder::writeColor(RenderGraphResource resource, AttachmentLoad load, VkClearColorValue clear) {
+	Use &use        = graph.addUse(pass, resource, RenderGraphAccess::ColorAttachment, true);
+	use.load        = load;
+	use.clear.color = clear;
+	return *this;
+}
+
+RenderGraph::PassBuilder &RenderGraph::PassBuilder::writeDepth(RenderGraphResource resource, AttachmentLoad load, float clearDepth) {
+	Use &use               = graph.addUse(pass, resource, RenderGraphAccess::DepthAttachment, true);
+	use.load               = load;
+	use.clear.depthStencil = {clearDepth, 0};
+	return *this;
+}
+
+RenderGraph::PassBuilder &RenderGraph::PassBuilder::readDepth(RenderGraphResource resource) {
+	graph.addUse(pass, resource, RenderGraphAccess::DepthReadOnly, false);
+	return *this;
+}
+
+RenderGraph::PassBuilder &RenderGraph::PassBuilder::read(RenderGraphResource resource, RenderGraphAccess access) {
+	graph.addUse(pass, resource, access, false);
+	return *this;
+}
+
+RenderGraph::PassBuilder &RenderGraph::PassBuilder::write(RenderGraphResource resource, RenderGraphAccess access) {
+	graph.addUse(pass, resource, access, true);
+	return *this;
+}
+
+RenderGraph::PassBuilder &RenderGraph::PassBuilder::setSideEffect() {
+	graph.passes[pass].sideEffect = true;
+	return *this;
+}
+
+// ---- RenderGraph ----
+
+RenderGraph::RenderGraph(VkDevice device, VmaAllocator allocator, DeletionQueue &deletionQueue) :
+    device(device),
+    allocator(allocator),
+    deletionQueue(deletionQueue) {
+	LOG_INFO("RenderGraph", "Created.");
+}
+
+RenderGraph::~RenderGraph() {
+	// Destruídas pela DeletionQueue (flushAll depois do vkDeviceWaitIdle no shutdown)
+	retirePhysicalImages(0);
+}
+
+void RenderGraph::reset() {
+	resources.clear();
+	passes.clear();
+	finalBarriers.clear();
+}
+
+RenderGraphResource RenderGraph::importImage(const char                 *name,
+                                             VkImage                     image,
+                                             VkImageView                 view,
+                                             const RenderGraphImageDesc &desc,
+                                             VkImageAspectFlags          aspect,
+                                             VkImageLayout               initialLayout,
+                                             VkPipelineStageFlags        previousStages,
+                                             VkAccessFlags               previousAccess,
+                                             VkImageLayout               finalLayout) {
+	Resource resource{};
+	resource.name           = name;
+	resource.imported       = true;
+	resource.desc           = desc;
+	resource.aspect         = aspect;
+	resource.image          = image;
+	resource.view           = view;
+	resource.initialLayout  = initialLayout;
+	resource.finalLayout    = finalLayout;
+	resource.previousStages = previousStages;
+	resource.previousAccess = previousAccess;
+	resources.push_back(resource);
+	return {static_cast<uint32_t>(resources.size() - 1)};
+}
+
+RenderGraphResource RenderGraph::importBuffer(const char *name, VkBuffer buffer, VkPipelineStageFlags previousStages, VkAccessFlags previousAccess) {
+	Resource resource{};
+	resource.name           = name;
+	resource.imported       = true;
+	resource.isBuffer       = true;
+	resource.buffer         = buffer;
+	resource.previousStages = previousStages;
+	resource.previousAccess = previousAccess;
+	resources.push_back(resource);
+	return {static_cast<uint32_t>(resources.size() - 1)};
+}
+
+RenderGraphResource RenderGraph::createImage(const char *name, const RenderGraphImageDesc &desc) {
+	Resource resource{};
+	resource.name   = name;
+	resource.desc   = desc;
+	resource.aspect = isDepth(desc.format) ? VK_IMAGE_ASPECT_DEPTH_BIT : VK_IMAGE_ASPECT_COLOR_BIT;
+	resources.push_back(resource);
+	return {static_cast<uint32_t>(resources.size() - 1)};
+}
+
+RenderGraph::PassBuilder RenderGraph::addPass(const char *name, ExecuteFn execute) {
+	Pass pass{};
+	pass.name    = name;
+	pass.execute = std::move(execute);
+	passes.push_back(std::move(pass));
+	return PassBuilder(*this, static_cast<uint32_t>(passes.size() - 1));
+}
+
+RenderGraph::Use &RenderGraph::addUse(uint32_t pass, RenderGraphResource resource, RenderGraphAccess access, bool write) {
+	if (!resource.isValid() || resource.index >= resources.size()) {
+		throw std::runtime_error("[RenderGraph] : Invalid resource!");
+	}
+	for (const Use &use : passes[pass].uses) {
+		if (use.resource == resource.index) {
+			throw std::runtime_error("[RenderGraph] : Resource used twice in the same pass!");
+		}
+	}
+
+	Use use{};
+	use.resource = resource.index;
+	use.access   = access;
+	use.write    = write;
+	passes[pass].uses.push_back(use);
+	return passes[pass].uses.back();
+}
+
+void RenderGraph::compile(uint64_t retireValue) {
+	PROFILE_CPU_ZONE("renderGraph compile");
+	stats              = {};
+	stats.passes       = static_cast<uint32_t>(passes.size());
+	stats.culledPasses = 0;
+
+	cullPasses();
+	computeLifetimes();
+	allocateTransients(retireValue);
+	buildBarriers();
+}
+
+void RenderGraph::cullPasses() {
+	// De trás para frente: um pass fica se escreve algo que alguém depois lê (ou um recurso importado).
+	// Quem escreve sem ler (CLEAR, DONT_CARE) encerra a dependência: o conteúdo anterior não importa.
+	std::vector<bool> needed(resources.size(), false);
+	for (size_t i = 0; i < resources.size(); i++) {
+		needed[i] = resources[i].imported;
+	}
+
+	for (size_t p = passes.size(); p-- > 0;) {
+		Pass &pass  = passes[p];
+		pass.culled = !pass.sideEffect;
+		for (const Use &use : pass.uses) {
+			if (use.write && needed[use.resource]) {
+				pass.culled = false;
+			}
+		}
+		if (pass.culled) {
+			stats.culledPasses++;
+			continue;
+		}
+
+		for (Use &use : pass.uses) {
+			const Resource &resource = resources[use.resource];
+			bool            reads    = !use.write || (isAttachment(use.access) && use.load == AttachmentLoad::Load);
+
+			// Sem leitor depois, o conteúdo do attachment não precisa voltar para a memória
+			use.store = resource.imported || needed[use.resource];
+			if (use.write && !reads) {
+				needed[use.resource] = resource.imported;
+			}
+			if (reads) {
+				needed[use.resource] = true;
+			}
+		}
+	}
+}
+
+void RenderGraph::computeLifetimes() {
+	for (uint32_t p = 0; p < passes.size(); p++) {
+		if (passes[p].culled) {
+			continue;
+		}
+		for (const Use &use : passes[p].uses) {
+			Resource &resource = resources[use.resource];
+			if (resource.firstPass == UINT32_MAX && !resource.imported) {
+				bool reads = !use.write || (isAttachment(use.access) && use.load == AttachmentLoad::Load);
+				if (reads) {
+					throw std::runtime_error(std::string("[RenderGraph] : Transient '") + resource.name + "' read before written!");
+				}
+			}
+			resource.firstPass = std::min(resource.firstPass, p);
+			resource.lastPass  = std::max(resource.lastPass, p);
+			resource.usage |= describe(use.access, use.load).usage;
+		}
+	}
+}
+
+VkMemoryRequirements RenderGraph::getRequirements(const RenderGraphImageDesc &desc, VkImageUsageFlags usage) const {
+	VkImageCreateInfo imageInfo{};
+	imageInfo.sType         = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
+	imageInfo.imageType     = VK_IMAGE_TYPE_2D;
+	imageInfo.format        = desc.format;
+	imageInfo.extent        = {desc.extent.width, desc.extent.height, 1};
+	imageInfo.mipLevels     = 1;
+	imageInfo.arrayLayers   = desc.layers;
+	imageInfo.samples       = VK_SAMPLE_COUNT_1_BIT;
+	imageInfo.tiling        = VK_IMAGE_TILING_OPTIMAL;
+	imageInfo.usage         = usage;
+	imageInfo.sharingMode   = VK_SHARING_MODE_EXCLUSIVE;
+	imageInfo.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+
+	VkDeviceImageMemoryRequirements info{};
+	info.sType       = VK_STRUCTURE_TYPE_DEVICE_IMAGE_MEMORY_REQUIREMENTS;
+	info.pCreateInfo = &imageInfo;
+
+	VkMemoryRequirements2 requirements{};
+	requirements.sType = VK_STRUCTURE_TYPE_MEMORY_REQUIREMENTS_2;
+	vkGetDeviceImageMemoryRequirements(device, &info, &requirements);
+	return requirements.memoryRequirements;
+}
+
+void RenderGraph::allocateTransients(uint64_t retireValue) {
+	struct Planned {
+		uint32_t             resource;
+		VkMemoryRequirements requirements;
+		uint32_t             slot;
+	};
+
+	std::vector<Planned> planned;
+	for (uint32_t i = 0; i < resources.size(); i++) {
+		const Resource &resource = resources[i];
+		if (!resource.imported && !resource.isBuffer && resource.firstPass != UINT32_MAX) {
+			planned.push_back({i, getRequirements(resource.desc, resource.usage), UINT32_MAX});
+		}
+	}
+
+	// Aliasing guloso: maiores primeiro, cada uma no primeiro bloco sem sobreposição de tempo de vida
+	std::vector<uint32_t> order(planned.size());
+	std::iota(order.begin(), order.end(), 0u);
+	std::sort(order.begin(), order.end(), [&](uint32_t a, uint32_t b) { return planned[a].requirements.size > planned[b].requirements.size; });
+
+	std::vector<VkMemoryRequirements>  slotRequirements;
+	std::vector<std::vector<uint32_t>> slotMembers;
+	for (uint32_t index : order) {
+		Planned        &image    = planned[index];
+		const Resource &resource = resources[image.resource];
+		for (uint32_t slot = 0; slot < slotRequirements.size() && image.slot == UINT32_MAX; slot++) {
+			if ((slotRequirements[slot].memoryTypeBits & image.requirements.memoryTypeBits) == 0) {
+				continue;
+			}
+			bool overlaps = false;
+			for (uint32_t member : slotMembers[slot]) {
+				const Resource &other = resources[planned[member].resource];
+				overlaps |= resource.firstPass <= other.lastPass && other.firstPass <= resource.lastPass;
+			}
+			if (!overlaps) {
+				image.slot = slot;
+			}
+		}
+		if (image.slot == UINT32_MAX) {
+			image.slot = static_cast<uint32_t>(slotRequirements.size());
+			slotRequirements.push_back(image.requirements);
+			slotMembers.emplace_back();
+		}
+
+		VkMemoryRequirements &slot = slotRequirements[image.slot];
+		slot.size                  = std::max(slot.size, image.requirements.size);
+		slot.alignment             = std::max(slot.alignment, image.requirements.alignment);
+		slot.memoryTypeBits &= image.requirements.memoryTypeBits;
+		slotMembers[image.slot].push_back(index);
+		stats.unaliasedBytes += image.requirements.size;
+	}
+
+	// Mesmo plano do frame anterior: reaproveita as imagens do cache
+	bool reuse = planned.size() == physicalImages.size() && slotRequirements.size() == memorySlots.size();
+	for (size_t i = 0; reuse && i < planned.size(); i++) {
+		const PhysicalImage &physical = physicalImages[i];
+		const Resource      &resource = resources[planned[i].resource];
+		reuse = sameDesc(physical.desc, resource.desc) && physical.usage == resource.usage && physical.slot == planned[i].slot;
+	}
+	for (size_t slot = 0; reuse && slot < slotRequirements.size(); slot++) {
+		reuse = memorySlots[slot].requirements.size == slotRequirements[slot].size;
+	}
+
+	if (!reuse) {
+		retirePhysicalImages(retireValue);
+
+		for (const VkMemoryRequirements &requirements : slotRequirements) {
+			VmaAllocationCreateInfo allocInfo{};
+			allocInfo.usage = VMA_MEMORY_USAGE_GPU_ONLY;
+
+			MemorySlot slot{};
+			slot.requirements = requirements;
+			if (vmaAllocateMemory(allocator, &requirements, &allocInfo, &slot.allocation, nullptr) != VK_SUCCESS) {
+				throw std::runtime_error("[RenderGraph] : Failed to allocate transient memory!");
+			}
+			memorySlots.push_back(slot);
+		}
+
+		for (const Planned &image : planned) {
+			const Resource &resource = resources[image.resource];
+
+			PhysicalImage physical{};
+			physical.desc   = resource.desc;
+			physical.usage  = resource.usage;
+			physical.aspect = resource.aspect;
+			physical.slot   = image.slot;
+
+			VkImageCreateInfo imageInfo{};
+			imageInfo.sType         = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
+			imageInfo.imageType     = VK_IMAGE_TYPE_2D;
+			imageInfo.format        = resource.desc.format;
+			imageInfo.extent        = {resource.desc.extent.width, resource.desc.extent.height, 1};
+			imageInfo.mipLevels     = 1;
+			imageInfo.arrayLayers   = resource.desc.layers;
+			imageInfo.samples       = VK_SAMPLE_COUNT_1_BIT;
+			imageInfo.tiling        = VK_IMAGE_TILING_OPTIMAL;
+			imageInfo.usage         = resource.usage;
+			imageInfo.sharingMode   = VK_SHARING_MODE_EXCLUSIVE;
+			imageInfo.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+			if (vkCreateImage(device, &imageInfo, nullptr, &physical.image) != VK_SUCCESS ||
+			    vmaBindImageMemory(allocator, memorySlots[image.slot].allocation, physical.image) != VK_SUCCESS) {
+				throw std::runtime_error(std::string("[RenderGraph] : Failed to create transient image '") + resource.name + "'!");
+			}
+
+			VkImageViewCreateInfo viewInfo{};
+			viewInfo.sType                       = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
+			viewInfo.image                       = physical.image;
+			viewInfo.viewType                    = resource.desc.layers > 1 ? VK_IMAGE_VIEW_TYPE_2D_ARRAY : VK_IMAGE_VIEW_TYPE_2D;
+			viewInfo.format                      = resource.desc.format;
+			viewInfo.subresourceRange.aspectMask = resource.aspect;
+			viewInfo.subresourceRange.levelCount = 1;
+			viewInfo.subresourceRange.layerCount = resource.desc.layers;
+			if (vkCreateImageView(device, &viewInfo, nullptr, &physical.view) != VK_SUCCESS) {
+				throw std::runtime_error(std::string("[RenderGraph] : Failed to create view for '") + resource.name + "'!");
+			}
+			physicalImages.push_back(physical);
+		}
+
+		VkDeviceSize aliasedBytes = 0;
+		for (const MemorySlot &slot : memorySlots) {
+			aliasedBytes += slot.requirements.size;
+		}
+		LOG_INFO("RenderGraph", "{} transient images in {} allocations ({} KB, {} KB without aliasing).",
+		         physicalImages.size(), memorySlots.size(), aliasedBytes / 1024, stats.unaliasedBytes / 1024);
+	}
+
+	// Estágios de todos os usos de cada bloco: a primeira barreira de cada imagem espera por eles
+	// (frame anterior e imagens que dividiram o bloco antes neste frame)
+	for (MemorySlot &slot : memorySlots) {
+		slot.stages = 0;
+		slot.writes = 0;
+	}
+	for (size_t i = 0; i < planned.size(); i++) {
+		resources[planned[i].resource].physical = static_cast<uint32_t>(i);
+	}
+	for (const Pass &pass : passes) {
+		if (pass.culled) {
+			continue;
+		}
+		for (const Use &use : pass.uses) {
+			const Resource &resource = resources[use.resource];
+			if (resource.physical != UINT32_MAX) {
+				AccessInfo  info = describe(use.access, use.load);
+				MemorySlot &slot = memorySlots[physicalImages[resource.physical].slot];
+				slot.stages |= info.stages;
+				slot.writes |= info.access & WRITE_ACCESS;
+			}
+		}
+	}
+
+	stats.transientImages      = static_cast<uint32_t>(physicalImages.size());
+	stats.transientAllocations = static_cast<uint32_t>(memorySlots.size());
+	for (const MemorySlot &slot : memorySlots) {
+		stats.transientBytes += slot.requirements.size;
+	}
+}
+
+void RenderGraph::retirePhysicalImages(uint64_t retireValue) {
+	if (physicalImages.empty() && memorySlots.empty()) {
+		return;
+	}
+
+	std::vector<PhysicalImage> images = std::move(physicalImages);
+	std::vector<MemorySlot>    slots  = std::move(memorySlots);
+	physicalImages.clear();
+	memorySlots.clear();
+
+	VkDevice     device    = this->device;
+	VmaAllocator allocator = this->allocator;
+	deletionQueue.push(retireValue, [device, allocator, images = std::move(images), slots = std::move(slots)]() {
+		for (const PhysicalImage &image : images) {
+			vkDestroyImageView(device, image.view, nullptr);
+			vkDestroyImage(device, image.image, nullptr);
+		}
+		for (const MemorySlot &slot : slots) {
+			vmaFreeMemory(allocator, slot.allocation);
+		}
+	});
+}
+
+void RenderGraph::addBarrier(Pass &pass, Resource &resource, const Use &use) {
+	AccessInfo info         = describe(use.access, use.load);
+	SyncState &state        = resource.state;
+	bool       layoutChange = !resource.isBuffer && state.layout != info.layout;
+	bool       reads        = !use.write || (isAttachment(use.access) && use.load == AttachmentLoad::Load);
+
+	VkPipelineStageFlags srcStages;
+	VkAccessFlags        srcAccess;
+	VkImageLayout        oldLayout = state.layout;
+
+	if (!use.write && !layoutChange) {
+		// Leitura depois de leitura (ou de nada): sem barreira. Depois de escrita: uma vez por estágio/acesso.
+		bool alreadyVisible = (state.visibleAccess & info.access) == info.access && (state.readStages & info.stages) == info.stages;
+		if (state.writeStages == 0 || alreadyVisible) {
+			state.readStages |= info.stages;
+			return;
+		}
+		srcStages = state.writeStages;
+		srcAccess = state.writeAccess;
+		state.readStages |= info.stages;
+		state.visibleAccess |= info.access;
+	}
+	else {
+		// Escrita (ou transição de layout): espera a última escrita e todas as leituras depois dela.
+		// Leituras só precisam de dependência de execução; só escritas precisam ficar disponíveis.
+		srcStages = state.writeStages | state.readStages;
+		srcAccess = state.writeAccess;
+		if (srcStages == 0 && !layoutChange) {
+			state.writeStages   = info.stages;
+			state.writeAccess   = info.access & WRITE_ACCESS;
+			state.visibleAccess = info.access;
+			return;
+		}
+		if (layoutChange && !reads) {
+			oldLayout = VK_IMAGE_LAYOUT_UNDEFINED;        // O conteúdo anterior não é lido: o driver pode descartar
+		}
+
+		state.layout        = resource.isBuffer ? state.layout : info.layout;
+		state.writeStages   = info.stages;
+		state.writeAccess   = info.access & WRITE_ACCESS;
+		state.readStages    = use.write ? 0 : info.stages;
+		state.visibleAccess = info.access;
+	}
+
+	pass.srcStages |= srcStages;
+	pass.dstStages |= info.stages;
+
+	if (resource.isBuffer) {
+		VkBufferMemoryBarrier barrier{};
+		barrier.sType               = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER;
+		barrier.srcAccessMask       = srcAccess;
+		barrier.dstAccessMask       = info.access;
+		barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+		barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+		barrier.buffer              = resource.buffer;
+		barrier.offset              = 0;
+		barrier.size                = VK_WHOLE_SIZE;
+		pass.bufferBarriers.push_back(barrier);
+		return;
+	}
+
+	VkImageMemoryBarrier barrier{};
+	barrier.sType                       = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+	barrier.srcAccessMask               = srcAccess;
+	barrier.dstAccessMask               = info.access;
+	barrier.oldLayout                   = oldLayout;
+	barrier.newLayout                   = info.layout;
+	barrier.srcQueueFamilyIndex         = VK_QUEUE_FAMILY_IGNORED;
+	barrier.dstQueueFamilyIndex         = VK_QUEUE_FAMILY_IGNORED;
+	barrier.image                       = getImage({static_cast<uint32_t>(&resource - resources.data())});
+	barrier.subresourceRange.aspectMask = resource.aspect;
+	barrier.subresourceRange.levelCount = VK_REMAINING_MIP_LEVELS;
+	barrier.subresourceRange.layerCount = VK_REMAINING_ARRAY_LAYERS;
+	pass.imageBarriers.push_back(barrier);
+}
+
+void RenderGraph::buildBarriers() {
+	for (Resource &resource : resources) {
+		resource.state = {};
+		if (resource.imported) {
+			// Uso anterior sem escrita (ex.: amostrada no frame passado) só pede dependência de execução
+			resource.state.layout = resource.initialLayout;
+			if (resource.previousAccess & WRITE_ACCESS) {
+				resource.state.writeStages = resource.previousStages;
+				resource.state.writeAccess = resource.previousAccess;
+			}
+			else {
+				resource.state.readStages = resource.previousStages;
+			}
+		}
+		else if (resource.physical != UINT32_MAX) {
+			const MemorySlot &slot     = memorySlots[physicalImages[resource.physical].slot];
+			resource.state.writeStages = slot.stages;
+			resource.state.writeAccess = slot.writes;
+		}
+	}
+
+	for (Pass &pass : passes) {
+		pass.srcStages = 0;
+		pass.dstStages = 0;
+		pass.imageBarriers.clear();
+		pass.bufferBarriers.clear();
+		if (pass.culled) {
+			continue;
+		}
+		for (const Use &use : pass.uses) {
+			addBarrier(pass, resources[use.resource], use);
+		}
+		stats.barriers += static_cast<uint32_t>(pass.imageBarriers.size() + pass.bufferBarriers.size());
+	}
+
+	// Importadas voltam para o layout que quem vem depois espera (ex.: PRESENT_SRC)
+	finalSrcStages = 0;
+	for (uint32_t i = 0; i < resources.size(); i++) {
+		Resource &resource = resources[i];
+		if (!resource.imported || resource.isBuffer || resource.finalLayout == VK_IMAGE_LAYOUT_UNDEFINED ||
+		    resource.finalLayout == resource.state.layout) {
+			continue;
+		}
+
+		VkImageMemoryBarrier barrier{};
+		barrier.sType                       = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+		barrier.srcAccessMask               = resource.state.writeAccess;
+		barrier.dstAccessMask               = 0;
+		barrier.oldLayout                   = resource.state.layout;
+		barrier.newLayout                   = resource.finalLayout;
+		barrier.srcQueueFamilyIndex         = VK_QUEUE_FAMILY_IGNORED;
+		barrier.dstQueueFamilyIndex         = VK_QUEUE_FAMILY_IGNORED;
+		barrier.image                       = resource.image;
+		barrier.subresourceRange.aspectMask = resource.aspect;
+		barrier.subresourceRange.levelCount = VK_REMAINING_MIP_LEVELS;
+		barrier.subresourceRange.layerCount = VK_REMAINING_ARRAY_LAYERS;
+		finalBarriers.push_back(barrier);
+		finalSrcStages |= resource.state.writeStages | resource.state.readStages;
+	}
+	finalDstStages = VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT;
+	stats.barriers += static_cast<uint32_t>(finalBarriers.size());
+}
+
+void RenderGraph::execute(VkCommandBuffer cmd) {
+	for (const Pass &pass : passes) {
+		if (pass.culled) {
+			continue;
+		}
+
+		if (!pass.imageBarriers.empty() || !pass.bufferBarriers.empty()) {
+			vkCmdPipelineBarrier(cmd,
+			                     pass.srcStages ? pass.srcStages : static_cast<VkPipelineStageFlags>(VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT),
+			                     pass.dstStages,
+			                     0, 0, nullptr,
+			                     static_cast<uint32_t>(pass.bufferBarriers.size()), pass.bufferBarriers.data(),
+			                     static_cast<uint32_t>(pass.imageBarriers.size()), pass.imageBarriers.data());
+		}
+
+		PROFILE_GPU_SCOPE(cmd, pass.name);
+
+		// Attachments na ordem em que o pass declarou
+		std::array<VkRenderingAttachmentInfo, 8> colorAttachments{};
+		uint32_t                                 colorCount = 0;
+		VkRenderingAttachmentInfo                depthAttachment{};
+		bool                                     hasDepth = false;
+		VkExtent2D                               extent   = {0, 0};
+		for (const Use &use : pass.uses) {
+			if (!isAttachment(use.access)) {
+				continue;
+			}
+			const Resource &resource = resources[use.resource];
+
+			VkRenderingAttachmentInfo attachment{};
+			attachment.sType       = VK_STRUCTURE_TYPE_RENDERING_ATTACHMENT_INFO;
+			attachment.imageView   = getImageView({use.resource});
+			attachment.imageLayout = describe(use.access, use.load).layout;
+			attachment.loadOp      = use.load == AttachmentLoad::Clear  ? VK_ATTACHMENT_LOAD_OP_CLEAR
+			                         : use.load == AttachmentLoad::Load ? VK_ATTACHMENT_LOAD_OP_LOAD
+			                                                            : VK_ATTACHMENT_LOAD_OP_DONT_CARE;
+			attachment.storeOp     = use.store ? VK_ATTACHMENT_STORE_OP_STORE : VK_ATTACHMENT_STORE_OP_DONT_CARE;
+			attachment.clearValue  = use.clear;
+			extent                 = resource.desc.extent;
+
+			if (use.access == RenderGraphAccess::ColorAttachment) {
+				if (colorCount == colorAttachments.size()) {
+					throw std::runtime_error("[RenderGraph] : Too many color attachments!");
+				}
+				colorAttachments[colorCount++] = attachment;
+			}
+			else {
+				depthAttachment = attachment;
+				hasDepth        = true;
+			}
+		}
+
+		if (colorCount == 0 && !hasDepth) {
+			pass.execute(cmd);
+			continue;
+		}
+
+		VkRenderingInfo renderingInfo{};
+		renderingInfo.sType                = VK_STRUCTURE_TYPE_RENDERING_INFO;
+		renderingInfo.renderArea.extent    = extent;
+		renderingInfo.layerCount           = 1;
+		renderingInfo.colorAttachmentCount = colorCount;
+		renderingInfo.pColorAttachments    = colorAttachments.data();
+		renderingInfo.pDepthAttachment     = hasDepth ? &depthAttachment : nullptr;
+
+		vkCmdBeginRendering(cmd, &renderingInfo);
+		pass.execute(cmd);
+		vkCmdEndRendering(cmd);
+	}
+
+	if (!finalBarriers.empty()) {
+		vkCmdPipelineBarrier(cmd,
+		                     finalSrcStages ? finalSrcStages : static_cast<VkPipelineStageFlags>(VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT),
+		                     finalDstStages,
+		                     0, 0, nullptr, 0, nullptr,
+		                     static_cast<uint32_t>(finalBarriers.size()), finalBarriers.data());
+	}
+}
+
+VkImage RenderGraph::getImage(RenderGraphResource resource) const {
+	const Resource &entry = resources.at(resource.index);
+	if (entry.imported) {
+		return entry.image;
+	}
+	return entry.physical != UINT32_MAX ? physicalImages[entry.physical].image : VK_NULL_HANDLE;
+}
+
+VkImageView RenderGraph::getImageView(RenderGraphResource resource) const {
+	const Resource &entry = resources.at(resource.index);
+	if (entry.imported) {
+		return entry.view;
+	}
+	return entry.physical != UINT32_MAX ? physicalImages[entry.physical].view : VK_NULL_HANDLE;
+}
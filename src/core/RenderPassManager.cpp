@@ -49,3 +49,20 @@ VkRenderPass RenderPassManager::createBasicRenderPass(VkDevice device, VkFormat
 void RenderPassManager::destroy(VkDevice device, VkRenderPass renderPass) {
     vkDestroyRenderPass(device, renderPass, nullptr);
 }
+
+bool RenderPassManager::isDynamicRenderingSupported(VkPhysicalDevice physicalDevice) {
+    VkPhysicalDeviceProperties properties;
+    vkGetPhysicalDeviceProperties(physicalDevice, &properties);
+    if (properties.apiVersion < VK_API_VERSION_1_3) {
+        return false;
+    }
+
+    VkPhysicalDeviceVulkan13Features features13{};
+    features13.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_3_FEATURES;
+    VkPhysicalDeviceFeatures2 features{};
+    features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2;
+    features.pNext = &features13;
+    vkGetPhysicalDeviceFeatures2(physicalDevice, &features);
+
+    return features13.dynamicRendering == VK_TRUE;
+}
@@ -1,31 +1,67 @@
 #include <core/ResourceManager.hpp>
 
+#include <cstdint>
+
 
 ResourceManager::ResourceManager(VkDevice device, VmaAllocator allocator, VmaWrapper& vmaWrapper) 
     :   m_device(device), 
         m_allocator(allocator), 
-        m_vmaWrapper(&vmaWrapper) {}
+        m_vmaWrapper(&vmaWrapper) {
+   createGeometryPool();
+}
 ResourceManager::~ResourceManager() {
-   for (auto& [handle, buffer] : m_buffers) {
-      m_vmaWrapper->destroyBuffer(buffer);
+   for (auto& [handle, entry] : m_buffers) {
+      m_vmaWrapper->destroyBuffer(entry.buffer);
    }
    m_buffers.clear();
+   for (auto& [handle, entry] : m_images) {
+      vkDestroyImageView(m_device, entry.view, nullptr);
+      m_vmaWrapper->destroyImage(entry.image);
+   }
+   m_images.clear();
+   m_vmaWrapper->destroyPool(m_geometryPool);
 };
 
+void ResourceManager::createGeometryPool() {
+   // Buffer "modelo" só para a VMA descobrir o memory type certo
+   VkBufferCreateInfo sampleBufferInfo{};
+   sampleBufferInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+   sampleBufferInfo.size = 65536;
+   sampleBufferInfo.usage = VK_BUFFER_USAGE_VERTEX_BUFFER_BIT | VK_BUFFER_USAGE_INDEX_BUFFER_BIT |
+                            VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT;
+
+   VmaAllocationCreateInfo sampleAllocInfo{};
+   sampleAllocInfo.usage = VMA_MEMORY_USAGE_GPU_ONLY;
+
+   m_geometryPool = m_vmaWrapper->createPoolForBuffers(sampleBufferInfo, sampleAllocInfo);
+}
+
 BufferHandle ResourceManager::createBuffer(const BufferCreateInfo& info) {
    VkBufferCreateInfo bufferInfo{};
    bufferInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
    bufferInfo.size = info.size;
    bufferInfo.usage = info.usage;
+   if (info.queueFamilies.size() > 1) {
+      bufferInfo.sharingMode = VK_SHARING_MODE_CONCURRENT;
+      bufferInfo.queueFamilyIndexCount = static_cast<uint32_t>(info.queueFamilies.size());
+      bufferInfo.pQueueFamilyIndices = info.queueFamilies.data();
+   }
+
+   BufferHandle handle = m_bufferHandleAllocator.allocate();
 
    VmaAllocationCreateInfo allocInfo{};
    allocInfo.usage = info.memoryUsage;
+   // O handle vai no userData para o desfragmentador achar o dono de cada alocação
+   allocInfo.pUserData = reinterpret_cast<void*>(static_cast<uintptr_t>(handle));
+   if (info.category == ResourceCategory::Geometry && info.memoryUsage == VMA_MEMORY_USAGE_GPU_ONLY) {
+      allocInfo.pool = m_geometryPool;
+   }
 
-   VmaBuffer newVmaBuffer = m_vmaWrapper->createBuffer(bufferInfo, allocInfo);
-
-   BufferHandle handle = m_bufferHandleAllocator.allocate();
+   VmaAllocationInfo allocationInfo{};
+   VmaBuffer newVmaBuffer = m_vmaWrapper->createBuffer(bufferInfo, allocInfo, &allocationInfo);
 
-   m_buffers[handle] = newVmaBuffer;
+   m_buffers[handle] = {newVmaBuffer, info.category, allocationInfo.size, info.size, info.usage};
+   trackAllocation(info.category, allocationInfo.size);
 
    return handle;
 }
@@ -35,8 +71,14 @@ void ResourceManager::destroyBuffer(BufferHandle handle) {
     // Procura o buffer no mapa.
     auto it = m_buffers.find(handle);
     if (it != m_buffers.end()) {
+        if (it->second.moving) {
+            // A alocação está no meio de uma passada de desfragmentação; o GpuDefragmenter destrói no fim
+            it->second.pendingDestroy = true;
+            return;
+        }
+        trackFree(it->second.category, it->second.allocatedSize);
         // Se encontrou, chama a VMA para destruir o buffer e liberar a memória.
-        vmaDestroyBuffer(m_allocator, it->second.buffer, it->second.allocation);
+        m_vmaWrapper->destroyBuffer(it->second.buffer);
         // Remove o buffer do mapa.
         m_buffers.erase(it);
     }
@@ -44,7 +86,7 @@ void ResourceManager::destroyBuffer(BufferHandle handle) {
 VmaBuffer ResourceManager::getBuffer(BufferHandle handle) const {
     auto it = m_buffers.find(handle);
     if (it != m_buffers.end()) {
-        return it->second;
+        return it->second.buffer;
     }
     // Retorna um buffer "vazio" se o handle não for encontrado.
     return {VK_NULL_HANDLE, VK_NULL_HANDLE};
@@ -52,4 +94,151 @@ VmaBuffer ResourceManager::getBuffer(BufferHandle handle) const {
 
 VkBuffer ResourceManager::getVkBuffer(BufferHandle handle) const {
     return getBuffer(handle).buffer;
-}
\ No newline at end of file
+}
+
+// ================== Imagens ============================
+
+ImageHandle ResourceManager::createImage(const ImageCreateInfo& info) {
+    VkImageCreateInfo imageInfo{};
+    imageInfo.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
+    imageInfo.imageType = VK_IMAGE_TYPE_2D;
+    imageInfo.format = info.format;
+    imageInfo.extent = info.extent;
+    imageInfo.mipLevels = info.mipLevels;
+    imageInfo.arrayLayers = 1;
+    imageInfo.samples = VK_SAMPLE_COUNT_1_BIT;
+    imageInfo.tiling = VK_IMAGE_TILING_OPTIMAL;
+    imageInfo.usage = info.usage;
+    imageInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+    imageInfo.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+
+    VmaAllocationCreateInfo allocInfo{};
+    allocInfo.usage = info.memoryUsage;
+
+    VmaAllocationInfo allocationInfo{};
+    VmaImage newVmaImage = m_vmaWrapper->createImage(imageInfo, allocInfo, &allocationInfo);
+
+    VkImageViewCreateInfo viewInfo{};
+    viewInfo.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
+    viewInfo.image = newVmaImage.image;
+    viewInfo.viewType = VK_IMAGE_VIEW_TYPE_2D;
+    viewInfo.format = info.format;
+    viewInfo.subresourceRange.aspectMask = info.aspect;
+    viewInfo.subresourceRange.baseMipLevel = 0;
+    viewInfo.subresourceRange.levelCount = info.mipLevels;
+    viewInfo.subresourceRange.baseArrayLayer = 0;
+    viewInfo.subresourceRange.layerCount = 1;
+
+    VkImageView view = VK_NULL_HANDLE;
+    if (vkCreateImageView(m_device, &viewInfo, nullptr, &view) != VK_SUCCESS) {
+        m_vmaWrapper->destroyImage(newVmaImage);
+        throw std::runtime_error("[ResourceManager] : Failed to create image view!");
+    }
+
+    ImageHandle handle = m_imageHandleAllocator.allocate();
+    m_images[handle] = {newVmaImage, view, info.category, allocationInfo.size};
+    trackAllocation(info.category, allocationInfo.size);
+
+    return handle;
+}
+
+void ResourceManager::destroyImage(ImageHandle handle) {
+    auto it = m_images.find(handle);
+    if (it != m_images.end()) {
+        trackFree(it->second.category, it->second.allocatedSize);
+        vkDestroyImageView(m_device, it->second.view, nullptr);
+        m_vmaWrapper->destroyImage(it->second.image);
+        m_images.erase(it);
+    }
+}
+
+VmaImage ResourceManager::getImage(ImageHandle handle) const {
+    auto it = m_images.find(handle);
+    if (it != m_images.end()) {
+        return it->second.image;
+    }
+    return {VK_NULL_HANDLE, VK_NULL_HANDLE};
+}
+
+VkImage ResourceManager::getVkImage(ImageHandle handle) const {
+    return getImage(handle).image;
+}
+
+VkImageView ResourceManager::getImageView(ImageHandle handle) const {
+    auto it = m_images.find(handle);
+    return it != m_images.end() ? it->second.view : VK_NULL_HANDLE;
+}
+
+// ================== Contabilidade por categoria ============================
+
+const CategoryUsage& ResourceManager::getCategoryUsage(ResourceCategory category) const {
+    return m_categoryUsage.at(static_cast<size_t>(category));
+}
+
+VkDeviceSize ResourceManager::getTotalTrackedBytes() const {
+    VkDeviceSize total = 0;
+    for (const auto& usage : m_categoryUsage) {
+        total += usage.currentBytes;
+    }
+    return total;
+}
+
+void ResourceManager::trackAllocation(ResourceCategory category, VkDeviceSize size) {
+    CategoryUsage& usage = m_categoryUsage.at(static_cast<size_t>(category));
+    usage.currentBytes += size;
+    usage.peakBytes = std::max(usage.peakBytes, usage.currentBytes);
+    usage.liveCount++;
+    usage.totalAllocations++;
+}
+
+void ResourceManager::trackFree(ResourceCategory category, VkDeviceSize size) {
+    CategoryUsage& usage = m_categoryUsage.at(static_cast<size_t>(category));
+    usage.currentBytes -= std::min(usage.currentBytes, size);
+    if (usage.liveCount > 0) {
+        usage.liveCount--;
+    }
+}
+
+// ================== Suporte à desfragmentação ============================
+
+BufferHandle ResourceManager::getHandleFromAllocation(VmaAllocation allocation) const {
+    VmaAllocationInfo allocationInfo{};
+    vmaGetAllocationInfo(m_allocator, allocation, &allocationInfo);
+    return static_cast<BufferHandle>(reinterpret_cast<uintptr_t>(allocationInfo.pUserData));
+}
+
+VkBufferCreateInfo ResourceManager::getBufferCreateInfo(BufferHandle handle) const {
+    const BufferEntry& entry = m_buffers.at(handle);
+
+    VkBufferCreateInfo bufferInfo{};
+    bufferInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+    bufferInfo.size = entry.requestedSize;
+    bufferInfo.usage = entry.usage;
+    return bufferInfo;
+}
+
+void ResourceManager::beginMove(BufferHandle handle) {
+    m_buffers.at(handle).moving = true;
+}
+
+bool ResourceManager::endMove(BufferHandle handle) {
+    auto it = m_buffers.find(handle);
+    if (it == m_buffers.end()) {
+        return false;
+    }
+    it->second.moving = false;
+    if (it->second.pendingDestroy) {
+        // A VMA libera a alocação (operation = DESTROY); aqui só sai da contabilidade
+        trackFree(it->second.category, it->second.allocatedSize);
+        m_buffers.erase(it);
+        return false;
+    }
+    return true;
+}
+
+VkBuffer ResourceManager::swapVkBuffer(BufferHandle handle, VkBuffer newBuffer) {
+    BufferEntry& entry = m_buffers.at(handle);
+    VkBuffer oldBuffer = entry.buffer.buffer;
+    entry.buffer.buffer = newBuffer;
+    return oldBuffer;
+}
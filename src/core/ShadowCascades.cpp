@@ -0,0 +1,129 @@
+#include <core/Logger.hpp>
+#include <core/ShadowCascades.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <glm/gtc/matrix_transform.hpp>
+#include <stdexcept>
+
+ShadowCascades::ShadowCascades(ResourceManager &resources, BindlessDescriptors &bindless, VkFormat depthFormat, const ShadowSettings &settings) :
+    resources(resources),
+    bindless(bindless),
+    depthFormat(depthFormat),
+    settings(settings) {
+	if (settings.cascadeCount == 0 || settings.cascadeCount > MAX_CASCADES) {
+		throw std::runtime_error("[ShadowCascades] : Cascade count must be between 1 and 4!");
+	}
+
+	for (uint32_t i = 0; i < settings.cascadeCount; i++) {
+		Cascade &cascade      = cascades[i];
+		cascade.dynamic       = i < settings.dynamicCascades;
+		cascade.image         = resources.createImage({.extent   = {settings.resolution, settings.resolution, 1},
+		                                               .format   = depthFormat,
+		                                               .usage    = VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT | VK_IMAGE_USAGE_SAMPLED_BIT,
+		                                               .aspect   = VK_IMAGE_ASPECT_DEPTH_BIT,
+		                                               .category = ResourceCategory::RenderTarget});
+		cascade.bindlessIndex = bindless.registerTexture(resources.getImageView(cascade.image));
+	}
+
+	LOG_INFO("ShadowCascades", "{} cascades of {}x{} ({} dynamic, {} cached).", settings.cascadeCount, settings.resolution,
+	         settings.resolution, std::min(settings.dynamicCascades, settings.cascadeCount),
+	         settings.cascadeCount - std::min(settings.dynamicCascades, settings.cascadeCount));
+}
+
+ShadowCascades::~ShadowCascades() {
+	for (uint32_t i = 0; i < settings.cascadeCount; i++) {
+		bindless.releaseTexture(cascades[i].bindlessIndex);
+		resources.destroyImage(cascades[i].image);
+	}
+}
+
+void ShadowCascades::update(const glm::mat4 &view, float fovY, float aspect, float nearPlane, float farPlane, const glm::vec3 &lightDir, float casterDepth) {
+	glm::mat4 cameraToWorld = glm::inverse(view);
+	glm::vec3 direction     = glm::normalize(lightDir);
+	float     shadowFar     = std::min(farPlane, settings.shadowDistance);
+	float     tanHalfFov    = std::tan(fovY * 0.5f);
+
+	stats.renderedCascades = 0;
+	stats.cachedCascades   = 0;
+
+	float splitNear = nearPlane;
+	for (uint32_t i = 0; i < settings.cascadeCount; i++) {
+		// Divisão prática: mistura da logarítmica com a uniforme
+		float p         = static_cast<float>(i + 1) / static_cast<float>(settings.cascadeCount);
+		float logSplit  = nearPlane * std::pow(shadowFar / nearPlane, p);
+		float uniSplit  = nearPlane + (shadowFar - nearPlane) * p;
+		float splitFar  = settings.splitLambda * logSplit + (1.0f - settings.splitLambda) * uniSplit;
+
+		// Esfera que envolve a fatia [splitNear, splitFar] do frustum
+		glm::vec3 corners[8];
+		glm::vec3 center(0.0f);
+		for (uint32_t c = 0; c < 8; c++) {
+			float depth = (c & 4) ? splitFar : splitNear;
+			float y     = depth * tanHalfFov * ((c & 2) ? 1.0f : -1.0f);
+			float x     = depth * tanHalfFov * aspect * ((c & 1) ? 1.0f : -1.0f);
+			corners[c]  = glm::vec3(cameraToWorld * glm::vec4(x, y, -depth, 1.0f));
+			center += corners[c] / 8.0f;
+		}
+		float radius = 0.0f;
+		for (const glm::vec3 &corner : corners) {
+			radius = std::max(radius, glm::length(corner - center));
+		}
+		radius = std::ceil(radius * 16.0f) / 16.0f;        // Tamanho estável entre frames
+
+		Cascade &cascade = cascades[i];
+		cascade.splitFar = splitFar;
+		splitNear        = splitFar;
+
+		// Em cache enquanto a fatia atual cabe na esfera guardada e a luz não girou
+		bool lightMoved  = glm::dot(direction, cascade.lightDir) < settings.lightTolerance;
+		bool sliceInside = glm::length(center - cascade.center) + radius <= cascade.radius;
+		if (!cascade.dynamic && cascade.initialized && !lightMoved && sliceInside) {
+			cascade.needsRender = false;
+			stats.cachedCascades++;
+			continue;
+		}
+
+		if (!cascade.dynamic && cascade.initialized) {
+			stats.cacheRefreshes++;
+		}
+		cascade.center      = center;
+		cascade.radius      = cascade.dynamic ? radius : radius * (1.0f + settings.cachePadding);
+		cascade.lightDir    = direction;
+		cascade.viewProj    = fitCascade(cascade.center, cascade.radius, direction, casterDepth);
+		cascade.needsRender = true;
+		stats.renderedCascades++;
+	}
+}
+
+glm::mat4 ShadowCascades::fitCascade(const glm::vec3 &center, float radius, const glm::vec3 &lightDir, float casterDepth) const {
+	glm::vec3 up  = std::abs(lightDir.y) > 0.99f ? glm::vec3(0.0f, 0.0f, 1.0f) : glm::vec3(0.0f, 1.0f, 0.0f);
+	glm::vec3 eye = center - lightDir * (radius + casterDepth);
+
+	glm::mat4 lightView = glm::lookAt(eye, center, up);
+	// Ortográfica com depth em [0, 1] (o glm vendorizado só gera [-1, 1])
+	glm::mat4 lightProj(1.0f);
+	lightProj[0][0] = 1.0f / radius;
+	lightProj[1][1] = 1.0f / radius;
+	lightProj[2][2] = -1.0f / (2.0f * radius + casterDepth);
+
+	// Alinha a origem ao texel da shadow map: a sombra não "nada" quando a câmera anda
+	glm::mat4 viewProj  = lightProj * lightView;
+	float     halfRes   = static_cast<float>(settings.resolution) * 0.5f;
+	glm::vec4 origin    = viewProj * glm::vec4(0.0f, 0.0f, 0.0f, 1.0f) * halfRes;
+	glm::vec2 offset    = (glm::round(glm::vec2(origin)) - glm::vec2(origin)) / halfRes;
+	lightProj[3][0] += offset.x;
+	lightProj[3][1] += offset.y;
+
+	return lightProj * lightView;
+}
+
+void ShadowCascades::writeSceneData(GpuSceneData &data) const {
+	data.cascadeCount    = settings.cascadeCount;
+	data.shadowTexelSize = 1.0f / static_cast<float>(settings.resolution);
+	for (uint32_t i = 0; i < settings.cascadeCount; i++) {
+		data.cascadeViewProj[i]  = cascades[i].viewProj;
+		data.cascadeSplits[i]    = cascades[i].splitFar;
+		data.shadowMapIndices[i] = cascades[i].bindlessIndex;
+	}
+}
@@ -1,4 +1,24 @@
 #include <core/SwapchainManager.hpp>
+#include <core/Logger.hpp>
+
+namespace {
+
+const char *presentModeName(VkPresentModeKHR mode) {
+	switch (mode) {
+		case VK_PRESENT_MODE_IMMEDIATE_KHR:
+			return "IMMEDIATE";
+		case VK_PRESENT_MODE_MAILBOX_KHR:
+			return "MAILBOX";
+		case VK_PRESENT_MODE_FIFO_KHR:
+			return "FIFO";
+		case VK_PRESENT_MODE_FIFO_RELAXED_KHR:
+			return "FIFO_RELAXED";
+		default:
+			return "OTHER";
+	}
+}
+
+}        // namespace
 
 bool checkDeviceSupportSwapChain(VkPhysicalDevice device) {
 	return true;
@@ -29,7 +49,6 @@ SwapchainManager::SwapChainSupportDetails SwapchainManager::querySwapchainSuppor
 }
 
 bool SwapchainManager::checkDeviceSupportSwapChain(VkPhysicalDevice device) {
-	std::cout << "[SwapchainManager] : Verifying if Device Supports Swap Chain";
 	uint32_t extensionCount;
 	vkEnumerateDeviceExtensionProperties(device, nullptr, &extensionCount, nullptr);
 
@@ -41,27 +60,19 @@ bool SwapchainManager::checkDeviceSupportSwapChain(VkPhysicalDevice device) {
 	for (const auto &extension : availableExtensions) {
 		requiredExtensions.erase(extension.extensionName);
 	}
-	if (requiredExtensions.empty()) {
-		std::cout << ": OK" << std::endl;
-	}
-	else {
-		std::cout << ": ERROR" << std::endl;
-	}
+	LOG_INFO("SwapchainManager", "Verifying if Device Supports Swap Chain: {}", requiredExtensions.empty() ? "OK" : "ERROR");
 
 	return requiredExtensions.empty();
 }
 
-bool SwapchainManager::createSwapchain(uint32_t width, uint32_t height) {
+bool SwapchainManager::createSwapchain(uint32_t width, uint32_t height, VkSwapchainKHR oldSwapchain) {
 	SwapChainSupportDetails swapChainSupport = SwapchainManager::querySwapchainSupport();
 
 	VkSurfaceFormatKHR surfaceFormat = chooseSwapSurfaceFormat(swapChainSupport.formats);
-	VkPresentModeKHR   presentMode   = chooseSwapPresentMode(swapChainSupport.presentModes);
 	VkExtent2D         extent        = chooseSwapExtent(swapChainSupport.capabilities, width, height);
 
-	uint32_t imageCount = swapChainSupport.capabilities.minImageCount + 1;
-	if (swapChainSupport.capabilities.maxImageCount > 0 && imageCount > swapChainSupport.capabilities.maxImageCount) {
-		imageCount = swapChainSupport.capabilities.maxImageCount;
-	}
+	presentMode         = chooseSwapPresentMode(swapChainSupport.presentModes);
+	uint32_t imageCount = chooseImageCount(swapChainSupport.capabilities, presentMode);
 	VkSwapchainCreateInfoKHR createInfo{};
 	createInfo.sType            = VK_STRUCTURE_TYPE_SWAPCHAIN_CREATE_INFO_KHR;
 	createInfo.surface          = surface;
@@ -72,6 +83,12 @@ bool SwapchainManager::createSwapchain(uint32_t width, uint32_t height) {
 	createInfo.imageArrayLayers = 1;
 	createInfo.imageUsage       = VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT;
 
+	// Upscale da resolução dinâmica é um blit direto na imagem do swapchain
+	transferDstSupported = (swapChainSupport.capabilities.supportedUsageFlags & VK_IMAGE_USAGE_TRANSFER_DST_BIT) != 0;
+	if (transferDstSupported) {
+		createInfo.imageUsage |= VK_IMAGE_USAGE_TRANSFER_DST_BIT;
+	}
+
 	this->swapchainImageFormat = surfaceFormat.format;
 	this->swapchainExtent = extent;
 
@@ -101,13 +118,15 @@ bool SwapchainManager::createSwapchain(uint32_t width, uint32_t height) {
 	// Ativa o clipping, o que significa que não nos importamos com pixels que estão escondidos por outras janelas.
 	createInfo.clipped = VK_TRUE;
 
-	// Como esta é a nossa primeira swapchain, não há uma "antiga" para referenciar.
-	createInfo.oldSwapchain = VK_NULL_HANDLE;
+	// Na recriação, o swapchain antigo é aposentado: o driver pode reaproveitar recursos dele
+	// e as imagens já adquiridas continuam válidas até ele ser destruído.
+	createInfo.oldSwapchain = oldSwapchain;
 
 	if (vkCreateSwapchainKHR(device, &createInfo, nullptr, &swapchain) != VK_SUCCESS) {
 		throw std::runtime_error("[SwapchainManager] : failed to create swap chain!");
 	}
 
+	LOG_INFO("SwapchainManager", "Present policy {} -> {}, {} images requested.", toString(presentPolicy), presentModeName(presentMode), imageCount);
 	return true;
 }
 
@@ -122,15 +141,117 @@ VkSurfaceFormatKHR SwapchainManager::chooseSwapSurfaceFormat(const std::vector<V
 }
 
 VkPresentModeKHR SwapchainManager::chooseSwapPresentMode(const std::vector<VkPresentModeKHR> &availablePresentModes) {
-	for (const auto &availablePresentMode : availablePresentModes) {
-		if (availablePresentMode == VK_PRESENT_MODE_MAILBOX_KHR) {
-			return availablePresentMode;
+	std::vector<VkPresentModeKHR> preferred;
+	switch (presentPolicy) {
+		case PresentPolicy::Throughput:
+			preferred = {VK_PRESENT_MODE_MAILBOX_KHR};
+			break;
+		case PresentPolicy::LowLatency:
+			preferred = {VK_PRESENT_MODE_MAILBOX_KHR, VK_PRESENT_MODE_FIFO_RELAXED_KHR};
+			break;
+		case PresentPolicy::Vsync:
+			break;
+		case PresentPolicy::Immediate:
+			preferred = {VK_PRESENT_MODE_IMMEDIATE_KHR, VK_PRESENT_MODE_MAILBOX_KHR};
+			break;
+	}
+
+	for (VkPresentModeKHR mode : preferred) {
+		if (std::find(availablePresentModes.begin(), availablePresentModes.end(), mode) != availablePresentModes.end()) {
+			return mode;
 		}
 	}
 
+	// FIFO é o único modo que a spec garante
 	return VK_PRESENT_MODE_FIFO_KHR;
 }
 
+uint32_t SwapchainManager::chooseImageCount(const VkSurfaceCapabilitiesKHR &capabilities, VkPresentModeKHR mode) const {
+	uint32_t imageCount = capabilities.minImageCount + 1;
+	switch (presentPolicy) {
+		case PresentPolicy::Throughput:
+			// MAILBOX precisa de uma imagem livre enquanto outra espera o vblank
+			imageCount = std::max(imageCount, mode == VK_PRESENT_MODE_MAILBOX_KHR ? 3u : 2u);
+			break;
+		case PresentPolicy::LowLatency:
+		case PresentPolicy::Immediate:
+			// Menos imagens = menos frames prontos esperando na fila de apresentação
+			imageCount = std::max(capabilities.minImageCount, 2u);
+			break;
+		case PresentPolicy::Vsync:
+			break;
+	}
+
+	if (capabilities.maxImageCount > 0 && imageCount > capabilities.maxImageCount) {
+		imageCount = capabilities.maxImageCount;
+	}
+	return imageCount;
+}
+
+bool SwapchainManager::parsePresentPolicy(const std::string &name, PresentPolicy &policy) {
+	if (name == "throughput") {
+		policy = PresentPolicy::Throughput;
+	}
+	else if (name == "low-latency") {
+		policy = PresentPolicy::LowLatency;
+	}
+	else if (name == "vsync") {
+		policy = PresentPolicy::Vsync;
+	}
+	else if (name == "immediate") {
+		policy = PresentPolicy::Immediate;
+	}
+	else {
+		return false;
+	}
+	return true;
+}
+
+const char *SwapchainManager::toString(PresentPolicy policy) {
+	switch (policy) {
+		case PresentPolicy::Throughput:
+			return "throughput";
+		case PresentPolicy::LowLatency:
+			return "low-latency";
+		case PresentPolicy::Vsync:
+			return "vsync";
+		case PresentPolicy::Immediate:
+			return "immediate";
+	}
+	return "unknown";
+}
+
+VkResult SwapchainManager::present(VkQueue queue, VkSemaphore waitSemaphore, uint32_t imageIndex) {
+	VkPresentInfoKHR presentInfo{};
+	presentInfo.sType              = VK_STRUCTURE_TYPE_PRESENT_INFO_KHR;
+	presentInfo.waitSemaphoreCount = 1;
+	presentInfo.pWaitSemaphores    = &waitSemaphore;
+	presentInfo.swapchainCount     = 1;
+	presentInfo.pSwapchains        = &swapchain;
+	presentInfo.pImageIndices      = &imageIndex;
+
+	VkResult result = vkQueuePresentKHR(queue, &presentInfo);
+
+	// Com FIFO o present bloqueia quando a fila enche, então o intervalo converge para o refresh do monitor
+	auto now = std::chrono::steady_clock::now();
+	if (presentTiming.presentCount > 0) {
+		double intervalMs = std::chrono::duration<double, std::milli>(now - lastPresentTime).count();
+
+		presentTiming.lastIntervalMs    = intervalMs;
+		presentTiming.averageIntervalMs = presentTiming.presentCount == 1 ? intervalMs : presentTiming.averageIntervalMs * 0.95 + intervalMs * 0.05;
+		presentTiming.minIntervalMs     = presentTiming.presentCount == 1 ? intervalMs : std::min(presentTiming.minIntervalMs, intervalMs);
+		presentTiming.maxIntervalMs     = std::max(presentTiming.maxIntervalMs, intervalMs);
+	}
+	lastPresentTime = now;
+	presentTiming.presentCount++;
+
+	return result;
+}
+
+void SwapchainManager::resetPresentTimingStats() {
+	presentTiming = {};
+}
+
 VkExtent2D SwapchainManager::chooseSwapExtent(const VkSurfaceCapabilitiesKHR &capabilities, uint32_t width, uint32_t height) {
 	if (capabilities.currentExtent.width != std::numeric_limits<uint32_t>::max()) {
 		return capabilities.currentExtent;
@@ -196,12 +317,12 @@ bool SwapchainManager::createImageViews() {
       }
    }
 
-   std::cout << "[SwapchainManager] : Image views created successfully!" << std::endl;
+   LOG_INFO("SwapchainManager", "Image views created successfully!");
    return true;
 }
 
 void SwapchainManager::cleanup() {
-	std::cout << "[SwapchainManager] : Final cleanup..." << std::endl;
+	LOG_INFO("SwapchainManager", "Final cleanup...");
 	cleanupSwapchain();
 }
 
@@ -231,47 +352,60 @@ bool SwapchainManager::createFramebuffers(VkRenderPass renderPass) {
 			throw std::runtime_error("[SwapchainManager] : Failed to create framebuffer!");
 		}
 	}
-	std::cout << "[SwapchainManager] : Framebuffers created successfully! (" << swapchainFramebuffers.size() << " framebuffers)" << std::endl;
+	LOG_INFO("SwapchainManager", "Framebuffers created successfully! ({} framebuffers)", swapchainFramebuffers.size());
    return true;
 }
 
 
 void SwapchainManager::cleanupSwapchain() {
-	std::cout << "[SwapchainManager] : Cleaning up swapchain resources..." << std::endl;
+	LOG_DEBUG("SwapchainManager", "Cleaning up swapchain resources...");
 
 	for (auto framebuffer : swapchainFramebuffers) {
 		vkDestroyFramebuffer(device, framebuffer, nullptr);
 	}
 
 	swapchainFramebuffers.clear();
-	std::cout << "\t [SwapchainManager] : Framebuffers destroyed." << std::endl;
+	LOG_DEBUG("SwapchainManager", "Framebuffers destroyed.");
 
 	for (auto imageView : swapchainImageViews) {
 		vkDestroyImageView(device, imageView, nullptr);
 	}
 
 	swapchainImageViews.clear();
-	std::cout << "\t [SwapchainManager] : Image views destroyed." << std::endl;
+	LOG_DEBUG("SwapchainManager", "Image views destroyed.");
 
 	if (swapchain != VK_NULL_HANDLE) {
 		vkDestroySwapchainKHR(device, swapchain, nullptr);
 		swapchain = VK_NULL_HANDLE;
-		std::cout << "[SwapchainManager] : Swapchain destroyed." << std::endl;
+		LOG_DEBUG("SwapchainManager", "Swapchain destroyed.");
 	}
 }
 
-void SwapchainManager::recreateSwapchain(uint32_t width, uint32_t height) {
-	std::cout << "[SwapchainManager] : Recreating swapchain..." << std::endl;
+void SwapchainManager::recreateSwapchain(uint32_t width, uint32_t height, DeletionQueue &deletionQueue, uint64_t retireValue) {
+	LOG_DEBUG("SwapchainManager", "Recreating swapchain...");
 
-	vkDeviceWaitIdle(device); // Wait for device to finish operations
+	// Sem vkDeviceWaitIdle: os frames em voo terminam de renderizar nas imagens antigas
+	VkSwapchainKHR             oldSwapchain    = swapchain;
+	std::vector<VkImageView>   oldImageViews   = std::move(swapchainImageViews);
+	std::vector<VkFramebuffer> oldFramebuffers = std::move(swapchainFramebuffers);
+	swapchainImageViews.clear();
+	swapchainFramebuffers.clear();
 
-	// Clean up old resources
-	cleanupSwapchain();
-    
-	// Recreate swapchain and dependent resources
-	createSwapchain(width, height);
+	createSwapchain(width, height, oldSwapchain);
 	createImageViews();
 	// Note: Framebuffers will be recreated by VulkanManager
 
-	std::cout << "\t [SwapchainManager] : Swapchain recreation complete." << std::endl;
-}
\ No newline at end of file
+	VkDevice dev = device;
+	deletionQueue.push(retireValue, [dev, oldSwapchain, oldImageViews, oldFramebuffers]() {
+		for (VkFramebuffer framebuffer : oldFramebuffers) {
+			vkDestroyFramebuffer(dev, framebuffer, nullptr);
+		}
+		for (VkImageView imageView : oldImageViews) {
+			vkDestroyImageView(dev, imageView, nullptr);
+		}
+		vkDestroySwapchainKHR(dev, oldSwapchain, nullptr);
+		LOG_DEBUG("SwapchainManager", "Retired swapchain destroyed.");
+	});
+
+	LOG_DEBUG("SwapchainManager", "Swapchain recreation complete.");
+}
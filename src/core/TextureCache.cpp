@@ -0,0 +1,165 @@
+#include <core/TextureCache.hpp>
+#include <core/Logger.hpp>
+
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <sstream>
+
+namespace {
+
+// Versão ("02": mips com média em espaço linear); muda quando o conteúdo gerado muda
+const uint8_t cacheIdentifier[12] = {0xAB, 'S', 'R', 'T', 'X', ' ', '0', '2', 0xBB, '\r', '\n', 0x1A};
+
+struct FileHeader {
+	uint8_t  identifier[12];
+	uint32_t vkFormat;
+	uint32_t width;
+	uint32_t height;
+	uint32_t levelCount;
+	uint32_t reserved;
+	uint64_t sourceSize;
+	int64_t  sourceTime;
+};
+
+struct LevelIndex {
+	uint64_t byteOffset;        // Relativo ao início da área de dados
+	uint64_t byteLength;
+};
+
+bool readSourceStamp(const std::string &sourcePath, uint64_t &size, int64_t &time) {
+	std::error_code error;
+	size = std::filesystem::file_size(sourcePath, error);
+	if (error) {
+		return false;
+	}
+	time = static_cast<int64_t>(std::filesystem::last_write_time(sourcePath, error).time_since_epoch().count());
+	return !error;
+}
+
+}        // namespace
+
+TextureCache::TextureCache(std::string directory) :
+    m_directory(std::move(directory)) {
+}
+
+VkFormat TextureCache::toVkFormat(BlockFormat format) {
+	return format == BlockFormat::BC1 ? VK_FORMAT_BC1_RGB_SRGB_BLOCK : VK_FORMAT_BC7_SRGB_BLOCK;
+}
+
+std::string TextureCache::cachePathFor(const std::string &sourcePath, BlockFormat format) const {
+	// Nome legível + hash do caminho completo (dois "colormap.png" de pastas diferentes não colidem)
+	std::error_code       error;
+	std::filesystem::path canonical = std::filesystem::weakly_canonical(sourcePath, error);
+	size_t                pathHash  = std::hash<std::string>{}(error ? sourcePath : canonical.string());
+
+	std::ostringstream name;
+	name << std::filesystem::path(sourcePath).stem().string() << "_" << std::hex << pathHash
+	     << (format == BlockFormat::BC1 ? ".bc1" : ".bc7") << ".srtx";
+	return (std::filesystem::path(m_directory) / name.str()).string();
+}
+
+CompressedTexture TextureCache::build(const ImageData &image, BlockFormat format) {
+	CompressedTexture texture;
+	texture.format = toVkFormat(format);
+	texture.width  = image.width;
+	texture.height = image.height;
+
+	for (const ImageData &mip : TextureCompressor::buildMipChain(image)) {
+		std::vector<uint8_t> blocks = TextureCompressor::compress(mip, format);
+
+		// Offsets alinhados a 16 (vkCmdCopyBufferToImage exige múltiplo do tamanho do bloco)
+		VkDeviceSize offset = (texture.data.size() + 15) & ~VkDeviceSize(15);
+		texture.data.resize(offset + blocks.size());
+		std::memcpy(texture.data.data() + offset, blocks.data(), blocks.size());
+
+		texture.mipOffsets.push_back(offset);
+		texture.mipSizes.push_back(blocks.size());
+	}
+	return texture;
+}
+
+bool TextureCache::load(const std::string &sourcePath, BlockFormat format, CompressedTexture &out) const {
+	std::ifstream file(cachePathFor(sourcePath, format), std::ios::binary | std::ios::ate);
+	if (!file.is_open()) {
+		return false;
+	}
+	size_t fileSize = static_cast<size_t>(file.tellg());
+	file.seekg(0);
+
+	FileHeader header{};
+	if (fileSize < sizeof(header) || !file.read(reinterpret_cast<char *>(&header), sizeof(header)) ||
+	    std::memcmp(header.identifier, cacheIdentifier, sizeof(cacheIdentifier)) != 0 ||
+	    header.vkFormat != static_cast<uint32_t>(toVkFormat(format)) || header.levelCount == 0 || header.levelCount > 32) {
+		return false;
+	}
+
+	uint64_t sourceSize = 0;
+	int64_t  sourceTime = 0;
+	if (readSourceStamp(sourcePath, sourceSize, sourceTime) &&
+	    (sourceSize != header.sourceSize || sourceTime != header.sourceTime)) {
+		LOG_INFO("TextureCache", "{} changed, rebuilding cache.", sourcePath);
+		return false;
+	}
+
+	std::vector<LevelIndex> levels(header.levelCount);
+	size_t                  dataStart = sizeof(header) + levels.size() * sizeof(LevelIndex);
+	if (fileSize < dataStart || !file.read(reinterpret_cast<char *>(levels.data()), levels.size() * sizeof(LevelIndex))) {
+		return false;
+	}
+
+	out        = {};
+	out.format = static_cast<VkFormat>(header.vkFormat);
+	out.width  = header.width;
+	out.height = header.height;
+	out.data.resize(fileSize - dataStart);
+	if (!file.read(reinterpret_cast<char *>(out.data.data()), out.data.size())) {
+		return false;
+	}
+
+	for (const LevelIndex &level : levels) {
+		if (level.byteOffset + level.byteLength > out.data.size()) {
+			return false;
+		}
+		out.mipOffsets.push_back(level.byteOffset);
+		out.mipSizes.push_back(level.byteLength);
+	}
+	return true;
+}
+
+void TextureCache::store(const std::string &sourcePath, BlockFormat format, const CompressedTexture &texture) const {
+	std::error_code error;
+	std::filesystem::create_directories(m_directory, error);
+
+	FileHeader header{};
+	std::memcpy(header.identifier, cacheIdentifier, sizeof(cacheIdentifier));
+	header.vkFormat   = static_cast<uint32_t>(texture.format);
+	header.width      = texture.width;
+	header.height     = texture.height;
+	header.levelCount = texture.getMipLevels();
+	readSourceStamp(sourcePath, header.sourceSize, header.sourceTime);
+
+	std::vector<LevelIndex> levels;
+	for (uint32_t i = 0; i < texture.getMipLevels(); i++) {
+		levels.push_back({texture.mipOffsets[i], texture.mipSizes[i]});
+	}
+
+	// Grava num temporário e renomeia, para nunca deixar um cache pela metade
+	std::string path     = cachePathFor(sourcePath, format);
+	std::string tempPath = path + ".tmp";
+	{
+		std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+		if (!file.is_open()) {
+			LOG_ERROR("TextureCache", "Failed to write {}", tempPath);
+			return;
+		}
+		file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+		file.write(reinterpret_cast<const char *>(levels.data()), levels.size() * sizeof(LevelIndex));
+		file.write(reinterpret_cast<const char *>(texture.data.data()), texture.data.size());
+	}
+	std::filesystem::rename(tempPath, path, error);
+	if (error) {
+		LOG_ERROR("TextureCache", "Failed to write {} ({})", path, error.message());
+	}
+}
@@ -0,0 +1,411 @@
+#include <core/TextureCompressor.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+namespace {
+
+// Escreve bits em sequência, LSB primeiro (layout do BC7)
+struct BitWriter {
+	uint8_t *out;
+	uint32_t pos = 0;
+
+	void write(uint32_t value, int count) {
+		for (int i = 0; i < count; i++, pos++) {
+			if ((value >> i) & 1u) {
+				out[pos >> 3] |= static_cast<uint8_t>(1u << (pos & 7));
+			}
+		}
+	}
+};
+
+// Ajusta uma reta (média + eixo principal) aos 16 pixels e devolve os extremos projetados
+void fitEndpoints(const uint8_t *rgba, int channels, float start[4], float end[4]) {
+	float mean[4] = {};
+	for (int i = 0; i < 16; i++) {
+		for (int c = 0; c < channels; c++) {
+			mean[c] += rgba[i * 4 + c];
+		}
+	}
+	for (int c = 0; c < channels; c++) {
+		mean[c] /= 16.0f;
+	}
+
+	float covariance[4][4] = {};
+	for (int i = 0; i < 16; i++) {
+		float d[4];
+		for (int c = 0; c < channels; c++) {
+			d[c] = rgba[i * 4 + c] - mean[c];
+		}
+		for (int a = 0; a < channels; a++) {
+			for (int b = 0; b < channels; b++) {
+				covariance[a][b] += d[a] * d[b];
+			}
+		}
+	}
+
+	// Power iteration; começa pela diagonal da bounding box
+	float axis[4] = {};
+	for (int c = 0; c < channels; c++) {
+		uint8_t lo = 255, hi = 0;
+		for (int i = 0; i < 16; i++) {
+			lo = std::min(lo, rgba[i * 4 + c]);
+			hi = std::max(hi, rgba[i * 4 + c]);
+		}
+		axis[c] = static_cast<float>(hi - lo);
+	}
+	for (int iteration = 0; iteration < 8; iteration++) {
+		float next[4] = {};
+		for (int a = 0; a < channels; a++) {
+			for (int b = 0; b < channels; b++) {
+				next[a] += covariance[a][b] * axis[b];
+			}
+		}
+		float length = 0.0f;
+		for (int c = 0; c < channels; c++) {
+			length += next[c] * next[c];
+		}
+		if (length < 1e-8f) {
+			break;
+		}
+		length = std::sqrt(length);
+		for (int c = 0; c < channels; c++) {
+			axis[c] = next[c] / length;
+		}
+	}
+
+	float minT = std::numeric_limits<float>::max();
+	float maxT = std::numeric_limits<float>::lowest();
+	for (int i = 0; i < 16; i++) {
+		float t = 0.0f;
+		for (int c = 0; c < channels; c++) {
+			t += (rgba[i * 4 + c] - mean[c]) * axis[c];
+		}
+		minT = std::min(minT, t);
+		maxT = std::max(maxT, t);
+	}
+
+	for (int c = 0; c < channels; c++) {
+		start[c] = std::clamp(mean[c] + axis[c] * minT, 0.0f, 255.0f);
+		end[c]   = std::clamp(mean[c] + axis[c] * maxT, 0.0f, 255.0f);
+	}
+}
+
+// Mínimos quadrados: melhores extremos para os pesos (0..1) já escolhidos de cada pixel
+bool refineEndpoints(const uint8_t *rgba, int channels, const float *weights, float start[4], float end[4]) {
+	float aa = 0.0f, ab = 0.0f, bb = 0.0f;
+	float ax[4] = {}, bx[4] = {};
+	for (int i = 0; i < 16; i++) {
+		float b = weights[i];
+		float a = 1.0f - b;
+		aa += a * a;
+		ab += a * b;
+		bb += b * b;
+		for (int c = 0; c < channels; c++) {
+			ax[c] += a * rgba[i * 4 + c];
+			bx[c] += b * rgba[i * 4 + c];
+		}
+	}
+
+	float determinant = aa * bb - ab * ab;
+	if (std::fabs(determinant) < 1e-6f) {
+		return false;
+	}
+	for (int c = 0; c < channels; c++) {
+		start[c] = std::clamp((bb * ax[c] - ab * bx[c]) / determinant, 0.0f, 255.0f);
+		end[c]   = std::clamp((aa * bx[c] - ab * ax[c]) / determinant, 0.0f, 255.0f);
+	}
+	return true;
+}
+
+int colorDistance(const uint8_t *a, const int *b, int channels) {
+	int distance = 0;
+	for (int c = 0; c < channels; c++) {
+		int d = a[c] - b[c];
+		distance += d * d;
+	}
+	return distance;
+}
+
+// ================== BC1 ============================
+
+uint16_t packRgb565(const float color[4]) {
+	uint32_t r = static_cast<uint32_t>(std::lround(color[0] * 31.0f / 255.0f));
+	uint32_t g = static_cast<uint32_t>(std::lround(color[1] * 63.0f / 255.0f));
+	uint32_t b = static_cast<uint32_t>(std::lround(color[2] * 31.0f / 255.0f));
+	return static_cast<uint16_t>((r << 11) | (g << 5) | b);
+}
+
+void unpackRgb565(uint16_t packed, int color[4]) {
+	int r    = (packed >> 11) & 31;
+	int g    = (packed >> 5) & 63;
+	int b    = packed & 31;
+	color[0] = (r << 3) | (r >> 2);
+	color[1] = (g << 2) | (g >> 4);
+	color[2] = (b << 3) | (b >> 2);
+	color[3] = 255;
+}
+
+// Codifica com extremos fixos; devolve o erro e os pesos usados por pixel (para o refinamento)
+int encodeBC1WithEndpoints(const uint8_t *rgba, const float start[4], const float end[4], uint8_t *out, float *weights) {
+	uint16_t color0 = packRgb565(start);
+	uint16_t color1 = packRgb565(end);
+
+	// Modo de 4 cores exige color0 > color1
+	bool swapped = color0 < color1;
+	if (swapped) {
+		std::swap(color0, color1);
+	}
+
+	int palette[4][4];
+	unpackRgb565(color0, palette[0]);
+	unpackRgb565(color1, palette[1]);
+	for (int c = 0; c < 3; c++) {
+		palette[2][c] = (2 * palette[0][c] + palette[1][c]) / 3;
+		palette[3][c] = (palette[0][c] + 2 * palette[1][c]) / 3;
+	}
+	static const float paletteWeights[4] = {0.0f, 1.0f, 1.0f / 3.0f, 2.0f / 3.0f};
+
+	uint32_t indices = 0;
+	int      error   = 0;
+	for (int i = 0; i < 16; i++) {
+		int best = 0, bestDistance = std::numeric_limits<int>::max();
+		// color0 == color1 cai no modo de 3 cores; índice 0 é sempre seguro
+		int candidates = color0 == color1 ? 1 : 4;
+		for (int p = 0; p < candidates; p++) {
+			int distance = colorDistance(&rgba[i * 4], palette[p], 3);
+			if (distance < bestDistance) {
+				bestDistance = distance;
+				best         = p;
+			}
+		}
+		indices |= static_cast<uint32_t>(best) << (i * 2);
+		error += bestDistance;
+		// Pesos relativos a (start, end), desfazendo a troca
+		weights[i] = swapped ? 1.0f - paletteWeights[best] : paletteWeights[best];
+	}
+
+	out[0] = static_cast<uint8_t>(color0 & 0xFF);
+	out[1] = static_cast<uint8_t>(color0 >> 8);
+	out[2] = static_cast<uint8_t>(color1 & 0xFF);
+	out[3] = static_cast<uint8_t>(color1 >> 8);
+	std::memcpy(out + 4, &indices, 4);        // Little-endian
+	return error;
+}
+
+// ================== BC7 (modo 6) ============================
+
+const int bc7Weights4[16] = {0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64};
+
+// Quantiza um extremo para 7 bits + p-bit compartilhado entre os 4 canais
+void quantizeBC7Endpoint(const float endpoint[4], uint8_t quantized[4], uint8_t &pBit) {
+	int bestError = std::numeric_limits<int>::max();
+	for (uint8_t p = 0; p < 2; p++) {
+		uint8_t candidate[4];
+		int     error = 0;
+		for (int c = 0; c < 4; c++) {
+			int value    = static_cast<int>(std::lround((endpoint[c] - p) / 2.0f));
+			candidate[c] = static_cast<uint8_t>(std::clamp(value, 0, 127));
+			int decoded  = (candidate[c] << 1) | p;
+			int d        = decoded - static_cast<int>(std::lround(endpoint[c]));
+			error += d * d;
+		}
+		if (error < bestError) {
+			bestError = error;
+			pBit      = p;
+			std::memcpy(quantized, candidate, 4);
+		}
+	}
+}
+
+int encodeBC7WithEndpoints(const uint8_t *rgba, const float start[4], const float end[4], uint8_t *out, float *weights) {
+	uint8_t endpoint0[4], endpoint1[4], pBit0 = 0, pBit1 = 0;
+	quantizeBC7Endpoint(start, endpoint0, pBit0);
+	quantizeBC7Endpoint(end, endpoint1, pBit1);
+
+	int decoded0[4], decoded1[4];
+	for (int c = 0; c < 4; c++) {
+		decoded0[c] = (endpoint0[c] << 1) | pBit0;
+		decoded1[c] = (endpoint1[c] << 1) | pBit1;
+	}
+
+	int palette[16][4];
+	for (int p = 0; p < 16; p++) {
+		for (int c = 0; c < 4; c++) {
+			palette[p][c] = ((64 - bc7Weights4[p]) * decoded0[c] + bc7Weights4[p] * decoded1[c] + 32) >> 6;
+		}
+	}
+
+	uint8_t indices[16];
+	int     error = 0;
+	for (int i = 0; i < 16; i++) {
+		int best = 0, bestDistance = std::numeric_limits<int>::max();
+		for (int p = 0; p < 16; p++) {
+			int distance = colorDistance(&rgba[i * 4], palette[p], 4);
+			if (distance < bestDistance) {
+				bestDistance = distance;
+				best         = p;
+			}
+		}
+		indices[i] = static_cast<uint8_t>(best);
+		error += bestDistance;
+		weights[i] = bc7Weights4[best] / 64.0f;
+	}
+
+	// O índice do pixel 0 (âncora) só tem 3 bits: se o bit alto estiver ligado, inverte os extremos
+	if (indices[0] & 8) {
+		std::swap(endpoint0, endpoint1);
+		std::swap(pBit0, pBit1);
+		for (uint8_t &index : indices) {
+			index = static_cast<uint8_t>(15 - index);
+		}
+	}
+
+	std::memset(out, 0, 16);
+	BitWriter writer{out};
+	writer.write(1u << 6, 7);        // Modo 6
+	for (int c = 0; c < 4; c++) {
+		writer.write(endpoint0[c], 7);
+		writer.write(endpoint1[c], 7);
+	}
+	writer.write(pBit0, 1);
+	writer.write(pBit1, 1);
+	writer.write(indices[0], 3);
+	for (int i = 1; i < 16; i++) {
+		writer.write(indices[i], 4);
+	}
+	return error;
+}
+
+// Curva sRGB -> linear dos 256 valores de um canal de cor
+const std::array<float, 256> &srgbToLinearTable() {
+	static const std::array<float, 256> table = [] {
+		std::array<float, 256> values{};
+		for (int i = 0; i < 256; i++) {
+			float s   = i / 255.0f;
+			values[i] = s <= 0.04045f ? s / 12.92f : std::pow((s + 0.055f) / 1.055f, 2.4f);
+		}
+		return values;
+	}();
+	return table;
+}
+
+uint8_t linearToSrgb(float linear) {
+	float s = linear <= 0.0031308f ? linear * 12.92f : 1.055f * std::pow(linear, 1.0f / 2.4f) - 0.055f;
+	return static_cast<uint8_t>(std::clamp(s * 255.0f + 0.5f, 0.0f, 255.0f));
+}
+
+}        // namespace
+
+// ================== Blocos ============================
+
+void TextureCompressor::encodeBlockBC1(const uint8_t *rgba, uint8_t *out) {
+	float start[4] = {}, end[4] = {}, weights[16];
+	fitEndpoints(rgba, 3, start, end);
+	int error = encodeBC1WithEndpoints(rgba, start, end, out, weights);
+
+	// Uma passada de refinamento; fica com o que tiver menos erro
+	if (error > 0 && refineEndpoints(rgba, 3, weights, start, end)) {
+		uint8_t refined[8];
+		if (encodeBC1WithEndpoints(rgba, start, end, refined, weights) < error) {
+			std::memcpy(out, refined, 8);
+		}
+	}
+}
+
+void TextureCompressor::encodeBlockBC7(const uint8_t *rgba, uint8_t *out) {
+	float start[4], end[4], weights[16];
+	fitEndpoints(rgba, 4, start, end);
+	int error = encodeBC7WithEndpoints(rgba, start, end, out, weights);
+
+	if (error > 0 && refineEndpoints(rgba, 4, weights, start, end)) {
+		uint8_t refined[16];
+		if (encodeBC7WithEndpoints(rgba, start, end, refined, weights) < error) {
+			std::memcpy(out, refined, 16);
+		}
+	}
+}
+
+// ================== Imagem ============================
+
+size_t TextureCompressor::compressedSize(uint32_t width, uint32_t height, BlockFormat format) {
+	size_t blocks = static_cast<size_t>((width + 3) / 4) * ((height + 3) / 4);
+	return blocks * (format == BlockFormat::BC1 ? 8 : 16);
+}
+
+bool TextureCompressor::hasAlpha(const ImageData &image) {
+	for (size_t i = 3; i < image.pixels.size(); i += 4) {
+		if (image.pixels[i] != 255) {
+			return true;
+		}
+	}
+	return false;
+}
+
+std::vector<uint8_t> TextureCompressor::compress(const ImageData &image, BlockFormat format) {
+	size_t               blockBytes = format == BlockFormat::BC1 ? 8 : 16;
+	uint32_t             blocksX    = (image.width + 3) / 4;
+	uint32_t             blocksY    = (image.height + 3) / 4;
+	std::vector<uint8_t> out(compressedSize(image.width, image.height, format));
+
+	uint8_t block[64];
+	for (uint32_t by = 0; by < blocksY; by++) {
+		for (uint32_t bx = 0; bx < blocksX; bx++) {
+			for (uint32_t y = 0; y < 4; y++) {
+				for (uint32_t x = 0; x < 4; x++) {
+					uint32_t px = std::min(bx * 4 + x, image.width - 1);
+					uint32_t py = std::min(by * 4 + y, image.height - 1);
+					std::memcpy(&block[(y * 4 + x) * 4], &image.pixels[(static_cast<size_t>(py) * image.width + px) * 4], 4);
+				}
+			}
+
+			uint8_t *dst = &out[(static_cast<size_t>(by) * blocksX + bx) * blockBytes];
+			if (format == BlockFormat::BC1) {
+				encodeBlockBC1(block, dst);
+			}
+			else {
+				encodeBlockBC7(block, dst);
+			}
+		}
+	}
+	return out;
+}
+
+std::vector<ImageData> TextureCompressor::buildMipChain(const ImageData &base) {
+	const std::array<float, 256> &linear = srgbToLinearTable();
+
+	std::vector<ImageData> chain;
+	chain.push_back(base);
+
+	while (chain.back().width > 1 || chain.back().height > 1) {
+		const ImageData &src = chain.back();
+		ImageData        dst;
+		dst.width  = std::max(src.width / 2, 1u);
+		dst.height = std::max(src.height / 2, 1u);
+		dst.pixels.resize(static_cast<size_t>(dst.width) * dst.height * 4);
+
+		for (uint32_t y = 0; y < dst.height; y++) {
+			for (uint32_t x = 0; x < dst.width; x++) {
+				uint32_t x0 = std::min(x * 2, src.width - 1), x1 = std::min(x * 2 + 1, src.width - 1);
+				uint32_t y0 = std::min(y * 2, src.height - 1), y1 = std::min(y * 2 + 1, src.height - 1);
+				const uint8_t *p00 = &src.pixels[(static_cast<size_t>(y0) * src.width + x0) * 4];
+				const uint8_t *p01 = &src.pixels[(static_cast<size_t>(y0) * src.width + x1) * 4];
+				const uint8_t *p10 = &src.pixels[(static_cast<size_t>(y1) * src.width + x0) * 4];
+				const uint8_t *p11 = &src.pixels[(static_cast<size_t>(y1) * src.width + x1) * 4];
+				uint8_t       *out = &dst.pixels[(static_cast<size_t>(y) * dst.width + x) * 4];
+
+				// Cor é sRGB (BC*_SRGB, como o R8G8B8A8_SRGB do blit): média em espaço linear
+				for (uint32_t c = 0; c < 3; c++) {
+					float sum = linear[p00[c]] + linear[p01[c]] + linear[p10[c]] + linear[p11[c]];
+					out[c]    = linearToSrgb(sum * 0.25f);
+				}
+				out[3] = static_cast<uint8_t>((p00[3] + p01[3] + p10[3] + p11[3] + 2) / 4);        // Alpha já é linear
+			}
+		}
+		chain.push_back(std::move(dst));
+	}
+	return chain;
+}
@@ -0,0 +1,445 @@
+#include <core/CpuTracer.hpp>
+#include <core/Logger.hpp>
+#include <core/PngDecoder.hpp>
+#include <core/TextureManager.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+
+TextureManager::TextureManager(VkDevice             device,
+                               VkPhysicalDevice     physicalDevice,
+                               ResourceManager     &resources,
+                               BufferManager       &bufferManager,
+                               BindlessDescriptors &bindless,
+                               uint32_t             framesInFlight,
+                               bool                 blockCompressionEnabled,
+                               uint32_t             workerCount,
+                               VkDeviceSize         uploadBudgetPerFrame) :
+    device(device),
+    physicalDevice(physicalDevice),
+    resources(resources),
+    bufferManager(bufferManager),
+    bindless(bindless),
+    framesInFlight(framesInFlight),
+    uploadBudgetPerFrame(uploadBudgetPerFrame) {
+	// Mips por vkCmdBlitImage precisam de filtro linear no formato (tiling optimal)
+	VkFormatProperties formatProperties;
+	vkGetPhysicalDeviceFormatProperties(physicalDevice, textureFormat, &formatProperties);
+	canBlitMips = (formatProperties.optimalTilingFeatures & VK_FORMAT_FEATURE_SAMPLED_IMAGE_FILTER_LINEAR_BIT) &&
+	              (formatProperties.optimalTilingFeatures & VK_FORMAT_FEATURE_BLIT_SRC_BIT) &&
+	              (formatProperties.optimalTilingFeatures & VK_FORMAT_FEATURE_BLIT_DST_BIT);
+	if (!canBlitMips) {
+		LOG_INFO("TextureManager", "Linear blit not supported, textures will have a single mip.");
+	}
+
+	// BC só vale se a feature foi ligada no device e o formato pode ser amostrado
+	if (blockCompressionEnabled) {
+		vkGetPhysicalDeviceFormatProperties(physicalDevice, TextureCache::toVkFormat(BlockFormat::BC1), &formatProperties);
+		bc1Supported = formatProperties.optimalTilingFeatures & VK_FORMAT_FEATURE_SAMPLED_IMAGE_BIT;
+		vkGetPhysicalDeviceFormatProperties(physicalDevice, TextureCache::toVkFormat(BlockFormat::BC7), &formatProperties);
+		bc7Supported = formatProperties.optimalTilingFeatures & VK_FORMAT_FEATURE_SAMPLED_IMAGE_BIT;
+	}
+	LOG_INFO("TextureManager", "Block compression: BC1 {}, BC7 {}", bc1Supported ? "on" : "off", bc7Supported ? "on" : "off");
+
+	createSampler();
+	bindless.setSampler(sampler);
+	createDefaultTexture();
+
+	if (workerCount == 0) {
+		// Deixa um core para a thread de render
+		uint32_t cores = std::thread::hardware_concurrency();
+		workerCount    = std::clamp(cores > 1 ? cores - 1 : 1u, 1u, 4u);
+	}
+	for (uint32_t i = 0; i < workerCount; i++) {
+		workers.emplace_back(&TextureManager::workerLoop, this);
+	}
+	LOG_INFO("TextureManager", "{} decode workers started.", workerCount);
+}
+
+TextureManager::~TextureManager() {
+	{
+		std::lock_guard<std::mutex> lock(queueMutex);
+		stopping = true;
+	}
+	queueCondition.notify_all();
+	for (auto &worker : workers) {
+		worker.join();
+	}
+
+	for (auto &release : stagingToRelease) {
+		bufferManager.destroyBuffer(release.buffer);
+	}
+	for (auto &texture : textures) {
+		if (texture.bindlessIndex != INVALID_HANDLE) {
+			bindless.releaseTexture(texture.bindlessIndex);
+		}
+		if (texture.image != INVALID_HANDLE) {
+			resources.destroyImage(texture.image);
+		}
+	}
+	if (sampler != VK_NULL_HANDLE) {
+		vkDestroySampler(device, sampler, nullptr);
+	}
+}
+
+void TextureManager::createSampler() {
+	VkSamplerCreateInfo samplerInfo{};
+	samplerInfo.sType        = VK_STRUCTURE_TYPE_SAMPLER_CREATE_INFO;
+	samplerInfo.magFilter    = VK_FILTER_LINEAR;
+	samplerInfo.minFilter    = VK_FILTER_LINEAR;
+	samplerInfo.mipmapMode   = VK_SAMPLER_MIPMAP_MODE_LINEAR;
+	samplerInfo.addressModeU = VK_SAMPLER_ADDRESS_MODE_REPEAT;
+	samplerInfo.addressModeV = VK_SAMPLER_ADDRESS_MODE_REPEAT;
+	samplerInfo.addressModeW = VK_SAMPLER_ADDRESS_MODE_REPEAT;
+	samplerInfo.minLod       = 0.0f;
+	samplerInfo.maxLod       = VK_LOD_CLAMP_NONE;        // Usa todos os mips que a imagem tiver
+	samplerInfo.borderColor  = VK_BORDER_COLOR_INT_OPAQUE_BLACK;
+
+	if (vkCreateSampler(device, &samplerInfo, nullptr, &sampler) != VK_SUCCESS) {
+		throw std::runtime_error("[TextureManager] : Failed to create sampler!");
+	}
+}
+
+void TextureManager::createDefaultTexture() {
+	// 1x1 branca; entra na fila de upload como se tivesse vindo de um worker
+	defaultTexture = static_cast<TextureHandle>(textures.size());
+	textures.push_back({.path = "<default>"});
+
+	DecodedImage image{.handle = defaultTexture};
+	image.data.width  = 1;
+	image.data.height = 1;
+	image.data.pixels = {255, 255, 255, 255};
+	decoded.push_front(std::move(image));
+}
+
+// ================== Workers ============================
+
+TextureHandle TextureManager::loadTexture(const std::string &path) {
+	auto it = pathToHandle.find(path);
+	if (it != pathToHandle.end()) {
+		return it->second;
+	}
+
+	TextureHandle handle = static_cast<TextureHandle>(textures.size());
+	textures.push_back({.path = path});
+	pathToHandle[path] = handle;
+
+	{
+		std::lock_guard<std::mutex> lock(queueMutex);
+		jobs.push_back({handle, path});
+	}
+	queueCondition.notify_one();
+
+	return handle;
+}
+
+void TextureManager::workerLoop() {
+	PROFILE_CPU_THREAD("texture decode");
+	while (true) {
+		DecodeJob job;
+		{
+			std::unique_lock<std::mutex> lock(queueMutex);
+			queueCondition.wait(lock, [this] { return stopping || !jobs.empty(); });
+			if (stopping) {
+				return;
+			}
+			job = std::move(jobs.front());
+			jobs.pop_front();
+		}
+
+		DecodedImage result{.handle = job.handle};
+		PROFILE_CPU_ZONE("TextureManager::decode");
+		try {
+			if (!loadCompressed(job.path, result)) {
+				result.data = PngDecoder::decodeFile(job.path);
+			}
+		} catch (const std::exception &e) {
+			LOG_ERROR("TextureManager", "Failed to decode {} ({})", job.path, e.what());
+			result.failed = true;
+		}
+
+		std::lock_guard<std::mutex> lock(queueMutex);
+		decoded.push_back(std::move(result));
+	}
+}
+
+// Cache BC primeiro; sem cache, decodifica, comprime e grava. Retorna false se deve ficar em RGBA8.
+bool TextureManager::loadCompressed(const std::string &path, DecodedImage &result) {
+	if (!bc1Supported && !bc7Supported) {
+		return false;
+	}
+
+	// Não dá pra saber se tem alpha antes de decodificar, então tenta os dois caches
+	if ((bc1Supported && cache.load(path, BlockFormat::BC1, result.compressed)) ||
+	    (bc7Supported && cache.load(path, BlockFormat::BC7, result.compressed))) {
+		result.isCompressed = true;
+		return true;
+	}
+
+	result.data = PngDecoder::decodeFile(path);
+
+	// BC1 para opacas (metade do tamanho); BC7 quando tem alpha ou BC1 não é suportado
+	bool        alpha  = TextureCompressor::hasAlpha(result.data);
+	BlockFormat format = (!alpha && bc1Supported) ? BlockFormat::BC1 : BlockFormat::BC7;
+	if (format == BlockFormat::BC7 && !bc7Supported) {
+		return true;        // Já decodificado; segue em RGBA8
+	}
+
+	auto start          = std::chrono::high_resolution_clock::now();
+	result.compressed   = TextureCache::build(result.data, format);
+	result.isCompressed = true;
+	result.data         = {};
+	cache.store(path, format, result.compressed);
+
+	auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::high_resolution_clock::now() - start);
+	LOG_INFO("TextureManager", "{} compressed to {} ({} mips, {} ms)", path, format == BlockFormat::BC1 ? "BC1" : "BC7", result.compressed.getMipLevels(), elapsed.count());
+	return true;
+}
+
+// ================== Upload (thread de render) ============================
+
+void TextureManager::processUploads(VkCommandBuffer cmd, uint64_t frameNumber) {
+	PROFILE_CPU_ZONE("TextureManager::processUploads");
+
+	// Staging de uploads cujo frame já terminou na GPU
+	for (size_t i = 0; i < stagingToRelease.size();) {
+		if (frameNumber >= stagingToRelease[i].retireFrame) {
+			bufferManager.destroyBuffer(stagingToRelease[i].buffer);
+			stagingToRelease[i] = stagingToRelease.back();
+			stagingToRelease.pop_back();
+		} else {
+			i++;
+		}
+	}
+
+	// Sempre sobe pelo menos uma imagem por frame, mesmo que ela sozinha passe do orçamento
+	VkDeviceSize uploadedBytes = 0;
+	while (uploadedBytes < uploadBudgetPerFrame) {
+		DecodedImage image;
+		{
+			std::lock_guard<std::mutex> lock(queueMutex);
+			if (decoded.empty()) {
+				break;
+			}
+			image = std::move(decoded.front());
+			decoded.pop_front();
+		}
+
+		if (image.failed) {
+			textures[image.handle].state = TextureState::Failed;
+			continue;
+		}
+
+		if (image.isCompressed) {
+			uploadedBytes += image.compressed.data.size();
+			uploadCompressed(cmd, frameNumber, image);
+		}
+		else {
+			uploadedBytes += image.data.pixels.size();
+			upload(cmd, frameNumber, image);
+		}
+	}
+	totalUploadedBytes += uploadedBytes;
+}
+
+void TextureManager::upload(VkCommandBuffer cmd, uint64_t frameNumber, DecodedImage &image) {
+	TextureEntry &texture = textures[image.handle];
+	texture.width         = image.data.width;
+	texture.height        = image.data.height;
+	texture.format        = textureFormat;
+	texture.mipLevels     = canBlitMips ? static_cast<uint32_t>(std::floor(std::log2(std::max(texture.width, texture.height)))) + 1 : 1;
+
+	VkDeviceSize size    = image.data.pixels.size();
+	BufferHandle staging = bufferManager.createStagingBuffer(size);
+	bufferManager.updateBuffer(staging, image.data.pixels.data(), size);
+	// Fica vivo até o frame que gravou a cópia sair de voo
+	stagingToRelease.push_back({staging, frameNumber + framesInFlight});
+
+	texture.image = resources.createImage({.extent    = {texture.width, texture.height, 1},
+	                                       .format    = textureFormat,
+	                                       .mipLevels = texture.mipLevels,
+	                                       .usage     = VK_IMAGE_USAGE_TRANSFER_SRC_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_SAMPLED_BIT});
+	VkImage vkImage = resources.getVkImage(texture.image);
+
+	// Todos os mips: UNDEFINED -> TRANSFER_DST
+	VkImageMemoryBarrier barrier{};
+	barrier.sType                           = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+	barrier.srcQueueFamilyIndex             = VK_QUEUE_FAMILY_IGNORED;
+	barrier.dstQueueFamilyIndex             = VK_QUEUE_FAMILY_IGNORED;
+	barrier.image                           = vkImage;
+	barrier.subresourceRange.aspectMask     = VK_IMAGE_ASPECT_COLOR_BIT;
+	barrier.subresourceRange.baseMipLevel   = 0;
+	barrier.subresourceRange.levelCount     = texture.mipLevels;
+	barrier.subresourceRange.baseArrayLayer = 0;
+	barrier.subresourceRange.layerCount     = 1;
+	barrier.oldLayout                       = VK_IMAGE_LAYOUT_UNDEFINED;
+	barrier.newLayout                       = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+	barrier.srcAccessMask                   = 0;
+	barrier.dstAccessMask                   = VK_ACCESS_TRANSFER_WRITE_BIT;
+	vkCmdPipelineBarrier(cmd, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, 0, 0, nullptr, 0, nullptr, 1, &barrier);
+
+	VkBufferImageCopy region{};
+	region.imageSubresource.aspectMask     = VK_IMAGE_ASPECT_COLOR_BIT;
+	region.imageSubresource.mipLevel       = 0;
+	region.imageSubresource.baseArrayLayer = 0;
+	region.imageSubresource.layerCount     = 1;
+	region.imageExtent                     = {texture.width, texture.height, 1};
+	vkCmdCopyBufferToImage(cmd, bufferManager.getVkBuffer(staging), vkImage, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &region);
+
+	generateMips(cmd, vkImage, texture.width, texture.height, texture.mipLevels);
+
+	markReady(texture);
+}
+
+void TextureManager::uploadCompressed(VkCommandBuffer cmd, uint64_t frameNumber, DecodedImage &image) {
+	const CompressedTexture &compressed = image.compressed;
+	TextureEntry            &texture    = textures[image.handle];
+	texture.width                       = compressed.width;
+	texture.height                      = compressed.height;
+	texture.format                      = compressed.format;
+	texture.mipLevels                   = compressed.getMipLevels();
+
+	// Arquivo do cache -> staging num memcpy só, todos os mips de uma vez
+	BufferHandle staging = bufferManager.createStagingBuffer(compressed.data.size());
+	bufferManager.updateBuffer(staging, compressed.data.data(), compressed.data.size());
+	stagingToRelease.push_back({staging, frameNumber + framesInFlight});
+
+	texture.image = resources.createImage({.extent    = {texture.width, texture.height, 1},
+	                                       .format    = texture.format,
+	                                       .mipLevels = texture.mipLevels,
+	                                       .usage     = VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_SAMPLED_BIT});
+	VkImage vkImage = resources.getVkImage(texture.image);
+
+	VkImageMemoryBarrier barrier{};
+	barrier.sType                           = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+	barrier.srcQueueFamilyIndex             = VK_QUEUE_FAMILY_IGNORED;
+	barrier.dstQueueFamilyIndex             = VK_QUEUE_FAMILY_IGNORED;
+	barrier.image                           = vkImage;
+	barrier.subresourceRange.aspectMask     = VK_IMAGE_ASPECT_COLOR_BIT;
+	barrier.subresourceRange.baseMipLevel   = 0;
+	barrier.subresourceRange.levelCount     = texture.mipLevels;
+	barrier.subresourceRange.baseArrayLayer = 0;
+	barrier.subresourceRange.layerCount     = 1;
+	barrier.oldLayout                       = VK_IMAGE_LAYOUT_UNDEFINED;
+	barrier.newLayout                       = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+	barrier.srcAccessMask                   = 0;
+	barrier.dstAccessMask                   = VK_ACCESS_TRANSFER_WRITE_BIT;
+	vkCmdPipelineBarrier(cmd, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, 0, 0, nullptr, 0, nullptr, 1, &barrier);
+
+	std::vector<VkBufferImageCopy> regions(texture.mipLevels);
+	for (uint32_t level = 0; level < texture.mipLevels; level++) {
+		regions[level]                                 = {};
+		regions[level].bufferOffset                    = compressed.mipOffsets[level];
+		regions[level].imageSubresource.aspectMask     = VK_IMAGE_ASPECT_COLOR_BIT;
+		regions[level].imageSubresource.mipLevel       = level;
+		regions[level].imageSubresource.baseArrayLayer = 0;
+		regions[level].imageSubresource.layerCount     = 1;
+		regions[level].imageExtent                     = {std::max(texture.width >> level, 1u), std::max(texture.height >> level, 1u), 1};
+	}
+	vkCmdCopyBufferToImage(cmd, bufferManager.getVkBuffer(staging), vkImage, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+	                       static_cast<uint32_t>(regions.size()), regions.data());
+
+	barrier.oldLayout     = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+	barrier.newLayout     = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+	barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+	barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
+	vkCmdPipelineBarrier(cmd, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, 0, 0, nullptr, 0, nullptr, 1, &barrier);
+
+	markReady(texture);
+}
+
+void TextureManager::markReady(TextureEntry &texture) {
+	// A cópia e os blits estão no mesmo command buffer, antes dos draws: já dá pra amostrar neste frame.
+	// O slot é novo (nenhum frame em voo referencia ele), então escrever agora é seguro.
+	texture.bindlessIndex = bindless.registerTexture(resources.getImageView(texture.image));
+	texture.state         = TextureState::Ready;
+}
+
+void TextureManager::generateMips(VkCommandBuffer cmd, VkImage image, uint32_t width, uint32_t height, uint32_t mipLevels) {
+	VkImageMemoryBarrier barrier{};
+	barrier.sType                           = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+	barrier.srcQueueFamilyIndex             = VK_QUEUE_FAMILY_IGNORED;
+	barrier.dstQueueFamilyIndex             = VK_QUEUE_FAMILY_IGNORED;
+	barrier.image                           = image;
+	barrier.subresourceRange.aspectMask     = VK_IMAGE_ASPECT_COLOR_BIT;
+	barrier.subresourceRange.levelCount     = 1;
+	barrier.subresourceRange.baseArrayLayer = 0;
+	barrier.subresourceRange.layerCount     = 1;
+
+	int32_t mipWidth  = static_cast<int32_t>(width);
+	int32_t mipHeight = static_cast<int32_t>(height);
+
+	for (uint32_t level = 1; level < mipLevels; level++) {
+		// Mip anterior: TRANSFER_DST -> TRANSFER_SRC
+		barrier.subresourceRange.baseMipLevel = level - 1;
+		barrier.oldLayout                     = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+		barrier.newLayout                     = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
+		barrier.srcAccessMask                 = VK_ACCESS_TRANSFER_WRITE_BIT;
+		barrier.dstAccessMask                 = VK_ACCESS_TRANSFER_READ_BIT;
+		vkCmdPipelineBarrier(cmd, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, 0, 0, nullptr, 0, nullptr, 1, &barrier);
+
+		int32_t nextWidth  = std::max(mipWidth / 2, 1);
+		int32_t nextHeight = std::max(mipHeight / 2, 1);
+
+		VkImageBlit blit{};
+		blit.srcOffsets[1]                 = {mipWidth, mipHeight, 1};
+		blit.srcSubresource.aspectMask     = VK_IMAGE_ASPECT_COLOR_BIT;
+		blit.srcSubresource.mipLevel       = level - 1;
+		blit.srcSubresource.baseArrayLayer = 0;
+		blit.srcSubresource.layerCount     = 1;
+		blit.dstOffsets[1]                 = {nextWidth, nextHeight, 1};
+		blit.dstSubresource.aspectMask     = VK_IMAGE_ASPECT_COLOR_BIT;
+		blit.dstSubresource.mipLevel       = level;
+		blit.dstSubresource.baseArrayLayer = 0;
+		blit.dstSubresource.layerCount     = 1;
+		vkCmdBlitImage(cmd,
+		               image, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+		               image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+		               1, &blit, VK_FILTER_LINEAR);
+
+		// Mip anterior pronto: TRANSFER_SRC -> SHADER_READ_ONLY
+		barrier.oldLayout     = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
+		barrier.newLayout     = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+		barrier.srcAccessMask = VK_ACCESS_TRANSFER_READ_BIT;
+		barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
+		vkCmdPipelineBarrier(cmd, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, 0, 0, nullptr, 0, nullptr, 1, &barrier);
+
+		mipWidth  = nextWidth;
+		mipHeight = nextHeight;
+	}
+
+	// Último mip (ou o único) nunca virou fonte de blit
+	barrier.subresourceRange.baseMipLevel = mipLevels - 1;
+	barrier.oldLayout                     = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+	barrier.newLayout                     = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+	barrier.srcAccessMask                 = VK_ACCESS_TRANSFER_WRITE_BIT;
+	barrier.dstAccessMask                 = VK_ACCESS_SHADER_READ_BIT;
+	vkCmdPipelineBarrier(cmd, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, 0, 0, nullptr, 0, nullptr, 1, &barrier);
+}
+
+// ================== Consultas ============================
+
+bool TextureManager::isReady(TextureHandle handle) const {
+	return handle < textures.size() && textures[handle].state == TextureState::Ready;
+}
+
+VkImageView TextureManager::getImageView(TextureHandle handle) const {
+	if (isReady(handle)) {
+		return resources.getImageView(textures[handle].image);
+	}
+	return isReady(defaultTexture) ? resources.getImageView(textures[defaultTexture].image) : VK_NULL_HANDLE;
+}
+
+uint32_t TextureManager::getBindlessIndex(TextureHandle handle) const {
+	if (isReady(handle)) {
+		return textures[handle].bindlessIndex;
+	}
+	// A padrão entra na frente da fila, então já está pronta no primeiro draw
+	return isReady(defaultTexture) ? textures[defaultTexture].bindlessIndex : 0;
+}
+
+size_t TextureManager::getPendingCount() const {
+	return std::count_if(textures.begin(), textures.end(),
+	                     [](const TextureEntry &texture) { return texture.state == TextureState::Decoding; });
+}
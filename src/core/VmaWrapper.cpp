@@ -1,12 +1,15 @@
 #include "core/VmaWrapper.hpp"
+#include <algorithm>
+#include <core/VulkanUtils/VulkanTools.hpp>
+#include <core/Logger.hpp>
 #define VMA_IMPLEMENTATION
 #include <vk_mem_alloc.h>
 
-VmaWrapper::VmaWrapper() : allocator(VK_NULL_HANDLE), device(VK_NULL_HANDLE) {
-	std::cout << "[VmaWrapper]:\t VmaWrapper created (uninitialized)" << std::endl;
+VmaWrapper::VmaWrapper() : allocator(VK_NULL_HANDLE), device(VK_NULL_HANDLE), memoryBudgetEnabled(false) {
+	LOG_INFO("VmaWrapper", "VmaWrapper created (uninitialized)");
 }
 
-void VmaWrapper::initialize(VkDevice device, VkPhysicalDevice physicalDevice, VkInstance instance) {
+void VmaWrapper::initialize(VkDevice device, VkPhysicalDevice physicalDevice, VkInstance instance, bool enableMemoryBudget) {
 	if (isInitialized()) {
 		throw std::runtime_error("[VmaWrapper]:\t Already initialized!");
 	}
@@ -14,8 +17,16 @@ void VmaWrapper::initialize(VkDevice device, VkPhysicalDevice physicalDevice, Vk
 	VmaAllocatorCreateInfo allocInfo{};
 	allocInfo.device         = device;
 	allocInfo.physicalDevice = physicalDevice;
-	allocInfo.instance       = instance;
-	// Resto usa valores padrão (flags = 0, ponteiros = nullptr)
+	allocInfo.instance         = instance;
+	// A VMA não pode usar uma versão maior que a do device (funções 1.3 não existem num device 1.2)
+	VkPhysicalDeviceProperties properties;
+	vkGetPhysicalDeviceProperties(physicalDevice, &properties);
+	allocInfo.vulkanApiVersion = std::min(VulkanTools::apiVersion, properties.apiVersion);
+	// Com VK_EXT_memory_budget a VMA consulta o orçamento real do driver em vez de estimar
+	if (enableMemoryBudget) {
+		allocInfo.flags |= VMA_ALLOCATOR_CREATE_EXT_MEMORY_BUDGET_BIT;
+	}
+	// Resto usa valores padrão (ponteiros = nullptr)
 
 	VkResult result = vmaCreateAllocator(&allocInfo, &allocator);
 
@@ -23,16 +34,17 @@ void VmaWrapper::initialize(VkDevice device, VkPhysicalDevice physicalDevice, Vk
 		throw std::runtime_error("[VmaWrapper]: \t Failed to initialize VMA!");
 	}
 
-	this->device = device;
+	this->device              = device;
+	this->memoryBudgetEnabled = enableMemoryBudget;
 
-	std::cout << "[VmaWrapper]: \t VMA initialized successfully!" << std::endl;
+	LOG_INFO("VmaWrapper", "VMA initialized successfully! (memory budget: {})", enableMemoryBudget ? "ON" : "OFF");
 }
 
 void VmaWrapper::destroy() {
 	if (isInitialized()) {
 		vmaDestroyAllocator(allocator);
 		allocator = VK_NULL_HANDLE; // Evita dupla liberação
-		std::cout << "[VmaWrapper]: \t Allocator destroyed." << std::endl;
+		LOG_INFO("VmaWrapper", "Allocator destroyed.");
 	}
 }
 
@@ -43,15 +55,15 @@ VmaWrapper::~VmaWrapper() {
 	if (isInitialized()) {
 		// Idealmente, destroy() já foi chamado.
 		// Logar um aviso se o allocator ainda existir pode ser útil para debug.
-		std::cout << "[VmaWrapper]: \t Destructor called, but allocator was not explicitly destroyed. Cleaning up now." << std::endl;
+		LOG_INFO("VmaWrapper", "Destructor called, but allocator was not explicitly destroyed. Cleaning up now.");
 		destroy();
 	}
 }
 
-VmaBuffer VmaWrapper::createBuffer(const VkBufferCreateInfo &bufferInfo, const VmaAllocationCreateInfo &allocInfo) {
+VmaBuffer VmaWrapper::createBuffer(const VkBufferCreateInfo &bufferInfo, const VmaAllocationCreateInfo &allocInfo, VmaAllocationInfo *outAllocInfo) {
 	VmaBuffer vmaBuffer;
 
-	if (vmaCreateBuffer(allocator, &bufferInfo, &allocInfo, &vmaBuffer.buffer, &vmaBuffer.allocation, nullptr) != VK_SUCCESS) {
+	if (vmaCreateBuffer(allocator, &bufferInfo, &allocInfo, &vmaBuffer.buffer, &vmaBuffer.allocation, outAllocInfo) != VK_SUCCESS) {
 		throw std::runtime_error("[VmaWrapper]: Failed to create buffer!");
 	}
 
@@ -67,3 +79,84 @@ void VmaWrapper::destroyBuffer(VmaBuffer &buffer) {
 		buffer.allocation = VK_NULL_HANDLE;
 	}
 }
+
+VmaImage VmaWrapper::createImage(const VkImageCreateInfo &imageInfo, const VmaAllocationCreateInfo &allocInfo, VmaAllocationInfo *outAllocInfo) {
+	VmaImage vmaImage;
+
+	if (vmaCreateImage(allocator, &imageInfo, &allocInfo, &vmaImage.image, &vmaImage.allocation, outAllocInfo) != VK_SUCCESS) {
+		throw std::runtime_error("[VmaWrapper]: Failed to create image!");
+	}
+
+	return vmaImage;
+}
+
+void VmaWrapper::destroyImage(VmaImage &image) {
+	if (image.image != VK_NULL_HANDLE) {
+		vmaDestroyImage(allocator, image.image, image.allocation);
+
+		image.image = VK_NULL_HANDLE;
+
+		image.allocation = VK_NULL_HANDLE;
+	}
+}
+
+// ================== Pools ============================
+
+VmaPool VmaWrapper::createPoolForBuffers(const VkBufferCreateInfo &sampleBufferInfo, const VmaAllocationCreateInfo &sampleAllocInfo) {
+	uint32_t memoryTypeIndex = 0;
+	if (vmaFindMemoryTypeIndexForBufferInfo(allocator, &sampleBufferInfo, &sampleAllocInfo, &memoryTypeIndex) != VK_SUCCESS) {
+		throw std::runtime_error("[VmaWrapper]: Failed to find memory type for pool!");
+	}
+
+	VmaPoolCreateInfo poolInfo{};
+	poolInfo.memoryTypeIndex = memoryTypeIndex;
+	// blockSize = 0 -> VMA escolhe o tamanho dos blocos; sem limite de blocos
+
+	VmaPool pool = VK_NULL_HANDLE;
+	if (vmaCreatePool(allocator, &poolInfo, &pool) != VK_SUCCESS) {
+		throw std::runtime_error("[VmaWrapper]: Failed to create pool!");
+	}
+	return pool;
+}
+
+void VmaWrapper::destroyPool(VmaPool &pool) {
+	if (pool != VK_NULL_HANDLE) {
+		vmaDestroyPool(allocator, pool);
+		pool = VK_NULL_HANDLE;
+	}
+}
+
+// ================== Estatísticas de memória ============================
+
+void VmaWrapper::setCurrentFrameIndex(uint32_t frameIndex) {
+	// A VMA usa o índice de frame para decidir quando re-consultar o orçamento do driver
+	vmaSetCurrentFrameIndex(allocator, frameIndex);
+}
+
+uint32_t VmaWrapper::getMemoryHeapCount() const {
+	const VkPhysicalDeviceMemoryProperties *memoryProperties = nullptr;
+	vmaGetMemoryProperties(allocator, &memoryProperties);
+	return memoryProperties->memoryHeapCount;
+}
+
+std::vector<VmaBudget> VmaWrapper::getHeapBudgets() const {
+	// vmaGetHeapBudgets escreve VK_MAX_MEMORY_HEAPS entradas no máximo, mas só as primeiras memoryHeapCount são válidas
+	std::vector<VmaBudget> budgets(VK_MAX_MEMORY_HEAPS);
+	vmaGetHeapBudgets(allocator, budgets.data());
+	budgets.resize(getMemoryHeapCount());
+	return budgets;
+}
+
+VmaTotalStatistics VmaWrapper::calculateStatistics() const {
+	VmaTotalStatistics stats{};
+	vmaCalculateStatistics(allocator, &stats);
+	return stats;
+}
+
+std::string VmaWrapper::buildStatsString(bool detailedMap) const {
+	char *statsString = nullptr;
+	vmaBuildStatsString(allocator, &statsString, detailedMap ? VK_TRUE : VK_FALSE);
+	std::string result(statsString ? statsString : "{}");
+	vmaFreeStatsString(allocator, statsString);
+	return result;
+}
@@ -1,10 +1,16 @@
+#include <algorithm>
 #include <chrono>
+#include <cmath>
+#include <core/Logger.hpp>
 #include <core/RenderPassManager.hpp>
+#include <core/PngWriter.hpp>
 #include <core/VulkanManager.hpp>
+#include <glm/gtc/constants.hpp>
 #include <glm/gtc/matrix_transform.hpp>
+#include <random>
 
-VulkanManager::VulkanManager(int width, int height, const char *title) :
-    window(width, height, title),
+VulkanManager::VulkanManager(int width, int height, const char *title, const RendererOptions &options) :
+    window(options.headless ? nullptr : std::make_unique<WindowManager>(width, height, title)),
     instance(VK_NULL_HANDLE),
     surface(VK_NULL_HANDLE),
     debugMessenger(VK_NULL_HANDLE),
@@ -12,53 +18,86 @@ VulkanManager::VulkanManager(int width, int height, const char *title) :
     device(VK_NULL_HANDLE),
     swapchainManager(nullptr),
     commandManager(nullptr),
-    framebufferResized(false)
+    framebufferResized(false),
+    options(options),
+    presentPolicy(options.presentPolicy),
+    requestedExtent{static_cast<uint32_t>(width), static_cast<uint32_t>(height)}
 //  cubeMesh(nullptr),
 //  triangleMesh(nullptr)
 {
-	std::cout << "[VulkanManager] : VulkanManager created." << std::endl;
+	LOG_INFO("VulkanManager", "VulkanManager created.");
 
-	// Set user pointer so callback can access this instance
-	glfwSetWindowUserPointer(window.getWindow(), this);
+	if (window) {
+		// Set user pointer so callback can access this instance
+		glfwSetWindowUserPointer(window->getWindow(), this);
 
-	// Set framebuffer resize callback
-	window.setFramebufferResizeCallback(framebufferResizeCallback);
+		// Set framebuffer resize callback
+		window->setFramebufferResizeCallback(framebufferResizeCallback);
+	}
 }
 
 VulkanManager::~VulkanManager() {
-	std::cout << "[VulkanManager] : VulkanManager destructor called." << std::endl;
+	LOG_INFO("VulkanManager", "VulkanManager destructor called.");
 	cleanup();
 }
 
 void VulkanManager::createSurface() {
-	window.createSurface(instance, &surface);
-	std::cout << "[VulkanManager] : Surface created." << std::endl;
+	window->createSurface(instance, &surface);
+	LOG_INFO("VulkanManager", "Surface created.");
 }
 
 // Executa a configuração completa da stack Vulkan respeitando as dependências entre etapas.
 void VulkanManager::initVulkan() {
-	std::cout << "[VulkanManager] : Initializing Vulkan..." << std::endl;
+	LOG_INFO("VulkanManager", "Initializing Vulkan...");
 	createInstance();
 	setupDebugMessenger();
-	createSurface();
+	if (!options.headless) {
+		createSurface();
+	}
 	pickPhysicalDevice();
 	createLogicalDevice();
-	setupSwapChain();
+	if (!options.headless) {
+		setupSwapChain();
+	}
 	setupVmaWrapper();
+	createDescriptorAllocators();
+	createBindlessDescriptors();
 	createGraphicsPipeline();
 	createFramebuffers();
 	createCommandPool();
 	createCommandBuffers();
 	createSyncObjects();
+	createAsyncCompute();
+	createFrameArenas();
 	createResourceManager();
 	createBufferManager();
+	if (options.headless) {
+		createOffscreenTarget();
+	}
+	createRenderGraph();
+	createShadowCascades();
+	createClusteredLighting();
+	createOcclusionCuller();
+	createParticleSystem();
+	createMemoryMonitor();
+	createDefragmenter();
+	createTextureManager();
+	createObjectBuffers();
 
 	// createCube();
 	// createTriangle();
 
 	loadCarModel();
+	buildScene();
+	// A geometria da carga inicial não entra no upload do primeiro frame
+	lastUploadedTotal = textureManager->getUploadedBytes() + bufferManager->getUploadedBytes();
+	createGpuProfiler();
+	createDynamicResolution();
+	if (!options.headless) {
+		createOverlay();
+	}
 
-	std::cout << "[VulkanManager] : Vulkan initialized successfully." << std::endl;
+	LOG_INFO("VulkanManager", "Vulkan initialized successfully.");
 }
 
 void VulkanManager::createBufferManager() {
@@ -68,7 +107,12 @@ void VulkanManager::createBufferManager() {
 	    *resourceManager,
 	    *commandManager,
 	    queueManager);
-	std::cout << "[VulkanManager] : Buffer Manager initialized." << std::endl;
+	// Storage buffers escritos numa fila e lidos na outra sem transferência de posse
+	uint32_t graphicsFamily = queueManager.getQueueFamilies().at(QueueType::GRAPHICS).index;
+	if (asyncCompute && asyncCompute->getQueueFamily() != graphicsFamily) {
+		bufferManager->setSharedQueueFamilies({graphicsFamily, asyncCompute->getQueueFamily()});
+	}
+	LOG_INFO("VulkanManager", "Buffer Manager initialized.");
 }
 
 void VulkanManager::createResourceManager() {
@@ -76,11 +120,92 @@ void VulkanManager::createResourceManager() {
 	    device,
 	    vmaWrapper.getAllocator(),
 	    vmaWrapper);
-	std::cout << "[VulkanManager] : Resource Manager initialized." << std::endl;
+	LOG_INFO("VulkanManager", "Resource Manager initialized.");
+}
+
+void VulkanManager::createMemoryMonitor() {
+	memoryMonitor = std::make_unique<MemoryMonitor>(vmaWrapper, *resourceManager);
+	LOG_INFO("VulkanManager", "Memory monitor initialized.");
+}
+
+void VulkanManager::createDefragmenter() {
+	defragmenter = std::make_unique<GpuDefragmenter>(
+	    device,
+	    vmaWrapper.getAllocator(),
+	    *resourceManager,
+	    MAX_FRAMES_IN_FLIGHT);
+	// Compacta sozinho quando mais de 30% dos blocos de geometria estiverem vazios
+	defragmenter->setAutoTrigger(0.3f);
+	LOG_INFO("VulkanManager", "Geometry defragmenter initialized.");
+}
+
+void VulkanManager::createDescriptorAllocators() {
+	descriptorLayoutCache = std::make_unique<DescriptorLayoutCache>(device);
+	frameDescriptors      = std::make_unique<FrameDescriptorAllocators>(device, MAX_FRAMES_IN_FLIGHT);
+	LOG_INFO("VulkanManager", "Descriptor allocators initialized.");
+}
+
+void VulkanManager::createBindlessDescriptors() {
+	bindlessDescriptors = std::make_unique<BindlessDescriptors>(device, physicalDevice, *descriptorLayoutCache);
+	LOG_INFO("VulkanManager", "Bindless descriptors initialized.");
+}
+
+void VulkanManager::createObjectBuffers() {
+	for (uint32_t i = 0; i < MAX_FRAMES_IN_FLIGHT; i++) {
+		BufferHandle buffer = bufferManager->createStorageBuffer(MAX_OBJECTS * sizeof(GpuObjectData));
+		objectBuffers.push_back(buffer);
+		objectBufferIndices.push_back(bindlessDescriptors->registerStorageBuffer(bufferManager->getVkBuffer(buffer)));
+
+		BufferHandle sceneBuffer = bufferManager->createStorageBuffer(sizeof(GpuSceneData));
+		sceneBuffers.push_back(sceneBuffer);
+		sceneBufferIndices.push_back(bindlessDescriptors->registerStorageBuffer(bufferManager->getVkBuffer(sceneBuffer)));
+	}
+	LOG_INFO("VulkanManager", "Object buffers created.");
+}
+
+void VulkanManager::createTextureManager() {
+	textureManager = std::make_unique<TextureManager>(
+	    device,
+	    physicalDevice,
+	    *resourceManager,
+	    *bufferManager,
+	    *bindlessDescriptors,
+	    MAX_FRAMES_IN_FLIGHT,
+	    textureCompressionBCEnabled);
+	// Decodifica em background; o upload acontece nos próximos frames
+	colormapTexture = textureManager->loadTexture("../assets/models/Textures/colormap.png");
+	LOG_INFO("VulkanManager", "Texture manager initialized.");
+}
+
+void VulkanManager::setPresentPolicy(PresentPolicy policy) {
+	if (policy == presentPolicy) {
+		return;
+	}
+	presentPolicy = policy;
+	if (!swapchainManager) {
+		return;        // Headless: nada é apresentado
+	}
+	swapchainManager->setPresentPolicy(policy);
+	frameScheduler->setLatencyMode(policy == PresentPolicy::LowLatency ? LatencyMode::LowLatency : LatencyMode::Throughput);
+	presentPolicyChanged = true;
+	LOG_INFO("VulkanManager", "Present policy set to {}.", SwapchainManager::toString(policy));
+}
+
+void VulkanManager::requestGeometryDefragmentation() {
+	if (defragmenter) {
+		defragmenter->requestDefragmentation();
+	}
+}
+
+void VulkanManager::dumpMemoryReport(const std::string &path) const {
+	if (memoryMonitor) {
+		memoryMonitor->sample();
+		memoryMonitor->dumpJson(path);
+	}
 }
 
 void VulkanManager::setupVmaWrapper() {
-	vmaWrapper.initialize(device, physicalDevice, instance);
+	vmaWrapper.initialize(device, physicalDevice, instance, memoryBudgetEnabled);
 }
 
 void VulkanManager::framebufferResizeCallback(GLFWwindow *window, int width, int height) {
@@ -89,127 +214,596 @@ void VulkanManager::framebufferResizeCallback(GLFWwindow *window, int width, int
 
 	if (app) {
 		app->framebufferResized = true;
-		std::cout << "[VulkanManager] : Framebuffer resized to " << width << "x" << height << std::endl;
+		LOG_DEBUG("VulkanManager", "Framebuffer resized to {}x{}", width, height);
 	}
 }
 
 void VulkanManager::recreateSwapChain() {
-	std::cout << "[VulkanManager] : Recreating swap chain..." << std::endl;
+	PROFILE_CPU_ZONE("recreateSwapChain");
+	LOG_DEBUG("VulkanManager", "Recreating swap chain...");
 
 	int width  = 0;
 	int height = 0;
-	glfwGetFramebufferSize(window.getWindow(), &width, &height);
+	glfwGetFramebufferSize(window->getWindow(), &width, &height);
 
 	while (width == 0 || height == 0) {
-		glfwGetFramebufferSize(window.getWindow(), &width, &height);
+		glfwGetFramebufferSize(window->getWindow(), &width, &height);
 		glfwWaitEvents();
 	}
 
-	vkDeviceWaitIdle(device);
-
-	swapchainManager->recreateSwapchain(width, height);
+	// Sem vkDeviceWaitIdle: os recursos antigos só saem da fila quando a GPU terminar o próximo frame,
+	// que já usa o swapchain novo (um frame de folga para o present do último frame antigo)
+	swapchainManager->recreateSwapchain(width, height, deletionQueue, frameScheduler->getSubmittedValue() + 1);
+	if (overlay) {
+		overlay->setMinImageCount(swapchainManager->getImageCount());
+	}
 
 	createFramebuffers();
 
-	std::cout << "[VulkanManager] : Swap chain recreation complete." << std::endl;
+	LOG_DEBUG("VulkanManager", "Swap chain recreation complete.");
 }
 
-void VulkanManager::drawFrame() {
-	vkWaitForFences(device, 1, &inFlightFences[currentFrame], VK_TRUE, UINT64_MAX);
+void VulkanManager::beginFrame() {
+	// currentFrame já foi liberado pelo waitForFrame() do mainLoop
+	frameNumber = static_cast<uint32_t>(frameScheduler->getFrameNumber());
+	deletionQueue.flush(frameScheduler->getCompletedValue());
+
+	memoryMonitor->update(frameNumber);
+	// O slot terminou na GPU: a arena dele pode ser reaproveitada
+	frameArenas->beginFrame(currentFrame);
+	frameDescriptors->beginFrame(currentFrame);
+
+	// O que sobrou do culling só é conhecido na GPU: contadores do último frame deste slot
+	if (occlusionCuller) {
+		const OcclusionStats &culled = occlusionCuller->beginFrame(currentFrame);
+		FrameStats           &stats  = frameStats.current();
+		stats.culledObjects += culled.frustumCulled + culled.occluded;
+		stats.instances += culled.earlyDraws + culled.lateDraws;
+		stats.triangles += culled.triangles;
+	}
+	if (particleSystem) {
+		frameStats.current().particles = particleSystem->beginFrame(currentFrame).alive;
+	}
+}
 
-	uint32_t imageIndex;
-	VkResult result = vkAcquireNextImageKHR(
-	    device,
-	    swapchainManager->getSwapchain(),
-	    UINT64_MAX,
-	    imageAvailableSemaphores[currentFrame],
-	    VK_NULL_HANDLE,
-	    &imageIndex);
+void VulkanManager::drawOffscreenFrame() {
+	PROFILE_CPU_ZONE("drawOffscreenFrame");
+	frameStats.begin(frameScheduler->getFrameNumber());
+	FrameStats &stats = frameStats.current();
+	{
+		FrameStageTimer timer(stats, FrameStage::Setup);
+		beginFrame();
+	}
 
-	if (result == VK_ERROR_OUT_OF_DATE_KHR) {
-		std::cout << "[VulkanManager] : Swapchain out of date, recreating..." << std::endl;
-		recreateSwapChain();
-		return;        // Try again next frame
+	{
+		FrameStageTimer timer(stats, FrameStage::Record);
+		vkResetCommandBuffer(commandBuffers[currentFrame], 0);
+		recordCommandBuffer(commandBuffers[currentFrame], 0);
 	}
-	else if (result != VK_SUCCESS && result != VK_SUBOPTIMAL_KHR) {
-		throw std::runtime_error("[VulkanManager] : Failed to acquire swap chain image!");
+
+	{
+		FrameStageTimer timer(stats, FrameStage::Submit);
+		submitAsyncCompute();
+		if (frameScheduler->submitOffscreen(queues.graphicsQueue, commandBuffers[currentFrame]) != VK_SUCCESS) {
+			throw std::runtime_error("[VulkanManager] : Failed to submit offscreen frame!");
+		}
 	}
+	frameScheduler->endFrame();
+	frameStats.end();
+}
 
-	vkResetFences(device, 1, &inFlightFences[currentFrame]);
+void VulkanManager::runFixedFrames() {
+	using Clock = std::chrono::steady_clock;
 
-	vkResetCommandBuffer(commandBuffers[currentFrame], 0);
-	recordCommandBuffer(commandBuffers[currentFrame], imageIndex);
+	LOG_INFO("VulkanManager", "Fixed run (scene {}, {} frames{})...", toString(options.scene), options.frameCount, options.benchmark ? ", benchmark" : "");
 
-	VkSubmitInfo submitInfo{};
-	submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+	BenchmarkReport report;
+	uint64_t        firstMeasuredFrame = UINT64_MAX;
 
-	VkSemaphore          waitSemaphores[] = {imageAvailableSemaphores[currentFrame]};
-	VkPipelineStageFlags waitStages[]     = {VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT};
-	submitInfo.waitSemaphoreCount         = 1;
-	submitInfo.pWaitSemaphores            = waitSemaphores;
-	submitInfo.pWaitDstStageMask          = waitStages;
+	// Tempo de GPU do frame que usou o slot por último (o slot já foi liberado, não bloqueia)
+	auto collectGpuTime = [&](uint32_t slot) {
+		if (!gpuProfiler || !gpuProfiler->collect(slot)) {
+			return;
+		}
+		if (dynamicResolution) {
+			dynamicResolution->addGpuTime(gpuProfiler->getLastFrame().totalMs);
+		}
+		if (gpuProfiler->getLastFrame().frameNumber >= firstMeasuredFrame) {
+			report.addGpuFrame(gpuProfiler->getLastFrame().totalMs);
+		}
+	};
+
+	// Um frame completo com passo de tempo fixo; false se a janela foi fechada
+	auto renderFrame = [&](double &cpuMs) {
+		if (window) {
+			if (window->shouldClose()) {
+				return false;
+			}
+			window->pollEvents();
+		}
+		currentFrame = frameScheduler->waitForFrame();
+		collectGpuTime(currentFrame);
 
-	submitInfo.commandBufferCount = 1;
-	submitInfo.pCommandBuffers    = &commandBuffers[currentFrame];
+		auto start = Clock::now();
+		if (options.headless) {
+			drawOffscreenFrame();
+		}
+		else {
+			drawFrame();
+		}
+		cpuMs = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+
+		simulationTime += options.timeStep;
+		return true;
+	};
+
+	// Aquecimento: texturas residentes + warmupFrames (caches, pipelines, clock da GPU subindo).
+	// Frames com textura ainda carregando não contam, senão o resultado dependeria do decode.
+	double   cpuMs        = 0.0;
+	uint32_t warmupFrames = 0;
+	while (textureManager->getPendingCount() > 0 || warmupFrames < options.warmupFrames) {
+		if (!renderFrame(cpuMs)) {
+			return;
+		}
+		warmupFrames++;
+	}
+
+	// Os frames medidos começam sempre do mesmo tempo simulado
+	simulationTime     = 0.0;
+	firstMeasuredFrame = frameScheduler->getFrameNumber();
+
+	for (uint32_t i = 0; i < options.frameCount; i++) {
+		auto frameStart = Clock::now();
+		if (!renderFrame(cpuMs)) {
+			break;
+		}
+		report.addFrame(std::chrono::duration<double, std::milli>(Clock::now() - frameStart).count(), cpuMs);
+	}
+	frameScheduler->drain();
+	for (uint32_t slot = 0; slot < MAX_FRAMES_IN_FLIGHT; slot++) {
+		collectGpuTime(slot);
+	}
 
-	VkSemaphore signalSemaphores[]  = {renderFinishedSemaphores[currentFrame]};
-	submitInfo.signalSemaphoreCount = 1;
-	submitInfo.pSignalSemaphores    = signalSemaphores;
+	if (options.benchmark) {
+		VkPhysicalDeviceProperties properties;
+		vkGetPhysicalDeviceProperties(physicalDevice, &properties);
+
+		BenchmarkInfo info;
+		info.scene         = toString(options.scene);
+		info.device        = properties.deviceName;
+		info.width         = getOutputExtent().width;
+		info.height        = getOutputExtent().height;
+		info.warmupFrames  = warmupFrames;
+		info.timeStepMs    = options.timeStep * 1000.0;
+		info.headless      = options.headless;
+		info.presentPolicy = options.headless ? "none" : SwapchainManager::toString(presentPolicy);
+		report.writeJson(options.benchmarkOutput, info);
+	}
 
-	if (vkQueueSubmit(queues.graphicsQueue, 1, &submitInfo, inFlightFences[currentFrame]) != VK_SUCCESS) {
-		throw std::runtime_error("failed to submit draw command buffer!");
+	if (options.headless && !options.readbackPath.empty()) {
+		if (PngWriter::writeFile(options.readbackPath, offscreenTarget->readback())) {
+			LOG_INFO("VulkanManager", "Last frame written to {}", options.readbackPath);
+		}
 	}
+	LOG_INFO("VulkanManager", "Fixed run finished ({} frames measured after {} warm-up frames).", report.getFrameCount(), warmupFrames);
+}
 
-	VkPresentInfoKHR presentInfo{};
-	presentInfo.sType = VK_STRUCTURE_TYPE_PRESENT_INFO_KHR;
+void VulkanManager::createOffscreenTarget() {
+	offscreenTarget = std::make_unique<OffscreenTarget>(*resourceManager, *bufferManager, requestedExtent);
+	LOG_INFO("VulkanManager", "Offscreen target created.");
+}
 
-	presentInfo.waitSemaphoreCount = 1;
-	presentInfo.pWaitSemaphores    = signalSemaphores;
+void VulkanManager::createRenderGraph() {
+	// O render graph grava tudo com vkCmdBeginRendering; sem dynamic rendering fica o render pass fixo
+	if (!dynamicRenderingEnabled) {
+		return;
+	}
+	renderGraph = std::make_unique<RenderGraph>(device, vmaWrapper.getAllocator(), deletionQueue);
+}
+
+void VulkanManager::createShadowCascades() {
+	// As shadow maps passam pelo render graph (importadas); o fallback de render pass fica sem sombras
+	if (!renderGraph) {
+		return;
+	}
+	shadowCascades = std::make_unique<ShadowCascades>(*resourceManager, *bindlessDescriptors, depthFormat);
+
+	PipelineConfig pipelineConfig{};
+	pipelineConfig.extend                = {shadowCascades->getResolution(), shadowCascades->getResolution()};
+	pipelineConfig.depthAttachmentFormat = shadowCascades->getDepthFormat();
+	pipelineConfig.vertexShaderPath      = "../assets/shaders/core/shadow/compiled/vert.spv";
+	pipelineConfig.fragmentShaderPath    = "";
+	pipelineConfig.setLayouts            = {bindlessDescriptors->getLayout()};
+	pipelineConfig.cullMode              = VK_CULL_MODE_NONE;        // Malhas abertas do modelo também fazem sombra
+	pipelineConfig.depthBias             = true;
+	pipelineConfig.depthBiasConstant     = 1.25f;
+	pipelineConfig.depthBiasSlope        = 1.75f;
+
+	std::tie(shadowPipeline, shadowPipelineLayout) = PipelineManager::createGraphicsPipeline(device, pipelineConfig);
+	LOG_INFO("VulkanManager", "Shadow pipeline created.");
+}
+
+void VulkanManager::createClusteredLighting() {
+	// A grade de clusters é montada por um pass de compute do render graph; o fallback fica só com o sol
+	if (!renderGraph) {
+		return;
+	}
+	clusteredLighting = std::make_unique<ClusteredLighting>(device, *bufferManager, *bindlessDescriptors, MAX_FRAMES_IN_FLIGHT);
+}
+
+void VulkanManager::createOcclusionCuller() {
+	// Culling e pirâmide são passes do render graph; o draw indireto precisa do firstInstance (índice do objeto)
+	if (!renderGraph) {
+		return;
+	}
+	if (!firstInstanceIndirectEnabled) {
+		LOG_INFO("VulkanManager", "drawIndirectFirstInstance not supported, occlusion culling disabled.");
+		return;
+	}
+	occlusionCuller = std::make_unique<OcclusionCuller>(device,
+	                                                    *resourceManager,
+	                                                    *bufferManager,
+	                                                    *bindlessDescriptors,
+	                                                    *descriptorLayoutCache,
+	                                                    *frameDescriptors,
+	                                                    deletionQueue,
+	                                                    MAX_FRAMES_IN_FLIGHT,
+	                                                    MAX_OBJECTS);
+}
+
+void VulkanManager::createParticleSystem() {
+	// Simulação e desenho são passes do render graph; o fallback de render pass fica sem partículas
+	if (!renderGraph) {
+		return;
+	}
+	VkFormat colorFormat = offscreenTarget ? OffscreenTarget::COLOR_FORMAT : swapchainManager->getSwapchainImageFormat();
+	particleSystem       = std::make_unique<ParticleSystem>(device, *bufferManager, *bindlessDescriptors, colorFormat, depthFormat, MAX_FRAMES_IN_FLIGHT);
+}
+
+void VulkanManager::createGpuProfiler() {
+	uint32_t graphicsFamily = queueManager.getQueueFamilies().at(QueueType::GRAPHICS).index;
+	if (!GpuProfiler::isSupported(physicalDevice, graphicsFamily)) {
+		LOG_INFO("VulkanManager", "Timestamps not supported, GPU profiler disabled.");
+		return;
+	}
+	gpuProfiler = std::make_unique<GpuProfiler>(device, physicalDevice, graphicsFamily, MAX_FRAMES_IN_FLIGHT);
+}
+
+void VulkanManager::createDynamicResolution() {
+	if (options.gpuBudgetMs <= 0.0) {
+		return;
+	}
+	// O tempo medido vem dos timestamps e a ampliação é um blit: sem isso a cena fica na resolução da saída
+	if (!renderGraph || !gpuProfiler || (swapchainManager && !swapchainManager->isTransferDstSupported())) {
+		LOG_WARN("VulkanManager", "Dynamic resolution needs the render graph, GPU timestamps and blits to the output, disabled.");
+		return;
+	}
+
+	VkFormat           format = offscreenTarget ? OffscreenTarget::COLOR_FORMAT : swapchainManager->getSwapchainImageFormat();
+	VkFormatProperties properties;
+	vkGetPhysicalDeviceFormatProperties(physicalDevice, format, &properties);
+	VkFormatFeatureFlags blitFeatures = VK_FORMAT_FEATURE_BLIT_SRC_BIT | VK_FORMAT_FEATURE_BLIT_DST_BIT | VK_FORMAT_FEATURE_SAMPLED_IMAGE_FILTER_LINEAR_BIT;
+	if ((properties.optimalTilingFeatures & blitFeatures) != blitFeatures) {
+		LOG_WARN("VulkanManager", "Output format can't be blitted with linear filtering, dynamic resolution disabled.");
+		return;
+	}
+
+	DynamicResolutionSettings settings;
+	settings.targetMs     = options.gpuBudgetMs;
+	settings.settleFrames = MAX_FRAMES_IN_FLIGHT;
+	dynamicResolution     = std::make_unique<DynamicResolution>(settings);
+}
+
+void VulkanManager::createOverlay() {
+	PerformanceOverlay::InitInfo info{};
+	info.instance       = instance;
+	info.physicalDevice = physicalDevice;
+	info.device         = device;
+	info.queueFamily    = queueManager.getQueueFamilies().at(QueueType::GRAPHICS).index;
+	info.queue          = queues.graphicsQueue;
+	info.window         = window->getWindow();
+	info.imageCount     = swapchainManager->getImageCount();
+	info.colorFormat    = swapchainManager->getSwapchainImageFormat();
+	info.renderPass     = dynamicRenderingEnabled ? VK_NULL_HANDLE : renderPass;
+
+	overlay = std::make_unique<PerformanceOverlay>(info);
+}
+
+void VulkanManager::setOverlayVisible(bool visible) {
+	if (overlay) {
+		overlay->setVisible(visible);
+	}
+}
+
+std::vector<GpuScopeStats> VulkanManager::getGpuScopeStats() const {
+	return gpuProfiler ? gpuProfiler->getScopeStats() : std::vector<GpuScopeStats>{};
+}
+
+void VulkanManager::buildScene() {
+	carInstances.clear();
+	sceneObjects.clear();
+	sceneLights.clear();
+	propMeshes.clear();
+
+	// AABB do carro (todas as meshes) já na escala da cena; o raio em XZ cobre o giro em Y
+	const float carScale = 0.01f;
+	glm::vec3   carMin(0.0f);
+	glm::vec3   carMax(0.0f);
+	for (size_t i = 0; i < carMeshes.size(); i++) {
+		carMin = i == 0 ? carMeshes[i].getBoundsMin() : glm::min(carMin, carMeshes[i].getBoundsMin());
+		carMax = i == 0 ? carMeshes[i].getBoundsMax() : glm::max(carMax, carMeshes[i].getBoundsMax());
+	}
+	carMin *= carScale;
+	carMax *= carScale;
+	float carRadius = glm::length(glm::vec2(std::max(std::abs(carMin.x), std::abs(carMax.x)), std::max(std::abs(carMin.z), std::abs(carMax.z))));
+
+	const uint32_t barrierCount = 16;
+	const size_t   staticCount  = 1 + barrierCount;        // Chão + barreiras
+	float          layoutHalf   = 0.0f;                    // Meia largura da área ocupada pelos carros
+
+	if (options.scene == BenchmarkScene::CarGrid || options.scene == BenchmarkScene::NightLights) {
+		// Grade quadrada de cópias; cada cópia ocupa um objeto por mesh no buffer de objetos
+		size_t   maxCopies = (MAX_OBJECTS - staticCount) / std::max<size_t>(carMeshes.size(), 1);
+		uint32_t side      = static_cast<uint32_t>(std::min<size_t>(8, static_cast<size_t>(std::sqrt(static_cast<double>(maxCopies)))));
+		float    spacing   = 1.5f;
+		float    half      = (static_cast<float>(side) - 1.0f) * spacing * 0.5f;
+
+		for (uint32_t z = 0; z < side; z++) {
+			for (uint32_t x = 0; x < side; x++) {
+				carInstances.push_back(glm::vec3(x * spacing - half, 0.0f, z * spacing - half));
+			}
+		}
+		cameraEye  = glm::vec3(0.0f, half * 1.5f + 2.0f, half * 2.5f + 4.0f);
+		cameraFar  = half * 6.0f + 10.0f;
+		layoutHalf = half + carRadius;
+	}
+	else {
+		carInstances.push_back(glm::vec3(0.8f, 0.0f, 0.0f));
+		layoutHalf = 0.8f + carRadius;
+	}
+
+	// Pista: chão na base dos carros e uma volta de barreiras. Tudo estático (entra nas cascatas em cache).
+	float groundY     = carMin.y;
+	groundHeight      = groundY;
+	carBoundsMin      = carMin;
+	carBoundsMax      = carMax;
+	float barrierRing = layoutHalf + 1.5f;
+	sceneRadius       = barrierRing + 4.0f;
+
+	MeshData ground  = MeshFactory::makePlane(sceneRadius * 2.0f, sceneRadius * 2.0f);
+	MeshData barrier = MeshFactory::makeCube();
+	for (Vertex &vertex : barrier.vertices) {
+		vertex.color[0] = 0.8f;
+		vertex.color[1] = 0.8f;
+		vertex.color[2] = 0.75f;
+	}
+	propMeshes.reserve(2);
+	for (const MeshData *data : {&ground, &barrier}) {
+		Mesh mesh(bufferManager.get());
+		mesh.upload(*data, *bufferManager);
+		propMeshes.push_back(std::move(mesh));
+	}
+
+	TextureHandle white = textureManager->getDefaultTexture();
+	sceneObjects.push_back({&propMeshes[0], glm::translate(glm::mat4(1.0f), glm::vec3(0.0f, groundY, 0.0f)), white, false});
+	for (uint32_t i = 0; i < barrierCount; i++) {
+		// Comprimento (Z local) tangente ao círculo
+		float     angle = glm::two_pi<float>() * static_cast<float>(i) / static_cast<float>(barrierCount);
+		glm::mat4 model = glm::translate(glm::mat4(1.0f), glm::vec3(std::cos(angle) * barrierRing, groundY + 0.3f, std::sin(angle) * barrierRing));
+		model           = glm::rotate(model, -angle, glm::vec3(0.0f, 1.0f, 0.0f));
+		model           = glm::scale(model, glm::vec3(0.3f, 0.6f, 1.2f));
+		sceneObjects.push_back({&propMeshes[1], model, white, false});
+	}
+	staticObjectCount = sceneObjects.size();
+
+	// Carros: um objeto por mesh por cópia
+	for (const glm::vec3 &position : carInstances) {
+		glm::mat4 transform = glm::scale(glm::translate(glm::mat4(1.0f), position), glm::vec3(carScale));
+		for (const Mesh &mesh : carMeshes) {
+			sceneObjects.push_back({&mesh, transform, colormapTexture, true});
+		}
+	}
+
+	// Comandos indiretos agrupados por mesh (ordem estável: a visibilidade do frame anterior segue o slot)
+	drawBatches.clear();
+	drawOrder.clear();
+	for (uint32_t i = 0; i < sceneObjects.size(); i++) {
+		const Mesh *mesh = sceneObjects[i].mesh;
+		auto        it   = std::find_if(drawBatches.begin(), drawBatches.end(), [mesh](const DrawBatch &batch) { return batch.mesh == mesh; });
+		if (it == drawBatches.end()) {
+			drawBatches.push_back({mesh, 0, 0});
+			it = drawBatches.end() - 1;
+		}
+		it->drawCount++;
+	}
+	for (DrawBatch &batch : drawBatches) {
+		batch.firstDraw = static_cast<uint32_t>(drawOrder.size());
+		for (uint32_t i = 0; i < sceneObjects.size(); i++) {
+			if (sceneObjects[i].mesh == batch.mesh) {
+				drawOrder.push_back(i);
+			}
+		}
+	}
+
+	// Luzes pontuais: uma lâmpada sobre cada barreira e faróis/lanternas em cada carro (giram com ele)
+	for (uint32_t i = 0; i < barrierCount; i++) {
+		float angle = glm::two_pi<float>() * (static_cast<float>(i) + 0.5f) / static_cast<float>(barrierCount);
+		sceneLights.push_back({glm::vec3(std::cos(angle) * barrierRing, groundY + 1.6f, std::sin(angle) * barrierRing), glm::vec3(0.0f), 0.0f,
+		                       glm::vec3(1.0f, 0.8f, 0.55f), 4.0f, 3.0f});
+	}
+	glm::vec3 carSize = carMax - carMin;
+	float     lampY   = carMin.y + carSize.y * 0.4f;
+	float     carSpin = glm::radians(90.0f);        // Mesmo giro dos carros em updateSceneData
+	for (const glm::vec3 &position : carInstances) {
+		for (float side : {-0.3f, 0.3f}) {
+			float x = (carMin.x + carMax.x) * 0.5f + side * carSize.x;
+			sceneLights.push_back({position, glm::vec3(x, lampY, carMax.z), carSpin, glm::vec3(1.0f, 0.95f, 0.85f), 2.0f, 2.0f});
+			sceneLights.push_back({position, glm::vec3(x, lampY, carMin.z), carSpin, glm::vec3(1.0f, 0.05f, 0.02f), 1.0f, 1.0f});
+		}
+	}
+
+	// Teste de estresse: noite com 1000 luzes no total, espalhadas sobre a pista e rodando em volta dela.
+	// Semente fixa: toda execução do benchmark vê a mesma distribuição.
+	sunIntensity = 1.0f;
+	ambientLight = 0.25f;
+	if (options.scene == BenchmarkScene::NightLights) {
+		const size_t totalLights = 1000;
+
+		sunIntensity = 0.05f;
+		ambientLight = 0.03f;
+
+		std::mt19937                          rng(1234);
+		std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+		while (sceneLights.size() < totalLights) {
+			float distance = std::sqrt(unit(rng)) * sceneRadius;        // Uniforme na área do disco
+			float angle    = unit(rng) * glm::two_pi<float>();
+			float height   = groundY + 0.2f + unit(rng) * 2.0f;
+			float speed    = (unit(rng) - 0.5f) * 0.8f;
+			sceneLights.push_back({glm::vec3(0.0f), glm::vec3(std::cos(angle) * distance, height, std::sin(angle) * distance), speed,
+			                       glm::vec3(0.2f + unit(rng) * 0.8f, 0.2f + unit(rng) * 0.8f, 0.2f + unit(rng) * 0.8f),
+			                       1.0f + unit(rng) * 2.0f, 1.5f});
+		}
+	}
+	LOG_INFO("VulkanManager", "Scene '{}' with {} car(s), {} objects ({} static), {} point lights.", toString(options.scene), carInstances.size(),
+	         sceneObjects.size(), staticObjectCount, sceneLights.size());
+}
+
+VkExtent2D VulkanManager::getOutputExtent() const {
+	return offscreenTarget ? offscreenTarget->getExtent() : swapchainManager->getSwapchainExtent();
+}
+
+VkExtent2D VulkanManager::getRenderExtent() const {
+	return dynamicResolution ? dynamicResolution->getRenderExtent(getOutputExtent()) : getOutputExtent();
+}
+
+const PresentTimingStats &VulkanManager::getPresentTimingStats() const {
+	static const PresentTimingStats noPresents{};
+	return swapchainManager ? swapchainManager->getPresentTimingStats() : noPresents;
+}
+
+void VulkanManager::drawFrame() {
+	PROFILE_CPU_ZONE("drawFrame");
+	frameStats.begin(frameScheduler->getFrameNumber());
+	FrameStats &stats = frameStats.current();
+	{
+		FrameStageTimer timer(stats, FrameStage::Setup);
+		beginFrame();
+	}
+
+	uint32_t imageIndex;
+	VkResult result;
+	{
+		FrameStageTimer timer(stats, FrameStage::Acquire);
+		result = vkAcquireNextImageKHR(
+		    device,
+		    swapchainManager->getSwapchain(),
+		    UINT64_MAX,
+		    frameScheduler->getImageAvailableSemaphore(),
+		    VK_NULL_HANDLE,
+		    &imageIndex);
+	}
+
+	if (result == VK_ERROR_OUT_OF_DATE_KHR) {
+		LOG_DEBUG("VulkanManager", "Swapchain out of date, recreating...");
+		recreateSwapChain();
+		return;        // Try again next frame
+	}
+	else if (result != VK_SUCCESS && result != VK_SUBOPTIMAL_KHR) {
+		throw std::runtime_error("[VulkanManager] : Failed to acquire swap chain image!");
+	}
+
+	// Monta a UI antes de gravar (só CPU); escondido não custa nada
+	if (overlay && overlay->isVisible()) {
+		PROFILE_CPU_ZONE("overlay build");
+		FrameStageTimer            timer(stats, FrameStage::Ui);
+		std::vector<GpuScopeStats> gpuScopes = getGpuScopeStats();
+
+		OverlayFrameData data;
+		data.pacing        = &frameScheduler->getStats();
+		data.gpuScopes     = gpuProfiler ? &gpuScopes : nullptr;
+		data.heaps         = &memoryMonitor->getHeapSamples();
+		data.frame         = &frameStats.last();
+		data.uploadedBytes = textureManager->getUploadedBytes() + bufferManager->getUploadedBytes();
+		overlay->build(data);
+	}
+
+	{
+		FrameStageTimer timer(stats, FrameStage::Record);
+		vkResetCommandBuffer(commandBuffers[currentFrame], 0);
+		recordCommandBuffer(commandBuffers[currentFrame], imageIndex);
+	}
 
-	VkSwapchainKHR swapChains[] = {swapchainManager->getSwapchain()};
-	presentInfo.swapchainCount  = 1;
-	presentInfo.pSwapchains     = swapChains;
+	// Sinaliza o timeline com frameNumber + 1 e o renderFinished do slot
+	{
+		FrameStageTimer timer(stats, FrameStage::Submit);
+		submitAsyncCompute();
+		if (frameScheduler->submit(queues.graphicsQueue, commandBuffers[currentFrame], VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT) != VK_SUCCESS) {
+			throw std::runtime_error("failed to submit draw command buffer!");
+		}
+	}
 
-	presentInfo.pImageIndices = &imageIndex;
+	{
+		FrameStageTimer timer(stats, FrameStage::Present);
+		result = swapchainManager->present(queues.presentQueue, frameScheduler->getRenderFinishedSemaphore(), imageIndex);
+	}
 
-	result = vkQueuePresentKHR(queues.presentQueue, &presentInfo);
+	// O frame já foi submetido: avança mesmo que o swapchain precise ser recriado
+	frameScheduler->endFrame();
+	frameStats.end();
 
-	if (result == VK_ERROR_OUT_OF_DATE_KHR || result == VK_SUBOPTIMAL_KHR || framebufferResized) {
+	if (result == VK_ERROR_OUT_OF_DATE_KHR || result == VK_SUBOPTIMAL_KHR || framebufferResized || presentPolicyChanged) {
 		framebufferResized = false;
-		std::cout << "[VulkanManager] : Swapchain suboptimal or resized, recreating..." << std::endl;
+		LOG_DEBUG("VulkanManager", "Swapchain suboptimal or resized, recreating...");
 		recreateSwapChain();
+		if (presentPolicyChanged) {
+			// Os intervalos medidos no modo anterior não servem mais
+			presentPolicyChanged = false;
+			swapchainManager->resetPresentTimingStats();
+			frameScheduler->resetStats();
+		}
 	}
 	else if (result != VK_SUCCESS) {
 		throw std::runtime_error("[VulkanManager] : Failed to present swap chain image!");
 	}
-
-	currentFrame = (currentFrame + 1) % MAX_FRAMES_IN_FLIGHT;
 }
 
 void VulkanManager::createSyncObjects() {
-	imageAvailableSemaphores.resize(MAX_FRAMES_IN_FLIGHT);
-	renderFinishedSemaphores.resize(MAX_FRAMES_IN_FLIGHT);
-	inFlightFences.resize(MAX_FRAMES_IN_FLIGHT);
-
-	VkSemaphoreCreateInfo semaphoreInfo{};
-	semaphoreInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
+	frameScheduler = std::make_unique<FrameScheduler>(
+	    device,
+	    options.framesInFlight,
+	    presentPolicy == PresentPolicy::LowLatency ? LatencyMode::LowLatency : LatencyMode::Throughput);
+	LOG_INFO("VulkanManager", "Synchronization objects created.");
+}
 
-	VkFenceCreateInfo fenceInfo{};
-	fenceInfo.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
-	fenceInfo.flags = VK_FENCE_CREATE_SIGNALED_BIT;        // Importante! Começa sinalizado
+void VulkanManager::createAsyncCompute() {
+	// Hoje só a atribuição de luzes vai para a fila de compute, e ela só existe com render graph
+	if (!options.asyncCompute || !dynamicRenderingEnabled) {
+		return;
+	}
+	if (queues.computeQueue == VK_NULL_HANDLE) {
+		LOG_INFO("VulkanManager", "No second queue with compute support, async compute disabled.");
+		return;
+	}
+	asyncCompute = std::make_unique<AsyncCompute>(device, queues.computeQueue, queues.computeFamily, MAX_FRAMES_IN_FLIGHT);
+}
 
-	for (size_t i = 0; i < MAX_FRAMES_IN_FLIGHT; i++) {
-		if (vkCreateSemaphore(device, &semaphoreInfo, nullptr, &imageAvailableSemaphores[i]) != VK_SUCCESS ||
-		    vkCreateSemaphore(device, &semaphoreInfo, nullptr, &renderFinishedSemaphores[i]) != VK_SUCCESS ||
-		    vkCreateFence(device, &fenceInfo, nullptr, &inFlightFences[i]) != VK_SUCCESS) {
-			throw std::runtime_error("failed to create synchronization objects for a frame!");
-		}
+void VulkanManager::submitAsyncCompute() {
+	if (!asyncCompute || !clusteredLighting) {
+		return;
 	}
+	// Sombras, culling e depth do frame gráfico não esperam; só o fragment shader lê a grade
+	uint64_t computeValue = asyncCompute->submit();
+	frameScheduler->waitOnNextSubmit(asyncCompute->getTimelineSemaphore(), computeValue, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT);
+}
 
-	std::cout << "[VulkanManager] : Synchronization objects created." << std::endl;
+void VulkanManager::createFrameArenas() {
+	frameArenas = std::make_unique<FrameArenas>(MAX_FRAMES_IN_FLIGHT, 256 * 1024);
+	LOG_INFO("VulkanManager", "Frame arenas created.");
 }
 
 void VulkanManager::recordCommandBuffer(VkCommandBuffer commandBuffer, uint32_t imageIndex) {
+	PROFILE_CPU_ZONE("recordCommandBuffer");
+
 	VkCommandBufferBeginInfo beginInfo{};
 	beginInfo.sType            = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
 	beginInfo.flags            = 0;
@@ -219,7 +813,274 @@ void VulkanManager::recordCommandBuffer(VkCommandBuffer commandBuffer, uint32_t
 		throw std::runtime_error("[VulkanManager] : Failed to begin recording command buffer!");
 	}
 
-	// Começar RenderPass
+	if (gpuProfiler) {
+		gpuProfiler->beginFrame(commandBuffer, currentFrame, frameScheduler->getFrameNumber());
+	}
+
+	// Trabalho de transferência do frame (fora do render pass)
+	{
+		PROFILE_GPU_SCOPE(commandBuffer, "transfers");
+		defragmenter->recordCommands(commandBuffer, frameNumber);
+		textureManager->processUploads(commandBuffer, frameNumber);
+	}
+
+	// Staging do frame: texturas enviadas agora + geometria criada desde o último frame
+	uint64_t uploadedTotal = textureManager->getUploadedBytes() + bufferManager->getUploadedBytes();
+	frameStats.current().uploadedBytes += uploadedTotal - lastUploadedTotal;
+	lastUploadedTotal = uploadedTotal;
+
+	updateSceneData();
+
+	// Grade de clusters no command buffer da fila de compute (submetido antes do frame gráfico)
+	if (asyncCompute && clusteredLighting) {
+		VkCommandBuffer computeCommands = asyncCompute->begin(currentFrame);
+		clusteredLighting->recordCulling(computeCommands);
+		frameStats.current().pipelineBinds++;
+		frameStats.current().descriptorBinds++;
+	}
+
+	if (renderGraph) {
+		recordFrameGraph(commandBuffer, imageIndex);
+	}
+	else {
+		recordMainPass(commandBuffer, imageIndex);
+	}
+
+	if (gpuProfiler) {
+		gpuProfiler->endFrame(commandBuffer);
+	}
+
+	if (vkEndCommandBuffer(commandBuffer) != VK_SUCCESS) {
+		throw std::runtime_error("[VulkanManager] : Failed to record command buffer!");
+	}
+}
+
+void VulkanManager::recordFrameGraph(VkCommandBuffer commandBuffer, uint32_t imageIndex) {
+	VkExtent2D extent       = getOutputExtent();
+	VkExtent2D renderExtent = getRenderExtent();
+	renderGraph->reset();
+
+	// Backbuffer: imagem do swapchain (vai para o present) ou alvo offscreen (lido pelo readback)
+	RenderGraphResource backbuffer;
+	if (offscreenTarget) {
+		backbuffer = renderGraph->importImage("backbuffer",
+		                                      offscreenTarget->getColorImage(),
+		                                      offscreenTarget->getColorView(),
+		                                      {OffscreenTarget::COLOR_FORMAT, extent},
+		                                      VK_IMAGE_ASPECT_COLOR_BIT,
+		                                      VK_IMAGE_LAYOUT_UNDEFINED,
+		                                      VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT,        // Frames em voo dividem a imagem
+		                                      VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT,
+		                                      VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL);
+	}
+	else {
+		// O acquire é esperado em COLOR_ATTACHMENT_OUTPUT, então a primeira barreira parte desse estágio
+		backbuffer = renderGraph->importImage("backbuffer",
+		                                      swapchainManager->getImages()[imageIndex],
+		                                      swapchainManager->getImageViews()[imageIndex],
+		                                      {swapchainManager->getSwapchainImageFormat(), extent},
+		                                      VK_IMAGE_ASPECT_COLOR_BIT,
+		                                      VK_IMAGE_LAYOUT_UNDEFINED,
+		                                      VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT,
+		                                      0,
+		                                      VK_IMAGE_LAYOUT_PRESENT_SRC_KHR);
+	}
+	RenderGraphResource depth = renderGraph->createImage("depth", {depthFormat, extent});
+
+	// Resolução dinâmica: a cena ocupa o canto renderExtent de uma cor do tamanho da saída (nada
+	// é realocado quando a escala muda) e um blit linear amplia esse canto para o backbuffer
+	RenderGraphResource sceneColor = backbuffer;
+	if (dynamicResolution) {
+		VkFormat colorFormat = offscreenTarget ? OffscreenTarget::COLOR_FORMAT : swapchainManager->getSwapchainImageFormat();
+		sceneColor           = renderGraph->createImage("scene color", {colorFormat, extent});
+	}
+
+	// Shadow maps persistem entre frames (cache); só entram passes para as que o update() marcou
+	static constexpr const char *CASCADE_PASSES[ShadowCascades::MAX_CASCADES] = {"shadow cascade 0", "shadow cascade 1",
+	                                                                              "shadow cascade 2", "shadow cascade 3"};
+	std::array<RenderGraphResource, ShadowCascades::MAX_CASCADES> shadowMaps{};
+	for (uint32_t c = 0; shadowCascades && c < shadowCascades->getCascadeCount(); c++) {
+		const ShadowCascades::Cascade &cascade    = shadowCascades->getCascade(c);
+		uint32_t                       resolution = shadowCascades->getResolution();
+
+		shadowMaps[c] = renderGraph->importImage(CASCADE_PASSES[c],
+		                                         shadowCascades->getImage(c),
+		                                         shadowCascades->getImageView(c),
+		                                         {shadowCascades->getDepthFormat(), {resolution, resolution}},
+		                                         VK_IMAGE_ASPECT_DEPTH_BIT,
+		                                         cascade.initialized ? VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL : VK_IMAGE_LAYOUT_UNDEFINED,
+		                                         VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT,        // Lida pelo opaque do frame anterior
+		                                         0,
+		                                         VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
+		if (cascade.needsRender) {
+			renderGraph->addPass(CASCADE_PASSES[c], [this, c](VkCommandBuffer cmd) { recordShadowCascade(cmd, c); })
+			    .writeDepth(shadowMaps[c], AttachmentLoad::Clear);
+			shadowCascades->markRendered(c);
+		}
+	}
+
+	// Grade de clusters: escrita pelo compute e lida pelo opaque no mesmo frame. Com compute assíncrono
+	// ela chega pronta (o submit espera o timeline da fila de compute no fragment shader) e não há pass
+	RenderGraphResource lightClusters;
+	if (clusteredLighting) {
+		lightClusters = renderGraph->importBuffer("light clusters",
+		                                          clusteredLighting->getClusterBuffer(),
+		                                          VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT,        // Lida pelo opaque do frame anterior
+		                                          0);
+		if (!asyncCompute) {
+			auto cullLights = [this](VkCommandBuffer cmd) {
+				clusteredLighting->recordCulling(cmd);
+				frameStats.current().pipelineBinds++;
+				frameStats.current().descriptorBinds++;
+			};
+			renderGraph->addPass("light clusters", cullLights).write(lightClusters, RenderGraphAccess::ComputeStorageWrite);
+		}
+	}
+
+	// Occlusion culling em duas fases: comandos indiretos, visibilidade e contadores vivem no culler
+	RenderGraphResource drawCommands;
+	RenderGraphResource visibility;
+	RenderGraphResource cullStats;
+	RenderGraphResource depthPyramid;
+	if (occlusionCuller) {
+		drawCommands = renderGraph->importBuffer("indirect draws", occlusionCuller->getDrawBuffer(), VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT, 0);
+		visibility   = renderGraph->importBuffer("visibility",
+		                                         occlusionCuller->getVisibilityBuffer(),
+		                                         VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,        // Cull late do frame anterior
+		                                         VK_ACCESS_SHADER_WRITE_BIT);
+		cullStats    = renderGraph->importBuffer("cull stats", occlusionCuller->getStatsBuffer(), VK_PIPELINE_STAGE_HOST_BIT, VK_ACCESS_HOST_WRITE_BIT);
+		depthPyramid = renderGraph->importImage("depth pyramid",
+		                                        occlusionCuller->getPyramidImage(),
+		                                        occlusionCuller->getPyramidView(),
+		                                        {OcclusionCuller::PYRAMID_FORMAT, occlusionCuller->getPyramidExtent()},
+		                                        VK_IMAGE_ASPECT_COLOR_BIT,
+		                                        VK_IMAGE_LAYOUT_UNDEFINED,        // Refeita inteira todo frame
+		                                        VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+		                                        0,
+		                                        VK_IMAGE_LAYOUT_UNDEFINED);
+
+		auto cullEarly = [this](VkCommandBuffer cmd) { occlusionCuller->recordCull(cmd, OcclusionCuller::Phase::Early); };
+		renderGraph->addPass("cull early", cullEarly)
+		    .read(visibility, RenderGraphAccess::ComputeStorageRead)
+		    .write(drawCommands, RenderGraphAccess::ComputeStorageWrite)
+		    .write(cullStats, RenderGraphAccess::ComputeStorageWrite);
+	}
+
+	// Com culling: só o que estava visível no frame anterior (o resto entra no "opaque late")
+	std::optional<OcclusionCuller::Phase> earlyPhase;
+	if (occlusionCuller) {
+		earlyPhase = OcclusionCuller::Phase::Early;
+	}
+	RenderGraph::PassBuilder opaque = renderGraph->addPass("opaque", [this, earlyPhase](VkCommandBuffer cmd) { recordScene(cmd, earlyPhase); });
+	opaque.writeColor(sceneColor, AttachmentLoad::Clear, {{0.2f, 0.2f, 0.2f, 1.0f}})
+	    .writeDepth(depth, AttachmentLoad::Clear);
+	for (uint32_t c = 0; shadowCascades && c < shadowCascades->getCascadeCount(); c++) {
+		opaque.read(shadowMaps[c], RenderGraphAccess::FragmentSampled);
+	}
+	if (clusteredLighting) {
+		opaque.read(lightClusters, RenderGraphAccess::FragmentStorageRead);
+	}
+
+	if (occlusionCuller) {
+		opaque.read(drawCommands, RenderGraphAccess::IndirectRead);
+
+		// Pirâmide do depth dos oclusores já desenhados; a view do depth transiente só existe depois do compile
+		auto buildPyramid = [this, depth](VkCommandBuffer cmd) { occlusionCuller->recordDepthPyramid(cmd, renderGraph->getImageView(depth)); };
+		renderGraph->addPass("depth pyramid", buildPyramid)
+		    .read(depth, RenderGraphAccess::ComputeSampled)
+		    .write(depthPyramid, RenderGraphAccess::ComputeStorageWrite);
+
+		auto cullLate = [this](VkCommandBuffer cmd) { occlusionCuller->recordCull(cmd, OcclusionCuller::Phase::Late); };
+		renderGraph->addPass("cull late", cullLate)
+		    .read(depthPyramid, RenderGraphAccess::ComputeStorageRead)
+		    .write(visibility, RenderGraphAccess::ComputeStorageWrite)
+		    .write(drawCommands, RenderGraphAccess::ComputeStorageWrite)
+		    .write(cullStats, RenderGraphAccess::ComputeStorageWrite);
+
+		// Recém-visíveis (desoclusão, entrando no frustum) por cima do que já foi desenhado
+		auto                     drawLate   = [this](VkCommandBuffer cmd) { recordScene(cmd, OcclusionCuller::Phase::Late); };
+		RenderGraph::PassBuilder opaqueLate = renderGraph->addPass("opaque late", drawLate);
+		opaqueLate.writeColor(sceneColor, AttachmentLoad::Load)
+		    .writeDepth(depth, AttachmentLoad::Load)
+		    .read(drawCommands, RenderGraphAccess::IndirectRead);
+		for (uint32_t c = 0; shadowCascades && c < shadowCascades->getCascadeCount(); c++) {
+			opaqueLate.read(shadowMaps[c], RenderGraphAccess::FragmentSampled);
+		}
+		if (clusteredLighting) {
+			opaqueLate.read(lightClusters, RenderGraphAccess::FragmentStorageRead);
+		}
+	}
+
+	// Partículas: simulação em compute e quads por cima do opaco (depth só testado, sem escrita)
+	if (particleSystem) {
+		RenderGraphResource particles = renderGraph->importBuffer("particles",
+		                                                          particleSystem->getParticleBuffer(),
+		                                                          VK_PIPELINE_STAGE_VERTEX_SHADER_BIT,        // Desenhadas no frame anterior
+		                                                          0);
+		RenderGraphResource drawList  = renderGraph->importBuffer("particle draw list",
+		                                                          particleSystem->getDrawListBuffer(),
+		                                                          VK_PIPELINE_STAGE_VERTEX_SHADER_BIT,
+		                                                          0);
+		RenderGraphResource drawArgs  = renderGraph->importBuffer("particle args", particleSystem->getArgsBuffer(), VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT, 0);
+
+		auto simulate = [this](VkCommandBuffer cmd) {
+			particleSystem->recordSimulation(cmd);
+			frameStats.current().pipelineBinds++;
+			frameStats.current().descriptorBinds++;
+		};
+		renderGraph->addPass("particle simulation", simulate)
+		    .write(particles, RenderGraphAccess::ComputeStorageWrite)
+		    .write(drawList, RenderGraphAccess::ComputeStorageWrite)
+		    .write(drawArgs, RenderGraphAccess::ComputeStorageWrite)
+		    .setSideEffect();
+
+		auto drawParticles = [this, renderExtent](VkCommandBuffer cmd) {
+			particleSystem->recordDraw(cmd, renderExtent);
+			FrameStats &stats = frameStats.current();
+			stats.drawCalls++;
+			stats.pipelineBinds++;
+			stats.descriptorBinds++;
+		};
+		renderGraph->addPass("particles", drawParticles)
+		    .writeColor(sceneColor, AttachmentLoad::Load)
+		    .readDepth(depth)
+		    .read(particles, RenderGraphAccess::VertexStorageRead)
+		    .read(drawList, RenderGraphAccess::VertexStorageRead)
+		    .read(drawArgs, RenderGraphAccess::IndirectRead);
+	}
+
+	if (dynamicResolution) {
+		auto upscale = [this, sceneColor, backbuffer, renderExtent, extent](VkCommandBuffer cmd) {
+			VkImageBlit region{};
+			region.srcSubresource = {VK_IMAGE_ASPECT_COLOR_BIT, 0, 0, 1};
+			region.srcOffsets[1]  = {static_cast<int32_t>(renderExtent.width), static_cast<int32_t>(renderExtent.height), 1};
+			region.dstSubresource = {VK_IMAGE_ASPECT_COLOR_BIT, 0, 0, 1};
+			region.dstOffsets[1]  = {static_cast<int32_t>(extent.width), static_cast<int32_t>(extent.height), 1};
+			vkCmdBlitImage(cmd, renderGraph->getImage(sceneColor), VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, renderGraph->getImage(backbuffer),
+			               VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &region, VK_FILTER_LINEAR);
+		};
+		renderGraph->addPass("upscale", upscale)
+		    .read(sceneColor, RenderGraphAccess::TransferRead)
+		    .write(backbuffer, RenderGraphAccess::TransferWrite);
+		frameStats.current().renderScale = dynamicResolution->getScale();
+	}
+
+	// O overlay fica na resolução da saída
+	if (overlay && overlay->isVisible()) {
+		renderGraph->addPass("overlay", [this](VkCommandBuffer cmd) { overlay->record(cmd); })
+		    .writeColor(backbuffer, AttachmentLoad::Load);
+	}
+
+	// Imagens transientes trocadas (resize) só são destruídas quando os frames já enviados terminarem
+	renderGraph->compile(frameScheduler->getSubmittedValue());
+	renderGraph->execute(commandBuffer);
+}
+
+void VulkanManager::recordMainPass(VkCommandBuffer commandBuffer, uint32_t imageIndex) {
+	PROFILE_GPU_SCOPE(commandBuffer, "opaque");
+
+	// Fallback sem dynamic rendering: render pass fixo, sem depth nem sombras
+	VkClearValue clearColor = {{{0.2f, 0.2f, 0.2f, 1.0f}}};
 
 	VkRenderPassBeginInfo renderPassInfo{};
 	renderPassInfo.sType             = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO;
@@ -227,55 +1088,231 @@ void VulkanManager::recordCommandBuffer(VkCommandBuffer commandBuffer, uint32_t
 	renderPassInfo.framebuffer       = swapchainManager->getFramebuffers()[imageIndex];
 	renderPassInfo.renderArea.offset = {0, 0};
 	renderPassInfo.renderArea.extent = swapchainManager->getSwapchainExtent();
-
-	VkClearValue clearColor        = {{{0.2f, 0.2f, 0.2f, 1.0f}}};
-	renderPassInfo.clearValueCount = 1;
-	renderPassInfo.pClearValues    = &clearColor;
+	renderPassInfo.clearValueCount   = 1;
+	renderPassInfo.pClearValues      = &clearColor;
 
 	vkCmdBeginRenderPass(commandBuffer, &renderPassInfo, VK_SUBPASS_CONTENTS_INLINE);
+	recordScene(commandBuffer);
+
+	// O overlay entra no fim do render pass principal (mesmo framebuffer)
+	if (overlay && overlay->isVisible()) {
+		overlay->record(commandBuffer);
+	}
+	vkCmdEndRenderPass(commandBuffer);
+}
+
+void VulkanManager::updateSceneData() {
+	PROFILE_CPU_ZONE("updateSceneData");
+	FrameStats &stats = frameStats.current();
+
+	// --- CÁLCULO DE TEMPO ---
+	// Tempo simulado: avança pelo relógio no modo interativo e em passo fixo no headless/benchmark
+	float time = static_cast<float>(simulationTime);
+
+	// Matrizes fixas (Câmera e Projeção)
+	const float fovY      = glm::radians(45.0f);
+	const float nearPlane = 0.1f;
+	float       aspect    = getOutputExtent().width / (float) getOutputExtent().height;
+	glm::mat4   view      = glm::lookAt(cameraEye, glm::vec3(0.0f, 0.0f, 0.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+	glm::mat4   proj      = glm::perspective(fovY, aspect, nearPlane, cameraFar);
+	proj[1][1] *= -1;        // Correção do Y invertido do Vulkan
+	frameViewProj = proj * view;
+
+	// Dados por objeto do frame montados na arena do frame (sem malloc por frame).
+	// Estáticos mantêm a model; carros giram em torno do próprio eixo.
+	ArenaVector<GpuObjectData> objects = frameArenas->makeVector<GpuObjectData>(sceneObjects.size());
+	for (const SceneObject &object : sceneObjects) {
+		glm::mat4 model = object.dynamic ? glm::rotate(object.transform, time * glm::radians(90.0f), glm::vec3(0.0f, 1.0f, 0.0f))
+		                                 : object.transform;
+		objects.push_back({.model = model, .textureIndex = textureManager->getBindlessIndex(object.texture), .pad = {}});
+	}
+	bufferManager->updateBuffer(objectBuffers[currentFrame], objects.data(), objects.size() * sizeof(GpuObjectData));
+	stats.uploadedBytes += objects.size() * sizeof(GpuObjectData);
+
+	// Esfera envolvente no mundo de cada draw, na ordem dos comandos indiretos
+	if (occlusionCuller) {
+		ArenaVector<GpuCullObject> cullObjects = frameArenas->makeVector<GpuCullObject>(drawOrder.size());
+		for (uint32_t objectIndex : drawOrder) {
+			const Mesh      &mesh   = *sceneObjects[objectIndex].mesh;
+			const glm::mat4 &model  = objects[objectIndex].model;
+			glm::vec3        center = glm::vec3(model * glm::vec4((mesh.getBoundsMin() + mesh.getBoundsMax()) * 0.5f, 1.0f));
+			float            scale  = std::max({glm::length(glm::vec3(model[0])), glm::length(glm::vec3(model[1])), glm::length(glm::vec3(model[2]))});
+			float            radius = glm::length(mesh.getBoundsMax() - mesh.getBoundsMin()) * 0.5f * scale;
+			cullObjects.push_back({.sphere = glm::vec4(center, radius), .objectIndex = objectIndex, .indexCount = mesh.getIndexCount(), .pad = {}});
+		}
+		occlusionCuller->update(frameViewProj, getRenderExtent(), cullObjects.data(), cullObjects.size(), frameScheduler->getSubmittedValue());
+		stats.uploadedBytes += cullObjects.size() * sizeof(GpuCullObject);
+	}
+
+	// Luz e sombras do frame
+	GpuSceneData scene{};
+	scene.view           = view;
+	scene.lightDirection = glm::vec4(lightDirection, sunIntensity);
+	scene.lightColor     = glm::vec4(1.0f, 0.97f, 0.92f, ambientLight);
+	if (shadowCascades) {
+		shadowCascades->update(view, fovY, aspect, nearPlane, cameraFar, lightDirection, sceneRadius);
+		shadowCascades->writeSceneData(scene);
+		stats.shadowCascadesRendered = shadowCascades->getStats().renderedCascades;
+		stats.shadowCascadesCached   = shadowCascades->getStats().cachedCascades;
+	}
+
+	// Luzes pontuais do frame; a distribuição nos clusters acontece na GPU (pass "light clusters" ou fila de compute)
+	if (clusteredLighting) {
+		ArenaVector<GpuPointLight> lights = frameArenas->makeVector<GpuPointLight>(sceneLights.size());
+		for (const SceneLight &light : sceneLights) {
+			glm::vec3 offset = glm::vec3(glm::rotate(glm::mat4(1.0f), time * light.angularSpeed, glm::vec3(0.0f, 1.0f, 0.0f)) * glm::vec4(light.offset, 0.0f));
+			lights.push_back({glm::vec4(light.pivot + offset, light.radius), glm::vec4(light.color, light.intensity)});
+		}
+		clusteredLighting->update(currentFrame, view, fovY, aspect, nearPlane, cameraFar, getRenderExtent(), lights.data(), lights.size());
+		clusteredLighting->writeSceneData(scene);
+		stats.pointLights = clusteredLighting->getLightCount();
+		stats.uploadedBytes += stats.pointLights * sizeof(GpuPointLight);
+	}
+
+	// Emissores de cada carro (rodando em torno do próprio eixo): fumaça nas rodas traseiras, poeira
+	// nas dianteiras e faíscas no fundo do carro. Só os emissores são enviados; as partículas vivem na GPU.
+	if (particleSystem) {
+		const float angularSpeed = glm::radians(90.0f);
+		glm::mat4   spin         = glm::rotate(glm::mat4(1.0f), time * angularSpeed, glm::vec3(0.0f, 1.0f, 0.0f));
+
+		// Rodas nos cantos da AABB local, com o comprimento no maior eixo horizontal
+		bool      alongZ = carBoundsMax.z - carBoundsMin.z >= carBoundsMax.x - carBoundsMin.x;
+		glm::vec3 center = (carBoundsMin + carBoundsMax) * 0.5f;
+		glm::vec3 half   = (carBoundsMax - carBoundsMin) * 0.5f;
+		glm::vec3 axle   = alongZ ? glm::vec3(0.0f, 0.0f, half.z * 0.65f) : glm::vec3(half.x * 0.65f, 0.0f, 0.0f);
+		glm::vec3 track  = alongZ ? glm::vec3(half.x * 0.8f, 0.0f, 0.0f) : glm::vec3(0.0f, 0.0f, half.z * 0.8f);
+		glm::vec3 base   = glm::vec3(center.x, groundHeight + 0.03f, center.z);
+
+		struct EmitterSlot {
+			ParticleType type;
+			glm::vec3    point;
+			float        inherit;        // Fração da velocidade do ponto no giro
+			float        lift;
+		};
+		const std::array<EmitterSlot, 4> slots = {{{ParticleType::TireSmoke, base - axle - track, 0.3f, 0.0f},
+		                                           {ParticleType::TireSmoke, base - axle + track, 0.3f, 0.0f},
+		                                           {ParticleType::Dust, base + axle - track, 0.5f, 0.0f},
+		                                           {ParticleType::Sparks, base - axle * 0.5f, 1.5f, 1.2f}}};
+
+		ArenaVector<ParticleEmitter> emitters = frameArenas->makeVector<ParticleEmitter>(carInstances.size() * slots.size());
+		for (const glm::vec3 &position : carInstances) {
+			for (const EmitterSlot &slot : slots) {
+				// Velocidade do ponto no giro (w x r) joga as partículas para fora da curva
+				glm::vec3       offset  = glm::vec3(spin * glm::vec4(slot.point, 0.0f));
+				ParticleEmitter emitter = ParticleEmitter::preset(slot.type);
+				emitter.position        = position + offset;
+				emitter.velocity        = glm::vec3(angularSpeed * offset.z, slot.lift, -angularSpeed * offset.x) * glm::vec3(slot.inherit, 1.0f, slot.inherit);
+				emitters.push_back(emitter);
+			}
+		}
+		particleSystem->update(time, view, frameViewProj, groundHeight, emitters.data(), emitters.size());
+		stats.uploadedBytes += emitters.size() * sizeof(GpuParticleEmitter);
+	}
+	bufferManager->updateBuffer(sceneBuffers[currentFrame], &scene, sizeof(GpuSceneData));
+	stats.uploadedBytes += sizeof(GpuSceneData);
+}
+
+void VulkanManager::drawObjects(VkCommandBuffer commandBuffer, size_t count) {
+	FrameStats &stats = frameStats.current();
+
+	for (size_t i = 0; i < count; i++) {
+		const Mesh &mesh = *sceneObjects[i].mesh;
+		mesh.bind(commandBuffer);
+		mesh.draw(commandBuffer, static_cast<uint32_t>(i));
+
+		// Mesh::bind liga vértices e índices; cada draw é uma instância
+		stats.vertexBufferBinds++;
+		stats.indexBufferBinds++;
+		stats.drawCalls++;
+		stats.instances++;
+		stats.triangles += mesh.getIndexCount() / 3;
+	}
+}
+
+void VulkanManager::drawCulled(VkCommandBuffer commandBuffer, OcclusionCuller::Phase phase) {
+	FrameStats &stats  = frameStats.current();
+	VkBuffer    buffer = occlusionCuller->getDrawBuffer();
+	uint32_t    stride = sizeof(VkDrawIndexedIndirectCommand);
+
+	// Um lote por mesh; instances e triângulos vêm dos contadores da GPU (beginFrame)
+	for (const DrawBatch &batch : drawBatches) {
+		batch.mesh->bind(commandBuffer);
+		stats.vertexBufferBinds++;
+		stats.indexBufferBinds++;
+
+		if (multiDrawIndirectEnabled) {
+			vkCmdDrawIndexedIndirect(commandBuffer, buffer, occlusionCuller->getDrawOffset(phase, batch.firstDraw), batch.drawCount, stride);
+			stats.drawCalls++;
+			continue;
+		}
+		for (uint32_t i = 0; i < batch.drawCount; i++) {
+			vkCmdDrawIndexedIndirect(commandBuffer, buffer, occlusionCuller->getDrawOffset(phase, batch.firstDraw + i), 1, stride);
+		}
+		stats.drawCalls += batch.drawCount;
+	}
+}
+
+void VulkanManager::recordShadowCascade(VkCommandBuffer commandBuffer, uint32_t cascade) {
+	FrameStats                    &stats = frameStats.current();
+	const ShadowCascades::Cascade &data  = shadowCascades->getCascade(cascade);
+	float                          size  = static_cast<float>(shadowCascades->getResolution());
+
+	vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, shadowPipeline);
+	stats.pipelineBinds++;
+
+	VkViewport viewport{0.0f, 0.0f, size, size, 0.0f, 1.0f};
+	VkRect2D   scissor{{0, 0}, {shadowCascades->getResolution(), shadowCascades->getResolution()}};
+	vkCmdSetViewport(commandBuffer, 0, 1, &viewport);
+	vkCmdSetScissor(commandBuffer, 0, 1, &scissor);
+
+	bindlessDescriptors->bind(commandBuffer, shadowPipelineLayout);
+	MeshPushConstants constants{.viewProj          = data.viewProj,
+	                            .objectBufferIndex = objectBufferIndices[currentFrame],
+	                            .sceneBufferIndex  = sceneBufferIndices[currentFrame]};
+	vkCmdPushConstants(commandBuffer, shadowPipelineLayout, VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT, 0, sizeof(MeshPushConstants), &constants);
+	stats.descriptorBinds++;
+	stats.pushConstantBytes += sizeof(MeshPushConstants);
+
+	// Cascatas em cache só guardam o que não se mexe
+	drawObjects(commandBuffer, data.dynamic ? sceneObjects.size() : staticObjectCount);
+}
+
+void VulkanManager::recordScene(VkCommandBuffer commandBuffer, std::optional<OcclusionCuller::Phase> phase) {
+	FrameStats &stats = frameStats.current();
 
 	// Bind Pipeline
 	vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, graphicsPipeline);
+	stats.pipelineBinds++;
 
 	// Configurar viewport e scissor (dinâmicos)
 	VkViewport viewport{};
 	viewport.x        = 0.0f;
 	viewport.y        = 0.0f;
-	viewport.width    = static_cast<float>(swapchainManager->getSwapchainExtent().width);
-	viewport.height   = static_cast<float>(swapchainManager->getSwapchainExtent().height);
+	viewport.width    = static_cast<float>(getRenderExtent().width);
+	viewport.height   = static_cast<float>(getRenderExtent().height);
 	viewport.minDepth = 0.0f;
 	viewport.maxDepth = 1.0f;
 	vkCmdSetViewport(commandBuffer, 0, 1, &viewport);
 
 	VkRect2D scissor{};
 	scissor.offset = {0, 0};
-	scissor.extent = swapchainManager->getSwapchainExtent();
+	scissor.extent = getRenderExtent();
 	vkCmdSetScissor(commandBuffer, 0, 1, &scissor);
 
-	// --- CÁLCULO DE TEMPO ---
-	static auto startTime   = std::chrono::high_resolution_clock::now();
-	auto        currentTime = std::chrono::high_resolution_clock::now();
-	float       time        = std::chrono::duration<float, std::chrono::seconds::period>(currentTime - startTime).count();
-
-	// Matrizes fixas (Câmera e Projeção)
-	glm::mat4 view = glm::lookAt(glm::vec3(0.0f, 2.0f, 4.0f), glm::vec3(0.0f, 0.0f, 0.0f), glm::vec3(0.0f, 1.0f, 0.0f));
-	glm::mat4 proj = glm::perspective(glm::radians(45.0f), swapchainManager->getSwapchainExtent().width / (float) swapchainManager->getSwapchainExtent().height, 0.1f, 10.0f);
-	proj[1][1] *= -1;        // Correção do Y invertido do Vulkan
-
-	MeshPushConstants constants;
-
-	if (!carMeshes.empty()) {
-		for (auto &mesh : carMeshes) {
-			mesh.bind(commandBuffer);
-			glm::mat4 model = glm::translate(glm::mat4(1.0f), glm::vec3(0.8f, 0.0f, 0.0f));
-			model           = glm::rotate(model, time * glm::radians(90.0f), glm::vec3(0.0f, 1.0f, 0.0f));
-			model = glm::scale(model, glm::vec3(0.01f));
-
-			constants.render_matrix = proj * view * model;
-
-			vkCmdPushConstants(commandBuffer, graphicsPipelineLayout, VK_SHADER_STAGE_VERTEX_BIT, 0, sizeof(MeshPushConstants), &constants);
-			mesh.draw(commandBuffer);
-		}
+	// Estado da passada inteira: um bind de set e um push constant; nada muda por draw além da geometria
+	bindlessDescriptors->bind(commandBuffer, graphicsPipelineLayout);
+	MeshPushConstants constants{.viewProj          = frameViewProj,
+	                            .objectBufferIndex = objectBufferIndices[currentFrame],
+	                            .sceneBufferIndex  = sceneBufferIndices[currentFrame]};
+	vkCmdPushConstants(commandBuffer, graphicsPipelineLayout, VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT, 0, sizeof(MeshPushConstants), &constants);
+	stats.descriptorBinds++;
+	stats.pushConstantBytes += sizeof(MeshPushConstants);
+
+	if (phase) {
+		drawCulled(commandBuffer, *phase);
+	}
+	else {
+		drawObjects(commandBuffer, sceneObjects.size());
 	}
 	// --- DESENHAR O CUBO (À DIREITA) ---
 	// if (cubeMesh) {
@@ -302,62 +1339,122 @@ void VulkanManager::recordCommandBuffer(VkCommandBuffer commandBuffer, uint32_t
 	// 	vkCmdPushConstants(commandBuffer, graphicsPipelineLayout, VK_SHADER_STAGE_VERTEX_BIT, 0, sizeof(MeshPushConstants), &constants);
 	// 	triangleMesh->draw(commandBuffer);
 	// }
-
-	vkCmdEndRenderPass(commandBuffer);
-
-	if (vkEndCommandBuffer(commandBuffer) != VK_SUCCESS) {
-		throw std::runtime_error("[VulkanManager] : Failed to record command buffer!");
-	}
 }
 
 void VulkanManager::createCommandPool() {
 	commandManager = std::make_unique<CommandManager>(device, queueManager);
 	commandManager->createCommandPool();
-	std::cout << "[VulkanManager] : Command pool setup complete." << std::endl;
+	LOG_INFO("VulkanManager", "Command pool setup complete.");
 }
 
 void VulkanManager::createCommandBuffers() {
 	commandBuffers.resize(MAX_FRAMES_IN_FLIGHT);
 	commandBuffers = commandManager->allocateCommandBuffers(MAX_FRAMES_IN_FLIGHT);
-	std::cout << "[VulkanManager] : Command buffers created." << std::endl;
+	LOG_INFO("VulkanManager", "Command buffers created.");
 	// NÃO gravar aqui - será feito no drawFrame()
 }
 
 void VulkanManager::createFramebuffers() {
+	// Com dynamic rendering não existe framebuffer: as image views do swapchain vão direto no vkCmdBeginRendering
+	if (dynamicRenderingEnabled) {
+		return;
+	}
 	swapchainManager->createFramebuffers(renderPass);
-	std::cout << "[VulkanManager] : Framebuffers created." << std::endl;
+	LOG_INFO("VulkanManager", "Framebuffers created.");
 }
 
 void VulkanManager::createGraphicsPipeline() {
 	PipelineConfig pipelineConfig{};
-	pipelineConfig.extend     = swapchainManager->getSwapchainExtent();
-	renderPass                = RenderPassManager::createBasicRenderPass(device, swapchainManager->getSwapchainImageFormat());
-	pipelineConfig.renderPass = renderPass;
-	std::cout << "[VulkanManager] : RenderPass created." << std::endl;
+	pipelineConfig.extend     = options.headless ? requestedExtent : swapchainManager->getSwapchainExtent();
+	if (dynamicRenderingEnabled) {
+		// Mesmos formatos do pass "opaque" do render graph: backbuffer + depth transiente
+		depthFormat                           = OffscreenTarget::chooseDepthFormat(physicalDevice);
+		pipelineConfig.colorAttachmentFormats = {options.headless ? OffscreenTarget::COLOR_FORMAT : swapchainManager->getSwapchainImageFormat()};
+		pipelineConfig.depthAttachmentFormat  = depthFormat;
+	}
+	else {
+		renderPass                = RenderPassManager::createBasicRenderPass(device, swapchainManager->getSwapchainImageFormat());
+		pipelineConfig.renderPass = renderPass;
+	}
+	pipelineConfig.setLayouts = {bindlessDescriptors->getLayout()};
+	LOG_INFO("VulkanManager", "RenderPass created.");
 
 	std::tie(graphicsPipeline, graphicsPipelineLayout) = PipelineManager::createGraphicsPipeline(device, pipelineConfig);
-	std::cout << "[VulkanManager] : Graphics pipeline created." << std::endl;
+	LOG_INFO("VulkanManager", "Graphics pipeline created.");
 }
 
 void VulkanManager::createLogicalDevice() {
+	// Extensões obrigatórias (deviceExtensions do SwapchainManager.hpp) + opcionais detectadas no device.
+	// Headless não apresenta nada, então nem o swapchain é pedido.
+	std::vector<const char *> enabledExtensions;
+	if (!options.headless) {
+		enabledExtensions = deviceExtensions;
+	}
+
+	memoryBudgetEnabled = VulkanTools::isDeviceExtensionSupported(physicalDevice, VK_EXT_MEMORY_BUDGET_EXTENSION_NAME);
+	if (memoryBudgetEnabled) {
+		enabledExtensions.push_back(VK_EXT_MEMORY_BUDGET_EXTENSION_NAME);
+	}
+
+	// Descriptor indexing (1.2) para o set bindless; o suporte já foi checado na escolha do device
+	VkPhysicalDeviceVulkan12Features vulkan12Features{};
+	vulkan12Features.sType                                         = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_FEATURES;
+	vulkan12Features.descriptorIndexing                            = VK_TRUE;
+	vulkan12Features.runtimeDescriptorArray                        = VK_TRUE;
+	vulkan12Features.descriptorBindingPartiallyBound               = VK_TRUE;
+	vulkan12Features.descriptorBindingSampledImageUpdateAfterBind  = VK_TRUE;
+	vulkan12Features.descriptorBindingStorageBufferUpdateAfterBind = VK_TRUE;
+	vulkan12Features.descriptorBindingUpdateUnusedWhilePending     = VK_TRUE;
+	vulkan12Features.shaderSampledImageArrayNonUniformIndexing     = VK_TRUE;
+	vulkan12Features.timelineSemaphore                             = VK_TRUE;        // FrameScheduler
+
+	// Dynamic rendering (1.3) é opcional: sem ele, render pass + framebuffers
+	dynamicRenderingEnabled = options.dynamicRendering && RenderPassManager::isDynamicRenderingSupported(physicalDevice);
+	if (options.headless && !dynamicRenderingEnabled) {
+		throw std::runtime_error("[VulkanManager] : Headless mode requires dynamic rendering (Vulkan 1.3)!");
+	}
+
+	VkPhysicalDeviceVulkan13Features vulkan13Features{};
+	vulkan13Features.sType            = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_3_FEATURES;
+	vulkan13Features.dynamicRendering = VK_TRUE;
+	if (dynamicRenderingEnabled) {
+		vulkan12Features.pNext = &vulkan13Features;
+	}
+	LOG_INFO("VulkanManager", "Main pass uses {}", dynamicRenderingEnabled ? "dynamic rendering." : "a classic render pass.");
+
+	// Features opcionais: só liga o que o device tiver
+	VkPhysicalDeviceFeatures supportedFeatures{};
+	vkGetPhysicalDeviceFeatures(physicalDevice, &supportedFeatures);
+
+	VkPhysicalDeviceFeatures enabledFeatures{};
+	enabledFeatures.textureCompressionBC = supportedFeatures.textureCompressionBC;
+	textureCompressionBCEnabled          = supportedFeatures.textureCompressionBC == VK_TRUE;
+
+	// Draws indiretos do occlusion culling: firstInstance é o índice do objeto; multi-draw junta os de uma mesh
+	enabledFeatures.drawIndirectFirstInstance = supportedFeatures.drawIndirectFirstInstance;
+	enabledFeatures.multiDrawIndirect         = supportedFeatures.multiDrawIndirect;
+	firstInstanceIndirectEnabled              = supportedFeatures.drawIndirectFirstInstance == VK_TRUE;
+	multiDrawIndirectEnabled                  = supportedFeatures.multiDrawIndirect == VK_TRUE;
+
 	// A fábrica retorna o dispositivo lógico juntamente com as filas configuradas.
 	std::tie(device, queues) = LogicalDeviceCreator::create(
-	    physicalDevice, queueManager, VulkanTools::enableValidationLayers, VulkanTools::validationLayers, deviceExtensions);        // Using deviceExtensions from SwapchainManager.hpp
-	std::cout << "[VulkanManager] : Logical device created." << std::endl;
+	    physicalDevice, queueManager, VulkanTools::enableValidationLayers, VulkanTools::validationLayers, enabledExtensions, enabledFeatures, &vulkan12Features);
+	LOG_INFO("VulkanManager", "Logical device created.");
 }
 
 void VulkanManager::setupSwapChain() {
 	// Cria o swapchain apenas após garantir que instância, dispositivo e superfícies estão prontos.
 	swapchainManager = std::make_unique<SwapchainManager>(
-	    device, physicalDevice, surface, *window.getWindow(), queueManager);
-	swapchainManager->createSwapchain(window.getWidth(), window.getHeight());
+	    device, physicalDevice, surface, *window->getWindow(), queueManager);
+	swapchainManager->setPresentPolicy(presentPolicy);
+	swapchainManager->createSwapchain(window->getWidth(), window->getHeight());
 	swapchainManager->createImageViews();
-	std::cout << "[VulkanManager] : Swapchain setup complete." << std::endl;
+	LOG_INFO("VulkanManager", "Swapchain setup complete.");
 }
 
 void VulkanManager::pickPhysicalDevice() {
 	physicalDevice = PhysicalDeviceSelector::select(instance, surface, queueManager);
-	std::cout << "[VulkanManager] : Physical device selected." << std::endl;
+	LOG_INFO("VulkanManager", "Physical device selected.");
 }
 
 void VulkanManager::createInstance() {
@@ -365,7 +1462,7 @@ void VulkanManager::createInstance() {
 
 	// Check validation layer support and disable if not available
 	if (useValidationLayers && !VulkanTools::checkValidationLayerSupport()) {
-		std::cerr << "[VulkanManager] : Validation layers requested but NOT available on this system. Proceeding without them." << std::endl;
+		LOG_WARN("VulkanManager", "Validation layers requested but NOT available on this system. Proceeding without them.");
 		useValidationLayers = false;
 	}
 
@@ -375,14 +1472,14 @@ void VulkanManager::createInstance() {
 	appInfo.applicationVersion = VK_MAKE_VERSION(1, 0, 0);
 	appInfo.pEngineName        = "No Engine";
 	appInfo.engineVersion      = VK_MAKE_VERSION(1, 0, 0);
-	appInfo.apiVersion         = VK_API_VERSION_1_0;
+	appInfo.apiVersion         = VulkanTools::apiVersion;
 
 	VkInstanceCreateInfo createInfo{};
 	createInfo.sType            = VK_STRUCTURE_TYPE_INSTANCE_CREATE_INFO;
 	createInfo.pApplicationInfo = &appInfo;
 
 	// Use VulkanTools::getRequiredExtensions() to get all required extensions
-	auto extensions                    = VulkanTools::getRequiredExtensions();
+	auto extensions                    = VulkanTools::getRequiredExtensions(!options.headless);
 	createInfo.enabledExtensionCount   = static_cast<uint32_t>(extensions.size());
 	createInfo.ppEnabledExtensionNames = extensions.data();
 
@@ -403,40 +1500,107 @@ void VulkanManager::createInstance() {
 	if (vkCreateInstance(&createInfo, nullptr, &instance) != VK_SUCCESS) {
 		throw std::runtime_error("[VulkanManager] : Failed to create Vulkan instance");
 	}
-	std::cout << "[VulkanManager] : Vulkan instance created." << std::endl;
+	LOG_INFO("VulkanManager", "Vulkan instance created.");
 }
 
 void VulkanManager::setupDebugMessenger() {
 	if (VulkanTools::enableValidationLayers) {
 		VulkanTools::setupDebugMessenger(instance, debugMessenger);
-		std::cout << "[VulkanManager] : Debug messenger setup." << std::endl;
+		LOG_INFO("VulkanManager", "Debug messenger setup.");
 	}
 	else {
-		std::cout << "[VulkanManager] : Validation layers disabled, skipping debug messenger setup" << std::endl;
+		LOG_INFO("VulkanManager", "Validation layers disabled, skipping debug messenger setup");
 	}
 }
 
 void VulkanManager::mainLoop() {
-	std::cout << "[VulkanManager] : Entering main loop..." << std::endl;
-	while (!window.shouldClose()) {
-		window.pollEvents();
+	if (options.headless || options.benchmark) {
+		runFixedFrames();
+		return;
+	}
+
+	LOG_INFO("VulkanManager", "Entering main loop...");
+	auto lastTime = std::chrono::steady_clock::now();
+	while (!window->shouldClose()) {
+		// Espera a GPU antes de ler o input: no modo LowLatency o input fica o mais novo possível
+		currentFrame = frameScheduler->waitForFrame();
+		// A escala da resolução dinâmica reage ao tempo de GPU do último frame deste slot
+		if (gpuProfiler && gpuProfiler->collect(currentFrame) && dynamicResolution) {
+			dynamicResolution->addGpuTime(gpuProfiler->getLastFrame().totalMs);
+		}
+		window->pollEvents();
+		if (overlay) {
+			overlay->handleInput();
+		}
 		drawFrame();
 		// Add rendering logic here
+
+		auto   now       = std::chrono::steady_clock::now();
+		double frameTime = std::chrono::duration<double>(now - lastTime).count();
+		simulationTime += frameTime;
+		lastTime = now;
+
+		if (overlay) {
+			overlay->addFrameSample(static_cast<float>(frameTime * 1000.0),
+			                        gpuProfiler ? static_cast<float>(gpuProfiler->getLastFrame().totalMs) : 0.0f);
+		}
 	}
-	std::cout << "[VulkanManager] : Exiting main loop." << std::endl;
+	LOG_INFO("VulkanManager", "Exiting main loop.");
 }
 
 void VulkanManager::cleanup() {
-	std::cout << "[VulkanManager] : Starting cleanup..." << std::endl;
+	LOG_INFO("VulkanManager", "Starting cleanup...");
 
 	if (device != VK_NULL_HANDLE) {
 		vkDeviceWaitIdle(device);
 	}
 
+	// Imagens transientes do render graph vão para a deletion queue
+	renderGraph.reset();
+
+	// GPU parada: swapchains aposentados podem ir embora (antes do surface)
+	deletionQueue.flushAll();
+
+	// Pipeline e pool de descritores do ImGui
+	overlay.reset();
+
 	// cubeMesh.reset();
 	// triangleMesh.reset();
 
-	// Tem que limpar o Car Meshes?
+	// Fecha qualquer passada de desfragmentação pendente antes de destruir os buffers
+	defragmenter.reset();
+
+	// Junta os workers e libera imagens/staging antes do ResourceManager
+	textureManager.reset();
+	offscreenTarget.reset();
+	shadowCascades.reset();
+	clusteredLighting.reset();
+	occlusionCuller.reset();
+	particleSystem.reset();
+	gpuProfiler.reset();
+	asyncCompute.reset();
+
+	for (BufferHandle &buffer : objectBuffers) {
+		bufferManager->destroyBuffer(buffer);
+	}
+	for (BufferHandle &buffer : sceneBuffers) {
+		bufferManager->destroyBuffer(buffer);
+	}
+	objectBuffers.clear();
+	objectBufferIndices.clear();
+	sceneBuffers.clear();
+	sceneBufferIndices.clear();
+
+	// Geometria antes do BufferManager (o destrutor da Mesh devolve os buffers para ele)
+	sceneObjects.clear();
+	carMeshes.clear();
+	propMeshes.clear();
+
+	// Todos os recursos do renderer já foram devolvidos: liveCount != 0 no relatório indica leak
+	if (!options.memoryReportPath.empty()) {
+		dumpMemoryReport(options.memoryReportPath);
+	}
+	memoryMonitor.reset();
 
 	bufferManager.reset();
 	resourceManager.reset();
@@ -445,62 +1609,70 @@ void VulkanManager::cleanup() {
 	vmaWrapper.destroy();
 
 	// Apenas destruir objetos de sincronização se eles foram criados
-	if (device != VK_NULL_HANDLE && !renderFinishedSemaphores.empty()) {
-		for (size_t i = 0; i < MAX_FRAMES_IN_FLIGHT; i++) {
-			if (renderFinishedSemaphores[i] != VK_NULL_HANDLE)
-				vkDestroySemaphore(device, renderFinishedSemaphores[i], nullptr);
-			if (imageAvailableSemaphores[i] != VK_NULL_HANDLE)
-				vkDestroySemaphore(device, imageAvailableSemaphores[i], nullptr);
-			if (inFlightFences[i] != VK_NULL_HANDLE)
-				vkDestroyFence(device, inFlightFences[i], nullptr);
-		}
-		std::cout << "[VulkanManager] : Synchronization objects destroyed." << std::endl;
+	if (frameScheduler) {
+		frameScheduler.reset();
+		LOG_INFO("VulkanManager", "Synchronization objects destroyed.");
 	}
 
+	// Pools e layouts por último: pipelines e o set bindless ainda referenciam os layouts
+	frameDescriptors.reset();
+	bindlessDescriptors.reset();
+	descriptorLayoutCache.reset();
+
 	// Command manager limpa automaticamente o pool e buffers
 	commandManager.reset();
-	std::cout << "[VulkanManager] : Command manager destroyed." << std::endl;
+	LOG_INFO("VulkanManager", "Command manager destroyed.");
 
 	// Desaloca em ordem inversa de criação para evitar o uso de recursos já destruídos.
 	if (device != VK_NULL_HANDLE && (graphicsPipeline != VK_NULL_HANDLE || graphicsPipelineLayout != VK_NULL_HANDLE)) {
 		PipelineManager::destroy(device, graphicsPipeline, graphicsPipelineLayout);
 	}
+	if (device != VK_NULL_HANDLE && shadowPipeline != VK_NULL_HANDLE) {
+		PipelineManager::destroy(device, shadowPipeline, shadowPipelineLayout);
+	}
 
 	// O Swapchain e seus framebuffers dependem do RenderPass, então devem ser destruídos antes.
 	swapchainManager.reset();
-	std::cout << "[VulkanManager] : Swapchain manager destroyed." << std::endl;
+	LOG_INFO("VulkanManager", "Swapchain manager destroyed.");
 
 	if (device != VK_NULL_HANDLE && renderPass != VK_NULL_HANDLE) {
 		RenderPassManager::destroy(device, renderPass);
-		std::cout << "[VulkanManager] : Render pass destroyed." << std::endl;
+		LOG_INFO("VulkanManager", "Render pass destroyed.");
 	}
 	if (device != VK_NULL_HANDLE) {
 		vkDestroyDevice(device, nullptr);
-		std::cout << "[VulkanManager] : Logical device destroyed." << std::endl;
+		LOG_INFO("VulkanManager", "Logical device destroyed.");
 		device = VK_NULL_HANDLE;
 	}
 	if (instance != VK_NULL_HANDLE) {
 		if (surface != VK_NULL_HANDLE) {
 			vkDestroySurfaceKHR(instance, surface, nullptr);
-			std::cout << "[VulkanManager] : Surface destroyed." << std::endl;
+			LOG_INFO("VulkanManager", "Surface destroyed.");
 			surface = VK_NULL_HANDLE;
 		}
 		if (VulkanTools::enableValidationLayers && debugMessenger != VK_NULL_HANDLE) {
 			VulkanTools::DestroyDebugUtilsMessengerEXT(instance, debugMessenger, nullptr);
-			std::cout << "[VulkanManager] : Debug messenger destroyed." << std::endl;
+			LOG_INFO("VulkanManager", "Debug messenger destroyed.");
 			debugMessenger = VK_NULL_HANDLE;
 		}
 		vkDestroyInstance(instance, nullptr);
-		std::cout << "[VulkanManager] : Vulkan instance destroyed." << std::endl;
+		LOG_INFO("VulkanManager", "Vulkan instance destroyed.");
 		instance = VK_NULL_HANDLE;
 	}
 
-	std::cout << "[VulkanManager] : Cleanup complete." << std::endl;
+	LOG_INFO("VulkanManager", "Cleanup complete.");
 }
 
 void VulkanManager::run() {
+	PROFILE_CPU_THREAD("render");
 	initVulkan();
 	mainLoop();
+	if (!options.tracePath.empty()) {
+		CpuTracer::writeChromeTrace(options.tracePath);
+	}
+	if (!options.frameStatsPath.empty()) {
+		frameStats.writeCsv(options.frameStatsPath);
+	}
 	// cleanup(); // Removido para evitar dupla liberação. O destrutor cuidará disso.
 }
 
@@ -517,7 +1689,8 @@ void VulkanManager::run() {
 // }
 
 void VulkanManager::loadCarModel() {
-	std::cout << "[VulkanManager] : Carregando modelo do carro..." << std::endl;
+	PROFILE_CPU_ZONE("loadCarModel");
+	LOG_INFO("VulkanManager", "Carregando modelo do carro...");
 
 	std::vector<MeshData> meshDatas = ModelLoader::load("../assets/models/obj file.obj");
 
@@ -527,6 +1700,5 @@ void VulkanManager::loadCarModel() {
 		mesh.upload(meshData, *bufferManager);
 		carMeshes.push_back(std::move(mesh));
 	}
-	std::cout << "[VulkanManager] : Modelo carregado! "
-	          << carMeshes.size() << " meshes." << std::endl;
+	LOG_INFO("VulkanManager", "Modelo carregado! {} meshes.", carMeshes.size());
 }
\ No newline at end of file
@@ -1,11 +1,12 @@
 #include <core/VulkanUtils/VulkanTools.hpp>
+#include <core/Logger.hpp>
 
 namespace VulkanTools {
 
 const std::vector<const char *> validationLayers = {"VK_LAYER_KHRONOS_validation"};
 
 bool checkValidationLayerSupport() {
-	std::cout << "[VulkanTools] : Checking Validation Layer Support" << std::endl;
+	LOG_INFO("VulkanTools", "Checking Validation Layer Support");
 	uint32_t layerCount;
 	vkEnumerateInstanceLayerProperties(&layerCount, nullptr);
 
@@ -17,7 +18,7 @@ bool checkValidationLayerSupport() {
 		for (const auto &layerProperties : availableLayers) {
 		if (strcmp(layerName, layerProperties.layerName) == 0) {
 				layerFound = true;
-				std::cout << "\t [VulkanTools] : Layer Found" << layerName << std::endl;
+				LOG_INFO("VulkanTools", "Layer Found {}", layerName);
 				break;
 			}
 		}
@@ -28,11 +29,14 @@ bool checkValidationLayerSupport() {
 	return true;
 }
 
-std::vector<const char *> getRequiredExtensions() {
-	uint32_t     glfwExtensionCount = 0;
-	const char **glfwExtensions     = glfwGetRequiredInstanceExtensions(&glfwExtensionCount);
+std::vector<const char *> getRequiredExtensions(bool windowSystem) {
+	std::vector<const char *> extensions;
 
-	std::vector<const char *> extensions(glfwExtensions, glfwExtensions + glfwExtensionCount);
+	if (windowSystem) {
+		uint32_t     glfwExtensionCount = 0;
+		const char **glfwExtensions     = glfwGetRequiredInstanceExtensions(&glfwExtensionCount);
+		extensions.assign(glfwExtensions, glfwExtensions + glfwExtensionCount);
+	}
 
 	if (enableValidationLayers) {
 		extensions.push_back(VK_EXT_DEBUG_UTILS_EXTENSION_NAME);
@@ -40,6 +44,21 @@ std::vector<const char *> getRequiredExtensions() {
 	return extensions;
 }
 
+bool isDeviceExtensionSupported(VkPhysicalDevice physicalDevice, const char *extensionName) {
+	uint32_t extensionCount = 0;
+	vkEnumerateDeviceExtensionProperties(physicalDevice, nullptr, &extensionCount, nullptr);
+
+	std::vector<VkExtensionProperties> availableExtensions(extensionCount);
+	vkEnumerateDeviceExtensionProperties(physicalDevice, nullptr, &extensionCount, availableExtensions.data());
+
+	for (const auto &extension : availableExtensions) {
+		if (strcmp(extensionName, extension.extensionName) == 0) {
+			return true;
+		}
+	}
+	return false;
+}
+
 VkResult CreateDebugUtilsMessengerEXT(VkInstance instance, const VkDebugUtilsMessengerCreateInfoEXT *pCreateInfo, const VkAllocationCallbacks *pAllocator, VkDebugUtilsMessengerEXT *pDebugMessenger) {
 	auto func = (PFN_vkCreateDebugUtilsMessengerEXT) vkGetInstanceProcAddr(instance, "vkCreateDebugUtilsMessengerEXT");
 	if (func != nullptr) {
@@ -67,8 +86,11 @@ VKAPI_ATTR VkBool32 VKAPI_CALL debugCallback(
     const VkDebugUtilsMessengerCallbackDataEXT *pCallbackData,
     void                                       *pUserData) {
 	// Filtra mensagens por severidade
-	if (messageSeverity >= VK_DEBUG_UTILS_MESSAGE_SEVERITY_WARNING_BIT_EXT) {
-		std::cerr << "Validation layer: " << pCallbackData->pMessage << std::endl;
+	if (messageSeverity >= VK_DEBUG_UTILS_MESSAGE_SEVERITY_ERROR_BIT_EXT) {
+		LOG_ERROR("Validation", "{}", pCallbackData->pMessage);
+	}
+	else if (messageSeverity >= VK_DEBUG_UTILS_MESSAGE_SEVERITY_WARNING_BIT_EXT) {
+		LOG_WARN("Validation", "{}", pCallbackData->pMessage);
 	}
 	return VK_FALSE;
 }
@@ -80,7 +102,7 @@ void setupDebugMessenger(VkInstance instance, VkDebugUtilsMessengerEXT &debugMes
 	if (CreateDebugUtilsMessengerEXT(instance, &createInfo, nullptr, &debugMessenger) != VK_SUCCESS) {
 		throw std::runtime_error("** Failed to set up debug messenger!");
 	}
-	std::cout << "- Debug messenger created successfully" << std::endl;
+	LOG_INFO("VulkanTools", "Debug messenger created successfully");
 }
 
 void populateDebugMessengerCreateInfo(VkDebugUtilsMessengerCreateInfoEXT &createInfo) {
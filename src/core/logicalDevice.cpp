@@ -1,17 +1,28 @@
 #include <core/logicalDevice.hpp>
 
+#include <algorithm>
+
 std::pair<VkDevice, LogicalDeviceCreator::DeviceQueue> LogicalDeviceCreator::create(
     VkPhysicalDevice physicalDevice,
     QueueManager& queueManager,
     bool enableValidationLayers,
     const std::vector<const char*>& validationLayers,
-    const std::vector<const char*>& deviceExtensions) {
+    const std::vector<const char*>& deviceExtensions,
+    const VkPhysicalDeviceFeatures& enabledFeatures,
+    const void* featureChain) {
     
     // Get queue family info from QueueManager
     const auto& queueFamilies = queueManager.getQueueFamilies();
     std::vector<VkDeviceQueueCreateInfo> queueCreateInfos;
     std::set<uint32_t> uniqueQueueFamilies;
 
+    // Uma prioridade por fila criada; precisa viver até o vkCreateDevice
+    uint32_t maxQueueCount = 1;
+    for (const auto& [type, info] : queueFamilies) {
+        maxQueueCount = std::max(maxQueueCount, info.queueCount);
+    }
+    std::vector<float> queuePriorities(maxQueueCount, 1.0f);
+
     // Create queue create infos
     for (const auto& [type, info] : queueFamilies) {
         if (uniqueQueueFamilies.insert(info.index).second) {
@@ -19,18 +30,18 @@ std::pair<VkDevice, LogicalDeviceCreator::DeviceQueue> LogicalDeviceCreator::cre
             queueCreateInfo.sType = VK_STRUCTURE_TYPE_DEVICE_QUEUE_CREATE_INFO;
             queueCreateInfo.queueFamilyIndex = info.index;
             queueCreateInfo.queueCount = info.queueCount;
-            float queuePriority = 1.0f; // Configurable in the future
-            queueCreateInfo.pQueuePriorities = &queuePriority;
+            queueCreateInfo.pQueuePriorities = queuePriorities.data(); // Configurable in the future
             queueCreateInfos.push_back(queueCreateInfo);
         }
     }
 
-    // Device features (customize as needed)
-    VkPhysicalDeviceFeatures deviceFeatures{};
+    // Device features (quem chama já filtrou pelo que o device suporta)
+    VkPhysicalDeviceFeatures deviceFeatures = enabledFeatures;
 
     // Device creation
     VkDeviceCreateInfo createInfo{};
     createInfo.sType = VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO;
+    createInfo.pNext = featureChain;
     createInfo.queueCreateInfoCount = static_cast<uint32_t>(queueCreateInfos.size());
     createInfo.pQueueCreateInfos = queueCreateInfos.data();
     createInfo.pEnabledFeatures = &deviceFeatures;
@@ -49,11 +60,24 @@ std::pair<VkDevice, LogicalDeviceCreator::DeviceQueue> LogicalDeviceCreator::cre
         throw std::runtime_error("[LogicalDeviceCreator] : Failed to create logical device");
     }
 
-    // Retrieve queues
+    // Retrieve queues (headless: sem família de present, usa a gráfica)
+    VkQueue graphicsQueue = queueManager.getQueue(device, QueueType::GRAPHICS);
     DeviceQueue queues{
-        queueManager.getQueue(device, QueueType::GRAPHICS),
-        queueManager.getQueue(device, QueueType::PRESENT)
+        graphicsQueue,
+        queueFamilies.count(QueueType::PRESENT) ? queueManager.getQueue(device, QueueType::PRESENT) : graphicsQueue,
+        VK_NULL_HANDLE,
+        queueFamilies.at(QueueType::GRAPHICS).index
     };
 
+    // Compute assíncrono: família só de compute ou, sem ela, a segunda fila da família gráfica
+    const QueueFamilyInfo& graphicsInfo = queueFamilies.at(QueueType::GRAPHICS);
+    auto computeIt = queueFamilies.find(QueueType::COMPUTE);
+    if (computeIt != queueFamilies.end() && computeIt->second.index != graphicsInfo.index) {
+        queues.computeQueue  = queueManager.getQueue(device, QueueType::COMPUTE);
+        queues.computeFamily = computeIt->second.index;
+    } else if (graphicsInfo.queueCount > 1) {
+        queues.computeQueue = queueManager.getQueue(device, QueueType::GRAPHICS, 1);
+    }
+
     return {device, queues};
 }
\ No newline at end of file
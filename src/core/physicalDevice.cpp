@@ -1,8 +1,11 @@
 #include <core/physicalDevice.hpp>
+#include <core/BindlessDescriptors.hpp>
+#include <core/FrameScheduler.hpp>
+#include <core/Logger.hpp>
 
 
 VkPhysicalDevice PhysicalDeviceSelector::select(VkInstance instance, VkSurfaceKHR surface, QueueManager& queueManager) {
-   std::cout << "[PhysicalDeviceSelector] : Checking Physicals Devices" << std::endl;
+   LOG_INFO("PhysicalDeviceSelector", "Checking Physicals Devices");
    uint32_t deviceCount = 0;
 	vkEnumeratePhysicalDevices(instance, &deviceCount, nullptr);
    if (deviceCount == 0) {
@@ -12,7 +15,7 @@ VkPhysicalDevice PhysicalDeviceSelector::select(VkInstance instance, VkSurfaceKH
 	vkEnumeratePhysicalDevices(instance, &deviceCount, devices.data());
    for (const auto& device : devices) {
       if (isDeviceSuitable(device, surface, queueManager)) {
-         std::cout << "[PhysicalDeviceSelector] : Find an device supported" << std::endl;
+         LOG_INFO("PhysicalDeviceSelector", "Find an device supported");
 			return device;
 		}
 	}
@@ -27,11 +30,19 @@ bool PhysicalDeviceSelector::isDeviceSuitable(VkPhysicalDevice device, VkSurface
     
     // Define requirements (same as in QueueManager::initialize for consistency)
     std::vector<QueueManager::QueueRequirements> requirements = {
-        {QueueType::GRAPHICS, 1, VK_QUEUE_GRAPHICS_BIT, false},
-        {QueueType::PRESENT, 1, 0, true}
+        {QueueType::GRAPHICS, 1, VK_QUEUE_GRAPHICS_BIT, false}
     };
+    // Headless (sem surface): não precisa de present nem de swapchain
+    bool presenting = surface != VK_NULL_HANDLE;
+    if (presenting) {
+        requirements.push_back({QueueType::PRESENT, 1, 0, true});
+    }
 
     // Check queue family support
-    return QueueManager::areQueueFamiliesSufficient(queueManager.getQueueFamilies(), requirements) && SwapchainManager::checkDeviceSupportSwapChain(device);
-    // Add more checks (e.g., extensions, features) as needed
+    // Descriptor indexing (Vulkan 1.2) é obrigatório: todo o material passa pelo set bindless
+    // Timeline semaphore também: o ritmo dos frames depende dele
+    return QueueManager::areQueueFamiliesSufficient(queueManager.getQueueFamilies(), requirements) &&
+           (!presenting || SwapchainManager::checkDeviceSupportSwapChain(device)) &&
+           BindlessDescriptors::isSupported(device) &&
+           FrameScheduler::isSupported(device);
 }
\ No newline at end of file
@@ -4,9 +4,12 @@ void QueueManager::initialize(VkPhysicalDevice device, VkSurfaceKHR surface) {
    queueFamilies = findQueueFamilies(device, surface);
 
    std::vector<QueueRequirements> requirements = {
-      {QueueType::GRAPHICS, 1, VK_QUEUE_GRAPHICS_BIT, false},
-      {QueueType::PRESENT, 1, 0, true}
+      {QueueType::GRAPHICS, 1, VK_QUEUE_GRAPHICS_BIT, false}
    };
+   // Sem surface (headless) não existe fila de apresentação
+   if (surface != VK_NULL_HANDLE) {
+      requirements.push_back({QueueType::PRESENT, 1, 0, true});
+   }
 
    if (!areQueueFamiliesSufficient(queueFamilies, requirements)) {
       throw std::runtime_error("[QueueManager] : Physical device does not support required queue families");
@@ -30,9 +33,13 @@ std::unordered_map<QueueType, QueueFamilyInfo> QueueManager::findQueueFamilies(V
          families[QueueType::GRAPHICS] = {i, props.queueCount, props.queueFlags, false};
       }
       
-      // Check for compute queue
+      // Check for compute queue (família sem gráficos ganha: é a que roda em paralelo de verdade)
       if (props.queueFlags & VK_QUEUE_COMPUTE_BIT) {
-         families[QueueType::COMPUTE] = {i, props.queueCount, props.queueFlags, false};
+         bool dedicated = !(props.queueFlags & VK_QUEUE_GRAPHICS_BIT);
+         auto current   = families.find(QueueType::COMPUTE);
+         if (current == families.end() || (dedicated && (current->second.flags & VK_QUEUE_GRAPHICS_BIT))) {
+            families[QueueType::COMPUTE] = {i, props.queueCount, props.queueFlags, false};
+         }
       }
       
       // Check for transfer queue